@@ -36,12 +36,30 @@
 #endif
 #define MARFS_DIR_NS_OFFSET_MASK (long)( 1L << MARFS_DIR_NS_OFFSET_BIT )
 
+#define MARFS_CREATBATCH_RUN 1024 // max entries per datastream_createbatch() call
+
+typedef struct marfs_pathent_struct {
+   char*       prefix; // path prefix string resolved by this entry ( NULL if unused )
+   size_t   prefixlen;
+   uint64_t      hash; // hash of the prefix string
+   uid_t         euid; // effective IDs of the resolving caller ( directory search perms
+   gid_t         egid; //   are only checked during the initial resolution )
+   time_t     expires; // time after which this entry must be resolved again
+   marfs_position pos; // position of the prefix dir itself ( MDAL_CTXT is chdir'd into it )
+} marfs_pathent;
+
 typedef struct marfs_ctxt_struct {
    pthread_mutex_t        lock; // for serializing access to this structure (if necessary)
    marfs_config*        config;
    marfs_interface       itype;
    marfs_position          pos;
    pthread_mutex_t erasurelock; // for serializing libNE erasure functions (if necessary)
+   pthread_mutex_t    pathlock; // for serializing access to the path cache
+   marfs_pathent*    pathcache; // cache of resolved path prefixes ( direct mapped, by prefix hash )
+   size_t         pathentries; // length of the pathcache list ( zero, if disabled )
+   unsigned int        pathttl; // lifetime of pathcache entries, in seconds
+   size_t             pathhits;
+   size_t           pathmisses;
 }* marfs_ctxt;
 
 typedef struct marfs_fhandle_struct {
@@ -69,6 +87,186 @@ typedef struct marfs_dhandle_struct {
 
 //   -------------   INTERNAL FUNCTIONS    -------------
 
+void pathcleanup( char* subpath, marfs_position* oppos ) {
+   if ( oppos ) { config_abandonposition( oppos ); }
+   if ( subpath ) { free( subpath ); }
+}
+
+/**
+ * Produce a hash value for the given path prefix ( FNV-1a )
+ * @param const char* prefix : Path prefix string
+ * @param size_t prefixlen : Length of the path prefix
+ * @return uint64_t : Hash of the prefix
+ */
+uint64_t pathcache_hash( const char* prefix, size_t prefixlen ) {
+   uint64_t hash = 14695981039346656037ULL;
+   size_t index;
+   for ( index = 0; index < prefixlen; index++ ) {
+      hash ^= (unsigned char)prefix[index];
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+/**
+ * Release the content of the given path cache entry
+ * NOTE -- caller must hold the pathlock of the containing ctxt
+ * @param marfs_pathent* ent : Entry to be released
+ */
+void pathcache_release( marfs_pathent* ent ) {
+   if ( ent->prefix ) {
+      config_abandonposition( &(ent->pos) );
+      free( ent->prefix );
+      ent->prefix = NULL;
+   }
+}
+
+/**
+ * Release all entries of the path cache of the given ctxt
+ * NOTE -- This must follow any op which may alter the resolution of a path prefix ( rename,
+ *         rmdir, unlink of a link, perm changes, chdir ), as entries would otherwise remain
+ *         valid until they expire.
+ * @param marfs_ctxt ctxt : Ctxt for which to flush the path cache
+ */
+void pathcache_flush( marfs_ctxt ctxt ) {
+   if ( ctxt->pathentries == 0 ) { return; } // nothing to flush
+   if ( pthread_mutex_lock( &(ctxt->pathlock) ) ) {
+      LOG( LOG_WARNING, "Failed to acquire pathlock for flush\n" );
+      return;
+   }
+   size_t index;
+   for ( index = 0; index < ctxt->pathentries; index++ ) {
+      pathcache_release( ctxt->pathcache + index );
+   }
+   pthread_mutex_unlock( &(ctxt->pathlock) );
+}
+
+/**
+ * Produce a position referencing the parent dir of the given path, using the path cache
+ * NOTE -- On a cache miss, the parent path is resolved from the current ctxt position and
+ *         inserted into the cache for subsequent use.
+ * @param marfs_ctxt ctxt : Current MarFS context
+ * @param const char* tgtpath : Target path
+ * @param marfs_position* oppos : Reference to be populated with a new MarFS position
+ * @return const char* : Reference to the final component of tgtpath, to be traversed relative to
+ *                       the produced position, or NULL if no position was produced
+ *                       ( caller should traverse the full path instead )
+ */
+const char* pathcache_lookup( marfs_ctxt ctxt, const char* tgtpath, marfs_position* oppos ) {
+   // identify the final path component
+   const char* finalcomp = strrchr( tgtpath, '/' );
+   if ( finalcomp == NULL  ||  finalcomp == tgtpath ) { return NULL; } // no prefix worth caching
+   finalcomp++;
+   if ( *finalcomp == '\0'  ||  strcmp( finalcomp, "." ) == 0  ||  strcmp( finalcomp, ".." ) == 0 ) {
+      return NULL; // these do not simply target a member of the prefix dir
+   }
+   size_t prefixlen = ( finalcomp - 1 ) - tgtpath;
+   uint64_t hash = pathcache_hash( tgtpath, prefixlen );
+   uid_t euid = geteuid();
+   gid_t egid = getegid();
+   time_t curtime = time( NULL );
+   // check for a matching entry
+   if ( pthread_mutex_lock( &(ctxt->pathlock) ) ) {
+      LOG( LOG_WARNING, "Failed to acquire pathlock for lookup\n" );
+      return NULL;
+   }
+   if ( ctxt->pathentries == 0 ) {
+      pthread_mutex_unlock( &(ctxt->pathlock) );
+      return NULL; // cache was disabled
+   }
+   marfs_pathent* ent = ctxt->pathcache + ( hash % ctxt->pathentries );
+   if ( ent->prefix  &&  ent->hash == hash  &&  ent->prefixlen == prefixlen  &&
+        ent->euid == euid  &&  ent->egid == egid  &&  strncmp( ent->prefix, tgtpath, prefixlen ) == 0 ) {
+      if ( ent->expires > curtime  &&  config_duplicateposition( &(ent->pos), oppos ) == 0 ) {
+         ctxt->pathhits++;
+         pthread_mutex_unlock( &(ctxt->pathlock) );
+         return finalcomp;
+      }
+      pathcache_release( ent ); // expired ( or unusable ) entry
+   }
+   ctxt->pathmisses++;
+   pthread_mutex_unlock( &(ctxt->pathlock) );
+   // resolve the prefix from our current position
+   char* prefix = strndup( tgtpath, prefixlen );
+   if ( prefix == NULL ) {
+      LOG( LOG_WARNING, "Failed to duplicate path prefix of: \"%s\"\n", tgtpath );
+      return NULL;
+   }
+   char* modpath = strdup( prefix );
+   if ( modpath == NULL ) {
+      LOG( LOG_WARNING, "Failed to duplicate path prefix of: \"%s\"\n", tgtpath );
+      free( prefix );
+      return NULL;
+   }
+   marfs_position prefixpos = { .ns = NULL, .depth = 0, .ctxt = NULL };
+   if ( config_duplicateposition( &(ctxt->pos), &(prefixpos) ) ) {
+      LOG( LOG_WARNING, "Failed to duplicate position of current marfs ctxt\n" );
+      free( modpath );
+      free( prefix );
+      return NULL;
+   }
+   // NOTE -- all prefix components are dirs, so always substitute links for INTERACTIVE ctxts
+   int prefixdepth = config_traverse( ctxt->config, &(prefixpos), &(modpath), (ctxt->itype == MARFS_INTERACTIVE) ? 1 : 0 );
+   if ( prefixdepth < 0  ||  config_fortifyposition( &(prefixpos) ) ) {
+      // leave any error reporting to a full traversal
+      LOG( LOG_INFO, "Path prefix is not cacheable: \"%s\"\n", prefix );
+      pathcleanup( modpath, &(prefixpos) );
+      free( prefix );
+      return NULL;
+   }
+   if ( *modpath != '\0'  &&  strcmp( modpath, "." ) ) {
+      // shift the position MDAL_CTXT into the prefix dir itself
+      MDAL curmdal = prefixpos.ns->prepo->metascheme.mdal;
+      MDAL_DHANDLE dh = curmdal->opendir( prefixpos.ctxt, modpath );
+      if ( dh == NULL ) {
+         LOG( LOG_INFO, "Failed to open prefix dir: \"%s\"\n", modpath );
+         pathcleanup( modpath, &(prefixpos) );
+         free( prefix );
+         return NULL;
+      }
+      if ( curmdal->chdir( prefixpos.ctxt, dh ) ) {
+         LOG( LOG_WARNING, "Failed to chdir into prefix dir: \"%s\"\n", modpath );
+         curmdal->closedir( dh );
+         pathcleanup( modpath, &(prefixpos) );
+         free( prefix );
+         return NULL;
+      }
+      prefixpos.depth = prefixdepth;
+   }
+   free( modpath );
+   if ( config_duplicateposition( &(prefixpos), oppos ) ) {
+      LOG( LOG_WARNING, "Failed to duplicate position of prefix: \"%s\"\n", prefix );
+      config_abandonposition( &(prefixpos) );
+      free( prefix );
+      return NULL;
+   }
+   // insert the new entry, replacing any previous occupant
+   if ( pthread_mutex_lock( &(ctxt->pathlock) ) ) {
+      LOG( LOG_WARNING, "Failed to acquire pathlock for insertion\n" );
+      config_abandonposition( &(prefixpos) );
+      free( prefix );
+      return finalcomp;
+   }
+   if ( ctxt->pathentries ) {
+      ent = ctxt->pathcache + ( hash % ctxt->pathentries );
+      pathcache_release( ent );
+      ent->prefix = prefix;
+      ent->prefixlen = prefixlen;
+      ent->hash = hash;
+      ent->euid = euid;
+      ent->egid = egid;
+      ent->expires = curtime + ctxt->pathttl;
+      ent->pos = prefixpos;
+      prefix = NULL;
+   }
+   pthread_mutex_unlock( &(ctxt->pathlock) );
+   if ( prefix ) { // cache was disabled in the interim
+      config_abandonposition( &(prefixpos) );
+      free( prefix );
+   }
+   return finalcomp;
+}
+
 /**
  * Translates the given path to an actual marfs subpath, relative to some NS
  * @param marfs_ctxt ctxt : Current MarFS context
@@ -81,14 +279,18 @@ typedef struct marfs_dhandle_struct {
  * @return int : Depth of the target from the containing NS, or -1 if a failure occurred
  */
 int pathshift( marfs_ctxt ctxt, const char* tgtpath, char** subpath, marfs_position* oppos, char linkchk ) {
+   // attempt to begin from a cached position of the parent dir
+   const char* finalcomp = NULL;
+   if ( ctxt->pathentries ) { finalcomp = pathcache_lookup( ctxt, tgtpath, oppos ); }
    // duplicate our pos structure and path
-   char* modpath = strdup( tgtpath );
+   char* modpath = strdup( (finalcomp) ? finalcomp : tgtpath );
    if ( modpath == NULL ) {
       LOG( LOG_ERR, "Failed to duplicate target path: \"%s\"\n", tgtpath );
+      if ( finalcomp ) { config_abandonposition( oppos ); }
       return -1;
    }
    // duplicate position values, so that config_traverse() won't modify the active CTXT position
-   if ( config_duplicateposition( &(ctxt->pos), oppos ) ) {
+   if ( finalcomp == NULL  &&  config_duplicateposition( &(ctxt->pos), oppos ) ) {
       LOG( LOG_ERR, "Failed to duplicate position of current marfs ctxt\n" );
       free( modpath );
       return -1;
@@ -120,9 +322,194 @@ int pathshift( marfs_ctxt ctxt, const char* tgtpath, char** subpath, marfs_posit
    return tgtdepth;
 }
 
-void pathcleanup( char* subpath, marfs_position* oppos ) {
-   if ( oppos ) { config_abandonposition( oppos ); }
-   if ( subpath ) { free( subpath ); }
+/**
+ * Identify the target of a batch create entry, traversing from the current ctxt position
+ * NOTE -- Unlike pathshift(), this never begins from a cached position.  As such, targets
+ *         within the same NS at the same depth always share the same MDAL_CTXT location.
+ * @param marfs_ctxt ctxt : Current MarFS context
+ * @param const char* tgtpath : Target path
+ * @param char** subpath : Reference to be populated with the MarFS subpath
+ * @param marfs_position* oppos : Reference to be populated with a new MarFS position
+ * @return int : Depth of the target from the containing NS, or -1 if a failure occurred
+ */
+int batchshift( marfs_ctxt ctxt, const char* tgtpath, char** subpath, marfs_position* oppos ) {
+   // duplicate our pos structure and path
+   char* modpath = strdup( tgtpath );
+   if ( modpath == NULL ) {
+      LOG( LOG_ERR, "Failed to duplicate target path: \"%s\"\n", tgtpath );
+      return -1;
+   }
+   if ( config_duplicateposition( &(ctxt->pos), oppos ) ) {
+      LOG( LOG_ERR, "Failed to duplicate position of current marfs ctxt\n" );
+      free( modpath );
+      return -1;
+   }
+   // traverse the config, skipping substitution of the final component ( as for marfs_creat() )
+   int tgtdepth = config_traverse( ctxt->config, oppos, &(modpath), (ctxt->itype == MARFS_INTERACTIVE) ? 2 : 0 );
+   if ( tgtdepth < 0 ) {
+      LOG( LOG_ERR, "Failed to traverse config for subpath: \"%s\"\n", modpath );
+      int origerrno = errno; // cache and restore errno, to better report the 'real' problem to users
+      free( modpath );
+      config_abandonposition( oppos );
+      errno = origerrno; // restore cached errno
+      return -1;
+   }
+   *subpath = modpath;
+   return tgtdepth;
+}
+
+/**
+ * Adjust the stat values of a file below a NS root, hiding the MDAL reference path
+ * @param struct stat* st : Stat values to be adjusted
+ */
+void statadjust( struct stat* st ) {
+   if ( S_ISREG( st->st_mode ) ) {
+      // regular files may need link count adjusted to ignore ref path
+      if ( st->st_nlink > 1 ) { st->st_nlink--; }
+      if ( st->st_size ) {
+         // assume allocated blocks, based on logical file size ( saves us having to pull an FTAG xattr )
+         blkcnt_t estblocks = ( st->st_size / 512 ) + ( (st->st_size % 512) ? 1 : 0 );
+         if ( estblocks > st->st_blocks ) { st->st_blocks = estblocks; }
+      }
+   }
+}
+
+/**
+ * Stat the root dir of the given NS, noting subspaces in the link count
+ * NOTE -- If the given interface type lacks NS_READMETA perms on the NS, only the file type
+ *         of the resulting stat info will be populated.
+ * @param marfs_ns* ns : Namespace to stat
+ * @param marfs_interface itype : Interface type of the requesting ctxt
+ * @param struct stat* st : Stat structure to be populated
+ * @return int : Zero on success, or -1 if a failure occurred
+ */
+int statnsroot( marfs_ns* ns, marfs_interface itype, struct stat* st ) {
+   char* nspath = NULL;
+   if ( config_nsinfo( ns->idstr, NULL, &(nspath) ) ) {
+      LOG( LOG_ERR, "Failed to identify NS path of namespace: \"%s\"\n", ns->idstr );
+      return -1;
+   }
+   MDAL nsmdal = ns->prepo->metascheme.mdal;
+   int retval = nsmdal->statnamespace( nsmdal->ctxt, nspath, st );
+   if ( retval == 0 ) {
+      if ( ( itype != MARFS_INTERACTIVE  &&  !(ns->bperms & NS_READMETA) )  ||
+           ( itype != MARFS_BATCH        &&  !(ns->iperms & NS_READMETA) ) ) {
+         // NS perms do not allow a stat op, so just indicate the file type
+         LOG( LOG_INFO, "NS perms restrict stat info of NS root: \"%s\"\n", nspath );
+         memset( st, 0, sizeof( struct stat ) );
+         st->st_mode = S_IFDIR;
+      }
+      else { st->st_nlink += ns->subnodecount; }
+   }
+   else { LOG( LOG_INFO, "Failed to stat NS root: \"%s\" ( %s )\n", nspath, strerror(errno) ); }
+   int origerrno = errno;
+   free( nspath );
+   errno = origerrno;
+   return retval;
+}
+
+/**
+ * Iterate to the next entry of an open directory handle, optionally populating stat info
+ * NOTE -- The caller is expected to clear errno prior to calling this func.
+ * @param marfs_dhandle dh : marfs_dhandle to read from
+ * @param struct stat* st : Stat structure to be populated for the returned entry
+ *                          ( NULL, if no stat info is desired )
+ * @param int flags : Flags of the stat op ( ignored, if 'st' is NULL )
+ * @return struct dirent* : Reference to the next dirent struct, or NULL w/ errno unset
+ *                          if all entries have been read, or NULL w/ errno set if a
+ *                          failure occurred
+ */
+struct dirent* direntnext( marfs_dhandle dh, struct stat* st, int flags ) {
+   // check for NULL args
+   if ( dh == NULL ) {
+      LOG( LOG_ERR, "Received a NULL marfs_dhandle arg\n" );
+      errno = EINVAL;
+      return NULL;
+   }
+   // acquire directory lock
+   if ( pthread_mutex_lock( &(dh->lock) ) ) {
+      LOG( LOG_ERR, "Failed to aqcuire marfs_dhandle lock\n" );
+      return NULL;
+   }
+   // potentially insert a subspace entry
+   if ( dh->depth == 0  &&  dh->ns->subnodecount  &&  (dh->location & MARFS_DIR_NS_OFFSET_MASK) == 0 ) {
+      while ( dh->location < dh->ns->subnodecount ) {
+         // stat the subspace, to check for existence
+         marfs_ns* tgtsubspace = (marfs_ns *)(dh->ns->subnodes[dh->location].content);
+         struct stat stval;
+         int stnsres = statnsroot( tgtsubspace, dh->itype, (st) ? st : &(stval) );
+         if ( stnsres  &&  errno != ENOENT ) {
+            LOG( LOG_ERR, "Failed to stat subspace root: \"%s\"\n", tgtsubspace->idstr );
+            pthread_mutex_unlock( &(dh->lock) );
+            return NULL;
+         }
+         errno = 0;
+         if ( stnsres == 0 ) {
+            // populate and return the subspace dirent
+            if ( snprintf( dh->subspcent.d_name, dh->subspcnamealloc, "%s", dh->ns->subnodes[dh->location].name ) >= dh->subspcnamealloc ) {
+               LOG( LOG_ERR, "Dirent struct does not have sufficient space to store subspace name: \"%s\" (%zu bytes available)\n", dh->ns->subnodes[dh->location].name, dh->subspcnamealloc );
+               pthread_mutex_unlock( &(dh->lock) );
+               errno = ENAMETOOLONG;
+               return NULL;
+            }
+            // increment our index
+            dh->location++;
+            if ( dh->location & MARFS_DIR_NS_OFFSET_MASK ) {
+               if ( dh->location != dh->ns->subnodecount ) {
+                  // indicate that our location has become invalid
+                  dh->location = MARFS_DIR_NS_OFFSET_MASK | 1L;
+                  LOG( LOG_ERR, "This readdir op has resulted in an excessive dir handle location value\n" );
+               }
+               else {
+                  // overwrite our location, to indicate that we have finished subspace listing
+                  dh->location = MARFS_DIR_NS_OFFSET_MASK;
+               }
+            }
+            pthread_mutex_unlock( &(dh->lock) );
+            return &(dh->subspcent);
+         }
+         // increment our index
+         dh->location++;
+      }
+      // overwrite our location, to indicate that we have finished subspace listing
+      dh->location = MARFS_DIR_NS_OFFSET_MASK;
+   }
+   // check for an invalid location value
+   if ( dh->location == (MARFS_DIR_NS_OFFSET_MASK | 1L) ) {
+      pthread_mutex_unlock( &(dh->lock) );
+      LOG( LOG_ERR, "Dir handle location value is invalid\n" );
+      errno = EMSGSIZE;
+      return NULL;
+   }
+   // perform the op
+   MDAL curmdal = dh->ns->prepo->metascheme.mdal;
+   struct dirent* retval = NULL;
+   char repeat = 1;
+   while ( repeat ) {
+      if ( st ) { retval = curmdal->readdirplus( dh->metahandle, st, flags ); }
+      else { retval = curmdal->readdir( dh->metahandle ); }
+      // filter out any restricted entries at the root of a NS
+      if ( dh->depth == 0  &&  retval != NULL  &&  curmdal->pathfilter( retval->d_name ) ) {
+         LOG( LOG_INFO, "Omitting hidden dirent: \"%s\"\n", retval->d_name );
+      }
+      else { repeat = 0; } // break on error, or if the entry wasn't filtered
+   }
+   if ( st  &&  retval != NULL ) {
+      // adjust stat values to match those of marfs_stat()
+      if ( dh->depth == 0  &&  ( strcmp( retval->d_name, "." ) == 0  ||  strcmp( retval->d_name, ".." ) == 0 ) ) {
+         // NS roots ( and the MDAL parent dir of a NS root, which is not the parent NS ) must be
+         //    stat'd as namespaces, to hide MDAL subdirs and note subspaces
+         marfs_ns* tgtns = dh->ns;
+         if ( retval->d_name[1] == '.'  &&  dh->ns->pnamespace ) { tgtns = dh->ns->pnamespace; }
+         if ( statnsroot( tgtns, dh->itype, st ) ) {
+            LOG( LOG_ERR, "Failed to stat NS root: \"%s\"\n", tgtns->idstr );
+            retval = NULL;
+         }
+      }
+      else { statadjust( st ); }
+   }
+   pthread_mutex_unlock( &(dh->lock) );
+   return retval;
 }
 
 /**
@@ -243,6 +630,16 @@ marfs_ctxt marfs_init( const char* configpath, marfs_interface type, pthread_mut
       LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
       return NULL;
    }
+   // initialize our path cache lock ( the cache itself is disabled by default )
+   if ( pthread_mutex_init( &(ctxt->pathlock), NULL ) ) {
+      LOG( LOG_ERR,"Failed to initialize pathlock for marfs_ctxt\n" );
+      pthread_mutex_destroy( &(ctxt->lock) );
+      rootmdal->destroyctxt( ctxt->pos.ctxt );
+      config_term( ctxt->config );
+      free( ctxt );
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return NULL;
+   }
    // all done
    LOG( LOG_INFO, "EXIT - Success\n" );
    return ctxt;
@@ -326,6 +723,100 @@ size_t marfs_configver( marfs_ctxt ctxt, char* verstr, size_t len ) {
    return retval;
 }
 
+/**
+ * Configure the path resolution cache of the given context struct, which retains resolved
+ * parent dir positions of recently targeted paths, allowing subsequent path ops within the
+ * same dir to skip traversal of all but the final path component
+ * NOTE -- Cache entries are flushed by any rename, rmdir, unlink, chmod, chown, or chdir op
+ *         issued through this ctxt, but changes made through any other ctxt or client
+ *         will only be reflected once the affected entries expire.
+ *         Entries are specific to the effective UID / GID of the resolving caller, as
+ *         directory search permissions are only checked during the initial resolution.
+ *         Callers which alter supplementary groups, without also altering EUID / EGID,
+ *         should not enable this cache.
+ * @param marfs_ctxt ctxt : marfs_ctxt to be updated
+ * @param size_t entries : Maximum number of cached path prefixes ( zero disables the cache )
+ * @param unsigned int ttl : Lifetime of each cache entry, in seconds
+ * @return int : Zero on success, or -1 on failure
+ */
+int marfs_setpathcache( marfs_ctxt ctxt, size_t entries, unsigned int ttl ) {
+   LOG( LOG_INFO, "ENTRY\n" );
+   // check for invalid args
+   if ( ctxt == NULL ) {
+      LOG( LOG_ERR, "Received a NULL marfs_ctxt\n" );
+      errno = EINVAL;
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return -1;
+   }
+   if ( entries  &&  ttl == 0 ) {
+      LOG( LOG_ERR, "Received a zero path cache TTL value\n" );
+      errno = EINVAL;
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return -1;
+   }
+   // allocate the new cache
+   marfs_pathent* newcache = NULL;
+   if ( entries ) {
+      newcache = calloc( entries, sizeof( marfs_pathent ) );
+      if ( newcache == NULL ) {
+         LOG( LOG_ERR, "Failed to allocate a path cache of %zu entries\n", entries );
+         LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+         return -1;
+      }
+   }
+   // acquire the path cache lock
+   if ( pthread_mutex_lock( &(ctxt->pathlock) ) ) {
+      LOG( LOG_ERR, "Failed to acquire marfs_ctxt pathlock\n" );
+      if ( newcache ) { free( newcache ); }
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return -1;
+   }
+   // replace the original cache
+   size_t index;
+   for ( index = 0; index < ctxt->pathentries; index++ ) {
+      pathcache_release( ctxt->pathcache + index );
+   }
+   if ( ctxt->pathcache ) { free( ctxt->pathcache ); }
+   ctxt->pathcache = newcache;
+   ctxt->pathentries = entries;
+   ctxt->pathttl = ttl;
+   ctxt->pathhits = 0;
+   ctxt->pathmisses = 0;
+   pthread_mutex_unlock( &(ctxt->pathlock) );
+   LOG( LOG_INFO, "EXIT - Success\n" );
+   return 0;
+}
+
+/**
+ * Retrieve path resolution cache hit / miss counts of the given context struct
+ * ( since the cache was last configured via marfs_setpathcache() )
+ * @param marfs_ctxt ctxt : marfs_ctxt to retrieve cache stats from
+ * @param size_t* hits : Reference to be populated with the number of cache hits
+ * @param size_t* misses : Reference to be populated with the number of cache misses
+ * @return int : Zero on success, or -1 on failure
+ */
+int marfs_pathcachestats( marfs_ctxt ctxt, size_t* hits, size_t* misses ) {
+   LOG( LOG_INFO, "ENTRY\n" );
+   // check for invalid args
+   if ( ctxt == NULL ) {
+      LOG( LOG_ERR, "Received a NULL marfs_ctxt\n" );
+      errno = EINVAL;
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return -1;
+   }
+   // acquire the path cache lock
+   if ( pthread_mutex_lock( &(ctxt->pathlock) ) ) {
+      LOG( LOG_ERR, "Failed to acquire marfs_ctxt pathlock\n" );
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return -1;
+   }
+   if ( hits ) { *hits = ctxt->pathhits; }
+   if ( misses ) { *misses = ctxt->pathmisses; }
+   pthread_mutex_unlock( &(ctxt->pathlock) );
+   LOG( LOG_INFO, "EXIT - Success\n" );
+   return 0;
+}
+
 /**
  * Destroy the provided marfs_ctxt
  * @param marfs_ctxt ctxt : marfs_ctxt to be destroyed
@@ -346,6 +837,9 @@ int marfs_term( marfs_ctxt ctxt ) {
       LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
       return -1;
    }
+   // release all path cache entries
+   pathcache_flush( ctxt );
+   if ( ctxt->pathcache ) { free( ctxt->pathcache ); }
    // terminate the position MDAL_CTXT
    int retval = 0;
    MDAL curmdal = ctxt->pos.ns->prepo->metascheme.mdal;
@@ -361,6 +855,7 @@ int marfs_term( marfs_ctxt ctxt ) {
    // free the ctxt struct itself
    pthread_mutex_unlock( &(ctxt->lock) );
    pthread_mutex_destroy( &(ctxt->lock) );
+   pthread_mutex_destroy( &(ctxt->pathlock) );
    pthread_mutex_destroy( &(ctxt->erasurelock) );
    free( ctxt );
    if ( retval == 0 ) { LOG( LOG_INFO, "EXIT - Success\n" ); }
@@ -519,14 +1014,8 @@ int marfs_stat( marfs_ctxt ctxt, const char* path, struct stat *buf, int flags )
       // note subspaces in link count
       buf->st_nlink += oppos.ns->subnodecount;
    }
-   else if ( tgtdepth != 0  &&  S_ISREG( buf->st_mode ) ) {
-      // regular files may need link count adjusted to ignore ref path
-      if ( buf->st_nlink > 1 ) { buf->st_nlink--; }
-      if ( buf->st_size ) {
-         // assume allocated blocks, based on logical file size ( saves us having to pull an FTAG xattr )
-         blkcnt_t estblocks = ( buf->st_size / 512 ) + ( (buf->st_size % 512) ? 1 : 0 );
-         if ( estblocks > buf->st_blocks ) { buf->st_blocks = estblocks; }
-      }
+   else if ( tgtdepth != 0  &&  retval == 0 ) {
+      statadjust( buf );
    }
    // cleanup references
    pathcleanup( subpath, &oppos );
@@ -582,6 +1071,8 @@ int marfs_chmod( marfs_ctxt ctxt, const char* path, mode_t mode, int flags ) {
    else {
       retval = curmdal->chmod( oppos.ctxt, subpath, mode, flags );
    }
+   // cached path prefixes may no longer be valid
+   if ( retval == 0 ) { pathcache_flush( ctxt ); }
    // cleanup references
    pathcleanup( subpath, &oppos );
    // return op result
@@ -637,6 +1128,8 @@ int marfs_chown( marfs_ctxt ctxt, const char* path, uid_t uid, gid_t gid, int fl
    else {
       retval = curmdal->chown( oppos.ctxt, subpath, uid, gid, flags );
    }
+   // cached path prefixes may no longer be valid
+   if ( retval == 0 ) { pathcache_flush( ctxt ); }
    // cleanup references
    pathcleanup( subpath, &oppos );
    // return op result
@@ -725,6 +1218,8 @@ int marfs_rename( marfs_ctxt ctxt, const char* from, const char* to ) {
    // perform the MDAL op
    MDAL curmdal = topos.ns->prepo->metascheme.mdal;
    int retval = curmdal->rename( frompos.ctxt, frompath, topos.ctxt, topath );
+   // cached path prefixes may no longer be valid
+   if ( retval == 0 ) { pathcache_flush( ctxt ); }
    // cleanup references
    pathcleanup( frompath, &frompos );
    pathcleanup( topath, &topos );
@@ -890,7 +1385,16 @@ int marfs_unlink( marfs_ctxt ctxt, const char* path ) {
    }
    // perform the MDAL op
    MDAL curmdal = oppos.ns->prepo->metascheme.mdal;
+   char linktgt = 1; // assume the target may be a link, in use by cached path prefixes
+   if ( ctxt->pathentries ) {
+      // only links can be both unlinked and traversed, so avoid flushing for all others
+      struct stat linkst;
+      if ( curmdal->stat( oppos.ctxt, subpath, &(linkst), AT_SYMLINK_NOFOLLOW ) == 0  &&
+           !(S_ISLNK(linkst.st_mode)) ) { linktgt = 0; }
+   }
    int retval = curmdal->unlink( oppos.ctxt, subpath );
+   // cached path prefixes may no longer be valid
+   if ( retval == 0  &&  linktgt ) { pathcache_flush( ctxt ); }
    // cleanup references
    pathcleanup( subpath, &oppos );
    // return op result
@@ -1161,6 +1665,8 @@ int marfs_rmdir( marfs_ctxt ctxt, const char* path ) {
       // just issue the base op
       retval = curmdal->rmdir( oppos.ctxt, subpath );
    }
+   // cached path prefixes may no longer be valid
+   if ( retval == 0 ) { pathcache_flush( ctxt ); }
    // cleanup references
    pathcleanup( subpath, &oppos );
    // return op result
@@ -1558,100 +2064,46 @@ marfs_dhandle marfs_opendir(marfs_ctxt ctxt, const char *path) {
  */
 struct dirent *marfs_readdir(marfs_dhandle dh) {
    LOG( LOG_INFO, "ENTRY\n" );
-   // check for NULL args
-   if ( dh == NULL ) {
-      LOG( LOG_ERR, "Received a NULL marfs_dhandle arg\n" );
+   int cachederrno = errno;
+   errno = 0;
+   struct dirent* retval = direntnext( dh, NULL, 0 );
+   if ( retval != NULL ) { LOG( LOG_INFO, "EXIT - Success\n" ); errno = cachederrno; }
+   else { LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) ); }
+   return retval;
+}
+
+/**
+ * Iterate to the next entry of an open directory handle, populating stat info for that
+ * entry ( equivalent to a marfs_readdir() followed by a marfs_stat() of the entry )
+ * NOTE -- Entries which vanish between being read and being stat'd will be skipped.
+ *         Subspaces which the caller lacks permission to stat will have only their file
+ *         type populated.
+ * @param marfs_dhandle dh : marfs_dhandle to read from
+ * @param struct stat* st : Stat structure to be populated for the returned entry
+ * @param int flags : A bitwise OR of the following...
+ *                    AT_SYMLINK_NOFOLLOW - do not dereference a symlink target
+ * @return struct dirent* : Reference to the next dirent struct, or NULL w/ errno unset
+ *                          if all entries have been read, or NULL w/ errno set if a
+ *                          failure occurred
+ */
+struct dirent *marfs_readdirplus(marfs_dhandle dh, struct stat* st, int flags) {
+   LOG( LOG_INFO, "ENTRY\n" );
+   // check for invalid args
+   if ( st == NULL ) {
+      LOG( LOG_ERR, "Received a NULL stat buffer\n" );
       errno = EINVAL;
       LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
       return NULL;
    }
-   // acquire directory lock
-   if ( pthread_mutex_lock( &(dh->lock) ) ) {
-      LOG( LOG_ERR, "Failed to aqcuire marfs_dhandle lock\n" );
+   if ( flags & ~(AT_SYMLINK_NOFOLLOW) ) {
+      LOG( LOG_ERR, "Received unsupported flag value\n" );
+      errno = EINVAL;
       LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
       return NULL;
    }
-   // cache our original errno value, and clear it
    int cachederrno = errno;
    errno = 0;
-   // potentially insert a subspace entry
-   if ( dh->depth == 0  &&  dh->ns->subnodecount  &&  (dh->location & MARFS_DIR_NS_OFFSET_MASK) == 0 ) {
-      while ( dh->location < dh->ns->subnodecount ) {
-         // stat the subspace, to identify inode info
-         marfs_ns* tgtsubspace = (marfs_ns *)(dh->ns->subnodes[dh->location].content);
-         char* subspacepath = NULL;
-         if ( config_nsinfo( tgtsubspace->idstr, NULL, &(subspacepath) ) ) {
-            LOG( LOG_ERR, "Failed to identify NS path of subspace: \"%s\"\n",
-                 tgtsubspace->idstr );
-            pthread_mutex_unlock( &(dh->lock) );
-            LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
-            return NULL;
-         }
-         // stat the subspace, to check for existence
-         MDAL tgtmdal = tgtsubspace->prepo->metascheme.mdal;
-         struct stat stval;
-         int stnsres = tgtmdal->statnamespace( tgtmdal->ctxt, subspacepath, &(stval) );
-         free( subspacepath );
-         if ( stnsres  &&  errno != ENOENT ) {
-            LOG( LOG_ERR, "Failed to stat subspace root: \"%s\"\n", subspacepath );
-            pthread_mutex_unlock( &(dh->lock) );
-            LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
-            return NULL;
-         }
-         if ( stnsres == 0 ) {
-            // populate and return the subspace dirent
-            if ( snprintf( dh->subspcent.d_name, dh->subspcnamealloc, "%s", dh->ns->subnodes[dh->location].name ) >= dh->subspcnamealloc ) {
-               LOG( LOG_ERR, "Dirent struct does not have sufficient space to store subspace name: \"%s\" (%zu bytes available)\n", dh->ns->subnodes[dh->location].name, dh->subspcnamealloc );
-               pthread_mutex_unlock( &(dh->lock) );
-               errno = ENAMETOOLONG;
-               LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
-               return NULL;
-            }
-            // increment our index
-            dh->location++;
-            if ( dh->location & MARFS_DIR_NS_OFFSET_MASK ) {
-               if ( dh->location != dh->ns->subnodecount ) {
-                  // indicate that our location has become invalid
-                  dh->location = MARFS_DIR_NS_OFFSET_MASK | 1L;
-                  LOG( LOG_ERR, "This readdir op has resulted in an excessive dir handle location value\n" );
-               }
-               else {
-                  // overwrite our location, to indicate that we have finished subspace listing
-                  dh->location = MARFS_DIR_NS_OFFSET_MASK;
-               }
-            }
-            pthread_mutex_unlock( &(dh->lock) );
-            LOG( LOG_INFO, "EXIT - Success\n" );
-            errno = cachederrno;
-            return &(dh->subspcent);
-         }
-         // increment our index
-         dh->location++;
-      }
-      // overwrite our location, to indicate that we have finished subspace listing
-      dh->location = MARFS_DIR_NS_OFFSET_MASK;
-   }
-   // check for an invalid location value
-   if ( dh->location == (MARFS_DIR_NS_OFFSET_MASK | 1L) ) {
-      pthread_mutex_unlock( &(dh->lock) );
-      LOG( LOG_ERR, "Dir handle location value is invalid\n" );
-      errno = EMSGSIZE;
-      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
-      return NULL;
-   }
-   // perform the op
-   MDAL curmdal = dh->ns->prepo->metascheme.mdal;
-   struct dirent* retval = NULL;
-   char repeat = 1;
-   while ( repeat ) {
-      retval = curmdal->readdir( dh->metahandle );
-      // filter out any restricted entries at the root of a NS
-      if ( dh->depth == 0  &&  retval != NULL  &&  curmdal->pathfilter( retval->d_name ) ) {
-         LOG( LOG_INFO, "Omitting hidden dirent: \"%s\"\n", retval->d_name );
-      }
-      else { repeat = 0; } // break on error, or if the entry wasn't filtered
-   }
-   pthread_mutex_unlock( &(dh->lock) );
+   struct dirent* retval = direntnext( dh, st, flags );
    if ( retval != NULL ) { LOG( LOG_INFO, "EXIT - Success\n" ); errno = cachederrno; }
    else { LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) ); }
    return retval;
@@ -1883,18 +2335,43 @@ int marfs_chdir(marfs_ctxt ctxt, marfs_dhandle dh) {
       LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
       return -1;
    }
-   // chdir to the specified dhandle
+   // the MDAL chdir only updates the user path of a ctxt, so a dhandle of a NS root ( or of
+   //    any other NS ) requires a ctxt established for the dhandle NS itself
    MDAL curmdal = dh->ns->prepo->metascheme.mdal;
-   if ( curmdal->chdir( ctxt->pos.ctxt, dh->metahandle ) ) {
+   marfs_position newpos = { .ns = dh->ns, .depth = 0, .ctxt = NULL };
+   if ( dh->ns == ctxt->pos.ns  &&  dh->depth ) {
+      newpos.ctxt = ctxt->pos.ctxt;
+   }
+   else if ( config_fortifyposition( &(newpos) ) ) {
+      LOG( LOG_ERR, "Failed to establish a MDAL_CTXT for NS of the dhandle\n" );
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      pthread_mutex_unlock( &(ctxt->lock) );
+      pthread_mutex_unlock( &(dh->lock) );
+      return -1;
+   }
+   // chdir to the specified dhandle
+   if ( dh->depth  &&  curmdal->chdir( newpos.ctxt, dh->metahandle ) ) {
       LOG( LOG_ERR, "Failed to chdir MDAL_CTXT\n" );
+      if ( newpos.ctxt != ctxt->pos.ctxt ) { curmdal->destroyctxt( newpos.ctxt ); }
       LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
       pthread_mutex_unlock( &(ctxt->lock) );
       pthread_mutex_unlock( &(dh->lock) );
       return -1;
    }
+   if ( dh->depth == 0  &&  curmdal->closedir( dh->metahandle ) ) {
+      // nothing to do but complain
+      LOG( LOG_WARNING, "Failed to close the MDAL_DHANDLE of a NS root\n" );
+   }
    // MDAL_CTXT has been updated; now update the position
+   if ( newpos.ctxt != ctxt->pos.ctxt  &&  config_abandonposition( &(ctxt->pos) ) ) {
+      // nothing to do but complain
+      LOG( LOG_WARNING, "Failed to abandon the previous position of the marfs_ctxt\n" );
+   }
    ctxt->pos.ns = dh->ns;
    ctxt->pos.depth = dh->depth;
+   ctxt->pos.ctxt = newpos.ctxt;
+   // relative path prefixes must now be resolved from the new position
+   pathcache_flush( ctxt );
    pthread_mutex_unlock( &(ctxt->lock) );
    pthread_mutex_unlock( &(dh->lock) );
    pthread_mutex_destroy( &(dh->lock) );
@@ -2207,6 +2684,234 @@ marfs_fhandle marfs_creat(marfs_ctxt ctxt, marfs_fhandle stream, const char *pat
    return stream;   
 }
 
+/**
+ * Create a sequence of new MarFS files, overwriting any existing files, and write out the
+ * complete content of each
+ * NOTE -- This produces the same result as a marfs_creat() / marfs_write() sequence for each
+ *         entry, with every file packed into the same stream.  However, metadata ops for each
+ *         file proceed in parallel with the writing of preceding file content, making this
+ *         far more efficient for large numbers of small files.
+ * @param marfs_ctxt ctxt : marfs_ctxt to operate relative to
+ * @param marfs_fhandle stream : Reference to an existing marfs_fhandle, or NULL
+ *                               ( see marfs_creat() )
+ * @param const marfs_creatent* entries : List of files to be created
+ *                                        NOTE -- every entry should target a distinct path
+ * @param size_t count : Count of 'entries'
+ * @param size_t* created : Reference to be populated with the count of entries created
+ *                          ( may be NULL )
+ * @return marfs_fhandle : marfs_fhandle referencing the most recently created file,
+ *                         or NULL if no file was created
+ *    NOTE -- If fewer than 'count' entries were created, errno will be set to describe the
+ *            failure of the first entry which was not.  That entry may have been created, but
+ *            not completely written, in which case it will be referenced by the marfs_fhandle.
+ *            Catastrophic error conditions are reported, and handled, just as for marfs_creat().
+ */
+marfs_fhandle marfs_creat_batch(marfs_ctxt ctxt, marfs_fhandle stream, const marfs_creatent* entries, size_t count, size_t* created) {
+   LOG( LOG_INFO, "ENTRY\n" );
+   if ( created ) { *created = 0; }
+   // check for NULL args
+   if ( ctxt == NULL ) {
+      LOG( LOG_ERR, "Received a NULL marfs_ctxt arg\n" );
+      errno = EINVAL;
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return NULL;
+   }
+   if ( entries == NULL  ||  count == 0 ) {
+      LOG( LOG_ERR, "Received a NULL or empty entries arg\n" );
+      errno = EINVAL;
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return NULL;
+   }
+   size_t runalloc = ( count < MARFS_CREATBATCH_RUN ) ? count : MARFS_CREATBATCH_RUN;
+   DATASTREAM_BATCHENT* dsents = malloc( sizeof( DATASTREAM_BATCHENT ) * runalloc );
+   if ( dsents == NULL ) {
+      LOG( LOG_ERR, "Failed to allocate space for %zu batch entries\n", runalloc );
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return NULL;
+   }
+   // check the state of our handle argument
+   char newstream = 0;
+   if ( stream == NULL ) {
+      // allocate a fresh handle
+      stream = new_marfs_fhandle();
+      if ( stream == NULL ) {
+         free( dsents );
+         LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+         return NULL;
+      }
+      newstream = 1;
+   }
+   else {
+      // acquire the lock for an existing stream
+      if ( pthread_mutex_lock( &(stream->lock) ) ) {
+         LOG( LOG_ERR, "Failed to acquire marfs_fhandle lock\n" );
+         free( dsents );
+         LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+         return NULL;
+      }
+      if ( stream->datastream == NULL  &&  stream->metahandle == NULL ) {
+         // a double-NULL handle has been flushed or suffered a fatal error
+         LOG( LOG_ERR, "Received a flushed marfs_fhandle\n" );
+         pthread_mutex_unlock( &(stream->lock) );
+         free( dsents );
+         errno = EINVAL;
+         LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+         return NULL;
+      }
+      else if ( stream->datastream == NULL  &&  stream->metahandle != NULL ) {
+         // meta-only reference; attempt to close it
+         MDAL curmdal = stream->ns->prepo->metascheme.mdal;
+         if ( curmdal->close( stream->metahandle ) ) {
+            LOG( LOG_ERR, "Failed to close previous MDAL_FHANDLE\n" );
+            stream->metahandle = NULL;
+            pthread_mutex_unlock( &(stream->lock) );
+            free( dsents );
+            errno = EBADFD;
+            LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+            return NULL;
+         }
+         stream->metahandle = NULL; // don't reattempt this op
+      }
+   }
+   // create each run of entries sharing a common target position
+   char anycreated = 0;
+   size_t done = 0;
+   int failerrno = 0;
+   while ( done < count ) {
+      // identify the target of the first entry of this run
+      marfs_position runpos = { .ns = NULL, .depth = 0, .ctxt = NULL };
+      char* subpath = NULL;
+      int tgtdepth = batchshift( ctxt, entries[done].path, &(subpath), &(runpos) );
+      if ( tgtdepth < 0 ) {
+         LOG( LOG_ERR, "Failed to identify target info for create op: \"%s\"\n", entries[done].path );
+         failerrno = errno;
+         break;
+      }
+      LOG( LOG_INFO, "TGT: Depth=%d, NS=\"%s\", SubPath=\"%s\"\n", tgtdepth, runpos.ns->idstr, subpath );
+      // check NS perms ( require RWMETA and WRITEDATA for file creation )
+      if ( ( ctxt->itype != MARFS_INTERACTIVE  &&
+               ( (runpos.ns->bperms & NS_RWMETA) != NS_RWMETA  ||
+                !(runpos.ns->bperms & NS_WRITEDATA) ) )
+           ||
+           ( ctxt->itype != MARFS_BATCH        &&
+               ( (runpos.ns->iperms & NS_RWMETA) != NS_RWMETA   ||
+                !(runpos.ns->iperms & NS_WRITEDATA) ) )
+         ) {
+         LOG( LOG_ERR, "NS perms do not allow a create op\n" );
+         pathcleanup( subpath, &runpos );
+         failerrno = EPERM;
+         break;
+      }
+      // check for NS target
+      if ( tgtdepth == 0 ) {
+         LOG( LOG_ERR, "Cannot target a MarFS NS with a create op\n" );
+         pathcleanup( subpath, &runpos );
+         failerrno = EISDIR;
+         break;
+      }
+      // check NS quota
+      MDAL tgtmdal = runpos.ns->prepo->metascheme.mdal;
+      if ( runpos.ns->fquota ) {
+         off_t inodeusage = tgtmdal->getinodeusage( runpos.ctxt );
+         if ( inodeusage < 0  ||  inodeusage >= runpos.ns->fquota ) {
+            LOG( LOG_ERR, "NS inode usage is excessive or unknown (%zd)\n", inodeusage );
+            pathcleanup( subpath, &runpos );
+            failerrno = EDQUOT;
+            break;
+         }
+      }
+      if ( runpos.ns->dquota ) {
+         off_t datausage = tgtmdal->getdatausage( runpos.ctxt );
+         if ( datausage < 0  ||  datausage >= runpos.ns->dquota ) {
+            LOG( LOG_ERR, "NS data usage is excessive or unknown (%zd)\n", datausage );
+            pathcleanup( subpath, &runpos );
+            failerrno = EDQUOT;
+            break;
+         }
+      }
+      dsents[0].path = subpath;
+      dsents[0].mode = entries[done].mode;
+      dsents[0].data = entries[done].data;
+      dsents[0].size = entries[done].size;
+      size_t runlen = 1;
+      // extend the run with all following entries of the same NS and depth
+      // NOTE -- any entry which does not qualify will be re-checked as the start of the next run
+      while ( runlen < runalloc  &&  done + runlen < count ) {
+         const marfs_creatent* entry = entries + done + runlen;
+         marfs_position entpos = { .ns = NULL, .depth = 0, .ctxt = NULL };
+         char* entsubpath = NULL;
+         int entdepth = batchshift( ctxt, entry->path, &(entsubpath), &(entpos) );
+         if ( entdepth < 0 ) { break; }
+         if ( entdepth == 0  ||  entpos.depth != runpos.depth  ||
+              strcmp( entpos.ns->idstr, runpos.ns->idstr ) ) {
+            pathcleanup( entsubpath, &entpos );
+            break;
+         }
+         config_abandonposition( &entpos );
+         dsents[runlen].path = entsubpath;
+         dsents[runlen].mode = entry->mode;
+         dsents[runlen].data = entry->data;
+         dsents[runlen].size = entry->size;
+         runlen++;
+      }
+      // duplicate the current NS ref
+      marfs_ns* dupref = config_duplicatensref( runpos.ns );
+      ssize_t runres = -1;
+      char hadstream = ( stream->datastream ) ? 1 : 0;
+      if ( dupref == NULL ) {
+         LOG( LOG_ERR, "Failed to duplicate op NS reference\n" );
+      }
+      else {
+         // attempt the op
+         runres = datastream_createbatch( &(stream->datastream), dsents, runlen, &runpos, ctxt->config->ctag );
+      }
+      failerrno = errno;
+      if ( stream->datastream  &&
+           stream->datastream->files[stream->datastream->curfile].metahandle != stream->metahandle ) {
+         // update our stream info to reflect the new target
+         if ( stream->ns ) { config_destroynsref( stream->ns ); }
+         stream->flags = O_WRONLY | O_CREAT;
+         stream->ns = dupref;
+         stream->metahandle = stream->datastream->files[stream->datastream->curfile].metahandle;
+         stream->itype = ctxt->itype;
+         anycreated = 1;
+      }
+      else if ( dupref ) { config_destroynsref( dupref ); }
+      if ( stream->datastream == NULL  &&  hadstream ) { stream->metahandle = NULL; } // don't allow invalid meta handle to persist
+      // cleanup run info
+      size_t runindex;
+      for ( runindex = 0; runindex < runlen; runindex++ ) { free( (char*)(dsents[runindex].path) ); }
+      config_abandonposition( &runpos );
+      if ( runres > 0 ) { done += runres; }
+      if ( runres < (ssize_t)runlen ) {
+         LOG( LOG_ERR, "Failure of datastream_createbatch() at entry %zu\n", done );
+         break;
+      }
+      failerrno = 0;
+   }
+   free( dsents );
+   if ( created ) { *created = done; }
+   if ( !(anycreated) ) {
+      if ( newstream ) { free( stream ); }
+      else {
+         if ( stream->metahandle == NULL ) { failerrno = EBADFD; } // ref is now defunct
+         pthread_mutex_unlock( &(stream->lock) );
+      }
+      errno = failerrno;
+      LOG( LOG_INFO, "EXIT - Failure w/ \"%s\"\n", strerror(errno) );
+      return NULL;
+   }
+   if ( !(newstream) ) { pthread_mutex_unlock( &(stream->lock) ); }
+   if ( done < count ) {
+      if ( stream->metahandle == NULL ) { failerrno = EBADFD; } // ref is now defunct
+      errno = failerrno;
+      LOG( LOG_INFO, "EXIT - Failure after %zu entries w/ \"%s\"\n", done, strerror(errno) );
+      return stream;
+   }
+   LOG( LOG_INFO, "EXIT - Success\n" );
+   return stream;
+}
+
 /**
  * Open an existing file
  * @param marfs_ctxt ctxt : marfs_ctxt to operate relative to
@@ -2243,6 +2948,13 @@ marfs_fhandle marfs_creat(marfs_ctxt ctxt, marfs_fhandle stream, const char *pat
  *                                   standard POSIX / Linux.  This flag causes MarFS to bypass
  *                                   the DAL ( data object path ) and operate exclusively via
  *                                   the MDAL ( metadata path ). )
+ *                    MARFS_LAZYVERIFY - Verify only a sample of data CRCs, leaving corruption of the
+ *                                 remainder undetected ( see NE_LAZYVERIFY )
+ *                                 ( note, only supported with O_RDONLY )
+ *                    MARFS_RANDOMREAD - Read data objects via positional DAL gets, rather than via
+ *                                 sequential read-ahead ( see NE_RANDOM ), making each small
+ *                                 marfs_read_at_offset() cost roughly one get per touched part
+ *                                 ( note, only supported with O_RDONLY and without MARFS_LAZYVERIFY )
  *                    NOTE -- some of these flags may require the caller to define _GNU_SOURCE!
  * @return marfs_fhandle : marfs_fhandle referencing the opened file,
  *                         or NULL if a failure occurred
@@ -2265,7 +2977,9 @@ marfs_fhandle marfs_open(marfs_ctxt ctxt, marfs_fhandle stream, const char *path
    if ( (flags & O_ASYNC) == 0  &&
             (
               (flags & O_ACCMODE) == O_RDWR || 
-              (flags & ~(O_ACCMODE)) != 0
+              (flags & ~(O_ACCMODE | MARFS_LAZYVERIFY | MARFS_RANDOMREAD)) != 0  ||
+              ( (flags & (MARFS_LAZYVERIFY | MARFS_RANDOMREAD))  &&  (flags & O_ACCMODE) != O_RDONLY )  ||
+              ( (flags & MARFS_LAZYVERIFY)  &&  (flags & MARFS_RANDOMREAD) )
             )
       ) {
       LOG( LOG_ERR, "Invalid flags value\n" );
@@ -2454,6 +3168,16 @@ marfs_fhandle marfs_open(marfs_ctxt ctxt, marfs_fhandle stream, const char *path
    if ( stream->ns ) { config_destroynsref( stream->ns ); }
    stream->ns = dupref;
    stream->metahandle = stream->datastream->files[stream->datastream->curfile].metahandle;
+   if ( (flags & O_ACCMODE) == O_RDONLY  &&
+        datastream_setverify( &(stream->datastream), (flags & MARFS_LAZYVERIFY) ? 1 : 0 ) ) {
+      // nothing to do besides complain, as the stream will simply verify all data inline
+      LOG( LOG_WARNING, "Failed to set verification mode of READ stream\n" );
+   }
+   if ( (flags & O_ACCMODE) == O_RDONLY  &&
+        datastream_setrandom( &(stream->datastream), (flags & MARFS_RANDOMREAD) ? 1 : 0 ) ) {
+      // nothing to do besides complain, as the stream will simply use sequential read-ahead
+      LOG( LOG_WARNING, "Failed to set random-access mode of READ stream\n" );
+   }
    stream->itype = ctxt->itype;
    // cleanup and return
    pthread_mutex_unlock( &(stream->lock) );
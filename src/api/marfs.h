@@ -18,6 +18,10 @@ extern "C"
 #include <fcntl.h>
 #include <sys/statvfs.h>
 
+// MarFS specific marfs_open() flags, chosen so as not to overlap any Linux open() flag
+#define MARFS_LAZYVERIFY 010000000000
+#define MARFS_RANDOMREAD 004000000000
+
 
 /* NOTE: Functions should operate the same as their POSIX counterparts if
 possible.
@@ -40,6 +44,14 @@ typedef enum
 	MARFS_BATCH
 } marfs_interface;
 
+typedef struct marfs_creatent_struct
+{
+	const char* path; // path of the file to be created
+	mode_t mode;      // mode value of the file to be created
+	const void* data; // complete content of the file
+	size_t size;      // length of 'data'
+} marfs_creatent;
+
 // CONTEXT MGMT OPS
 
 /**
@@ -85,6 +97,34 @@ int marfs_setctag(marfs_ctxt ctxt, const char* ctag);
  */
 size_t marfs_configver(marfs_ctxt ctxt, char* verstr, size_t len);
 
+/**
+ * Configure the path resolution cache of the given context struct, which retains resolved
+ * parent dir positions of recently targeted paths, allowing subsequent path ops within the
+ * same dir to skip traversal of all but the final path component
+ * NOTE -- Cache entries are flushed by any rename, rmdir, unlink, chmod, chown, or chdir op
+ *         issued through this ctxt, but changes made through any other ctxt or client
+ *         will only be reflected once the affected entries expire.
+ *         Entries are specific to the effective UID / GID of the resolving caller, as
+ *         directory search permissions are only checked during the initial resolution.
+ *         Callers which alter supplementary groups, without also altering EUID / EGID,
+ *         should not enable this cache.
+ * @param marfs_ctxt ctxt : marfs_ctxt to be updated
+ * @param size_t entries : Maximum number of cached path prefixes ( zero disables the cache )
+ * @param unsigned int ttl : Lifetime of each cache entry, in seconds
+ * @return int : Zero on success, or -1 on failure
+ */
+int marfs_setpathcache( marfs_ctxt ctxt, size_t entries, unsigned int ttl );
+
+/**
+ * Retrieve path resolution cache hit / miss counts of the given context struct
+ * ( since the cache was last configured via marfs_setpathcache() )
+ * @param marfs_ctxt ctxt : marfs_ctxt to retrieve cache stats from
+ * @param size_t* hits : Reference to be populated with the number of cache hits
+ * @param size_t* misses : Reference to be populated with the number of cache misses
+ * @return int : Zero on success, or -1 on failure
+ */
+int marfs_pathcachestats( marfs_ctxt ctxt, size_t* hits, size_t* misses );
+
 /**
  * Destroy the provided marfs_ctxt
  * @param marfs_ctxt ctxt : marfs_ctxt to be destroyed
@@ -339,6 +379,22 @@ marfs_dhandle marfs_opendir(marfs_ctxt ctxt, const char *path);
  */
 struct dirent *marfs_readdir(marfs_dhandle handle);
 
+/**
+ * Iterate to the next entry of an open directory handle, populating stat info for that
+ * entry ( equivalent to a marfs_readdir() followed by a marfs_stat() of the entry )
+ * NOTE -- Entries which vanish between being read and being stat'd will be skipped.
+ *         Subspaces which the caller lacks permission to stat will have only their file
+ *         type populated.
+ * @param marfs_dhandle handle : marfs_dhandle to read from
+ * @param struct stat* st : Stat structure to be populated for the returned entry
+ * @param int flags : A bitwise OR of the following...
+ *                    AT_SYMLINK_NOFOLLOW - do not dereference a symlink target
+ * @return struct dirent* : Reference to the next dirent struct, or NULL w/ errno unset
+ *                          if all entries have been read, or NULL w/ errno set if a
+ *                          failure occurred
+ */
+struct dirent *marfs_readdirplus(marfs_dhandle handle, struct stat* st, int flags);
+
 /**
  * Identify the ( abstract ) location of an open directory handle
  * NOTE -- This 'location' can be used via marfs_seekdir() to allow for the repeating
@@ -462,6 +518,30 @@ ssize_t marfs_dlistxattr(marfs_dhandle dh, char* buf, size_t size);
  */
 marfs_fhandle marfs_creat(marfs_ctxt ctxt, marfs_fhandle stream, const char *path, mode_t mode);
 
+/**
+ * Create a sequence of new MarFS files, overwriting any existing files, and write out the
+ * complete content of each
+ * NOTE -- This produces the same result as a marfs_creat() / marfs_write() sequence for each
+ *         entry, with every file packed into the same stream.  However, metadata ops for each
+ *         file proceed in parallel with the writing of preceding file content, making this
+ *         far more efficient for large numbers of small files.
+ * @param marfs_ctxt ctxt : marfs_ctxt to operate relative to
+ * @param marfs_fhandle stream : Reference to an existing marfs_fhandle, or NULL
+ *                               ( see marfs_creat() )
+ * @param const marfs_creatent* entries : List of files to be created
+ *                                        NOTE -- every entry should target a distinct path
+ * @param size_t count : Count of 'entries'
+ * @param size_t* created : Reference to be populated with the count of entries created
+ *                          ( may be NULL )
+ * @return marfs_fhandle : marfs_fhandle referencing the most recently created file,
+ *                         or NULL if no file was created
+ *    NOTE -- If fewer than 'count' entries were created, errno will be set to describe the
+ *            failure of the first entry which was not.  That entry may have been created, but
+ *            not completely written, in which case it will be referenced by the marfs_fhandle.
+ *            Catastrophic error conditions are reported, and handled, just as for marfs_creat().
+ */
+marfs_fhandle marfs_creat_batch(marfs_ctxt ctxt, marfs_fhandle stream, const marfs_creatent* entries, size_t count, size_t* created);
+
 /**
  * Open a MarFS file ( normally used for existing file, but can create 'meta cached' files )
  * @param marfs_ctxt ctxt : marfs_ctxt to operate relative to
@@ -498,6 +578,13 @@ marfs_fhandle marfs_creat(marfs_ctxt ctxt, marfs_fhandle stream, const char *pat
  *                                   standard POSIX / Linux.  This flag causes MarFS to bypass
  *                                   the DAL ( data object path ) and operate exclusively via
  *                                   the MDAL ( metadata path ). )
+ *                    MARFS_LAZYVERIFY - Verify only a sample of data CRCs, leaving corruption of the
+ *                                 remainder undetected ( see NE_LAZYVERIFY )
+ *                                 ( note, only supported with O_RDONLY )
+ *                    MARFS_RANDOMREAD - Read data objects via positional DAL gets, rather than via
+ *                                 sequential read-ahead ( see NE_RANDOM ), making each small
+ *                                 marfs_read_at_offset() cost roughly one get per touched part
+ *                                 ( note, only supported with O_RDONLY and without MARFS_LAZYVERIFY )
  *                    NOTE -- some of these flags may require the caller to define _GNU_SOURCE!
  * @return marfs_fhandle : marfs_fhandle referencing the opened file,
  *                         or NULL if a failure occurred
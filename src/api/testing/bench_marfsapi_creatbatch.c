@@ -0,0 +1,129 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Small file packing benchmark
+ *
+ * Packs a set of small files into a single stream, directly below a NS root, through a BATCH
+ * ctxt.  This is done first via a marfs_creat() / marfs_write() sequence for each file, then via
+ * marfs_creat_batch().  Reports the file creation rate of each method, unlinking all files
+ * between passes.  The MDAL tree is established via ./testing/config.xml, just as for
+ * test_marfsapi.
+ */
+
+#include "api/testing/benchfuncs.c"
+
+#define BENCH_NS "/campaign/gransom-allocation"
+
+int main(int argc, char** argv) {
+   int files = 10000;
+   size_t filesize = 1024;
+   if (argc > 3) {
+      printf("usage: %s [file_count [file_bytes]]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { files = atoi(argv[1]); }
+   if (argc > 2) { filesize = strtoull(argv[2], NULL, 10); }
+   if (files < 1 || filesize > 1048576) {
+      printf("ERROR: invalid file count or file size ( 1MiB maximum )\n");
+      return -1;
+   }
+
+   // create the dirs necessary for DAL/MDAL initialization, noting if we need to clean them up
+   pthread_mutex_t erasurelock;
+   char cleantop = 0;
+   if ( bench_setup( &erasurelock, CFG_FIX | CFG_OWNERCHECK | CFG_MDALCHECK | CFG_DALCHECK | CFG_RECURSE, &cleantop ) ) {
+      return -1;
+   }
+   marfs_ctxt ctxt = marfs_init( "testing/config.xml", MARFS_BATCH, &erasurelock );
+   if ( ctxt == NULL ) {
+      printf("ERROR: failed to initialize marfs ctxt\n");
+      return -1;
+   }
+
+   // generate our file list
+   char* data = malloc( filesize + 1 );
+   char* names = malloc( sizeof(char) * files * 128 );
+   marfs_creatent* entries = malloc( sizeof(marfs_creatent) * files );
+   if ( data == NULL  ||  names == NULL  ||  entries == NULL ) {
+      printf("ERROR: failed to allocate file list\n");
+      return -1;
+   }
+   memset( data, 'x', filesize + 1 );
+   int f;
+   for (f = 0; f < files; f++) {
+      snprintf( names + (f * 128), 128, "%s/bench_marfsapi_creatbatch%d", BENCH_NS, f );
+      entries[f].path = names + (f * 128);
+      entries[f].mode = 0644;
+      entries[f].data = data;
+      entries[f].size = filesize;
+   }
+
+   printf("%d files of %zu bytes below \"%s\"\n", files, filesize, BENCH_NS);
+   printf("%12s %12s %12s\n", "method", "usec/file", "files/s");
+   struct timeval beg, end;
+   int retval = 0;
+   int pass;
+   for (pass = 0; pass < 2  &&  retval == 0; pass++) {
+      size_t created = 0;
+      marfs_fhandle fh = NULL;
+      gettimeofday(&beg, NULL);
+      if ( pass == 0 ) {
+         for (f = 0; f < files; f++) {
+            if ( (fh = marfs_creat( ctxt, fh, entries[f].path, entries[f].mode )) == NULL ) {
+               printf("ERROR: failed to create \"%s\" (%s)\n", entries[f].path, strerror(errno));
+               retval = -1;
+               break;
+            }
+            created++; // file exists, regardless of write success
+            if ( marfs_write( fh, entries[f].data, entries[f].size ) != entries[f].size ) {
+               printf("ERROR: failed to write \"%s\" (%s)\n", entries[f].path, strerror(errno));
+               retval = -1;
+               break;
+            }
+         }
+      }
+      else {
+         fh = marfs_creat_batch( ctxt, NULL, entries, files, &(created) );
+         if ( created < files ) {
+            printf("ERROR: failed to batch create \"%s\" (%s)\n", entries[created].path, strerror(errno));
+            if ( fh ) { created++; } // failed file may exist
+            retval = -1;
+         }
+      }
+      if ( fh  &&  marfs_close( fh ) ) {
+         printf("ERROR: failed to close stream (%s)\n", strerror(errno));
+         retval = -1;
+      }
+      gettimeofday(&end, NULL);
+      if ( retval == 0 ) {
+         double usec = elapsed(&beg, &end) * 1e6 / files;
+         printf("%12s %12.1f %12.0f\n", (pass) ? "creat_batch" : "creat+write", usec, 1e6 / usec);
+      }
+      // unlink ( always attempted, for cleanup )
+      for (f = 0; f < created; f++) {
+         if ( marfs_unlink( ctxt, entries[f].path )  &&  errno != ENOENT ) {
+            printf("ERROR: failed to unlink \"%s\" (%s)\n", entries[f].path, strerror(errno));
+            retval = -1;
+         }
+      }
+   }
+
+   free( entries );
+   free( names );
+   free( data );
+   if ( marfs_term( ctxt ) ) {
+      printf("ERROR: failed to terminate marfs ctxt\n");
+      retval = -1;
+   }
+   if ( bench_cleanup( &erasurelock, cleantop ) ) {
+      retval = -1;
+   }
+   return retval;
+}
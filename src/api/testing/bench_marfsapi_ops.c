@@ -0,0 +1,118 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Metadata op benchmark
+ *
+ * Creates a set of empty files directly below a NS root, by absolute path, through an INTERACTIVE
+ * ctxt, then stats and unlinks each of them.  Reports the rate of each op.  Every such op traverses
+ * several namespaces, establishing ( and later abandoning ) a MDAL_CTXT for each.  The MDAL tree is
+ * established via ./testing/config.xml, just as for test_marfsapi.
+ */
+
+#include "api/testing/benchfuncs.c"
+
+#define BENCH_NS "/campaign/gransom-allocation/heavily-protected-data"
+
+int main(int argc, char** argv) {
+   int files = 10000;
+   if (argc > 2) {
+      printf("usage: %s [file_count]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { files = atoi(argv[1]); }
+   if (files < 1) {
+      printf("ERROR: invalid file count\n");
+      return -1;
+   }
+
+   // create the dirs necessary for DAL/MDAL initialization, noting if we need to clean them up
+   pthread_mutex_t erasurelock;
+   char cleantop = 0;
+   if ( bench_setup( &erasurelock, CFG_FIX | CFG_OWNERCHECK | CFG_MDALCHECK | CFG_DALCHECK | CFG_RECURSE, &cleantop ) ) {
+      return -1;
+   }
+   marfs_ctxt ctxt = marfs_init( "testing/config.xml", MARFS_INTERACTIVE, &erasurelock );
+   if ( ctxt == NULL ) {
+      printf("ERROR: failed to initialize marfs ctxt\n");
+      return -1;
+   }
+
+   printf("%d files below \"%s\"\n", files, BENCH_NS);
+   printf("%8s %12s %12s\n", "op", "usec/op", "ops/s");
+   char filepath[1024];
+   struct stat st;
+   struct timeval beg, end;
+   int retval = 0;
+   int f;
+
+   // create
+   gettimeofday(&beg, NULL);
+   for (f = 0; f < files; f++) {
+      snprintf( filepath, 1024, "%s/bench_marfsapi_ops%d", BENCH_NS, f );
+      marfs_fhandle fh = marfs_creat( ctxt, NULL, filepath, 0644 );
+      if ( fh == NULL ) {
+         printf("ERROR: failed to create \"%s\" (%s)\n", filepath, strerror(errno));
+         retval = -1;
+         break;
+      }
+      if ( marfs_close( fh ) ) {
+         printf("ERROR: failed to close \"%s\" (%s)\n", filepath, strerror(errno));
+         retval = -1;
+         f++; // file exists, regardless
+         break;
+      }
+   }
+   gettimeofday(&end, NULL);
+   int created = f;
+   if ( retval == 0 ) {
+      double usec = elapsed(&beg, &end) * 1e6 / files;
+      printf("%8s %12.1f %12.0f\n", "create", usec, 1e6 / usec);
+   }
+
+   // stat
+   gettimeofday(&beg, NULL);
+   for (f = 0; f < created  &&  retval == 0; f++) {
+      snprintf( filepath, 1024, "%s/bench_marfsapi_ops%d", BENCH_NS, f );
+      if ( marfs_stat( ctxt, filepath, &st, 0 ) ) {
+         printf("ERROR: failed to stat \"%s\" (%s)\n", filepath, strerror(errno));
+         retval = -1;
+      }
+   }
+   gettimeofday(&end, NULL);
+   if ( retval == 0 ) {
+      double usec = elapsed(&beg, &end) * 1e6 / files;
+      printf("%8s %12.1f %12.0f\n", "stat", usec, 1e6 / usec);
+   }
+
+   // unlink ( always attempted, for cleanup )
+   char reportunlink = ( retval == 0 );
+   gettimeofday(&beg, NULL);
+   for (f = 0; f < created; f++) {
+      snprintf( filepath, 1024, "%s/bench_marfsapi_ops%d", BENCH_NS, f );
+      if ( marfs_unlink( ctxt, filepath ) ) {
+         printf("ERROR: failed to unlink \"%s\" (%s)\n", filepath, strerror(errno));
+         retval = -1;
+      }
+   }
+   gettimeofday(&end, NULL);
+   if ( retval == 0  &&  reportunlink ) {
+      double usec = elapsed(&beg, &end) * 1e6 / files;
+      printf("%8s %12.1f %12.0f\n", "unlink", usec, 1e6 / usec);
+   }
+
+   if ( marfs_term( ctxt ) ) {
+      printf("ERROR: failed to terminate marfs ctxt\n");
+      retval = -1;
+   }
+   if ( bench_cleanup( &erasurelock, cleantop ) ) {
+      retval = -1;
+   }
+   return retval;
+}
@@ -0,0 +1,180 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Directory listing benchmark
+ *
+ * Populates a single directory, below a NS root, with empty files ( via marfs_creat_batch() through
+ * a BATCH ctxt ), then lists that directory with attributes through an INTERACTIVE ctxt ( much like
+ * 'ls -l' via FUSE ).  This is done first via marfs_readdir() followed by a marfs_stat() of each
+ * entry, then via marfs_readdirplus().  Reports the listing rate of each method.  The MDAL tree is
+ * established via ./testing/config.xml, just as for test_marfsapi.
+ */
+
+#include "api/testing/benchfuncs.c"
+
+#include <dirent.h>
+
+#define BENCH_DIR "/campaign/gransom-allocation/bench_marfsapi_readdir"
+#define BENCH_BATCH 8192 // files per marfs_creat_batch() call
+#define BENCH_CACHE 1024 // path cache settings of the listing ctxt ( matching those of marfs-fuse )
+#define BENCH_TTL 1
+
+int bench_list(marfs_ctxt ctxt, char plus, int* entries, double* usec) {
+   char entpath[1024];
+   struct stat st;
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   marfs_dhandle dh = marfs_opendir( ctxt, BENCH_DIR );
+   if ( dh == NULL ) {
+      printf("ERROR: failed to open \"%s\" (%s)\n", BENCH_DIR, strerror(errno));
+      return -1;
+   }
+   int count = 0;
+   struct dirent* dent;
+   errno = 0;
+   while ( (dent = (plus) ? marfs_readdirplus( dh, &st, AT_SYMLINK_NOFOLLOW ) : marfs_readdir( dh )) != NULL ) {
+      if ( !(plus) ) {
+         snprintf( entpath, 1024, "%s/%s", BENCH_DIR, dent->d_name );
+         if ( marfs_stat( ctxt, entpath, &st, AT_SYMLINK_NOFOLLOW ) ) {
+            printf("ERROR: failed to stat \"%s\" (%s)\n", entpath, strerror(errno));
+            marfs_closedir( dh );
+            return -1;
+         }
+      }
+      count++;
+   }
+   if ( errno ) {
+      printf("ERROR: failed to list \"%s\" (%s)\n", BENCH_DIR, strerror(errno));
+      marfs_closedir( dh );
+      return -1;
+   }
+   if ( marfs_closedir( dh ) ) {
+      printf("ERROR: failed to close \"%s\" (%s)\n", BENCH_DIR, strerror(errno));
+      return -1;
+   }
+   gettimeofday(&end, NULL);
+   *entries = count;
+   *usec = elapsed(&beg, &end) * 1e6 / count;
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   int files = 1000000;
+   if (argc > 2) {
+      printf("usage: %s [entries]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { files = atoi(argv[1]); }
+   if (files < 1) {
+      printf("ERROR: invalid entry count\n");
+      return -1;
+   }
+
+   // create the dirs necessary for DAL/MDAL initialization, noting if we need to clean them up
+   pthread_mutex_t erasurelock;
+   char cleantop = 0;
+   if ( bench_setup( &erasurelock, CFG_FIX | CFG_OWNERCHECK | CFG_MDALCHECK | CFG_DALCHECK | CFG_RECURSE, &cleantop ) ) {
+      return -1;
+   }
+   marfs_ctxt batchctxt = marfs_init( "testing/config.xml", MARFS_BATCH, &erasurelock );
+   marfs_ctxt interctxt = marfs_init( "testing/config.xml", MARFS_INTERACTIVE, &erasurelock );
+   if ( batchctxt == NULL  ||  interctxt == NULL ) {
+      printf("ERROR: failed to initialize marfs ctxts\n");
+      return -1;
+   }
+   if ( marfs_setpathcache( interctxt, BENCH_CACHE, BENCH_TTL ) ) {
+      printf("ERROR: failed to configure path cache of %d entries\n", BENCH_CACHE);
+      return -1;
+   }
+
+   // populate our target dir
+   if ( marfs_mkdir( batchctxt, BENCH_DIR, 0755 ) ) {
+      printf("ERROR: failed to create \"%s\" (%s)\n", BENCH_DIR, strerror(errno));
+      return -1;
+   }
+   char* names = malloc( sizeof(char) * BENCH_BATCH * 128 );
+   marfs_creatent* entries = malloc( sizeof(marfs_creatent) * BENCH_BATCH );
+   if ( names == NULL  ||  entries == NULL ) {
+      printf("ERROR: failed to allocate file list\n");
+      return -1;
+   }
+   int retval = 0;
+   int created = 0;
+   marfs_fhandle fh = NULL;
+   while ( created < files ) {
+      int count = ( files - created < BENCH_BATCH ) ? files - created : BENCH_BATCH;
+      int f;
+      for (f = 0; f < count; f++) {
+         snprintf( names + (f * 128), 128, "%s/entry%d", BENCH_DIR, created + f );
+         entries[f].path = names + (f * 128);
+         entries[f].mode = 0644;
+         entries[f].data = NULL;
+         entries[f].size = 0;
+      }
+      size_t batchcreated = 0;
+      fh = marfs_creat_batch( batchctxt, fh, entries, count, &(batchcreated) );
+      created += batchcreated;
+      if ( batchcreated < count ) {
+         printf("ERROR: failed to batch create \"%s\" (%s)\n", entries[batchcreated].path, strerror(errno));
+         if ( fh ) { created++; } // failed file may exist
+         retval = -1;
+         break;
+      }
+   }
+   if ( fh  &&  marfs_close( fh ) ) {
+      printf("ERROR: failed to close stream (%s)\n", strerror(errno));
+      retval = -1;
+   }
+
+   if ( retval == 0 ) {
+      printf("%d files in \"%s\"\n", files, BENCH_DIR);
+      printf("%14s %12s %12s %12s\n", "method", "entries", "usec/entry", "entries/s");
+   }
+   int pass;
+   for (pass = 0; pass < 2  &&  retval == 0; pass++) {
+      int listed = 0;
+      double usec = 0.0;
+      if ( bench_list( interctxt, (char)pass, &listed, &usec ) ) {
+         retval = -1;
+      }
+      else if ( listed != files + 2 ) { // include '.' and '..'
+         printf("ERROR: listed %d entries, rather than the expected %d\n", listed, files + 2);
+         retval = -1;
+      }
+      else {
+         printf("%14s %12d %12.2f %12.0f\n", (pass) ? "readdirplus" : "readdir+stat", listed, usec, 1e6 / usec);
+      }
+   }
+
+   // cleanup our dir ( always attempted )
+   int f;
+   char entpath[1024];
+   for (f = 0; f < created; f++) {
+      snprintf( entpath, 1024, "%s/entry%d", BENCH_DIR, f );
+      if ( marfs_unlink( batchctxt, entpath )  &&  errno != ENOENT ) {
+         printf("ERROR: failed to unlink \"%s\" (%s)\n", entpath, strerror(errno));
+         retval = -1;
+      }
+   }
+   if ( marfs_rmdir( batchctxt, BENCH_DIR ) ) {
+      printf("ERROR: failed to remove \"%s\"\n", BENCH_DIR);
+      retval = -1;
+   }
+   free( entries );
+   free( names );
+   if ( marfs_term( interctxt )  ||  marfs_term( batchctxt ) ) {
+      printf("ERROR: failed to terminate marfs ctxts\n");
+      retval = -1;
+   }
+   if ( bench_cleanup( &erasurelock, cleantop ) ) {
+      retval = -1;
+   }
+   return retval;
+}
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Path resolution benchmark
+ *
+ * Populates a single directory, several levels below a NS root, then repeatedly stats every entry
+ * of that directory by absolute path ( much like 'ls -l' via FUSE ) through an INTERACTIVE ctxt.
+ * Reports the stat rate with the marfs_ctxt path cache disabled, then enabled.  The MDAL tree is
+ * established via ./testing/config.xml, just as for test_marfsapi.
+ */
+
+#include "api/testing/benchfuncs.c"
+
+#define BENCH_PARENT "/campaign/gransom-allocation/bench_marfsapi_stat"
+#define BENCH_CACHE 256
+#define BENCH_TTL 30
+
+int bench_stats(marfs_ctxt ctxt, const char* dirpath, int entries, int passes, double* usec) {
+   char entpath[1024];
+   struct stat st;
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   int p;
+   for (p = 0; p < passes; p++) {
+      int e;
+      for (e = 0; e < entries; e++) {
+         snprintf( entpath, 1024, "%s/entry%d", dirpath, e );
+         if ( marfs_stat( ctxt, entpath, &st, 0 ) ) {
+            printf("ERROR: failed to stat \"%s\" (%s)\n", entpath, strerror(errno));
+            return -1;
+         }
+      }
+   }
+   gettimeofday(&end, NULL);
+   *usec = elapsed(&beg, &end) * 1e6 / ( (double)entries * passes );
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   int depth = 8;
+   int entries = 10000;
+   int passes = 3;
+   if (argc > 4) {
+      printf("usage: %s [dir_depth [entries [passes]]]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { depth = atoi(argv[1]); }
+   if (argc > 2) { entries = atoi(argv[2]); }
+   if (argc > 3) { passes = atoi(argv[3]); }
+   if (depth < 1 || depth > 64 || entries < 1 || passes < 1) {
+      printf("ERROR: invalid depth, entry count, or pass count\n");
+      return -1;
+   }
+
+   // create the dirs necessary for DAL/MDAL initialization, noting if we need to clean them up
+   pthread_mutex_t erasurelock;
+   char cleantop = 0;
+   if ( bench_setup( &erasurelock, CFG_FIX | CFG_OWNERCHECK | CFG_MDALCHECK | CFG_RECURSE, &cleantop ) ) {
+      return -1;
+   }
+   marfs_ctxt ctxt = marfs_init( "testing/config.xml", MARFS_INTERACTIVE, &erasurelock );
+   if ( ctxt == NULL ) {
+      printf("ERROR: failed to initialize marfs ctxt\n");
+      return -1;
+   }
+
+   // build out our target dir
+   char dirpath[1024];
+   int dirlen = snprintf( dirpath, 1024, "%s", BENCH_PARENT );
+   int d;
+   for (d = 0; d <= depth; d++) {
+      if ( d ) { dirlen += snprintf( dirpath + dirlen, 1024 - dirlen, "/subdir%d", d ); }
+      if ( marfs_mkdir( ctxt, dirpath, 0755 ) ) {
+         printf("ERROR: failed to create \"%s\" (%s)\n", dirpath, strerror(errno));
+         return -1;
+      }
+   }
+   char entpath[1024];
+   int e;
+   for (e = 0; e < entries; e++) {
+      snprintf( entpath, 1024, "%s/entry%d", dirpath, e );
+      if ( marfs_mkdir( ctxt, entpath, 0755 ) ) {
+         printf("ERROR: failed to create \"%s\" (%s)\n", entpath, strerror(errno));
+         return -1;
+      }
+   }
+
+   printf("%d entries at depth %d, %d stat passes\n", entries, depth + 3, passes);
+   printf("%10s %12s %12s %12s %12s\n", "pathcache", "usec/stat", "stats/s", "hits", "misses");
+   int retval = 0;
+   size_t cachesizes[2] = { 0, BENCH_CACHE };
+   int c;
+   for (c = 0; c < 2 && retval == 0; c++) {
+      double usec = 0.0;
+      size_t hits = 0;
+      size_t misses = 0;
+      if ( marfs_setpathcache( ctxt, cachesizes[c], BENCH_TTL ) ) {
+         printf("ERROR: failed to configure path cache of %zu entries\n", cachesizes[c]);
+         retval = -1;
+      }
+      else if ( bench_stats( ctxt, dirpath, entries, passes, &usec ) ) {
+         retval = -1;
+      }
+      else if ( marfs_pathcachestats( ctxt, &hits, &misses ) ) {
+         printf("ERROR: failed to retrieve path cache stats\n");
+         retval = -1;
+      }
+      else {
+         printf("%10zu %12.1f %12.0f %12zu %12zu\n", cachesizes[c], usec, 1e6 / usec, hits, misses);
+      }
+   }
+
+   // cleanup our dir tree
+   for (e = 0; e < entries; e++) {
+      snprintf( entpath, 1024, "%s/entry%d", dirpath, e );
+      if ( marfs_rmdir( ctxt, entpath ) ) {
+         printf("ERROR: failed to remove \"%s\"\n", entpath);
+         retval = -1;
+      }
+   }
+   for (d = depth; d >= 0; d--) {
+      if ( marfs_rmdir( ctxt, dirpath ) ) {
+         printf("ERROR: failed to remove \"%s\"\n", dirpath);
+         retval = -1;
+      }
+      *(strrchr( dirpath, '/' )) = '\0';
+   }
+   if ( marfs_term( ctxt ) ) {
+      printf("ERROR: failed to terminate marfs ctxt\n");
+      retval = -1;
+   }
+   if ( bench_cleanup( &erasurelock, cleantop ) ) {
+      retval = -1;
+   }
+   return retval;
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Common scaffolding of the marfs API benchmarks ( testing/bench_marfsapi_*.c )
+ *
+ * Each benchmark establishes its MDAL tree via ./testing/config.xml, just as for test_marfsapi,
+ * below ./test_datastream_topdir.
+ */
+
+#include "marfs_auto_config.h" // ahead of all system headers, for nftw()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ftw.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "marfs.h"
+#include "config/config.h" // for config validation, alone
+
+
+double elapsed(struct timeval* beg, struct timeval* end) {
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+int removeent(const char* fpath, const struct stat* sb, int typeflag, struct FTW* ftwbuf) {
+   return remove( fpath );
+}
+
+/**
+ * Create the dirs necessary for DAL/MDAL initialization, initialize the erasure lock, and verify
+ * ( fixing ) the benchmark config
+ * @param pthread_mutex_t* erasurelock : Erasure lock to be initialized
+ * @param int verifyflags : Flags for config_verify() ( see config.h )
+ * @param char* cleantop : Set to 1 if ./test_datastream_topdir was created by this call, 0 if not
+ * @return int : Zero on success, or -1 on failure
+ */
+int bench_setup(pthread_mutex_t* erasurelock, int verifyflags, char* cleantop) {
+   errno = 0;
+   *cleantop = 1;
+   if ( mkdir( "./test_datastream_topdir", S_IRWXU ) ) {
+      if ( errno != EEXIST ) {
+         printf("ERROR: failed to create test_datastream_topdir\n");
+         return -1;
+      }
+      *cleantop = 0;
+   }
+   errno = 0;
+   if ( mkdir( "./test_datastream_topdir/dal_root", S_IRWXU )  &&  errno != EEXIST ) {
+      printf("ERROR: failed to create test_datastream_topdir/dal_root\n");
+      return -1;
+   }
+   errno = 0;
+   if ( mkdir( "./test_datastream_topdir/mdal_root", S_IRWXU )  &&  errno != EEXIST ) {
+      printf("ERROR: failed to create test_datastream_topdir/mdal_root\n");
+      return -1;
+   }
+   if ( pthread_mutex_init( erasurelock, NULL ) ) {
+      printf("ERROR: failed to initialize erasure lock\n");
+      return -1;
+   }
+   marfs_config* verconf = config_init( "testing/config.xml", erasurelock );
+   if ( verconf == NULL  ||  config_verify( verconf, ".", verifyflags ) ) {
+      printf("ERROR: failed to verify marfs config\n");
+      return -1;
+   }
+   config_term( verconf );
+   return 0;
+}
+
+/**
+ * Destroy the erasure lock, then remove ./test_datastream_topdir, if created by bench_setup()
+ * @param pthread_mutex_t* erasurelock : Erasure lock to be destroyed
+ * @param char cleantop : Value produced by bench_setup()
+ * @return int : Zero on success, or -1 on failure
+ */
+int bench_cleanup(pthread_mutex_t* erasurelock, char cleantop) {
+   pthread_mutex_destroy( erasurelock );
+   if ( cleantop  &&  nftw( "./test_datastream_topdir", removeent, 100, FTW_DEPTH | FTW_PHYS ) ) {
+      printf("ERROR: failed to remove test_datastream_topdir\n");
+      return -1;
+   }
+   return 0;
+}
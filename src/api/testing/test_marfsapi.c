@@ -120,6 +120,12 @@ int main( int argc, char** argv ) {
       return -1;
    }
 
+   // enable path resolution caching for our interactive ctxt
+   if ( marfs_setpathcache( interctxt, 64, 30 ) ) {
+      printf( "failed to enable path cache for inter ctxt\n" );
+      return -1;
+   }
+
    // check the batchctxt config version
    char onekstr[1024] = {0};
    ssize_t verstrlen = marfs_configver( batchctxt, onekstr, 1024 );
@@ -221,6 +227,28 @@ int main( int argc, char** argv ) {
          return -1;
       }
    }
+   // pack in another set of files, via a single batch create
+   marfs_creatent* bents = malloc( sizeof( marfs_creatent ) * 1024 );
+   char* bnames = malloc( sizeof( char ) * 1024 * 64 );
+   if ( bents == NULL  ||  bnames == NULL ) {
+      printf( "failed to allocate batch create entries\n" );
+      return -1;
+   }
+   for( index = 0; index < 1024; index++ ) {
+      snprintf( bnames + (index * 64), 64, "gransom-allocation/packed-files/bfile%d", index );
+      bents[index].path = bnames + (index * 64);
+      bents[index].mode = 0644;
+      bents[index].data = oneMBbuffer + index;
+      bents[index].size = index % 100;
+   }
+   size_t bcreated = 0;
+   if ( (bgasubfhandle = marfs_creat_batch( batchctxt, bgasubfhandle, bents, 1024, &(bcreated) )) == NULL  ||
+        bcreated != 1024 ) {
+      printf( "failed to batch create packed-files/bfile* ( %zu created )\n", bcreated );
+      return -1;
+   }
+   free( bents );
+   free( bnames );
    // finally close this stream
    if ( marfs_close( bgasubfhandle ) ) {
       printf( "failed to close 'bgasubfilehandle'\n" );
@@ -282,6 +310,57 @@ int main( int argc, char** argv ) {
       return -1;
    }
 
+   // list the gransom-allocation NS root with attributes, checking them against marfs_stat()
+   marfs_dhandle gadhandle = marfs_opendir( batchctxt, "gransom-allocation" );
+   if ( gadhandle == NULL ) {
+      printf( "failed to open dir handle for 'gransom-allocation'\n" );
+      return -1;
+   }
+   struct stat plusst;
+   struct dirent* plusent;
+   int pluscount = 0;
+   errno = 0;
+   while ( (plusent = marfs_readdirplus( gadhandle, &(plusst), AT_SYMLINK_NOFOLLOW )) != NULL ) {
+      char entpath[1024];
+      struct stat entst;
+      // NOTE -- NS roots may be stat'd via different MDAL ops, so only compare inode and type of these
+      char nsroot = 1;
+      if ( strcmp( plusent->d_name, "." ) == 0 ) { snprintf( entpath, 1024, "gransom-allocation" ); }
+      else if ( strcmp( plusent->d_name, ".." ) == 0 ) { snprintf( entpath, 1024, "/campaign" ); }
+      else { snprintf( entpath, 1024, "gransom-allocation/%s", plusent->d_name ); nsroot = 0; }
+      if ( marfs_stat( batchctxt, entpath, &(entst), AT_SYMLINK_NOFOLLOW ) ) {
+         // restricted subspaces should only have their file type populated
+         if ( errno != EPERM  ||  plusst.st_mode != S_IFDIR  ||  plusst.st_ino != 0 ) {
+            printf( "failed to stat readdirplus entry \"%s\" (%s)\n", entpath, strerror(errno) );
+            return -1;
+         }
+         errno = 0;
+      }
+      else if ( plusst.st_ino != entst.st_ino  ||  plusst.st_mode != entst.st_mode  ||
+                ( !(nsroot)  &&  ( plusst.st_nlink != entst.st_nlink  ||  plusst.st_size != entst.st_size  ||
+                                   plusst.st_blocks != entst.st_blocks ) ) ) {
+         printf( "readdirplus stat values of \"%s\" do not match those of marfs_stat()\n", entpath );
+         return -1;
+      }
+      if ( strcmp( plusent->d_name, "gfile1-link" ) == 0  &&  entst.st_nlink != 2 ) {
+         printf( "unexpected link count of 'gfile1-link': %zu\n", (size_t)entst.st_nlink );
+         return -1;
+      }
+      pluscount++;
+   }
+   if ( errno ) {
+      printf( "readdirplus of 'gransom-allocation' failed (%s)\n", strerror(errno) );
+      return -1;
+   }
+   if ( marfs_closedir( gadhandle ) ) {
+      printf( "failed to close dir handle for 'gransom-allocation'\n" );
+      return -1;
+   }
+   if ( pluscount < 6 ) { // '.', '..', 'gasubdir', 'packed-files', 'gfile1-link', and at least one subspace
+      printf( "unexpected readdirplus entry count for 'gransom-allocation': %d\n", pluscount );
+      return -1;
+   }
+
    // write out a parallel file
    marfs_fhandle phandle = marfs_creat( batchctxt, NULL, "gransom-allocation/parallelfile", 0600 );
    if ( phandle == NULL ) {
@@ -534,6 +613,28 @@ int main( int argc, char** argv ) {
          return -1;
       }
    }
+   // batch created files
+   for ( index = 0; index < 1024; index++ ) {
+      char fname[1024];
+      if ( snprintf( fname, 1024, "gransom-allocation/packed-files/bfile%d", index ) >= 1024 ) {
+         printf( "failed to generate name of packed-files/bfile%d\n", index );
+         return -1;
+      }
+      phandle = marfs_open( batchctxt, phandle, fname, O_RDONLY );
+      if ( phandle == NULL ) {
+         printf( "failed to open packed-files/bfile%d for read\n", index );
+         return -1;
+      }
+      bzero( oneMBreadbuf, 1048576 );
+      if ( marfs_read( phandle, oneMBreadbuf, 1048576 ) != index % 100 ) {
+         printf( "failed to read %d bytes from %s\n", index % 100, fname );
+         return -1;
+      }
+      if ( memcmp( oneMBreadbuf, oneMBbuffer + index, index % 100 ) ) {
+         printf( "unexpected content of %s\n", fname );
+         return -1;
+      }
+   }
    // file1
    phandle = marfs_open( batchctxt, phandle, "gransom-allocation/gasubdir/file1", O_RDONLY );
    if ( phandle == NULL ) {
@@ -659,6 +760,17 @@ int main( int argc, char** argv ) {
          return -1;
       }
    }
+   for( index = 0; index < 1024; index++ ) {
+      char fname[1024];
+      if ( snprintf( fname, 1024, "../packed-files/bfile%d", index ) >= 1024 ) {
+         printf( "failed to generate name of packed-files/bfile%d\n", index );
+         return -1;
+      }
+      if ( marfs_unlink( interctxt, fname ) ) {
+         printf( "failed to unlink '%s'\n", fname );
+         return -1;
+      }
+   }
    if ( marfs_rmdir( interctxt, "/campaign/gransom-allocation/packed-files" ) ) {
       printf( "failed to rmdir '/campaign/gransom-allocation/packed-files'\n" );
       return -1;
@@ -700,6 +812,115 @@ int main( int argc, char** argv ) {
       return -1;
    }
 
+   // verify that path cache entries of our interactive ctxt are invalidated by dir changes
+   struct stat pcstval;
+   size_t pchits = 0;
+   size_t pcmisses = 0;
+   size_t pcprevmisses = 0;
+   if ( marfs_mkdir( interctxt, "pcdir", 0776 )  ||  marfs_mkdir( interctxt, "pcdir/pcsub", 0776 ) ) {
+      printf( "failed to create 'pcdir/pcsub'\n" );
+      return -1;
+   }
+   if ( marfs_stat( interctxt, "pcdir/pcsub", &(pcstval), 0 )  ||
+        marfs_stat( interctxt, "pcdir/pcsub", &(pcstval), 0 ) ) {
+      printf( "failed to stat 'pcdir/pcsub'\n" );
+      return -1;
+   }
+   marfs_pathcachestats( interctxt, &(pchits), &(pcmisses) );
+   if ( pchits == 0 ) {
+      printf( "repeat stat of 'pcdir/pcsub' did not hit the path cache\n" );
+      return -1;
+   }
+   ino_t pcoldino = pcstval.st_ino;
+   // rename of the cached prefix dir
+   if ( marfs_rename( interctxt, "pcdir", "pcdir2" ) ) {
+      printf( "failed to rename 'pcdir' to 'pcdir2'\n" );
+      return -1;
+   }
+   pcprevmisses = pcmisses;
+   errno = 0;
+   if ( marfs_stat( interctxt, "pcdir/pcsub", &(pcstval), 0 ) == 0  ||  errno != ENOENT ) {
+      printf( "stat of 'pcdir/pcsub' following rename of 'pcdir' did not fail with ENOENT (%s)\n", strerror(errno) );
+      return -1;
+   }
+   marfs_pathcachestats( interctxt, &(pchits), &(pcmisses) );
+   if ( pcmisses == pcprevmisses ) {
+      printf( "stat of 'pcdir/pcsub' following rename of 'pcdir' hit the path cache\n" );
+      return -1;
+   }
+   if ( marfs_stat( interctxt, "pcdir2/pcsub", &(pcstval), 0 )  ||  pcstval.st_ino != pcoldino ) {
+      printf( "failed to stat renamed 'pcdir2/pcsub'\n" );
+      return -1;
+   }
+   // rmdir of the cached prefix dir, replaced by a new dir of the same name
+   if ( marfs_rmdir( interctxt, "pcdir2/pcsub" )  ||  marfs_rmdir( interctxt, "pcdir2" ) ) {
+      printf( "failed to rmdir 'pcdir2/pcsub' and 'pcdir2'\n" );
+      return -1;
+   }
+   errno = 0;
+   if ( marfs_stat( interctxt, "pcdir2/pcsub", &(pcstval), 0 ) == 0  ||  errno != ENOENT ) {
+      printf( "stat of 'pcdir2/pcsub' following rmdir of 'pcdir2' did not fail with ENOENT (%s)\n", strerror(errno) );
+      return -1;
+   }
+   if ( marfs_mkdir( interctxt, "pcdir2", 0776 )  ||  marfs_mkdir( interctxt, "pcdir2/pcsub", 0776 ) ) {
+      printf( "failed to recreate 'pcdir2/pcsub'\n" );
+      return -1;
+   }
+   if ( marfs_stat( interctxt, "pcdir2/pcsub", &(pcstval), 0 ) ) {
+      printf( "failed to stat recreated 'pcdir2/pcsub' (%s)\n", strerror(errno) );
+      return -1;
+   }
+   // chmod of the cached prefix dir
+   marfs_pathcachestats( interctxt, &(pchits), &(pcmisses) );
+   pcprevmisses = pcmisses;
+   if ( marfs_chmod( interctxt, "pcdir2", 0666, 0 ) ) {
+      printf( "failed to chmod 'pcdir2'\n" );
+      return -1;
+   }
+   errno = 0;
+   int pcstatret = marfs_stat( interctxt, "pcdir2/pcsub", &(pcstval), 0 );
+   if ( geteuid() != 0  &&  ( pcstatret == 0  ||  errno != EACCES ) ) {
+      printf( "stat of 'pcdir2/pcsub' following removal of search perms did not fail with EACCES (%s)\n", strerror(errno) );
+      return -1;
+   }
+   marfs_pathcachestats( interctxt, &(pchits), &(pcmisses) );
+   if ( pcmisses == pcprevmisses ) {
+      printf( "stat of 'pcdir2/pcsub' following chmod of 'pcdir2' hit the path cache\n" );
+      return -1;
+   }
+   if ( marfs_chmod( interctxt, "pcdir2", 0776, 0 ) ) {
+      printf( "failed to restore perms of 'pcdir2'\n" );
+      return -1;
+   }
+   if ( marfs_stat( interctxt, "pcdir2/pcsub", &(pcstval), 0 ) ) {
+      printf( "failed to stat 'pcdir2/pcsub' following restore of search perms (%s)\n", strerror(errno) );
+      return -1;
+   }
+   // chdir away from the cached prefix dir
+   marfs_dhandle pcdhandle = marfs_opendir( interctxt, ".." );
+   if ( pcdhandle == NULL  ||  marfs_chdir( interctxt, pcdhandle ) ) {
+      printf( "failed to chdir inter ctxt to gransom-allocation\n" );
+      return -1;
+   }
+   errno = 0;
+   if ( marfs_stat( interctxt, "pcdir2/pcsub", &(pcstval), 0 ) == 0  ||  errno != ENOENT ) {
+      printf( "stat of 'pcdir2/pcsub' following chdir did not fail with ENOENT (%s)\n", strerror(errno) );
+      return -1;
+   }
+   if ( marfs_stat( interctxt, "heavily-protected-data/pcdir2/pcsub", &(pcstval), 0 ) ) {
+      printf( "failed to stat 'heavily-protected-data/pcdir2/pcsub' following chdir (%s)\n", strerror(errno) );
+      return -1;
+   }
+   pcdhandle = marfs_opendir( interctxt, "heavily-protected-data" );
+   if ( pcdhandle == NULL  ||  marfs_chdir( interctxt, pcdhandle ) ) {
+      printf( "failed to chdir inter ctxt back to hpd dir\n" );
+      return -1;
+   }
+   if ( marfs_rmdir( interctxt, "pcdir2/pcsub" )  ||  marfs_rmdir( interctxt, "pcdir2" ) ) {
+      printf( "failed to rmdir 'pcdir2/pcsub' and 'pcdir2'\n" );
+      return -1;
+   }
+
    // identify the root marfs MDAL and use this for all cleanup
    // NOTE -- shortcut.  Unsafe in most cases
    MDAL rootmdal = batchctxt->config->rootns->prepo->metascheme.mdal;
@@ -747,6 +968,18 @@ int main( int argc, char** argv ) {
    }
    rootmdal->destroynamespace( rootmdal->ctxt, "/." ); // TODO : fix MDAL edge case?
 
+   // verify that our interactive ctxt made use of its path cache
+   size_t pathhits = 0;
+   size_t pathmisses = 0;
+   if ( marfs_pathcachestats( interctxt, &(pathhits), &(pathmisses) ) ) {
+      printf( "failed to retrieve path cache stats of inter ctxt\n" );
+      return -1;
+   }
+   if ( pathhits == 0  ||  pathmisses == 0 ) {
+      printf( "unexpected path cache stats of inter ctxt ( hits = %zu, misses = %zu )\n", pathhits, pathmisses );
+      return -1;
+   }
+
    // cleanup our marfs_ctxt structs
    if ( marfs_term( batchctxt ) ) {
       printf( "Failed to destory our batch ctxt\n" );
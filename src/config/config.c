@@ -40,6 +40,14 @@
  *             <max_size>1G</max_size>
  *          </chunking>
  *
+ *          <!-- Read-Ahead -->
+ *          <readahead enabled="yes">
+ *             <depth>2</depth>
+ *          </readahead>
+ *
+ *          <!-- Write-Behind -->
+ *          <writebehind enabled="yes"/>
+ *
  *          <!-- Object Distribution -->
  *          <distribution>
  *             <pods dweight=2>4:0=1,3=5</pods>
@@ -122,6 +130,8 @@
 #include "general_include/restrictedchars.h"
 
 #include <libxml/tree.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #ifndef LIBXML_TREE_ENABLED
 #error "Included Libxml2 does not support tree functionality!"
@@ -130,6 +140,108 @@
 
 //   -------------   INTERNAL DEFINITIONS    -------------
 
+#define CTXTPOOL_SIZE 32 // maximum count of idle MDAL_CTXTs retained per NS
+
+typedef struct marfs_ctxtpool_struct {
+   pthread_mutex_t lock;                 // for serializing access to this structure
+   size_t          count;                // count of idle ctxts currently retained
+   MDAL_CTXT       ctxts[CTXTPOOL_SIZE]; // idle ctxts, each referencing the root of the NS
+   uid_t           euids[CTXTPOOL_SIZE]; // effective uid of the user who released each ctxt
+   gid_t           egids[CTXTPOOL_SIZE]; // effective gid of the user who released each ctxt
+} marfs_ctxtpool;
+
+/**
+ * Borrow an idle MDAL_CTXT, referencing the root of the given NS, from the pool of that NS
+ * NOTE -- Opening a NS ctxt is subject to the permissions of the calling user.  To preserve
+ *         that check, by default, only ctxts released by a user with the same effective uid
+ *         and gid are provided.
+ * @param marfs_ns* ns : NS to borrow a ctxt from
+ * @param char anyuser : Flag indicating that a ctxt released by any user is acceptable
+ *                       ( as when the caller would otherwise duplicate an existing ctxt )
+ * @return MDAL_CTXT : Reference to the borrowed ctxt, or NULL if none is available
+ */
+MDAL_CTXT config_borrowctxt( marfs_ns* ns, char anyuser ) {
+   marfs_ctxtpool* pool = ns->ctxtpool;
+   if ( pool == NULL ) { return NULL; }
+   if ( pthread_mutex_lock( &(pool->lock) ) ) {
+      LOG( LOG_WARNING, "Failed to acquire ctxt pool lock of NS \"%s\"\n", ns->idstr );
+      return NULL;
+   }
+   MDAL_CTXT ctxt = NULL;
+   uid_t euid = geteuid();
+   gid_t egid = getegid();
+   size_t index = pool->count;
+   while ( index ) {
+      // prefer the most recently released ctxt
+      index--;
+      if ( anyuser  ||  ( pool->euids[index] == euid  &&  pool->egids[index] == egid ) ) {
+         ctxt = pool->ctxts[index];
+         // fill the gap with the final pool entry
+         pool->count--;
+         pool->ctxts[index] = pool->ctxts[pool->count];
+         pool->euids[index] = pool->euids[pool->count];
+         pool->egids[index] = pool->egids[pool->count];
+         break;
+      }
+   }
+   pthread_mutex_unlock( &(pool->lock) );
+   return ctxt;
+}
+
+/**
+ * Release a MDAL_CTXT of the given NS, either retaining it in the pool of that NS or destroying it
+ * @param marfs_ns* ns : NS referenced by the ctxt
+ * @param MDAL_CTXT ctxt : Ctxt to be released
+ * @param unsigned int depth : Depth of the ctxt below the NS root ( only NS root ctxts are retained )
+ * @return int : Zero on success, or -1 if the ctxt could not be destroyed
+ */
+int config_releasectxt( marfs_ns* ns, MDAL_CTXT ctxt, unsigned int depth ) {
+   marfs_ctxtpool* pool = ns->ctxtpool;
+   if ( pool  &&  depth == 0 ) {
+      if ( pthread_mutex_lock( &(pool->lock) ) ) {
+         LOG( LOG_WARNING, "Failed to acquire ctxt pool lock of NS \"%s\"\n", ns->idstr );
+      }
+      else {
+         char retained = 0;
+         if ( pool->count < CTXTPOOL_SIZE ) {
+            pool->ctxts[pool->count] = ctxt;
+            pool->euids[pool->count] = geteuid();
+            pool->egids[pool->count] = getegid();
+            pool->count++;
+            retained = 1;
+         }
+         pthread_mutex_unlock( &(pool->lock) );
+         if ( retained ) { return 0; }
+      }
+   }
+   return ns->prepo->metascheme.mdal->destroyctxt( ctxt );
+}
+
+/**
+ * Destroy all idle MDAL_CTXTs retained by the given NS and all NS below it
+ * NOTE -- This must be called prior to the cleanup of any MDAL, as namespaces may be
+ *         linked below those of a different repo.
+ * @param marfs_ns* ns : NS to drain the ctxt pools of
+ * @return int : Zero on success, or -1 on failure
+ */
+int config_drainctxtpools( marfs_ns* ns ) {
+   int retval = 0;
+   if ( ns->ctxtpool ) {
+      for ( ; ns->ctxtpool->count; ns->ctxtpool->count-- ) {
+         if ( ns->prepo->metascheme.mdal->destroyctxt( ns->ctxtpool->ctxts[ns->ctxtpool->count - 1] ) ) {
+            LOG( LOG_WARNING, "Failed to destroy an idle MDAL_CTXT of NS \"%s\"\n", ns->idstr );
+            retval = -1;
+         }
+      }
+   }
+   size_t nodeindex = 0;
+   for ( ; nodeindex < ns->subnodecount; nodeindex++ ) {
+      marfs_ns* subspace = (marfs_ns*)( ns->subnodes[nodeindex].content );
+      if ( subspace  &&  config_drainctxtpools( subspace ) ) { retval = -1; }
+   }
+   return retval;
+}
+
 /**
  * Traverse backwards, identifying the previous element of a given path
  * @param char* path : Reference to the head of the path string
@@ -182,20 +294,33 @@ int config_enterns( marfs_position* pos, marfs_ns* nextns, const char* relpath,
       if ( nextns->ghtarget == NULL ) {
          // update the NS
          pos->ns = nextns;
-         // update or destroy any existing ctxt
-         if ( curns->prepo == nextns->prepo  &&  updatectxt ) {
+         // update or release any existing ctxt
+         MDAL_CTXT idlectxt = NULL;
+         if ( curns->prepo == nextns->prepo  &&  updatectxt  &&
+              (idlectxt = config_borrowctxt( nextns, 0 )) != NULL ) {
+            // an idle ctxt of the new NS can simply replace our own
+            if ( pos->ctxt  &&  config_releasectxt( curns, pos->ctxt, pos->depth ) ) {
+               // nothing to do but complain
+               LOG( LOG_WARNING, "Failed to release MDAL_CTXT for NS \"%s\"\n", curns->idstr );
+            }
+            pos->ctxt = idlectxt;
+         }
+         else if ( curns->prepo == nextns->prepo  &&  updatectxt ) {
             // shifting NS within a repo means we can directly update
             if ( curns->prepo->metascheme.mdal->setnamespace( pos->ctxt, relpath ) ) {
                LOG( LOG_ERR, "Failed to update CTXT via relative path value: \"%s\"\n", relpath );
+               // this ctxt may not reference the new NS, so must not be retained by it
+               curns->prepo->metascheme.mdal->destroyctxt( pos->ctxt );
+               pos->ctxt = NULL;
                config_abandonposition( pos );
                return -1;
             }
          }
          else {
-            // destroy the current context
-            if ( pos->ctxt  &&  curns->prepo->metascheme.mdal->destroyctxt( pos->ctxt ) ) {
+            // release the current context
+            if ( pos->ctxt  &&  config_releasectxt( curns, pos->ctxt, pos->depth ) ) {
                // nothing to do but complain
-               LOG( LOG_WARNING, "Failed to destroy MDAL_CTXT for NS \"%s\"\n", curns->idstr );
+               LOG( LOG_WARNING, "Failed to release MDAL_CTXT for NS \"%s\"\n", curns->idstr );
             }
             pos->ctxt = NULL;
             // potentially recreate
@@ -209,6 +334,7 @@ int config_enterns( marfs_position* pos, marfs_ns* nextns, const char* relpath,
                LOG( LOG_INFO, "Established a fresh MDAL_CTXT following cross-repo NS transition\n" );
             }
          }
+         pos->depth = 0; // any ctxt now references the root of the new NS
          LOG( LOG_INFO, "Performed simple transition from NS \"%s\" to NS \"%s\"\n", curns->idstr, nextns->idstr );
          return 0;
       }
@@ -231,6 +357,8 @@ int config_enterns( marfs_position* pos, marfs_ns* nextns, const char* relpath,
       }
       // Store the original GhostNS as our source ( will never change for this copy )
       tgtns->ghsource = nextns;
+      // Copies never retain idle ctxts
+      tgtns->ctxtpool = NULL;
       // Target of the copy should match that of the Ghost itself
       tgtns->ghtarget = nextns->ghtarget;
       // Parent NS of the copy should match that of the Ghost Target ( this parent can never appear as a child )
@@ -310,9 +438,9 @@ int config_enterns( marfs_position* pos, marfs_ns* nextns, const char* relpath,
       // provide the new, dynamically allocated NS target
       pos->ns = tgtns;
       // GhostNS contexts must always be freshly created
-      if ( pos->ctxt  &&  curns->prepo->metascheme.mdal->destroyctxt( pos->ctxt ) ) {
+      if ( pos->ctxt  &&  config_releasectxt( curns, pos->ctxt, pos->depth ) ) {
          // nothing to do but complain
-         LOG( LOG_WARNING, "Failed to destroy MDAL_CTXT for NS \"%s\"\n", curns->idstr );
+         LOG( LOG_WARNING, "Failed to release MDAL_CTXT for NS \"%s\"\n", curns->idstr );
       }
       pos->ctxt = NULL;
       if ( updatectxt ) {
@@ -1133,6 +1261,14 @@ int free_namespace( HASH_NODE* nsnode ) {
    // free NS componenets
    if ( ns ) {
       LOG( LOG_INFO, "Freeing NS: \"%s\"\n", nsname );
+      // free the ctxt pool ( idle ctxts must already have been destroyed )
+      if ( ns->ctxtpool ) {
+         if ( ns->ctxtpool->count ) {
+            LOG( LOG_WARNING, "Abandoning %zu idle MDAL_CTXTs of NS \"%s\"\n", ns->ctxtpool->count, nsname );
+         }
+         pthread_mutex_destroy( &(ns->ctxtpool->lock) );
+         free( ns->ctxtpool );
+      }
       // free the namespace id string
       free( ns->idstr );
       // free the namespace itself
@@ -1332,6 +1468,7 @@ int create_namespace( HASH_NODE* nsnode, marfs_ns* pnamespace, marfs_repo* prepo
    ns->subnodecount = 0;
    ns->ghtarget = NULL;
    ns->ghsource = NULL;
+   ns->ctxtpool = NULL;
 
    // set parent values
    ns->prepo = prepo;
@@ -1519,6 +1656,24 @@ int create_namespace( HASH_NODE* nsnode, marfs_ns* pnamespace, marfs_repo* prepo
    ns->subnodes = subspacelist;
    ns->subnodecount = subspcount;
 
+   // real namespaces retain idle MDAL_CTXTs for reuse
+   if ( !(gns) ) {
+      ns->ctxtpool = malloc( sizeof( struct marfs_ctxtpool_struct ) );
+      if ( ns->ctxtpool == NULL ) {
+         LOG( LOG_ERR, "failed to allocate space for the ctxt pool of NS \"%s\"\n", nsname );
+         free_namespace( nsnode );
+         return -1;
+      }
+      if ( pthread_mutex_init( &(ns->ctxtpool->lock), NULL ) ) {
+         LOG( LOG_ERR, "failed to initialize the ctxt pool lock of NS \"%s\"\n", nsname );
+         free( ns->ctxtpool );
+         ns->ctxtpool = NULL;
+         free_namespace( nsnode );
+         return -1;
+      }
+      ns->ctxtpool->count = 0;
+   }
+
    return 0;
 }
 
@@ -1991,6 +2146,44 @@ int parse_datascheme( marfs_ds* ds, xmlNode* dataroot, pthread_mutex_t* erasurel
             return -1;
          }
       }
+      else if ( strncmp( (char*)dataroot->name, "readahead", 10 ) == 0 ) {
+         // iterate over child nodes, populating depth
+         char haveD = 0;
+         for( ; subnode; subnode = subnode->next ) {
+            if ( subnode->type != XML_ELEMENT_NODE ) {
+               // skip comment nodes
+               if ( subnode->type == XML_COMMENT_NODE ) { continue; }
+               LOG( LOG_ERR, "encountered unknown node within a 'readahead' definition\n" );
+               return -1;
+            }
+            if ( strncmp( (char*)subnode->name, "depth", 6 ) == 0 ) {
+               haveD = 1;
+               if( parse_size_node( &(ds->readahead), subnode ) ) {
+                  LOG( LOG_ERR, "failed to parse 'depth' value within a 'readahead' definition\n" );
+                  return -1;
+               }
+            }
+            else {
+               LOG( LOG_ERR, "encountered an unrecognized \"%s\" node within a 'readahead' definition\n", (char*)subnode->name );
+               return -1;
+            }
+         }
+         // verify that all expected values were populated
+         if ( !(haveD) ) {
+            LOG( LOG_ERR, "encountered a 'readahead' definition without a 'depth' value\n" );
+            return -1;
+         }
+      }
+      else if ( strncmp( (char*)dataroot->name, "writebehind", 12 ) == 0 ) {
+         // this definition has no content, beyond the 'enabled' attribute
+         for( ; subnode; subnode = subnode->next ) {
+            if ( subnode->type != XML_COMMENT_NODE ) {
+               LOG( LOG_ERR, "encountered unknown node within a 'writebehind' definition\n" );
+               return -1;
+            }
+         }
+         ds->writebehind = 1;
+      }
       else if ( strncmp( (char*)dataroot->name, "distribution", 13 ) == 0 ) {
          // iterate over child nodes, creating our distribution tables
          for( ; subnode; subnode = subnode->next ) {
@@ -2330,6 +2523,8 @@ int create_repo( marfs_repo* repo, xmlNode* reporoot, pthread_mutex_t* erasurelo
    repo->datascheme.nectxt = NULL;
    repo->datascheme.objfiles = 1;
    repo->datascheme.objsize = 0;
+   repo->datascheme.readahead = 0;
+   repo->datascheme.writebehind = 0;
    repo->datascheme.podtable = NULL;
    repo->datascheme.captable = NULL;
    repo->datascheme.scattertable = NULL;
@@ -2792,8 +2987,22 @@ int config_term( marfs_config* config ) {
       LOG( LOG_ERR, "Received a NULL config reference\n" );
       return -1;
    }
-   // free all repos
+   // destroy all idle ctxts, while every MDAL remains active
    int retval = 0;
+   int repoindex = 0;
+   for ( ; repoindex < config->repocount; repoindex++ ) {
+      marfs_repo* repo = config->repolist + repoindex;
+      int nsindex = 0;
+      for ( ; nsindex < repo->metascheme.nscount; nsindex++ ) {
+         // NOTE -- linked namespaces are referenced only by the NS above them
+         marfs_ns* ns = (marfs_ns*)( repo->metascheme.nslist[nsindex].content );
+         if ( ns  &&  config_drainctxtpools( ns ) ) {
+            LOG( LOG_ERR, "Failed to destroy idle MDAL_CTXTs below NS %d of repo \"%s\"\n", nsindex, repo->name );
+            retval = -1;
+         }
+      }
+   }
+   // free all repos
    for ( ; config->repocount > 0; config->repocount-- ) {
       if ( free_repo( config->repolist + (config->repocount - 1) ) ) {
          LOG( LOG_ERR, "Failed to free repo %d\n", config->repocount - 1 );
@@ -2848,6 +3057,7 @@ marfs_ns* config_duplicatensref( marfs_ns* ns ) {
    ghcopy->subnodecount = ns->subnodecount;
    ghcopy->ghtarget = ns->ghtarget;
    ghcopy->ghsource = ns->ghsource;
+   ghcopy->ctxtpool = NULL;
    ghcopy->subnodes = malloc( sizeof( HASH_NODE ) * ghcopy->subnodecount );
    if ( ghcopy->subnodes == NULL ) {
       LOG( LOG_ERR, "Failed to allocate GhostNS copy subnodes\n" );
@@ -2910,8 +3120,11 @@ int config_establishposition( marfs_position* pos, marfs_config* config ) {
       errno = EINVAL;
       return -1;
    }
-   // populate the root position values
-   pos->ctxt = config->rootns->prepo->metascheme.mdal->newctxt( "/.", config->rootns->prepo->metascheme.mdal->ctxt );
+   // populate the root position values, reusing an idle ctxt if possible
+   pos->ctxt = config_borrowctxt( config->rootns, 0 );
+   if ( pos->ctxt == NULL ) {
+      pos->ctxt = config->rootns->prepo->metascheme.mdal->newctxt( "/.", config->rootns->prepo->metascheme.mdal->ctxt );
+   }
    if ( pos->ctxt == NULL ) {
       LOG( LOG_ERR, "Failed to create a root MDAL_CTXT\n" );
       return -1;
@@ -2953,7 +3166,12 @@ int config_duplicateposition( marfs_position* srcpos, marfs_position* destpos )
    // depth and CTXT are much more straightforward
    destpos->depth = srcpos->depth;
    if ( srcpos->ctxt ) {
-      destpos->ctxt = srcpos->ns->prepo->metascheme.mdal->dupctxt( srcpos->ctxt );
+      // a ctxt referencing the NS root is interchangeable with any idle ctxt of that NS
+      destpos->ctxt = NULL;
+      if ( srcpos->depth == 0 ) { destpos->ctxt = config_borrowctxt( srcpos->ns, 1 ); }
+      if ( destpos->ctxt == NULL ) {
+         destpos->ctxt = srcpos->ns->prepo->metascheme.mdal->dupctxt( srcpos->ctxt );
+      }
       if ( destpos->ctxt == NULL ) {
          LOG( LOG_ERR, "Failed to duplicate MDAL_CTXT of source position\n" );
          destpos->depth = 0;
@@ -3021,6 +3239,12 @@ int config_fortifyposition( marfs_position* pos ) {
       LOG( LOG_INFO, "Generated new split ctxt for GhostNS copy: \"%s\"\n", pos->ns->idstr );
       return 0;
    }
+   // reuse an idle ctxt, if possible
+   pos->ctxt = config_borrowctxt( pos->ns, 0 );
+   if ( pos->ctxt ) {
+      LOG( LOG_INFO, "Reusing idle ctxt of NS: \"%s\"\n", pos->ns->idstr );
+      return 0;
+   }
    // determine the NS path
    char* nspath;
    if ( config_nsinfo( pos->ns->idstr, NULL, &(nspath) ) ) {
@@ -3040,6 +3264,7 @@ int config_fortifyposition( marfs_position* pos ) {
 
 /**
  * Terminate a marfs_position struct
+ * NOTE -- A ctxt referencing the root of a NS is retained by that NS, for reuse by later positions
  * @param marfs_position* pos : Position to be destroyed
  * @return int : Zero on success, or -1 on failure
  */
@@ -3057,7 +3282,7 @@ int config_abandonposition( marfs_position* pos ) {
    }
    int retval = 0;
    if ( pos->ctxt ) {
-      retval = pos->ns->prepo->metascheme.mdal->destroyctxt( pos->ctxt );
+      retval = config_releasectxt( pos->ns, pos->ctxt, pos->depth );
       if ( retval ) {
          LOG( LOG_WARNING, "Failed to destroy position ctxt\n" );
       }
@@ -3729,8 +3954,7 @@ int config_traverse( marfs_config* config, marfs_position* pos, char** subpath,
                      return -1;
                   }
                   // NOTE -- now targetting the rootNS
-                  pos->depth = 0;
-                  if ( pos->ns != config->rootns ) {
+                  if ( pos->ns != config->rootns  ||  pos->depth != 0 ) {
                      // we need to create a fresh MDAL_CTXT, referencing the rootNS
                      if ( pos->ctxt  &&  mdal->destroyctxt( pos->ctxt ) ) {
                         // nothing to do, besides complain
@@ -3744,6 +3968,7 @@ int config_traverse( marfs_config* config, marfs_position* pos, char** subpath,
                         return -1;
                      }
                   }
+                  pos->depth = 0;
                   depth = 0; // now at the root of the rootNS
                   relpath = parsestart; // update relpath, as our NS has shifted
                }
@@ -44,6 +44,8 @@ typedef struct marfs_namespace_struct {
    // GhostNS-specific info
    marfs_ns*   ghtarget;     // target NS of this ghost ( NULL for non-ghost NS )
    marfs_ns*   ghsource;     // reference to the original ghost NS instance ( NULL for all but active ghosts )
+   // MDAL_CTXT reuse
+   struct marfs_ctxtpool_struct* ctxtpool; // idle MDAL_CTXTs targeting this NS ( NULL for ghosts and ghost copies )
 } marfs_ns;
 // NOTE -- namespaces will be wrapped in HASH_NODES for use in HASH_TABLEs
 //         the HASH_NODE struct will provide the name string of the namespace
@@ -54,6 +56,8 @@ typedef struct marfs_datascheme_struct {
    ne_ctxt    nectxt;        // LibNE context reference for data access
    size_t     objfiles;      // maximum count of files per data object (zero if no limit)
    size_t     objsize;       // maximum data object size (zero if no limit)
+   size_t     readahead;     // count of subsequent data objects to open during sequential reads (zero if disabled)
+   char       writebehind;   // flag indicating that data objects may be closed asynchronously during writes
    HASH_TABLE podtable;      // hash table for object POD postion
    HASH_TABLE captable;      // hash table for object CAP position
    HASH_TABLE scattertable;  // hash table for object SCATTER position
@@ -159,6 +163,7 @@ int config_fortifyposition( marfs_position* pos );
 
 /**
  * Terminate a marfs_position struct
+ * NOTE -- A ctxt referencing the root of a NS is retained by that NS, for reuse by later positions
  * @param marfs_position* pos : Position to be destroyed
  * @return int : Zero on success, or -1 on failure
  */
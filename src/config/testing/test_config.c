@@ -345,6 +345,8 @@ int main(int argc, char **argv)
    newrepo.datascheme.nectxt = NULL;
    newrepo.datascheme.objfiles = 1;
    newrepo.datascheme.objsize = 0;
+   newrepo.datascheme.readahead = 0;
+   newrepo.datascheme.writebehind = 0;
    newrepo.datascheme.podtable = NULL;
    newrepo.datascheme.captable = NULL;
    newrepo.datascheme.scattertable = NULL;
@@ -388,6 +390,14 @@ int main(int argc, char **argv)
       printf( "unexpected objsize value for datascheme: %zu\n", ds->objsize );
       return -1;
    }
+   if ( ds->readahead != 2 ) {
+      printf( "unexpected readahead value for datascheme: %zu\n", ds->readahead );
+      return -1;
+   }
+   if ( ds->writebehind != 1 ) {
+      printf( "unexpected writebehind value for datascheme: %d\n", (int)ds->writebehind );
+      return -1;
+   }
    if ( ds->podtable == NULL  ||  ds->captable == NULL  ||  ds->scattertable == NULL ) {
       printf( "not all pod/cap/scatter tables were initialized for datascheme\n" );
       return -1;
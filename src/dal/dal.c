@@ -40,6 +40,14 @@ DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc)
       {
          typetxt = type->children;
       }
+      else if (type->type == XML_ATTRIBUTE_NODE && (strncmp((char *)type->name, "checksum", 9) == 0 ||
+                                                    strncmp((char *)type->name, "qdepth", 7) == 0 ||
+                                                    strncmp((char *)type->name, "bufpool", 8) == 0 ||
+                                                    strncmp((char *)type->name, "numa", 5) == 0 ||
+                                                    strncmp((char *)type->name, "threadpool", 11) == 0))
+      {
+         continue; // checksum type, ioqueue, NUMA, and thread pool values are consumed by libne, rather than by any DAL
+      }
       else
       {
          LOG(LOG_WARNING, "encountered unrecognized or redundant DAL attribute: \"%s\"\n", (char *)type->name);
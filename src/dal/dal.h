@@ -15,6 +15,7 @@
 #include <strings.h>
 #include <string.h>
 #include <errno.h>
+#include <sys/uio.h>
 
 #ifndef LIBXML_TREE_ENABLED
 #error "Included Libxml2 does not support tree functionality!"
@@ -42,6 +43,13 @@ typedef enum DAL_MODE_enum
    DAL_METAREAD = 4 // retrieve the meta info of an object
 } DAL_MODE;
 
+// checksum algorithms which may protect each IO of an object
+typedef enum DAL_CRC_enum
+{
+   CRC_IEEE = 0, // crc32_ieee() ( the original, and default, algorithm )
+   CRC_ISCSI = 1 // crc32_iscsi() ( CRC32C, hardware accelerated on most platforms )
+} DAL_CRC;
+
 // meta information which can be attached to DAL objects
 typedef struct meta_info_struct
 {
@@ -53,6 +61,7 @@ typedef struct meta_info_struct
    ssize_t blocksz;
    long long crcsum;
    ssize_t totsz;
+   DAL_CRC crctype;
 } meta_info;
 
 /**
@@ -93,6 +102,10 @@ typedef struct DAL_struct
    // Preferred I/O Size
    size_t io_size;
 
+   // Preferred I/O Batch Depth -- number of io_size buffers which may be coalesced into a single 'putv' call
+   //  (values less than 2 indicate no preference for coalesced writes)
+   int io_batch;
+
    // DAL Functions --
    int (*verify)(DAL_CTXT ctxt, int flags);
    // Description:
@@ -152,6 +165,13 @@ typedef struct DAL_struct
    //  Store data to the object associated with the given WRITE/REBUILD BLOCK_CTXT.
    // Return Values:
    //  Zero on success, Non-zero if the operation could not be completed
+   int (*putv)(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt);
+   // Description:
+   //  Store a sequence of data buffers to the object associated with the given WRITE/REBUILD BLOCK_CTXT.
+   //  This is equivalent to a 'put' of each buffer, in order, but may be completed via a single operation.
+   //  Note - this function is optional, and may be left NULL by any DAL which does not benefit from it.
+   // Return Values:
+   //  Zero on success, Non-zero if the operation could not be completed
    ssize_t (*get)(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
    // Description:
    //  Retrieve data from the object associated with the given READ BLOCK_CTXT.
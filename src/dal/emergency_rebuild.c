@@ -1204,6 +1204,8 @@ int main(int argc, char** argv) {
         tqopts.num_threads = NUM_CONS;
         tqopts.num_prod_threads = 0;
         tqopts.max_qdepth = QDEPTH;
+        tqopts.lockfree = 0;
+        tqopts.pool = NULL;
         tqopts.thread_init_func = reb_thread_init;
         tqopts.thread_consumer_func = reb_cons;
         tqopts.thread_producer_func = NULL;
@@ -637,12 +637,14 @@ DAL fuzzing_dal_init(xmlNode *root, DAL_location max_loc)
    fdal->name = dctxt->under_dal->name;
    fdal->ctxt = (DAL_CTXT)dctxt;
    fdal->io_size = dctxt->under_dal->io_size;
+   fdal->io_batch = 1;
    fdal->verify = fuzzing_verify;
    fdal->migrate = fuzzing_migrate;
    fdal->open = fuzzing_open;
    fdal->set_meta = fuzzing_set_meta;
    fdal->get_meta = fuzzing_get_meta;
    fdal->put = fuzzing_put;
+   fdal->putv = NULL;
    fdal->get = fuzzing_get;
    fdal->abort = fuzzing_abort;
    fdal->close = fuzzing_close;
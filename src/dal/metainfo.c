@@ -33,6 +33,7 @@
 
 
 #define MINFO_VER 1
+#define MINFO_CRC_VER 2 // version which appends a checksum type ( only written for non-default types )
 
 
 /* ------------------------------   INTERNAL HELPER FUNCTIONS   ------------------------------ */
@@ -81,6 +82,7 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    minfo->blocksz = -1;
    minfo->crcsum  = -1;
    minfo->totsz   = -1;
+   minfo->crctype = CRC_IEEE; // untagged and 'v1' meta info always implies the original CRC type
    // get the meta info for the given object
    ssize_t dstrbytes;
    if ( (dstrbytes = meta_filler( handle, str, strmax )) <= 0 ) {
@@ -111,6 +113,7 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    char metablocksz[20]; /* char array to get complete block size from the meta string */
    char metacrcsum[20];  /* char array to get crc sum from the meta string */
    char metatotsize[20]; /* char array to get object totsz from the meta string */
+   char metacrctype[5];  /* char array to get checksum type from the meta string */
 
    LOG( LOG_INFO, "Parsing meta string: %s", str );
 
@@ -133,7 +136,20 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    }
    
    int ret = 0;
-   if ( vertag ) {
+   if ( vertag >= MINFO_CRC_VER ) {
+      status = 9; // expect a trailing checksum type as well
+      ret = sscanf(parse,"%4s %4s %4s %19s %19s %19s %19s %19s %4s",
+                           metaN,
+                           metaE,
+                           metaO,
+                           metapartsz,
+                           metaversz,
+                           metablocksz,
+                           metacrcsum,
+                           metatotsize,
+                           metacrctype);
+   }
+   else if ( vertag ) {
       // only process the meta string if we successfully retreived it
       ret = sscanf(parse,"%4s %4s %4s %19s %19s %19s %19s %19s",
                            metaN,
@@ -163,7 +179,8 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
       free( str );
       return -1;
    }
-   if (ret != 8) {
+   int expected = status;
+   if (ret != expected) {
       LOG( LOG_WARNING, "sscanf parsed only %d values from meta info: \"%s\"\n", ret, str);
       status = ret;
    }  
@@ -192,11 +209,21 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    PARSE_VALUE( minfo->blocksz, metablocksz, 5,  strtol, ssize_t )
    PARSE_VALUE(  minfo->crcsum,  metacrcsum, 6, strtoll, long long )
    PARSE_VALUE(   minfo->totsz, metatotsize, 7, strtoll, ssize_t )
+   if ( ret > 8 ) {
+      long tmp_type = strtol( metacrctype, &(endptr), 10 );
+      if ( *(endptr) == '\0'  &&  ( tmp_type == CRC_IEEE  ||  tmp_type == CRC_ISCSI ) ) {
+         minfo->crctype = (DAL_CRC) tmp_type;
+      }
+      else {
+         LOG( LOG_ERR, "failed to parse meta value at position 8: \"%s\"\n", metacrctype );
+         status -= 1;
+      }
+   }
 
-   LOG( LOG_INFO, "Got values (N=%d,E=%d,O=%d,partsz=%zd,versz=%zd,blocksz=%zd,totsz=%zd)\n",
-                  minfo->N, minfo->E, minfo->O, minfo->partsz, minfo->versz, minfo->blocksz, minfo->totsz );
+   LOG( LOG_INFO, "Got values (N=%d,E=%d,O=%d,partsz=%zd,versz=%zd,blocksz=%zd,totsz=%zd,crctype=%d)\n",
+                  minfo->N, minfo->E, minfo->O, minfo->partsz, minfo->versz, minfo->blocksz, minfo->totsz, (int)minfo->crctype );
 
-   return ( valid_suffix  &&  status == 8 ) ? 0 : status;
+   return ( valid_suffix  &&  status == expected ) ? 0 : status;
 }
 
 
@@ -225,11 +252,24 @@ int dal_set_meta_helper( int (*meta_writer)(BLOCK_CTXT handle, const char *meta_
    LOG( LOG_INFO, "crcsum %zd\n", minfo->crcsum );
 
 	// fill the string allocation with meta_info values
-   if ( snprintf(str,strmax, "v%d %d %d %d %zd %zd %zd %llu %zd\n",
-                  MINFO_VER, minfo->N, minfo->E, minfo->O,
-                  minfo->partsz, minfo->versz,
-                  minfo->blocksz, minfo->crcsum,
-                  minfo->totsz) < 0 ) {
+   // NOTE -- objects protected by the original CRC type retain the original version tag and format,
+   //         so that they remain readable by older clients
+   int prres;
+   if ( minfo->crctype == CRC_IEEE ) {
+      prres = snprintf(str,strmax, "v%d %d %d %d %zd %zd %zd %llu %zd\n",
+                        MINFO_VER, minfo->N, minfo->E, minfo->O,
+                        minfo->partsz, minfo->versz,
+                        minfo->blocksz, minfo->crcsum,
+                        minfo->totsz);
+   }
+   else {
+      prres = snprintf(str,strmax, "v%d %d %d %d %zd %zd %zd %llu %zd %d\n",
+                        MINFO_CRC_VER, minfo->N, minfo->E, minfo->O,
+                        minfo->partsz, minfo->versz,
+                        minfo->blocksz, minfo->crcsum,
+                        minfo->totsz, (int)minfo->crctype);
+   }
+   if ( prres < 0 ) {
       LOG( LOG_ERR, "failed to convert meta_info to string format!\n" );
       free( str );
       return -1;
@@ -263,6 +303,7 @@ void cpy_minfo( meta_info* target, meta_info* source ) {
    target->versz = source->versz;
    target->blocksz = source->blocksz;
    target->totsz = source->totsz;
+   target->crctype = source->crctype;
 }
 
 /**
@@ -279,6 +320,7 @@ int cmp_minfo( meta_info* minfo1, meta_info* minfo2 ) {
    if ( minfo1->versz != minfo2->versz ) { return -1; }
    if ( minfo1->blocksz != minfo2->blocksz ) { return -1; }
    if ( minfo1->totsz != minfo2->totsz ) { return -1; }
+   if ( minfo1->crctype != minfo2->crctype ) { return -1; }
    return 0;
 }
 
@@ -411,12 +411,14 @@ DAL noop_dal_init(xmlNode *root, DAL_location max_loc)
    ndal->name = "noop";
    ndal->ctxt = (DAL_CTXT)dctxt;
    ndal->io_size = IO_SIZE;
+   ndal->io_batch = 1;
    ndal->verify = noop_verify;
    ndal->migrate = noop_migrate;
    ndal->open = noop_open;
    ndal->set_meta = noop_set_meta;
    ndal->get_meta = noop_get_meta;
    ndal->put = noop_put;
+   ndal->putv = NULL;
    ndal->get = noop_get;
    ndal->abort = noop_abort;
    ndal->close = noop_close;
@@ -28,6 +28,8 @@
 #include <unistd.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <sys/uio.h>
 
 //   -------------    POSIX DEFINITIONS    -------------
 
@@ -54,6 +56,7 @@ typedef struct posix_block_context_struct
    char *filepath; // File Path (if open)
    int filelen;    // Length of filepath string
    DAL_MODE mode;  // Mode in which this block was opened
+   off_t offset;   // Offset of the next put operation
 } * POSIX_BLOCK_CTXT;
 
 typedef struct posix_dal_context_struct
@@ -67,6 +70,8 @@ typedef struct posix_dal_context_struct
    int metaflags;        // Any additional flag values to be passed to open() of meta files
 } * POSIX_DAL_CTXT;
 
+#define IO_BATCH 2 // default number of ioblocks to coalesce into a single pwritev() call ( libNE permits up to 'qdepth' - 2 )
+
 /* For emergency rebuild. This indicates all the combinations of locations that either need to be rebuilt,
  * or locations that the rebuild data can be distributed to.
  */
@@ -865,6 +870,8 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
 
 int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size);
 
+int posix_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt);
+
 ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
 
 int posix_abort(BLOCK_CTXT ctxt);
@@ -1698,7 +1705,7 @@ int posix_get_meta(BLOCK_CTXT ctxt, meta_info* target )
    return dal_get_meta_helper( posix_get_meta_internal, ctxt, target );
 }
 
-int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
+int posix_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
 {
    if (ctxt == NULL)
    {
@@ -1707,16 +1714,56 @@ int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
-   // just a write to our pre-opened FD
-   if (write(bctxt->fd, buf, size) != size)
+   if (iovcnt < 1 || iovcnt > IOV_MAX)
    {
-      LOG(LOG_ERR, "write to \"%s\" failed (%s)\n", bctxt->filepath, strerror(errno));
+      LOG(LOG_ERR, "received an invalid iovec count: %d\n", iovcnt);
+      errno = EINVAL;
       return -1;
    }
 
+   // duplicate the iovec list, as we may need to adjust it to handle partial writes
+   struct iovec liov[iovcnt];
+   memcpy(liov, iov, sizeof(struct iovec) * iovcnt);
+   struct iovec *curiov = liov;
+   ssize_t written = 0;
+   while (1)
+   {
+      // skip over any completed buffers, and adjust a partially written one
+      while (iovcnt > 0 && (size_t)written >= curiov->iov_len)
+      {
+         written -= curiov->iov_len;
+         curiov++;
+         iovcnt--;
+      }
+      if (iovcnt == 0) { break; }
+      curiov->iov_base = (char *)curiov->iov_base + written;
+      curiov->iov_len -= written;
+      // positional write to our pre-opened FD
+      written = pwritev(bctxt->fd, curiov, iovcnt, bctxt->offset);
+      if (written < 0)
+      {
+         if (errno == EINTR) { written = 0; continue; }
+         LOG(LOG_ERR, "pwritev to \"%s\" at offset %zd failed (%s)\n", bctxt->filepath, bctxt->offset, strerror(errno));
+         return -1;
+      }
+      if (written == 0)
+      {
+         LOG(LOG_ERR, "pwritev to \"%s\" at offset %zd made no progress\n", bctxt->filepath, bctxt->offset);
+         errno = EIO;
+         return -1;
+      }
+      bctxt->offset += written;
+   }
+
    return 0;
 }
 
+int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
+{
+   struct iovec iov = { .iov_base = (void *)buf, .iov_len = size };
+   return posix_putv(ctxt, &iov, 1);
+}
+
 ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
 {
    if (ctxt == NULL)
@@ -1733,19 +1780,14 @@ ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
       return -1;
    }
 
-   // always reseek ( minimal performance impact and a bit more explicitly safe )
-   LOG(LOG_INFO, "Performing seek to offset of %zd\n", offset);
-   off_t newoff = lseek(bctxt->fd, offset, SEEK_SET);
-   // make sure our new offset makes sense
-   if (newoff != offset)
+   // just a positional read from our pre-opened FD ( no need to reseek )
+   LOG(LOG_INFO, "Performing read of %zu bytes at offset %zd\n", size, offset);
+   ssize_t res = pread(bctxt->fd, buf, size, offset);
+   if (res < 0)
    {
-      LOG(LOG_ERR, "failed to seek to offset %zd of file \"%s\" (%s)\n", offset, bctxt->filepath, strerror(errno));
-      return -1;
+      LOG(LOG_ERR, "failed to read from offset %zd of file \"%s\" (%s)\n", offset, bctxt->filepath, strerror(errno));
    }
 
-   // just a read from our pre-opened FD
-   ssize_t res = read(bctxt->fd, buf, size);
-
    return res;
 }
 
@@ -1928,6 +1970,7 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
    dctxt->dataflags = 0;
    dctxt->metaflags = 0;
    size_t io_size = IO_SIZE;
+   int io_batch = IO_BATCH;
 
    int origerrno = errno;
    errno = EINVAL; // assume EINVAL
@@ -2035,6 +2078,15 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
                   break;
                }
             }
+            else if ( strncasecmp( (char*)attr->name, "batch", 6 ) == 0 ) {
+               char* endptr = NULL;
+               long parseval = strtol((char *)attr->children->content, &endptr, 10);
+               if ( *endptr != '\0'  ||  parseval < 1  ||  parseval > IOV_MAX ) {
+                  LOG( LOG_ERR, "Failed to parse POSIX DAL 'io' batch value: \"%s\"\n", (char *)attr->children->content );
+                  break;
+               }
+               io_batch = (int)parseval;
+            }
             else if ( strncasecmp( (char*)attr->name, "dataflags", 10 ) == 0 ) {
                if ( parse_open_flags( (const char*)attr->children->content, &(dctxt->dataflags) ) ) { break; }
             }
@@ -2093,12 +2145,14 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
    pdal->name = "posix";
    pdal->ctxt = (DAL_CTXT)dctxt;
    pdal->io_size = io_size;
+   pdal->io_batch = io_batch;
    pdal->verify = posix_verify;
    pdal->migrate = posix_migrate;
    pdal->open = posix_open;
    pdal->set_meta = posix_set_meta;
    pdal->get_meta = posix_get_meta;
    pdal->put = posix_put;
+   pdal->putv = posix_putv;
    pdal->get = posix_get;
    pdal->abort = posix_abort;
    pdal->close = posix_close;
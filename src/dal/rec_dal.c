@@ -799,12 +799,14 @@ DAL rec_dal_init(xmlNode *root, DAL_location max_loc)
     rdal->name = "s3";
     rdal->ctxt = (DAL_CTXT)dctxt;
     rdal->io_size = io_size;
+    rdal->io_batch = 1;
     rdal->verify = rec_verify;
     rdal->migrate = rec_migrate;
     rdal->open = rec_open;
     rdal->set_meta = rec_set_meta;
     rdal->get_meta = rec_get_meta;
     rdal->put = rec_put;
+    rdal->putv = NULL;
     rdal->get = rec_get;
     rdal->abort = rec_abort;
     rdal->close = rec_close;
@@ -21,6 +21,8 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <pthread.h>
+#include <sys/select.h>
 #include <libs3.h>
 
 //   -------------    S3 DEFINITIONS    -------------
@@ -29,6 +31,9 @@
 #define TRIES 5              // Number of times to retry a request
 #define IO_SIZE (5 << 20)    // Preferred I/O Size: 5M
 #define NO_OBJID "noneGiven" // Substitute ID when one is provided
+#define INFLIGHT_PARTS 4     // Default number of multipart upload parts in flight per block
+#define READAHEAD_IOS 2      // Default size of coalesced GETs ( and of the read-ahead window ), in I/Os
+#define PROGRESS_WAIT 10     // Maximum wait ( in ms ) of a request pipe between libs3 polls
 
 //   -------------    S3 CONTEXT    -------------
 
@@ -44,15 +49,72 @@ typedef struct growbuffer
    struct growbuffer *prev, *next;
 } growbuffer;
 
+// Request context over which multipart upload parts are issued asynchronously
+typedef struct s3_pipe_struct
+{
+   S3RequestContext *reqctx;    // libs3 request context ( retaining its own connection cache )
+   pthread_t thread;            // Progress thread, driving all requests of the context
+   pthread_mutex_t lock;        // Lock protecting all pipe state and every use of reqctx
+   pthread_cond_t cond;         // Signaled on request submission, request completion, and shutdown
+   int requests;                // Number of incomplete requests
+   char shutdown;               // Flag indicating that the progress thread should exit
+   struct s3_pipe_struct *next; // Next idle pipe of the DAL
+} s3_pipe;
+
+typedef struct s3_dal_context_struct
+{
+   DAL_location max_loc;     // Maximum pod/cap/block/scatter values
+   char *accessKey;          // AWS Access Key ID
+   char *secretKey;          // AWS Secret Access Key
+   char *region;             // AWS Region Name
+   size_t max_inflight;      // Maximum bytes of multipart upload parts in flight per block
+   size_t read_ahead;        // Size of coalesced sequential GETs, and of the read-ahead window, per block
+   pthread_mutex_t pipelock; // Lock protecting the idle pipe list
+   s3_pipe *idlepipes;       // Pipes of closed blocks, retained so that their connections are reused
+} * S3_DAL_CTXT;
+
+// Multipart upload part, retained until its upload has succeeded or ultimately failed
+typedef struct s3_part_struct
+{
+   struct s3_block_context_struct *bctxt; // Block context this part belongs to
+   int seq;                               // Part number
+   char *data;                            // Part data
+   size_t size;                           // Size of part data
+   size_t sent;                           // Bytes of data handed to libs3 by the current request
+   int tries;                             // Remaining upload attempts
+   char done;                             // Flag indicating that the current request has completed
+   S3Status status;                       // Completion status of the current request
+   char *etag;                            // ETag returned for the uploaded part
+   struct s3_part_struct *next;           // Next unreaped part of the same block
+} s3_part;
+
+// Byte range of an object, retrieved via a single GET request
+typedef struct s3_range_struct
+{
+   struct s3_block_context_struct *bctxt; // Block context this range belongs to
+   char *data;                            // Buffer holding range data
+   size_t capacity;                       // Allocated size of the data buffer
+   off_t offset;                          // Object offset of the start of the range
+   size_t size;                           // Requested length of the range
+   size_t len;                            // Bytes of range data received
+   char active;                           // Flag indicating that an asynchronous request was issued
+   char done;                             // Flag indicating that the asynchronous request has completed
+   char cancel;                           // Flag indicating that the asynchronous request should be abandoned
+   S3Status status;                       // Completion status of the asynchronous request
+} s3_range;
+
 typedef struct s3_block_context_struct
 {
+   S3_DAL_CTXT dctxt;              // DAL context this block was opened via
    char *bucket;                   // Bucket name
    S3BucketContext *bucketContext; // Context for object's bucket
    char *key;                      // Object key
    DAL_MODE mode;                  // Mode in which this block was opened
 
-   growbuffer *data_gb; // Buffer for data
-   int data_size;       // Size of data buffer
+   s3_range cache; // Most recently retrieved range (if read enabled)
+   s3_range ahead; // Range being read ahead (if read enabled)
+   off_t nextoff;  // Offset immediately following the previous get (if read enabled)
+   off_t eof;      // Offset beyond which the object is known to hold no data, or -1 if unknown (if read enabled)
 
    char *meta; // Metadata buffer to be written on close (if any)
 
@@ -60,17 +122,18 @@ typedef struct s3_block_context_struct
    int seq;             // Part number for multipart upload (if write enabled)
    growbuffer *part_gb; // Buffer to hold list of parts (if write enable)
    int part_size;       // Size of part buffer (if write enable)
-} * S3_BLOCK_CTXT;
 
-typedef struct s3_dal_context_struct
-{
-   DAL_location max_loc; // Maximum pod/cap/block/scatter values
-   char *accessKey;      // AWS Access Key ID
-   char *secretKey;      // AWS Secret Access Key
-   char *region;         // AWS Region Name
-} * S3_DAL_CTXT;
+   s3_part *parts;  // Parts not yet reaped (if write enabled)
+   size_t inflight; // Total size of unreaped parts (if write enabled)
+   char **etags;    // ETags of uploaded parts, indexed by part number - 1 (if write enabled)
+   int etagcnt;     // Allocated length of the etags list (if write enabled)
+   char failed;     // Flag indicating that some part could not be uploaded (if write enabled)
+
+   s3_pipe *pipe;   // Pipe over which parts are uploaded or ranges read ahead (if opened for write or read)
+} * S3_BLOCK_CTXT;
 
-static S3Status statusG;
+// Status of the most recent synchronous request issued by this thread
+static __thread S3Status statusG;
 
 //   -------------    S3 INTERNAL FUNCTIONS    -------------
 
@@ -244,45 +307,32 @@ static S3Status initialMultipartCallback(const char *upload_id, void *callbackDa
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * This callback is made during a put object operation, to obtain the next
- * chunk of data to put to the S3 service as the contents of the object.  This
+ * This callback is made during an upload part operation, to obtain the next
+ * chunk of data to put to the S3 service as the contents of the part.  This
  * callback is made repeatedly, each time acquiring the next chunk of data to
  * write to the service, until a negative or 0 value is returned.
  * @param bufferSize gives the maximum number of bytes that may be written
  *        into the buffer parameter by this callback
  * @param buffer gives the buffer to fill with at most bufferSize bytes of
  *        data as the next chunk of data to send to S3 as the contents of this
- *        object
- * @param callbackData is the callback data as specified when the request
- *        was issued.
- * @return < 0 to abort the request with the S3StatusAbortedByCallback, which
- *        will be pased to the response complete callback for this request, or
- *        0 to indicate the end of data, or > 0 to identify the number of
+ *        part
+ * @param callbackData is the s3_part being uploaded
+ * @return 0 to indicate the end of data, or > 0 to identify the number of
  *        bytes that were written into the buffer by this callback
  **/
-static int putObjectDataCallback(int bufferSize, char *buffer, void *callbackData)
+static int partDataCallback(int bufferSize, char *buffer, void *callbackData)
 {
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
-
-   int ret = 0;
+   s3_part *part = (s3_part *)callbackData;
 
-   if (bctxt->data_size)
+   size_t toCopy = part->size - part->sent;
+   if (toCopy > (size_t)bufferSize)
    {
-      int toRead = ((bctxt->data_size > (unsigned)bufferSize) ? (unsigned)bufferSize : bctxt->data_size);
-      if (bctxt->data_gb)
-      {
-         growbuffer_read(&(bctxt->data_gb), toRead, &ret, buffer);
-      }
-      else
-      {
-         LOG(LOG_ERR, "missing data growbuffer!\n");
-         return -1;
-      }
+      toCopy = bufferSize;
    }
+   memcpy(buffer, part->data + part->sent, toCopy);
+   part->sent += toCopy;
 
-   bctxt->data_size -= ret;
-
-   return ret;
+   return (int)toCopy;
 }
 
 /** (INTERNAL HELPER FUNCTION)
@@ -294,28 +344,48 @@ static int putObjectDataCallback(int bufferSize, char *buffer, void *callbackDat
  * returns an error status.
  * @param bufferSize gives the number of bytes in buffer
  * @param buffer is the data being passed into the callback
- * @param callbackData is the callback data as specified when the request
- *        was issued.
- * @return S3StatusOK to continue processing the request, anything else to
- *         immediately abort the request with a status which will be
- *         passed to the S3ResponseCompleteCallback for this request.
- *         Typically, this will return either S3StatusOK or
- *         S3StatusAbortedByCallback.
+ * @param callbackData is the s3_range being retrieved
+ * @return S3StatusOK to continue processing the request, or
+ *         S3StatusAbortedByCallback if more data arrives than was requested
  **/
 static S3Status getObjectDataCallback(int bufferSize, const char *buffer, void *callbackData)
 {
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
+   s3_range *range = (s3_range *)callbackData;
 
-   if (!growbuffer_append(&(bctxt->data_gb), buffer, bufferSize))
+   if (range->len + bufferSize > range->size)
    {
-      LOG(LOG_ERR, "data not appended to growbuffer\n");
+      LOG(LOG_ERR, "received more data than requested\n");
       return S3StatusAbortedByCallback;
    }
-   bctxt->data_size += bufferSize;
+   memcpy(range->data + range->len, buffer, bufferSize);
+   range->len += bufferSize;
 
    return S3StatusOK;
 }
 
+/** (INTERNAL HELPER FUNCTION)
+ * This callback is repeatedly made during an asynchronous ( read-ahead ) get
+ * request, exactly as getObjectDataCallback() is, but abandons the request
+ * once its block no longer wants the data.
+ * NOTE -- the pipe lock, which also protects the 'cancel' flag, is held by
+ *         the progress thread throughout this callback.
+ * @param bufferSize gives the number of bytes in buffer
+ * @param buffer is the data being passed into the callback
+ * @param callbackData is the s3_range being retrieved
+ * @return S3StatusOK to continue processing the request, or
+ *         S3StatusAbortedByCallback if the request has been cancelled
+ **/
+static S3Status aheadDataCallback(int bufferSize, const char *buffer, void *callbackData)
+{
+   s3_range *range = (s3_range *)callbackData;
+
+   if (range->cancel)
+   {
+      return S3StatusAbortedByCallback;
+   }
+   return getObjectDataCallback(bufferSize, buffer, callbackData);
+}
+
 /** (INTERNAL HELPER FUNCTION)
  * This callback is made after commit of a multipart upload operation.  It
  * indicates that the data uploaded via the multipart upload operation has
@@ -384,23 +454,19 @@ static S3Status getMetaResponsePropertiesCallback(const S3ResponseProperties *pr
 
 /** (INTERNAL HELPER FUNCTION)
  * This callback is made whenever the response properties become available for
- * a put() operation.
+ * an upload part operation.
  * @param properties are the properties that are available from the response
- * @param callbackData is the callback data as specified when the request
- *        was issued.
- * @return S3StatusOK to continue processing the request, anything else to
- *         immediately abort the request with a status which will be
- *         passed to the S3ResponseCompleteCallback for this request.
- *         Typically, this will return either S3StatusOK or
- *         S3StatusAbortedByCallback.
+ * @param callbackData is the s3_part being uploaded
+ * @return S3StatusOK to continue processing the request
  **/
-static S3Status putResponseProperiesCallback(const S3ResponseProperties *properties, void *callbackData)
+static S3Status partPropertiesCallback(const S3ResponseProperties *properties, void *callbackData)
 {
-   responsePropertiesCallback(properties, callbackData);
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
-   char buf[256];
-   int n = snprintf(buf, sizeof(buf), "<Part><ETag>%s</ETag><PartNumber>%d</PartNumber></Part>", properties->eTag, bctxt->seq);
-   bctxt->part_size += growbuffer_append(&(bctxt->part_gb), buf, n);
+   s3_part *part = (s3_part *)callbackData;
+   if (properties->eTag)
+   {
+      free(part->etag);
+      part->etag = strdup(properties->eTag);
+   }
    return S3StatusOK;
 }
 
@@ -469,6 +535,48 @@ static void responseCompleteCallback(S3Status status, const S3ErrorDetails *erro
    }
 }
 
+/** (INTERNAL HELPER FUNCTION)
+ * This callback is made as the very last callback of every upload part
+ * operation.  It records the status of the request, then wakes any thread
+ * waiting on the pipe the request was issued via.
+ * NOTE -- This is always called with the lock of that pipe held.
+ * @param status gives the overall status of the response
+ * @param errorDetails if non-NULL, gives details as returned by the S3
+ *        service, describing the error
+ * @param callbackData is the s3_part being uploaded
+ **/
+static void partCompleteCallback(S3Status status, const S3ErrorDetails *error, void *callbackData)
+{
+   s3_part *part = (s3_part *)callbackData;
+   responseCompleteCallback(status, error, NULL);
+   part->status = status;
+   part->done = 1;
+   s3_pipe *pipe = part->bctxt->pipe;
+   pipe->requests--;
+   pthread_cond_broadcast(&(pipe->cond));
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * This callback is made as the very last callback of every asynchronous
+ * get object operation.  It records the status of the request, then wakes
+ * any thread waiting on the pipe the request was issued via.
+ * NOTE -- This is always called with the lock of that pipe held.
+ * @param status gives the overall status of the response
+ * @param errorDetails if non-NULL, gives details as returned by the S3
+ *        service, describing the error
+ * @param callbackData is the s3_range being retrieved
+ **/
+static void rangeCompleteCallback(S3Status status, const S3ErrorDetails *error, void *callbackData)
+{
+   s3_range *range = (s3_range *)callbackData;
+   responseCompleteCallback(status, error, NULL);
+   range->status = status;
+   range->done = 1;
+   s3_pipe *pipe = range->bctxt->pipe;
+   pipe->requests--;
+   pthread_cond_broadcast(&(pipe->cond));
+}
+
 //   -------------    S3 HANDLERS    -------------
 
 // Callbacks for verify() operations
@@ -521,11 +629,11 @@ static S3ResponseHandler getMetaHandler = {
 
 };
 
-// Callbacks for put_object operations
-static S3PutObjectHandler putHandler = {
-    {&putResponseProperiesCallback,
-     &responseCompleteCallback},
-    &putObjectDataCallback
+// Callbacks for asynchronous upload_part operations
+static S3PutObjectHandler partHandler = {
+    {&partPropertiesCallback,
+     &partCompleteCallback},
+    &partDataCallback
 
 };
 
@@ -537,6 +645,14 @@ static S3GetObjectHandler getHandler = {
 
 };
 
+// Callbacks for asynchronous ( read-ahead ) get_object operations
+static S3GetObjectHandler aheadHandler = {
+    {&responsePropertiesCallback,
+     &rangeCompleteCallback},
+    &aheadDataCallback
+
+};
+
 // Callbacks for multipart abort operations
 static S3AbortMultipartUploadHandler abortHandler = {
     {&responsePropertiesCallback,
@@ -562,6 +678,449 @@ static S3ListServiceHandler listHandler = {
 };
 
 
+//   -------------    S3 REQUEST PIPES    -------------
+
+/** (INTERNAL HELPER FUNCTION)
+ * Progress thread of a request pipe, repeatedly driving all outstanding
+ * requests of the pipe's libs3 request context until the pipe is shut down
+ * @param void* arg : Reference to the s3_pipe to be driven
+ * @return void* : Always NULL
+ */
+static void *pipe_thread(void *arg)
+{
+   s3_pipe *pipe = (s3_pipe *)arg;
+   pthread_mutex_lock(&(pipe->lock));
+   while (1)
+   {
+      while (pipe->requests == 0 && !(pipe->shutdown))
+      {
+         pthread_cond_wait(&(pipe->cond), &(pipe->lock));
+      }
+      if (pipe->requests == 0)
+      {
+         break; // shutdown, with nothing left outstanding
+      }
+      int remaining = 0;
+      S3Status status = S3_runonce_request_context(pipe->reqctx, &remaining);
+      if (status != S3StatusOK)
+      {
+         LOG(LOG_WARNING, "failed to drive request context (%s)\n", S3_get_status_name(status));
+      }
+      if (pipe->requests == 0)
+      {
+         continue;
+      }
+      // wait for socket activity, without holding the lock against new submissions
+      fd_set readfds, writefds, exceptfds;
+      FD_ZERO(&readfds);
+      FD_ZERO(&writefds);
+      FD_ZERO(&exceptfds);
+      int maxfd = -1;
+      S3_get_request_context_fdsets(pipe->reqctx, &readfds, &writefds, &exceptfds, &maxfd);
+      int64_t timeout = S3_get_request_context_timeout(pipe->reqctx);
+      if (timeout < 0 || timeout > PROGRESS_WAIT)
+      {
+         timeout = PROGRESS_WAIT;
+      }
+      struct timeval tv = {.tv_sec = 0, .tv_usec = timeout * 1000};
+      pthread_mutex_unlock(&(pipe->lock));
+      select(maxfd + 1, &readfds, &writefds, &exceptfds, &tv);
+      pthread_mutex_lock(&(pipe->lock));
+   }
+   pthread_mutex_unlock(&(pipe->lock));
+   return NULL;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Shut down and free the given request pipe
+ * @param s3_pipe* pipe : Reference to the pipe to be destroyed
+ */
+static void pipe_destroy(s3_pipe *pipe)
+{
+   pthread_mutex_lock(&(pipe->lock));
+   pipe->shutdown = 1;
+   pthread_cond_broadcast(&(pipe->cond));
+   pthread_mutex_unlock(&(pipe->lock));
+   pthread_join(pipe->thread, NULL);
+   S3_destroy_request_context(pipe->reqctx);
+   pthread_cond_destroy(&(pipe->cond));
+   pthread_mutex_destroy(&(pipe->lock));
+   free(pipe);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Obtain an idle request pipe of the given DAL, creating a new one if none are available
+ * @param S3_DAL_CTXT dctxt : DAL context to obtain a pipe from
+ * @return s3_pipe* : Reference to the pipe, or NULL on failure
+ */
+static s3_pipe *pipe_acquire(S3_DAL_CTXT dctxt)
+{
+   pthread_mutex_lock(&(dctxt->pipelock));
+   s3_pipe *pipe = dctxt->idlepipes;
+   if (pipe)
+   {
+      dctxt->idlepipes = pipe->next;
+   }
+   pthread_mutex_unlock(&(dctxt->pipelock));
+   if (pipe)
+   {
+      pipe->next = NULL;
+      return pipe;
+   }
+
+   pipe = malloc(sizeof(struct s3_pipe_struct));
+   if (pipe == NULL)
+   {
+      return NULL;
+   } // malloc will set errno
+   S3Status status = S3_create_request_context(&(pipe->reqctx));
+   if (status != S3StatusOK)
+   {
+      LOG(LOG_ERR, "failed to create request context (%s)\n", S3_get_status_name(status));
+      free(pipe);
+      errno = ENOMEM;
+      return NULL;
+   }
+   pipe->requests = 0;
+   pipe->shutdown = 0;
+   pipe->next = NULL;
+   if (pthread_mutex_init(&(pipe->lock), NULL))
+   {
+      LOG(LOG_ERR, "failed to initialize pipe lock\n");
+      S3_destroy_request_context(pipe->reqctx);
+      free(pipe);
+      return NULL;
+   }
+   if (pthread_cond_init(&(pipe->cond), NULL))
+   {
+      LOG(LOG_ERR, "failed to initialize pipe condition\n");
+      pthread_mutex_destroy(&(pipe->lock));
+      S3_destroy_request_context(pipe->reqctx);
+      free(pipe);
+      return NULL;
+   }
+   if (pthread_create(&(pipe->thread), NULL, pipe_thread, pipe))
+   {
+      LOG(LOG_ERR, "failed to launch pipe progress thread\n");
+      pthread_cond_destroy(&(pipe->cond));
+      pthread_mutex_destroy(&(pipe->lock));
+      S3_destroy_request_context(pipe->reqctx);
+      free(pipe);
+      return NULL;
+   }
+   return pipe;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Return the given ( now idle ) request pipe to its DAL, for reuse by a later block
+ * @param S3_DAL_CTXT dctxt : DAL context to return the pipe to
+ * @param s3_pipe* pipe : Reference to the pipe to be returned
+ */
+static void pipe_release(S3_DAL_CTXT dctxt, s3_pipe *pipe)
+{
+   pthread_mutex_lock(&(dctxt->pipelock));
+   pipe->next = dctxt->idlepipes;
+   dctxt->idlepipes = pipe;
+   pthread_mutex_unlock(&(dctxt->pipelock));
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Issue an upload request for the given part via the pipe of its block
+ * NOTE -- The caller must hold the lock of that pipe.
+ * @param s3_part* part : Reference to the part to be uploaded
+ */
+static void part_submit(s3_part *part)
+{
+   S3_BLOCK_CTXT bctxt = part->bctxt;
+   part->sent = 0;
+   part->done = 0;
+   part->tries--;
+   // account for this request before issuing it, as libs3 may complete it immediately
+   bctxt->pipe->requests++;
+   pthread_cond_broadcast(&(bctxt->pipe->cond));
+   S3_upload_part(bctxt->bucketContext, bctxt->key, NULL, &partHandler, part->seq, bctxt->upload_id, part->size, bctxt->pipe->reqctx, TIMEOUT, part);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Process all completed part uploads of the given block, recording the ETag of each success,
+ * resubmitting any retryable failure, and recording any other failure
+ * NOTE -- The caller must hold the lock of the block's pipe.
+ * @param S3_BLOCK_CTXT bctxt : Block context to reap the parts of
+ */
+static void parts_reap(S3_BLOCK_CTXT bctxt)
+{
+   s3_part **partref = &(bctxt->parts);
+   while (*partref)
+   {
+      s3_part *part = *partref;
+      if (!(part->done))
+      {
+         partref = &(part->next);
+         continue;
+      }
+      if (part->status == S3StatusOK && part->etag)
+      {
+         bctxt->etags[part->seq - 1] = part->etag;
+         part->etag = NULL;
+      }
+      else if (S3_status_is_retryable(part->status) && part->tries > 0)
+      {
+         LOG(LOG_WARNING, "retrying upload of part %d of \"%s/%s\" (%s)\n", part->seq, bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(part->status));
+         part_submit(part);
+         partref = &(part->next);
+         continue;
+      }
+      else
+      {
+         LOG(LOG_ERR, "failed to upload part %d of \"%s/%s\" (%s)\n", part->seq, bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(part->status));
+         bctxt->failed = 1;
+      }
+      *partref = part->next;
+      bctxt->inflight -= part->size;
+      free(part->etag);
+      free(part->data);
+      free(part);
+   }
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Wait for the total size of in-flight parts of the given block to drop to the given limit
+ * @param S3_BLOCK_CTXT bctxt : Block context to wait on
+ * @param size_t limit : Maximum in-flight bytes, or zero to wait for all parts to complete
+ * @return int : Zero if all parts have been uploaded successfully so far, or -1 if any failed
+ */
+static int parts_wait(S3_BLOCK_CTXT bctxt, size_t limit)
+{
+   pthread_mutex_lock(&(bctxt->pipe->lock));
+   parts_reap(bctxt);
+   while (bctxt->parts && (limit == 0 || bctxt->inflight > limit))
+   {
+      pthread_cond_wait(&(bctxt->pipe->cond), &(bctxt->pipe->lock));
+      parts_reap(bctxt);
+   }
+   pthread_mutex_unlock(&(bctxt->pipe->lock));
+   return (bctxt->failed) ? -1 : 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Wait for all parts of the given block to complete, then release its pipe and ETag list
+ * @param S3_BLOCK_CTXT bctxt : Block context to release the upload state of
+ * @return int : Zero if all parts were uploaded successfully, or -1 if any failed
+ */
+static int parts_release(S3_BLOCK_CTXT bctxt)
+{
+   int retval = 0;
+   if (bctxt->pipe)
+   {
+      retval = parts_wait(bctxt, 0);
+      pipe_release(bctxt->dctxt, bctxt->pipe);
+      bctxt->pipe = NULL;
+   }
+   if (bctxt->etags)
+   {
+      int i;
+      for (i = 0; i < bctxt->etagcnt; i++)
+      {
+         free(bctxt->etags[i]);
+      }
+      free(bctxt->etags);
+      bctxt->etags = NULL;
+      bctxt->etagcnt = 0;
+   }
+   return retval;
+}
+
+
+/** (INTERNAL HELPER FUNCTION)
+ * Determine whether the given range holds data at the given offset
+ * @param s3_range* range : Range to check
+ * @param off_t offset : Object offset to check for
+ * @return int : Non-zero if the range holds data at the offset, or zero if not
+ */
+static int range_covers(s3_range *range, off_t offset)
+{
+   return (range->len && offset >= range->offset && offset < range->offset + (off_t)range->len);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Synchronously retrieve the given byte range of the object referenced by the given block
+ * @param S3_BLOCK_CTXT bctxt : Block context to retrieve data of
+ * @param s3_range* range : Range to be populated, with a data buffer of at least 'size' bytes
+ * @param off_t offset : Object offset of the start of the range
+ * @param size_t size : Length of the range
+ * @return int : Zero on success ( though the range may be short, at the end of the object ),
+ *               or -1 on failure
+ */
+static int range_fetch(S3_BLOCK_CTXT bctxt, s3_range *range, off_t offset, size_t size)
+{
+   range->offset = offset;
+   range->size = size;
+
+   // Give several tries to retrieve data from specified location
+   int i = TRIES;
+   do
+   {
+      range->len = 0;
+      S3_get_object(bctxt->bucketContext, bctxt->key, NULL, offset, size, NULL, TIMEOUT, &getHandler, range);
+      i--;
+   } while (S3_status_is_retryable(statusG) && i >= 0);
+
+   if (statusG != S3StatusOK)
+   {
+      LOG(LOG_ERR, "failed to read from \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
+      range->len = 0;
+      errno = EIO;
+      return -1;
+   }
+   if (range->len < size)
+   {
+      bctxt->eof = offset + range->len; // short range, so the object ends here
+   }
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Ensure that the data buffer of the given range can hold at least the given number of bytes
+ * @param s3_range* range : Range to be expanded
+ * @param size_t size : Required capacity
+ * @return int : Zero on success, or -1 on failure
+ */
+static int range_alloc(s3_range *range, size_t size)
+{
+   if (range->capacity >= size)
+   {
+      return 0;
+   }
+   char *newdata = realloc(range->data, size);
+   if (newdata == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate a %zu byte range buffer\n", size);
+      return -1;
+   } // realloc will set errno
+   range->data = newdata;
+   range->capacity = size;
+   range->len = 0;
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Begin asynchronous retrieval of the read-ahead window of the given block, starting at the given offset
+ * NOTE -- Failure to read ahead is never fatal, so this function simply returns if anything goes wrong.
+ * @param S3_BLOCK_CTXT bctxt : Block context to read ahead on
+ * @param off_t offset : Object offset of the start of the window
+ */
+static void range_readahead(S3_BLOCK_CTXT bctxt, off_t offset)
+{
+   if (bctxt->eof >= 0 && offset >= bctxt->eof)
+   {
+      return; // nothing to read ahead
+   }
+   if (bctxt->pipe == NULL)
+   {
+      bctxt->pipe = pipe_acquire(bctxt->dctxt);
+      if (bctxt->pipe == NULL)
+      {
+         LOG(LOG_WARNING, "failed to obtain a request pipe for read-ahead of \"%s/%s\"\n", bctxt->bucketContext->bucketName, bctxt->key);
+         return;
+      }
+   }
+   s3_range *ahead = &(bctxt->ahead);
+   if (range_alloc(ahead, bctxt->dctxt->read_ahead))
+   {
+      return;
+   }
+   ahead->offset = offset;
+   ahead->size = bctxt->dctxt->read_ahead;
+   ahead->len = 0;
+   ahead->active = 1;
+   ahead->done = 0;
+   ahead->cancel = 0;
+   pthread_mutex_lock(&(bctxt->pipe->lock));
+   // account for this request before issuing it, as libs3 may complete it immediately
+   bctxt->pipe->requests++;
+   pthread_cond_broadcast(&(bctxt->pipe->cond));
+   S3_get_object(bctxt->bucketContext, bctxt->key, NULL, offset, ahead->size, bctxt->pipe->reqctx, TIMEOUT, &aheadHandler, ahead);
+   pthread_mutex_unlock(&(bctxt->pipe->lock));
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Wait for any read-ahead request of the given block to complete
+ * @param S3_BLOCK_CTXT bctxt : Block context to wait on
+ * @return int : Zero if the read-ahead window was successfully retrieved, or -1 if not
+ */
+static int range_wait(S3_BLOCK_CTXT bctxt)
+{
+   s3_range *ahead = &(bctxt->ahead);
+   if (!(ahead->active))
+   {
+      return -1;
+   }
+   pthread_mutex_lock(&(bctxt->pipe->lock));
+   while (!(ahead->done))
+   {
+      pthread_cond_wait(&(bctxt->pipe->cond), &(bctxt->pipe->lock));
+   }
+   pthread_mutex_unlock(&(bctxt->pipe->lock));
+   ahead->active = 0;
+   if (ahead->status != S3StatusOK)
+   {
+      // likely just a window beyond the end of the object
+      LOG(LOG_INFO, "discarding failed read-ahead at offset %zd of \"%s/%s\" (%s)\n", ahead->offset, bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(ahead->status));
+      ahead->len = 0;
+      if (bctxt->eof < 0 || ahead->offset < bctxt->eof)
+      {
+         bctxt->eof = ahead->offset; // avoid any repeat of a window beyond the end of the object
+      }
+      return -1;
+   }
+   if (ahead->len < ahead->size)
+   {
+      bctxt->eof = ahead->offset + ahead->len; // short range, so the object ends here
+   }
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Abandon any read-ahead request of the given block, waiting only for libs3 to drop it
+ * @param S3_BLOCK_CTXT bctxt : Block context to cancel the read-ahead of
+ */
+static void range_cancel(S3_BLOCK_CTXT bctxt)
+{
+   s3_range *ahead = &(bctxt->ahead);
+   if (!(ahead->active))
+   {
+      return;
+   }
+   pthread_mutex_lock(&(bctxt->pipe->lock));
+   ahead->cancel = 1;
+   while (!(ahead->done))
+   {
+      pthread_cond_wait(&(bctxt->pipe->cond), &(bctxt->pipe->lock));
+   }
+   pthread_mutex_unlock(&(bctxt->pipe->lock));
+   ahead->active = 0;
+   ahead->len = 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Cancel any read-ahead request of the given block, then release its pipe and range buffers
+ * @param S3_BLOCK_CTXT bctxt : Block context to release the read state of
+ */
+static void range_release(S3_BLOCK_CTXT bctxt)
+{
+   range_cancel(bctxt);
+   if (bctxt->pipe)
+   {
+      pipe_release(bctxt->dctxt, bctxt->pipe);
+      bctxt->pipe = NULL;
+   }
+   free(bctxt->cache.data);
+   free(bctxt->ahead.data);
+   bctxt->cache.data = NULL;
+   bctxt->ahead.data = NULL;
+}
+
+
 int s3_set_meta_internal(BLOCK_CTXT ctxt, const char *meta_buf, size_t size)
 {
    if (ctxt == NULL)
@@ -901,7 +1460,14 @@ int s3_cleanup(DAL dal)
    }
    S3_DAL_CTXT dctxt = (S3_DAL_CTXT)dal->ctxt; // should have been passed a s3 context
 
-   // shut down libs3
+   // shut down all idle pipes, then libs3 itself
+   while (dctxt->idlepipes)
+   {
+      s3_pipe *pipe = dctxt->idlepipes;
+      dctxt->idlepipes = pipe->next;
+      pipe_destroy(pipe);
+   }
+   pthread_mutex_destroy(&(dctxt->pipelock));
    S3_deinitialize();
 
    // free the DAL struct and its associated state
@@ -929,8 +1495,18 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
       return NULL;
    } // malloc will set errno
 
+   bctxt->dctxt = dctxt;
    bctxt->mode = mode;
    bctxt->seq = 1;
+   bctxt->upload_id = NULL;
+   bctxt->part_gb = 0;
+   bctxt->part_size = 0;
+   bctxt->pipe = NULL;
+   bctxt->parts = NULL;
+   bctxt->inflight = 0;
+   bctxt->etags = NULL;
+   bctxt->etagcnt = 0;
+   bctxt->failed = 0;
 
    if (strlen(objID) == 0)
    {
@@ -939,8 +1515,12 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
    bctxt->key = strdup(objID);
    bctxt->meta = NULL;
 
-   bctxt->data_gb = 0;
-   bctxt->data_size = 0;
+   memset(&(bctxt->cache), 0, sizeof(s3_range));
+   memset(&(bctxt->ahead), 0, sizeof(s3_range));
+   bctxt->cache.bctxt = bctxt;
+   bctxt->ahead.bctxt = bctxt;
+   bctxt->nextoff = 0;
+   bctxt->eof = -1;
 
    // Form bucket from location
    int size = sizeof(char) * (4 + num_digits(location.block) + num_digits(location.cap) + num_digits(location.scatter));
@@ -976,6 +1556,18 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
          LOG(LOG_INFO, "Open for REBUILD\n");
       }
 
+      // Obtain a pipe ( and any connections it retains ) for our part uploads
+      bctxt->pipe = pipe_acquire(dctxt);
+      if (bctxt->pipe == NULL)
+      {
+         LOG(LOG_ERR, "failed to obtain a request pipe for \"%s/%s\"\n", bctxt->bucketContext->bucketName, bctxt->key);
+         free(bctxt->bucket);
+         free(bctxt->bucketContext);
+         free(bctxt->key);
+         free(bctxt);
+         return NULL;
+      }
+
       // Give several tries to initiate a multipart upload
       int i = TRIES;
       do
@@ -987,6 +1579,7 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
       if (statusG != S3StatusOK)
       {
          LOG(LOG_ERR, "failed to initiate multipart upload for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
+         pipe_release(dctxt, bctxt->pipe);
          free(bctxt->bucket);
          free(bctxt->bucketContext);
          free(bctxt->key);
@@ -996,8 +1589,6 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
          return NULL;
       }
 
-      bctxt->part_gb = 0;
-      bctxt->part_size = growbuffer_append(&(bctxt->part_gb), "<CompleteMultipartUpload>", strlen("<CompleteMultipartUpload>"));
    }
 
    return bctxt;
@@ -1029,35 +1620,57 @@ int s3_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
       return -1;
    }
 
-   // Add data to growbuffer to be handed to libs3
-   bctxt->data_size = size;
-   if (!growbuffer_append(&(bctxt->data_gb), buf, size))
+   // Wait for sufficient in-flight parts to complete
+   size_t limit = (size < bctxt->dctxt->max_inflight) ? (bctxt->dctxt->max_inflight - size) : 0;
+   if (parts_wait(bctxt, limit))
    {
-      LOG(LOG_ERR, "data not appended to growbuffer\n");
-      growbuffer_destroy(bctxt->data_gb);
-      bctxt->data_size = 0;
+      LOG(LOG_ERR, "previous part upload of \"%s/%s\" failed\n", bctxt->bucketContext->bucketName, bctxt->key);
+      errno = EIO;
       return -1;
    }
 
-   // Give several tries to add data to the object's multipart upload
-   int i = TRIES;
-   do
+   // Expand our ETag list, if necessary
+   if (bctxt->seq > bctxt->etagcnt)
    {
-      S3_upload_part(bctxt->bucketContext, bctxt->key, NULL, &putHandler, bctxt->seq, bctxt->upload_id, size, NULL, TIMEOUT, bctxt);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      int newcnt = (bctxt->etagcnt) ? (bctxt->etagcnt * 2) : 16;
+      char **newetags = realloc(bctxt->etags, sizeof(char *) * newcnt);
+      if (newetags == NULL)
+      {
+         LOG(LOG_ERR, "failed to expand ETag list to %d entries\n", newcnt);
+         return -1;
+      } // realloc will set errno
+      memset(newetags + bctxt->etagcnt, 0, sizeof(char *) * (newcnt - bctxt->etagcnt));
+      bctxt->etags = newetags;
+      bctxt->etagcnt = newcnt;
+   }
 
-   if (statusG != S3StatusOK)
+   // Copy the data, as the caller may reuse its buffer as soon as we return
+   s3_part *part = malloc(sizeof(struct s3_part_struct));
+   if (part == NULL)
    {
-      LOG(LOG_ERR, "failed to upload part %d of \"%s/%s\" (%s)\n", bctxt->seq, bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
-      errno = EIO;
-      growbuffer_destroy(bctxt->data_gb);
-      bctxt->data_size = 0;
       return -1;
-   }
+   } // malloc will set errno
+   part->data = malloc(size);
+   if (part->data == NULL && size)
+   {
+      free(part);
+      return -1;
+   } // malloc will set errno
+   memcpy(part->data, buf, size);
+   part->bctxt = bctxt;
+   part->seq = bctxt->seq;
+   part->size = size;
+   part->tries = TRIES + 1;
+   part->etag = NULL;
+
+   // Give several tries to add data to the object's multipart upload, asynchronously
+   pthread_mutex_lock(&(bctxt->pipe->lock));
+   part->next = bctxt->parts;
+   bctxt->parts = part;
+   bctxt->inflight += size;
+   part_submit(part);
+   pthread_mutex_unlock(&(bctxt->pipe->lock));
    bctxt->seq++;
-   growbuffer_destroy(bctxt->data_gb);
-   bctxt->data_size = 0;
    return 0;
 }
 
@@ -1077,36 +1690,82 @@ ssize_t s3_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
       return -1;
    }
 
-   bctxt->data_size = 0;
-
-   // Give several tries to retrieve data from specified location
-   int i = TRIES;
-   do
+   // Only sequential gets are coalesced into larger ranges and read ahead, as
+   // random gets ( such as those of NE_RANDOM handles ) would only waste bandwidth
+   size_t read_ahead = bctxt->dctxt->read_ahead;
+   char sequential = (read_ahead > 0 && offset == bctxt->nextoff);
+   s3_range *cache = &(bctxt->cache);
+   // a seek away from the read-ahead window leaves that data unwanted
+   if (!sequential && bctxt->ahead.active && (offset < bctxt->ahead.offset || offset >= bctxt->ahead.offset + (off_t)bctxt->ahead.size))
    {
-      S3_get_object(bctxt->bucketContext, bctxt->key, NULL, offset, size, NULL, TIMEOUT, &getHandler, bctxt);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
-
-   if (statusG != S3StatusOK)
-   {
-      LOG(LOG_ERR, "failed to read from \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
-      errno = EIO;
-      growbuffer_destroy(bctxt->data_gb);
-      return -1;
+      range_cancel(bctxt);
+   }
+   char *tgt = (char *)buf;
+   size_t retrieved = 0;
+   while (retrieved < size)
+   {
+      off_t curoff = offset + retrieved;
+      size_t want = size - retrieved;
+      // claim the read-ahead window, if it begins within this request
+      if (!range_covers(cache, curoff) && bctxt->ahead.active &&
+          curoff >= bctxt->ahead.offset && curoff < bctxt->ahead.offset + (off_t)bctxt->ahead.size &&
+          range_wait(bctxt) == 0)
+      {
+         s3_range tmp = bctxt->ahead;
+         bctxt->ahead = *cache;
+         *cache = tmp;
+      }
+      if (!range_covers(cache, curoff))
+      {
+         if (!sequential || want >= read_ahead)
+         {
+            // no benefit to coalescing, so just retrieve the data directly
+            s3_range direct = {.bctxt = bctxt, .data = tgt + retrieved, .capacity = want};
+            if (range_fetch(bctxt, &direct, curoff, want))
+            {
+               return -1;
+            }
+            retrieved += direct.len;
+            break; // either complete, or at the end of the object
+         }
+         if (range_alloc(cache, read_ahead) || range_fetch(bctxt, cache, curoff, read_ahead))
+         {
+            return -1;
+         }
+         if (!range_covers(cache, curoff))
+         {
+            break; // at the end of the object
+         }
+      }
+      size_t avail = (cache->offset + cache->len) - curoff;
+      if (avail > want)
+      {
+         avail = want;
+      }
+      memcpy(tgt + retrieved, cache->data + (curoff - cache->offset), avail);
+      retrieved += avail;
+      if (cache->len < cache->size && curoff + (off_t)avail == cache->offset + (off_t)cache->len)
+      {
+         break; // at the end of the object
+      }
    }
+   bctxt->nextoff = offset + retrieved;
 
-   // Add data in growbuffer to buf
-   int ret = 0;
-   size = 0;
-   do
+   // Keep the window following this data in flight
+   if (sequential && retrieved == size && !(bctxt->ahead.active))
    {
-      growbuffer_read(&(bctxt->data_gb), bctxt->data_size, &ret, buf);
-      buf += ret;
-      size += ret;
-   } while (ret > 0);
-   growbuffer_destroy(bctxt->data_gb);
+      off_t aheadoff = bctxt->nextoff;
+      if (range_covers(cache, aheadoff))
+      {
+         aheadoff = (cache->len == cache->size) ? cache->offset + cache->len : -1;
+      }
+      if (aheadoff >= 0)
+      {
+         range_readahead(bctxt, aheadoff);
+      }
+   }
 
-   return size;
+   return retrieved;
 }
 
 int s3_abort(BLOCK_CTXT ctxt)
@@ -1127,6 +1786,9 @@ int s3_abort(BLOCK_CTXT ctxt)
 
    int retval = 0;
 
+   // any outstanding parts must complete before the upload can be aborted
+   parts_release(bctxt);
+
    // abort the multipart upload
    int i = TRIES;
    do
@@ -1171,8 +1833,26 @@ int s3_close(BLOCK_CTXT ctxt)
    // Commit any data written
    if (bctxt->mode == DAL_WRITE || bctxt->mode == DAL_REBUILD)
    {
+      // Wait for all outstanding parts
+      if (parts_wait(bctxt, 0))
+      {
+         LOG(LOG_ERR, "failed to upload all parts of \"%s/%s\"\n", bctxt->bucketContext->bucketName, bctxt->key);
+         parts_release(bctxt);
+         errno = EIO;
+         return -1;
+      }
 
+      // List all parts, in order
+      bctxt->part_size = growbuffer_append(&(bctxt->part_gb), "<CompleteMultipartUpload>", strlen("<CompleteMultipartUpload>"));
+      int seq;
+      for (seq = 1; seq < bctxt->seq; seq++)
+      {
+         char buf[256];
+         int n = snprintf(buf, sizeof(buf), "<Part><ETag>%s</ETag><PartNumber>%d</PartNumber></Part>", bctxt->etags[seq - 1], seq);
+         bctxt->part_size += growbuffer_append(&(bctxt->part_gb), buf, n);
+      }
       bctxt->part_size += growbuffer_append(&(bctxt->part_gb), "</CompleteMultipartUpload>", strlen("</CompleteMultipartUpload>"));
+      parts_release(bctxt);
 
       // Give several tries to complete the multipart upload
       int i = TRIES;
@@ -1236,6 +1916,11 @@ int s3_close(BLOCK_CTXT ctxt)
       free(bctxt->upload_id);
    }
 
+   else
+   {
+      range_release(bctxt);
+   }
+
    // free state
    free(bctxt->bucket);
    free(bctxt->bucketContext);
@@ -1298,6 +1983,8 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
          dctxt->max_loc = max_loc;
 
          size_t io_size = IO_SIZE;
+         ssize_t max_inflight = -1;
+         ssize_t read_ahead = -1;
 
          // find the access key, secret key, and region. Fail if any are missing
          while (root != NULL)
@@ -1321,6 +2008,14 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
                   io_size = atol((char *)root->children->content);
                }
             }
+            else if (root->type == XML_ELEMENT_NODE && strncmp((char *)root->name, "max_inflight", 13) == 0)
+            {
+               max_inflight = atol((char *)root->children->content);
+            }
+            else if (root->type == XML_ELEMENT_NODE && strncmp((char *)root->name, "read_ahead", 11) == 0)
+            {
+               read_ahead = atol((char *)root->children->content);
+            }
             root = root->next;
          }
 
@@ -1343,6 +2038,23 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
             return NULL;
          }
 
+         // Limit each block to a few parts in flight, unless otherwise specified
+         // NOTE -- a value of zero limits each block to a single part in flight
+         dctxt->max_inflight = (max_inflight < 0) ? (INFLIGHT_PARTS * io_size) : max_inflight;
+         // Coalesce sequential GETs into a couple of I/Os, unless otherwise specified
+         // NOTE -- a value of zero disables both coalescing and read-ahead
+         dctxt->read_ahead = (read_ahead < 0) ? (READAHEAD_IOS * io_size) : read_ahead;
+         dctxt->idlepipes = NULL;
+         if (pthread_mutex_init(&(dctxt->pipelock), NULL))
+         {
+            LOG(LOG_ERR, "failed to initialize pipe list lock\n");
+            free(dctxt->accessKey);
+            free(dctxt->secretKey);
+            free(dctxt->region);
+            free(dctxt);
+            return NULL;
+         }
+
          // Initialize libs3
          S3Status status;
          if ((status = S3_initialize("s3_dal", S3_INIT_ALL, hostname)) != S3StatusOK)
@@ -1388,12 +2100,14 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
          s3dal->name = "s3";
          s3dal->ctxt = (DAL_CTXT)dctxt;
          s3dal->io_size = io_size;
+         s3dal->io_batch = 1;
          s3dal->verify = s3_verify;
          s3dal->migrate = s3_migrate;
          s3dal->open = s3_open;
          s3dal->set_meta = s3_set_meta;
          s3dal->get_meta = s3_get_meta;
          s3dal->put = s3_put;
+         s3dal->putv = NULL;
          s3dal->get = s3_get;
          s3dal->abort = s3_abort;
          s3dal->close = s3_close;
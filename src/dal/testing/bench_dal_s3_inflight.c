@@ -0,0 +1,141 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * S3 multipart upload benchmark
+ *
+ * Writes a single block via the S3 DAL described by ./testing/s3_config.xml ( typically a local
+ * S3-compatible server, such as MinIO ), once for each of several 'max_inflight' values, and reports
+ * the resulting upload throughput against the number of parts permitted in flight.
+ */
+
+#include "dal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/time.h>
+
+#define MAXDEPTH 16
+
+double elapsed(struct timeval *beg, struct timeval *end)
+{
+  return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+int main(int argc, char **argv)
+{
+  int parts = 32;
+  size_t partmb = 5;
+  if (argc > 3)
+  {
+    printf("usage: %s [parts [part_MiB]]\n", argv[0]);
+    return -1;
+  }
+  if (argc > 1)
+  {
+    parts = atoi(argv[1]);
+  }
+  if (argc > 2)
+  {
+    partmb = strtoull(argv[2], NULL, 10);
+  }
+  if (parts < 1 || partmb < 1)
+  {
+    printf("error: invalid part count or part size\n");
+    return -1;
+  }
+  size_t partsz = partmb * 1048576;
+
+  LIBXML_TEST_VERSION
+
+  void *writebuffer = malloc(partsz);
+  if (writebuffer == NULL)
+  {
+    printf("error: failed to allocate write buffer\n");
+    return -1;
+  }
+  memset(writebuffer, 'x', partsz);
+
+  printf("%d parts of %zu MiB per block\n", parts, partmb);
+  printf("%10s %14s %10s\n", "inflight", "max_inflight", "MiB/s");
+  DAL_location maxloc = {.pod = 0, .block = 0, .cap = 0, .scatter = 0};
+  int depth;
+  for (depth = 1; depth <= MAXDEPTH; depth *= 2)
+  {
+    // parse our config, then limit the DAL to 'depth' parts in flight
+    xmlDoc *doc = xmlReadFile("./testing/s3_config.xml", NULL, XML_PARSE_NOBLANKS);
+    if (doc == NULL)
+    {
+      printf("error: could not parse file %s\n", "./testing/s3_config.xml");
+      return -1;
+    }
+    char inflightstr[32];
+    snprintf(inflightstr, sizeof(inflightstr), "%zu", depth * partsz);
+    xmlNewTextChild(xmlDocGetRootElement(doc), NULL, (xmlChar *)"max_inflight", (xmlChar *)inflightstr);
+    DAL dal = init_dal(xmlDocGetRootElement(doc), maxloc);
+    xmlFreeDoc(doc);
+    if (dal == NULL)
+    {
+      printf("error: failed to initialize DAL: %s\n", strerror(errno));
+      if (errno == ENONET)
+      {
+        return 0; // no server to benchmark against
+      }
+      return -1;
+    }
+    if (depth == 1 && dal->verify(dal->ctxt, CFG_FIX))
+    {
+      printf("error: failed to verify DAL buckets\n");
+      return -1;
+    }
+
+    struct timeval beg, end;
+    gettimeofday(&beg, NULL);
+    BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, maxloc, "bench_dal_s3_inflight");
+    if (block == NULL)
+    {
+      printf("error: failed to open block context for write: %s\n", strerror(errno));
+      return -1;
+    }
+    int i;
+    for (i = 0; i < parts; i++)
+    {
+      if (dal->put(block, writebuffer, partsz))
+      {
+        printf("error: put of part %d did not return expected value\n", i + 1);
+        dal->abort(block);
+        return -1;
+      }
+    }
+    if (dal->close(block))
+    {
+      printf("error: failed to close block write context: %s\n", strerror(errno));
+      return -1;
+    }
+    gettimeofday(&end, NULL);
+    printf("%10d %14s %10.1f\n", depth, inflightstr, (parts * partmb) / elapsed(&beg, &end));
+
+    if (dal->del(dal->ctxt, maxloc, "bench_dal_s3_inflight"))
+    {
+      printf("error: del failed!\n");
+      return -1;
+    }
+    if (dal->cleanup(dal))
+    {
+      printf("error: failed to cleanup DAL\n");
+      return -1;
+    }
+  }
+
+  free(writebuffer);
+  xmlCleanupParser();
+  return 0;
+}
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * S3 read-ahead benchmark
+ *
+ * Writes a single block via the S3 DAL described by ./testing/s3_config.xml ( typically a local
+ * S3-compatible server, such as MinIO ), then reads it back sequentially, once for each of several
+ * 'read_ahead' values, reporting throughput and get() latency.  Each pass runs beneath a timer DAL,
+ * which exports per-operation timing data to ./bench_dal_s3_readahead_TMP.<read_ahead> on cleanup
+ * ( see timing_hist.r ).
+ */
+
+#include "dal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/time.h>
+
+#define MAXWINDOW 8
+
+double elapsed(struct timeval *beg, struct timeval *end)
+{
+  return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+// Initialize a timer DAL, wrapping the configured S3 DAL with the given read_ahead value
+DAL bench_dal(size_t read_ahead, DAL_location maxloc)
+{
+  xmlDoc *s3doc = xmlReadFile("./testing/s3_config.xml", NULL, XML_PARSE_NOBLANKS);
+  if (s3doc == NULL)
+  {
+    printf("error: could not parse file %s\n", "./testing/s3_config.xml");
+    return NULL;
+  }
+  char valstr[64];
+  snprintf(valstr, sizeof(valstr), "%zu", read_ahead);
+  xmlNewTextChild(xmlDocGetRootElement(s3doc), NULL, (xmlChar *)"read_ahead", (xmlChar *)valstr);
+
+  xmlDoc *doc = xmlNewDoc((xmlChar *)"1.0");
+  xmlNode *root = xmlNewNode(NULL, (xmlChar *)"DAL");
+  xmlNewProp(root, (xmlChar *)"type", (xmlChar *)"timer");
+  xmlDocSetRootElement(doc, root);
+  xmlAddChild(root, xmlDocCopyNode(xmlDocGetRootElement(s3doc), doc, 1));
+  snprintf(valstr, sizeof(valstr), "./bench_dal_s3_readahead_TMP.%zu", read_ahead);
+  xmlNewTextChild(root, NULL, (xmlChar *)"dump_path", (xmlChar *)valstr);
+  xmlFreeDoc(s3doc);
+
+  DAL dal = init_dal(root, maxloc);
+  xmlFreeDoc(doc);
+  return dal;
+}
+
+int main(int argc, char **argv)
+{
+  size_t datamb = 64;
+  size_t getkb = 1024;
+  if (argc > 3)
+  {
+    printf("usage: %s [object_MiB [get_KiB]]\n", argv[0]);
+    return -1;
+  }
+  if (argc > 1)
+  {
+    datamb = strtoull(argv[1], NULL, 10);
+  }
+  if (argc > 2)
+  {
+    getkb = strtoull(argv[2], NULL, 10);
+  }
+  if (datamb < 5 || getkb < 1)
+  {
+    printf("error: invalid object size ( minimum of 5MiB ) or get size\n");
+    return -1;
+  }
+  size_t datasz = datamb * 1048576;
+  size_t getsz = getkb * 1024;
+  size_t partsz = 5 * 1048576; // minimum multipart upload part size
+
+  LIBXML_TEST_VERSION
+
+  char *writebuffer = malloc(datasz);
+  char *readbuffer = malloc(datasz);
+  if (writebuffer == NULL || readbuffer == NULL)
+  {
+    printf("error: failed to allocate data buffers\n");
+    return -1;
+  }
+  size_t i;
+  for (i = 0; i < datasz; i++)
+  {
+    writebuffer[i] = (char)(i % 251);
+  }
+
+  // write out our object
+  DAL_location maxloc = {.pod = 0, .block = 0, .cap = 0, .scatter = 0};
+  DAL dal = bench_dal(0, maxloc);
+  if (dal == NULL)
+  {
+    printf("error: failed to initialize DAL: %s\n", strerror(errno));
+    if (errno == ENONET)
+    {
+      return 0; // no server to benchmark against
+    }
+    return -1;
+  }
+  if (dal->verify(dal->ctxt, CFG_FIX))
+  {
+    printf("error: failed to verify DAL buckets\n");
+    return -1;
+  }
+  BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, maxloc, "bench_dal_s3_readahead");
+  if (block == NULL)
+  {
+    printf("error: failed to open block context for write: %s\n", strerror(errno));
+    return -1;
+  }
+  for (i = 0; i < datasz; i += partsz)
+  {
+    size_t putsz = (datasz - i < partsz) ? datasz - i : partsz;
+    if (dal->put(block, writebuffer + i, putsz))
+    {
+      printf("error: put at offset %zu did not return expected value\n", i);
+      dal->abort(block);
+      return -1;
+    }
+  }
+  if (dal->close(block))
+  {
+    printf("error: failed to close block write context: %s\n", strerror(errno));
+    return -1;
+  }
+  if (dal->cleanup(dal))
+  {
+    printf("error: failed to cleanup DAL\n");
+    return -1;
+  }
+
+  printf("%zu MiB object, read via %zu KiB gets\n", datamb, getkb);
+  printf("%12s %10s %14s %14s\n", "read_ahead", "MiB/s", "avg_get_usec", "max_get_usec");
+  int retval = 0;
+  int window;
+  for (window = 0; window <= MAXWINDOW && retval == 0; window = (window) ? window * 2 : 2)
+  {
+    dal = bench_dal(window * getsz, maxloc);
+    if (dal == NULL)
+    {
+      printf("error: failed to initialize DAL: %s\n", strerror(errno));
+      return -1;
+    }
+    block = dal->open(dal->ctxt, DAL_READ, maxloc, "bench_dal_s3_readahead");
+    if (block == NULL)
+    {
+      printf("error: failed to open block context for read: %s\n", strerror(errno));
+      return -1;
+    }
+    memset(readbuffer, 0, datasz);
+    double maxget = 0.0;
+    struct timeval beg, end, getbeg, getend;
+    gettimeofday(&beg, NULL);
+    for (i = 0; i < datasz; i += getsz)
+    {
+      size_t wantsz = (datasz - i < getsz) ? datasz - i : getsz;
+      gettimeofday(&getbeg, NULL);
+      ssize_t res = dal->get(block, readbuffer + i, wantsz, i);
+      gettimeofday(&getend, NULL);
+      if (res != wantsz)
+      {
+        printf("error: get at offset %zu returned %zd\n", i, res);
+        retval = -1;
+        break;
+      }
+      if (elapsed(&getbeg, &getend) > maxget)
+      {
+        maxget = elapsed(&getbeg, &getend);
+      }
+    }
+    gettimeofday(&end, NULL);
+    if (retval == 0 && memcmp(writebuffer, readbuffer, datasz))
+    {
+      printf("error: retrieved data does not match written!\n");
+      retval = -1;
+    }
+    if (retval == 0)
+    {
+      double total = elapsed(&beg, &end);
+      printf("%12zu %10.1f %14.1f %14.1f\n", window * getsz, datamb / total,
+             total * 1e6 / ((datasz + getsz - 1) / getsz), maxget * 1e6);
+    }
+    if (dal->close(block))
+    {
+      printf("error: failed to close block read context: %s\n", strerror(errno));
+      retval = -1;
+    }
+    if (window == MAXWINDOW || retval)
+    {
+      if (dal->del(dal->ctxt, maxloc, "bench_dal_s3_readahead"))
+      {
+        printf("error: del failed!\n");
+        retval = -1;
+      }
+    }
+    if (dal->cleanup(dal))
+    {
+      printf("error: failed to cleanup DAL\n");
+      retval = -1;
+    }
+  }
+
+  free(writebuffer);
+  free(readbuffer);
+  xmlCleanupParser();
+  return retval;
+}
@@ -63,17 +63,39 @@ int main(int argc, char **argv)
       printf("error: failed to allocate write buffer\n");
       return -1;
    }
+   int i;
+   for (i = 0; i < (10 * 1024); i++)
+   {
+      ((unsigned char *)writebuffer)[i] = (unsigned char)(i % 251);
+   }
    BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, maxloc, "");
    if (block == NULL)
    {
       printf("error: failed to open block context for write: %s\n", strerror(errno));
       return -1;
    }
-   if (dal->put(block, writebuffer, (10 * 1024)))
+   if (dal->put(block, writebuffer, (4 * 1024)))
    {
       printf("error: put did not return expected value\n");
       return -1;
    }
+   // the remainder of the block is written as a single vectored put
+   if (dal->putv == NULL || dal->io_batch < 1)
+   {
+      printf("error: posix DAL does not provide a vectored put\n");
+      return -1;
+   }
+   struct iovec iov[3];
+   for (i = 0; i < 3; i++)
+   {
+      iov[i].iov_base = writebuffer + ((4 + (2 * i)) * 1024);
+      iov[i].iov_len = (2 * 1024);
+   }
+   if (dal->putv(block, iov, 3))
+   {
+      printf("error: putv did not return expected value\n");
+      return -1;
+   }
    meta_info meta_val = { .N = 3, .E = 1, .O = 3, .partsz = 4096, .versz = 1048576, .blocksz = 10485760, .crcsum = 1234567, .totsz = 7654321 };
    if (dal->set_meta(block, &meta_val))
    {
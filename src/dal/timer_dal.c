@@ -999,12 +999,14 @@ DAL timer_dal_init(xmlNode *root, DAL_location max_loc)
   tdal->name = "timer";
   tdal->ctxt = (DAL_CTXT)dctxt;
   tdal->io_size = dctxt->under_dal->io_size;
+  tdal->io_batch = 1;
   tdal->verify = timer_verify;
   tdal->migrate = timer_migrate;
   tdal->open = timer_open;
   tdal->set_meta = timer_set_meta;
   tdal->get_meta = timer_get_meta;
   tdal->put = timer_put;
+  tdal->putv = NULL;
   tdal->get = timer_get;
   tdal->abort = timer_abort;
   tdal->close = timer_close;
@@ -20,6 +20,7 @@
 #include "general_include/numdigits.h"
 
 #include <time.h>
+#include <pthread.h>
 
 
 //   -------------   INTERNAL DEFINITIONS    -------------
@@ -41,6 +42,66 @@ typedef struct datastream_position_struct {
                             //   Note -- this changes per-file, within the same object ( recovFinfoLength differs )
 } DATASTREAM_POSITION;
 
+typedef struct datastream_prefetch_struct {
+   size_t      objno;       // stream object number of the prefetched object
+   char*       objname;     // name of the prefetched object ( NULL if this slot is unused )
+   ne_ctxt     nectxt;      // LibNE context used to open the object
+   ne_location location;    // location of the prefetched object
+   ne_erasure  erasure;     // erasure structure of the prefetched object
+   ne_mode     mode;        // mode used to open the object
+   pthread_t   thread;      // background thread performing the open
+   char        active;      // flag indicating an outstanding ( unjoined ) thread
+   ne_handle   handle;      // resulting object handle ( NULL if the open failed )
+} DATASTREAM_PREFETCH;
+
+typedef struct datastream_writebehind_struct {
+   ne_handle   handle;      // handle of the object being closed
+   FTAG        ftag;        // FTAG value associated with the object ( for rebuild marker creation )
+   RTAG        rtag;        // object status, populated by the close
+   int         closeres;    // result of the ne_close() of the object
+   STREAMFILE* files;       // files to be completed once the object has been closed
+   size_t      filecnt;     // count of 'files' entries
+   pthread_t   thread;      // background thread performing the close
+   char        active;      // flag indicating an outstanding ( unjoined ) thread
+} DATASTREAM_WRITEBEHIND;
+
+#define BATCH_THREADS 8  // metadata threads of each datastream_createbatch() call
+#define BATCH_WINDOW 64  // max entries in flight ( established ahead of, or awaiting link behind, the stream )
+
+typedef enum {
+   BATCHSLOT_FREE = 0,  // slot is available for the next entry
+   BATCHSLOT_PREP,      // reference file of the entry is being established
+   BATCHSLOT_READY,     // reference file established, awaiting placement within the stream
+   BATCHSLOT_FAILED,    // reference file could not be established
+   BATCHSLOT_PLACED     // entry is installed into the stream, awaiting ( or undergoing ) link
+} DATASTREAM_BATCHSLOT_STATE;
+
+typedef struct datastream_batchslot_struct {
+   DATASTREAM_BATCHSLOT_STATE state;
+   STREAMFILE     file;    // file of the entry ( meta handle passes to the stream on install )
+   RECOVERY_FINFO finfo;   // recovery info of the entry ( passes to the stream on install )
+   char*          rpath;   // reference path of the entry
+   int            error;   // errno value of a failed reference file creation
+} DATASTREAM_BATCHSLOT;
+
+typedef struct datastream_batch_struct {
+   pthread_mutex_t lock;        // protects all slot states and counters
+   pthread_cond_t  update;      // signaled upon any slot state or counter change
+   pthread_mutex_t refdirlock;  // serializes reference dir creation ( which alters the process umask )
+   struct datastream_struct shadow; // read-only stream values, for use by batch threads
+   MDAL_CTXT       ctxt;        // MDAL_CTXT of the target NS
+   const DATASTREAM_BATCHENT* entries;
+   size_t          count;       // count of 'entries'
+   size_t          basefileno;  // file number of the first entry
+   size_t          nextprep;    // index of the next entry to have its reference file established
+   size_t          nextlink;    // index of the next entry to be linked
+   size_t          linkable;    // entries below this index are ready to be linked
+   size_t          linking;     // count of links in progress
+   int             linkerror;   // errno value of the first failed link ( zero, if none )
+   char            abort;       // flag indicating that batch threads should exit
+   DATASTREAM_BATCHSLOT slots[BATCH_WINDOW];
+} DATASTREAM_BATCH;
+
 
 //   -------------   INTERNAL FUNCTIONS    -------------
 
@@ -98,6 +159,175 @@ char* repackmarkertgt( const char* rpath, FTAG* ftag, const marfs_ms* ms ) {
    return rmarkstr;
 }
 
+/**
+ * Identify the ne_mode with which data objects of the given READ DATASTREAM should be opened
+ * @param DATASTREAM stream : READ DATASTREAM to identify the mode of
+ * @return ne_mode : Mode value to be passed to ne_open()
+ */
+ne_mode readmode(DATASTREAM stream) {
+   if (stream->randomread) {
+      return (NE_RDONLY | NE_RANDOM);
+   }
+   return (stream->lazyverify) ? (NE_RDALL | NE_LAZYVERIFY) : NE_RDALL;
+}
+
+/**
+ * Background thread function, opening a single read-ahead data object
+ * @param void* arg : Reference to the DATASTREAM_PREFETCH slot to be populated
+ * @return void* : Always NULL
+ */
+void* prefetch_thread(void* arg) {
+   DATASTREAM_PREFETCH* pf = (DATASTREAM_PREFETCH*)arg;
+   LOG(LOG_INFO, "Prefetching object %zu: \"%s\"\n", pf->objno, pf->objname);
+   pf->handle = ne_open(pf->nectxt, pf->objname, pf->location, pf->erasure, pf->mode);
+   if (pf->handle == NULL) {
+      // not necessarily an error, as we may have speculated beyond the end of the stream
+      LOG(LOG_INFO, "Failed to prefetch object %zu: \"%s\"\n", pf->objno, pf->objname);
+   }
+   return NULL;
+}
+
+/**
+ * Discard the given read-ahead slot, aborting any prefetched object handle
+ * @param DATASTREAM_PREFETCH* pf : Reference to the slot to be discarded
+ */
+void prefetch_discard(DATASTREAM_PREFETCH* pf) {
+   if (pf->active) {
+      pthread_join(pf->thread, NULL);
+      pf->active = 0;
+   }
+   if (pf->handle && ne_abort(pf->handle)) {
+      LOG(LOG_WARNING, "Failed to abort prefetched handle of object %zu\n", pf->objno);
+   }
+   pf->handle = NULL;
+   if (pf->objname) {
+      free(pf->objname);
+      pf->objname = NULL;
+   }
+}
+
+/**
+ * Retrieve a prefetched handle for the given object from the read-ahead slots of a READ stream
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param const char* objname : Name of the target data object
+ * @return ne_handle : Prefetched object handle, or NULL if none is available
+ */
+ne_handle prefetch_claim(DATASTREAM stream, const char* objname) {
+   size_t pfindex = 0;
+   for (; pfindex < stream->prefetchcnt; pfindex++) {
+      DATASTREAM_PREFETCH* pf = stream->prefetch + pfindex;
+      if (pf->objname == NULL || strcmp(pf->objname, objname)) {
+         continue;
+      }
+      // wait for the open to complete, and take ownership of the result
+      if (pf->active) {
+         pthread_join(pf->thread, NULL);
+         pf->active = 0;
+      }
+      ne_handle handle = pf->handle;
+      pf->handle = NULL;
+      prefetch_discard(pf);
+      return handle;
+   }
+   return NULL;
+}
+
+/**
+ * Begin background opens of the data objects following the current object of a READ stream
+ * NOTE -- Failures here are never fatal; at worst, subsequent objects are opened on demand.
+ * @param DATASTREAM stream : Current DATASTREAM
+ */
+void prefetch_schedule(DATASTREAM stream) {
+   // shorthand references
+   const marfs_ds* ds = &(stream->ns->prepo->datascheme);
+   const FTAG* curftag = &(stream->files[stream->curfile].ftag);
+   if (ds->readahead == 0) {
+      return; // read-ahead is disabled
+   }
+   if (stream->prefetch == NULL) {
+      // NOTE -- this allocation is never resized, as running threads reference its slots
+      stream->prefetch = calloc(ds->readahead, sizeof(DATASTREAM_PREFETCH));
+      if (stream->prefetch == NULL) {
+         LOG(LOG_WARNING, "Failed to allocate %zu read-ahead slots\n", ds->readahead);
+         return;
+      }
+      stream->prefetchcnt = ds->readahead;
+   }
+   // identify the range of objects worth prefetching
+   size_t lastobj = stream->objno + stream->prefetchcnt;
+   if (curftag->endofstream) {
+      // no object beyond the final object of this file can exist
+      size_t finalobj = datastream_filebounds(curftag);
+      if (lastobj > finalobj) {
+         lastobj = finalobj;
+      }
+   }
+   // otherwise, we speculate that the stream continues beyond the current file
+   FTAG tgttag = *curftag;
+   tgttag.offset = stream->recoveryheaderlen;
+   // discard any slots which have fallen out of that range, or which reference another stream
+   size_t pfindex = 0;
+   for (; pfindex < stream->prefetchcnt; pfindex++) {
+      DATASTREAM_PREFETCH* pf = stream->prefetch + pfindex;
+      if (pf->objname == NULL) {
+         continue;
+      }
+      char keep = 0;
+      if (pf->objno > stream->objno && pf->objno <= lastobj) {
+         char* objname = NULL;
+         ne_erasure erasure;
+         ne_location location;
+         tgttag.objno = pf->objno;
+         if (datastream_objtarget(&(tgttag), ds, &(objname), &(erasure), &(location)) == 0) {
+            if (strcmp(objname, pf->objname) == 0) {
+               keep = 1;
+            }
+            free(objname);
+         }
+      }
+      if (!(keep)) {
+         LOG(LOG_INFO, "Discarding stale prefetch of object %zu\n", pf->objno);
+         prefetch_discard(pf);
+      }
+   }
+   // launch opens of any objects not yet covered
+   size_t objno = stream->objno + 1;
+   for (; objno <= lastobj; objno++) {
+      DATASTREAM_PREFETCH* freeslot = NULL;
+      for (pfindex = 0; pfindex < stream->prefetchcnt; pfindex++) {
+         DATASTREAM_PREFETCH* pf = stream->prefetch + pfindex;
+         if (pf->objname == NULL) {
+            if (freeslot == NULL) {
+               freeslot = pf;
+            }
+         }
+         else if (pf->objno == objno) {
+            break;
+         }
+      }
+      if (pfindex < stream->prefetchcnt || freeslot == NULL) {
+         continue; // already prefetched, or no room remaining
+      }
+      tgttag.objno = objno;
+      if (datastream_objtarget(&(tgttag), ds, &(freeslot->objname), &(freeslot->erasure), &(freeslot->location))) {
+         LOG(LOG_WARNING, "Failed to identify target of object %zu for prefetch\n", objno);
+         freeslot->objname = NULL;
+         return;
+      }
+      freeslot->objno = objno;
+      freeslot->nectxt = ds->nectxt;
+      freeslot->mode = readmode(stream);
+      freeslot->handle = NULL;
+      if (pthread_create(&(freeslot->thread), NULL, prefetch_thread, freeslot)) {
+         LOG(LOG_WARNING, "Failed to launch prefetch thread for object %zu\n", objno);
+         free(freeslot->objname);
+         freeslot->objname = NULL;
+         return;
+      }
+      freeslot->active = 1;
+   }
+}
+
 /**
  * Frees the provided stream, aborting the datahandle and closing all metahandles
  * @param DATASTREAM stream : DATASTREAM to be freed
@@ -109,6 +339,32 @@ void freestream(DATASTREAM stream) {
    if (stream->datahandle && ne_abort(stream->datahandle)) {
       LOG(LOG_WARNING, "Failed to abort stream datahandle\n");
    }
+   // wait out any write-behind close, abandoning the files awaiting it
+   if (stream->writebehind) {
+      DATASTREAM_WRITEBEHIND* wb = stream->writebehind;
+      if (wb->active) {
+         pthread_join(wb->thread, NULL);
+      }
+      rtag_free( &(wb->rtag) );
+      size_t fileindex = 0;
+      for (; fileindex < wb->filecnt; fileindex++) {
+         if (wb->files[fileindex].metahandle && ms->mdal->close(wb->files[fileindex].metahandle)) {
+            LOG(LOG_WARNING, "Failed to close meta handle for write-behind file %zu\n", fileindex);
+         }
+      }
+      if (wb->files) {
+         free(wb->files);
+      }
+      free(wb);
+   }
+   // abort any prefetched data handles
+   if (stream->prefetch) {
+      size_t pfindex = 0;
+      for (; pfindex < stream->prefetchcnt; pfindex++) {
+         prefetch_discard(stream->prefetch + pfindex);
+      }
+      free(stream->prefetch);
+   }
    // free any string elements
    if (stream->ctag) {
       free(stream->ctag);
@@ -382,21 +638,26 @@ int genrecoveryinfo(DATASTREAM stream, RECOVERY_FINFO* finfo, STREAMFILE* file,
 }
 
 /**
- * Create a new file at the current ( 'curfile' ) STREAMFILE reference position
+ * Establish the reference file of a new file, without yet placing it within the stream
+ * NOTE -- This function modifies no stream state, and may be called from threads other
+ *         than the stream owner ( see datastream_createbatch() )
  * @param DATASTREAM stream : Current DATASTREAM
  * @param const char* path : Path of the file to be created
  * @param MDAL_CTXT ctxt : Current MDAL_CTXT
  * @param mode_t mode : Mode of the file to be created
- * @return int : Zero on success, or -1 on failure
+ * @param size_t fileno : File number of the new file
+ * @param char mkrefdirs : Flag indicating that missing reference dirs should be created
+ * @param STREAMFILE* newfile : Reference to the STREAMFILE to be populated
+ * @param RECOVERY_FINFO* newfinfo : Reference to the RECOVERY_FINFO to be populated
+ * @return char* : Reference path of the new file, or NULL on failure
+ *                 NOTE -- returned path must be freed by caller
  */
-int create_new_file(DATASTREAM stream, const char* path, MDAL_CTXT ctxt, mode_t mode) {
-   // NOTE -- it is the responsibility of the caller to set curfile/fileno/objno/offset
-   //         values to the appropraite start positions prior to calling
+char* prepfile(DATASTREAM stream, const char* path, MDAL_CTXT ctxt, mode_t mode, size_t fileno, char mkrefdirs, STREAMFILE* newfile, RECOVERY_FINFO* newfinfo) {
    // populate shorthand references
    const marfs_ms* ms = &(stream->ns->prepo->metascheme);
    const marfs_ds* ds = &(stream->ns->prepo->datascheme);
    // construct a reference struct for our new file
-   struct streamfile_struct newfile =
+   struct streamfile_struct tmpfile =
    {
       .metahandle = NULL,
       .ftag.majorversion = FTAG_CURRENT_MAJORVERSION,
@@ -408,9 +669,9 @@ int create_new_file(DATASTREAM stream, const char* path, MDAL_CTXT ctxt, mode_t
       .ftag.refbreadth = ms->refbreadth,
       .ftag.refdepth = ms->refdepth,
       .ftag.refdigits = ms->refdigits,
-      .ftag.fileno = stream->fileno,
-      .ftag.objno = stream->objno,   // potentially modified below
-      .ftag.offset = stream->offset, // potentially modified below
+      .ftag.fileno = fileno,
+      .ftag.objno = 0,  // set by placefile()
+      .ftag.offset = 0, // set by placefile()
       .ftag.endofstream = 0,
       .ftag.protection = ds->protection,
       .ftag.bytes = 0,
@@ -423,20 +684,21 @@ int create_new_file(DATASTREAM stream, const char* path, MDAL_CTXT ctxt, mode_t
       .times[1].tv_nsec = 0,
       .dotimes = 1
    };
+   *newfile = tmpfile;
 
    // establish a reference path for the new file
-   char* newrpath = datastream_genrpath(&(newfile.ftag), stream->ns->prepo->metascheme.reftable, ms->mdal, ctxt);
+   char* newrpath = datastream_genrpath(&(newfile->ftag), ms->reftable, (mkrefdirs) ? ms->mdal : NULL, ctxt);
    if (newrpath == NULL) {
       LOG(LOG_ERR, "Failed to identify reference path for stream\n");
       if (errno == EBADFD) {
          errno = ENOMSG;
       } // don't allow our reserved EBADFD value
-      return -1;
+      return NULL;
    }
 
    // create the reference file, ensuring we don't collide with an existing reference
-   newfile.metahandle = ms->mdal->openref(ctxt, newrpath, O_CREAT | O_EXCL | O_WRONLY, mode);
-   if (newfile.metahandle == NULL) {
+   newfile->metahandle = ms->mdal->openref(ctxt, newrpath, O_CREAT | O_EXCL | O_WRONLY, mode);
+   if (newfile->metahandle == NULL) {
       LOG(LOG_ERR, "Failed to create reference meta file: \"%s\"\n", newrpath);
       // a BUSY error is more indicative of the real problem
       if (errno == EEXIST) {
@@ -447,91 +709,180 @@ int create_new_file(DATASTREAM stream, const char* path, MDAL_CTXT ctxt, mode_t
          errno = ENOMSG;
       }
       free(newrpath);
-      return -1;
+      return NULL;
    }
 
    // identify file recovery info
-   RECOVERY_FINFO newfinfo;
-   if (genrecoveryinfo(stream, &(newfinfo), &(newfile), path)) {
+   if (genrecoveryinfo(stream, newfinfo, newfile, path)) {
       LOG(LOG_ERR, "Failed to populate recovery info for file: \"%s\"\n", path);
+      ms->mdal->close(newfile->metahandle);
+      newfile->metahandle = NULL;
       ms->mdal->unlinkref(ctxt, newrpath);
       free(newrpath);
       if (errno == EBADFD) {
          errno = ENOMSG;
       } // don't allow our reserved EBADFD value
-      return -1;
+      return NULL;
+   }
+
+   return newrpath;
+}
+
+/**
+ * Abandon a file established by prepfile(), which has yet to be installed into the stream
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param MDAL_CTXT ctxt : Current MDAL_CTXT
+ * @param char* rpath : Reference path of the file ( freed by this func )
+ * @param STREAMFILE* file : Reference to the STREAMFILE of the file
+ * @param RECOVERY_FINFO* finfo : Reference to the RECOVERY_FINFO of the file
+ */
+void abandonfile(DATASTREAM stream, MDAL_CTXT ctxt, char* rpath, STREAMFILE* file, RECOVERY_FINFO* finfo) {
+   // shorthand references
+   const marfs_ms* ms = &(stream->ns->prepo->metascheme);
+   int origerrno = errno; // cleanup shouldn't alter the reported error
+   if (file->metahandle) {
+      ms->mdal->close(file->metahandle);
+      file->metahandle = NULL;
    }
+   ms->mdal->unlinkref(ctxt, rpath);
+   free(rpath);
+   if (finfo->path) {
+      free(finfo->path);
+      finfo->path = NULL;
+   }
+   errno = origerrno;
+}
+
+/**
+ * Position a file established by prepfile() at the current offset of the stream,
+ * shifting it to a fresh data object, if necessary
+ * NOTE -- it is the responsibility of the caller to set curfile/fileno/objno/offset
+ *         values to the appropraite start positions prior to calling
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param STREAMFILE* newfile : Reference to the STREAMFILE to be positioned
+ * @return int : Zero on success, or -1 on failure
+ */
+int placefile(DATASTREAM stream, STREAMFILE* newfile) {
+   newfile->ftag.objno = stream->objno;
+   newfile->ftag.offset = stream->offset;
 
    // ensure the recovery info size is compatible with the current object size
-   if (newfile.ftag.objsize && (stream->recoveryheaderlen + newfile.ftag.recoverybytes) >= newfile.ftag.objsize) {
+   if (newfile->ftag.objsize && (stream->recoveryheaderlen + newfile->ftag.recoverybytes) >= newfile->ftag.objsize) {
       LOG(LOG_ERR, "Recovery info size of new file is incompatible with current object size\n");
-      ms->mdal->unlinkref(ctxt, newrpath);
-      free(newrpath);
       errno = ENAMETOOLONG; // this is most likely an issue with path length
       return -1;
    }
 
    // ensure that the current object still has space remaining for this file
-   if (newfile.ftag.objsize && (newfile.ftag.objsize - stream->offset) < newfile.ftag.recoverybytes) {
+   if (newfile->ftag.objsize && (newfile->ftag.objsize - stream->offset) < newfile->ftag.recoverybytes) {
       // we're too far into the current obj to fit any more data
       LOG(LOG_INFO, "Shifting to new object, as current can't hold recovery info\n");
-      newfile.ftag.objno++;
-      newfile.ftag.offset = stream->recoveryheaderlen;
+      newfile->ftag.objno++;
+      newfile->ftag.offset = stream->recoveryheaderlen;
    }
-   else if (newfile.ftag.objfiles && stream->curfile >= newfile.ftag.objfiles) {
+   else if (newfile->ftag.objfiles && stream->curfile >= newfile->ftag.objfiles) {
       // there are too many files in the current obj to fit this one
       LOG(LOG_INFO, "Shifting to new object, as current can't hold another file\n");
-      newfile.ftag.objno++;
-      newfile.ftag.offset = stream->recoveryheaderlen;
+      newfile->ftag.objno++;
+      newfile->ftag.offset = stream->recoveryheaderlen;
+   }
+
+   return 0;
+}
+
+/**
+ * Install a positioned file at the current ( 'curfile' ) STREAMFILE reference position
+ * NOTE -- On success, the stream takes ownership of the file's meta handle and recovery
+ *         info path.  On failure, the stream is unmodified.
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param STREAMFILE* newfile : Reference to the STREAMFILE to be installed
+ * @param RECOVERY_FINFO* newfinfo : Reference to the RECOVERY_FINFO of that file
+ * @return int : Zero on success, or -1 on failure
+ */
+int installfile(DATASTREAM stream, STREAMFILE* newfile, RECOVERY_FINFO* newfinfo) {
+   // shorthand references
+   const marfs_ds* ds = &(stream->ns->prepo->datascheme);
+   // check if the current stream has space for this new file ref
+   if (stream->curfile >= stream->filealloc) {
+      size_t origalloc = stream->filealloc;
+      stream->filealloc = allocfiles(&(stream->files), stream->filealloc, ds->objfiles + 1);
+      if (stream->filealloc == 0) {
+         LOG(LOG_ERR, "Failed to expand file list allocation\n");
+         stream->filealloc = origalloc;
+         if (errno == EBADFD) {
+            errno = ENOMSG;
+         } // don't allow our reserved EBADFD value
+         return -1;
+      }
+   }
+
+   // update the stream with new file information
+   stream->files[stream->curfile] = *newfile;
+   if (stream->finfo.path) {
+      free(stream->finfo.path);
+   }
+   stream->finfo = *newfinfo;
+   stream->fileno = newfile->ftag.fileno;
+   stream->objno = newfile->ftag.objno;
+   stream->offset = newfile->ftag.offset;
+
+   return 0;
+}
+
+/**
+ * Create a new file at the current ( 'curfile' ) STREAMFILE reference position
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param const char* path : Path of the file to be created
+ * @param MDAL_CTXT ctxt : Current MDAL_CTXT
+ * @param mode_t mode : Mode of the file to be created
+ * @return int : Zero on success, or -1 on failure
+ */
+int create_new_file(DATASTREAM stream, const char* path, MDAL_CTXT ctxt, mode_t mode) {
+   // NOTE -- it is the responsibility of the caller to set curfile/fileno/objno/offset
+   //         values to the appropraite start positions prior to calling
+   // establish the reference file
+   STREAMFILE newfile;
+   RECOVERY_FINFO newfinfo;
+   char* newrpath = prepfile(stream, path, ctxt, mode, stream->fileno, 1, &(newfile), &(newfinfo));
+   if (newrpath == NULL) {
+      LOG(LOG_ERR, "Failed to establish reference file for: \"%s\"\n", path);
+      return -1;
+   }
+
+   // position the file within the stream
+   if (placefile(stream, &(newfile))) {
+      LOG(LOG_ERR, "Failed to position new file within the stream: \"%s\"\n", path);
+      abandonfile(stream, ctxt, newrpath, &(newfile), &(newfinfo));
+      return -1;
    }
 
    // attach updated ftag value to the new file
    if (putftag(stream, &(newfile))) {
       LOG(LOG_ERR, "Failed to initialize FTAG value on target file\n");
-      ms->mdal->unlinkref(ctxt, newrpath);
-      free(newrpath);
       if (errno == EBADFD) {
          errno = ENOMSG;
       } // don't allow our reserved EBADFD value
+      abandonfile(stream, ctxt, newrpath, &(newfile), &(newfinfo));
       return -1;
    }
 
    // link the new file into the user namespace
    if (linkfile(stream, newrpath, path, ctxt)) {
       LOG(LOG_ERR, "Failed to link reference file to target user path: \"%s\"\n", path);
-      ms->mdal->unlinkref(ctxt, newrpath);
-      free(newrpath);
       if (errno == EBADFD) {
          errno = ENOMSG;
       } // don't allow our reserved EBADFD value
+      abandonfile(stream, ctxt, newrpath, &(newfile), &(newfinfo));
       return -1;
    }
 
-   // check if the current stream has space for this new file ref
-   if (stream->curfile >= stream->filealloc) {
-      stream->filealloc = allocfiles(&(stream->files), stream->filealloc, ds->objfiles + 1);
-      if (stream->filealloc == 0) {
-         LOG(LOG_ERR, "Failed to expand file list allocation\n");
-         stream->filealloc = stream->curfile - 1;
-         ms->mdal->unlinkref(ctxt, newrpath);
-         free(newrpath);
-         if (errno == EBADFD) {
-            errno = ENOMSG;
-         } // don't allow our reserved EBADFD value
-         return -1;
-      }
-   }
-   free(newrpath); // finally done with rpath
-
    // update the stream with new file information
-   stream->files[stream->curfile] = newfile;
-   if (stream->finfo.path) {
-      free(stream->finfo.path);
+   if (installfile(stream, &(newfile), &(newfinfo))) {
+      LOG(LOG_ERR, "Failed to install new file into the stream: \"%s\"\n", path);
+      abandonfile(stream, ctxt, newrpath, &(newfile), &(newfinfo));
+      return -1;
    }
-   stream->finfo = newfinfo;
-   stream->fileno = newfile.ftag.fileno;
-   stream->objno = newfile.ftag.objno;
-   stream->offset = newfile.ftag.offset;
+   free(newrpath); // finally done with rpath
 
    return 0;
 }
@@ -945,8 +1296,14 @@ int open_current_obj(DATASTREAM stream) {
 
    // open a handle for the new object
    if (stream->type == READ_STREAM) {
-      LOG(LOG_INFO, "Opening object for READ: \"%s\"\n", objname);
-      stream->datahandle = ne_open(ds->nectxt, objname, location, erasure, NE_RDALL);
+      stream->datahandle = prefetch_claim(stream, objname);
+      if (stream->datahandle) {
+         LOG(LOG_INFO, "Using prefetched READ handle: \"%s\"\n", objname);
+      }
+      else {
+         LOG(LOG_INFO, "Opening object for READ: \"%s\"\n", objname);
+         stream->datahandle = ne_open(ds->nectxt, objname, location, erasure, readmode(stream));
+      }
    }
    else {
       if (stream->type == CREATE_STREAM  ||  stream->type == REPACK_STREAM) {
@@ -982,6 +1339,8 @@ int open_current_obj(DATASTREAM stream) {
             return -1;
          }
       }
+      // begin opening the objects which follow this one
+      prefetch_schedule(stream);
    }
    else {
       // our offset value should match the recovery header length
@@ -1031,31 +1390,20 @@ int open_current_obj(DATASTREAM stream) {
 }
 
 /**
- * Close the current DATASTERAM object reference, potentially populating a rebuild string
+ * Complete the close of a DATASTREAM data object, populating a rebuild marker if the object was
+ * synced with errors
  * @param DATASTREAM stream : Current DATASTREAM
- * @param FTAG* curftag : Reference to the FTAG value associated with the current object
+ * @param FTAG* curftag : Reference to the FTAG value associated with the closed object
  *                        ( used to generate the rebuild marker path )
  * @param MDAL_CTXT mdalctxt : Optional reference to an MDAL_CTXT for the current NS
  *                             ( to avoid generating a new one for rebuild marker creation )
+ * @param RTAG rtag : Object status, as populated by ne_close()
+ *                    NOTE -- internal arrays of this RTAG will be freed by this func
+ * @param int closeres : Result of the ne_close() of the object
  * @return int : Zero on success, or -1 on failure
  */
-int close_current_obj(DATASTREAM stream, FTAG* curftag, MDAL_CTXT mdalctxt) {
-   RTAG rtag;
-   bzero( &(rtag), sizeof(RTAG) );
+int closeout_obj(DATASTREAM stream, FTAG* curftag, MDAL_CTXT mdalctxt, RTAG rtag, int closeres) {
    MDAL mdal = stream->ns->prepo->metascheme.mdal;
-   // set a stripewidth and allocate the rtag internal arrays
-   rtag.majorversion = RTAG_CURRENT_MAJORVERSION;
-   rtag.minorversion = RTAG_CURRENT_MINORVERSION;
-   rtag.stripewidth = curftag->protection.N + curftag->protection.E;
-   if ( rtag_alloc( &(rtag) ) ) {
-      LOG(LOG_ERR, "Failed to allocate data object status arrays\n");
-      return -1;
-   }
-   int closeres = 0;
-   if (stream->datahandle != NULL) {
-      closeres = ne_close(stream->datahandle, NULL, &(rtag.stripestate));
-      stream->datahandle = NULL; // never reattempt this process
-   }
    if (closeres > 0) {
       // object synced, but with errors
 
@@ -1315,6 +1663,34 @@ int close_current_obj(DATASTREAM stream, FTAG* curftag, MDAL_CTXT mdalctxt) {
    return 0;
 }
 
+/**
+ * Close the current DATASTERAM object reference, potentially populating a rebuild string
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param FTAG* curftag : Reference to the FTAG value associated with the current object
+ *                        ( used to generate the rebuild marker path )
+ * @param MDAL_CTXT mdalctxt : Optional reference to an MDAL_CTXT for the current NS
+ *                             ( to avoid generating a new one for rebuild marker creation )
+ * @return int : Zero on success, or -1 on failure
+ */
+int close_current_obj(DATASTREAM stream, FTAG* curftag, MDAL_CTXT mdalctxt) {
+   RTAG rtag;
+   bzero( &(rtag), sizeof(RTAG) );
+   // set a stripewidth and allocate the rtag internal arrays
+   rtag.majorversion = RTAG_CURRENT_MAJORVERSION;
+   rtag.minorversion = RTAG_CURRENT_MINORVERSION;
+   rtag.stripewidth = curftag->protection.N + curftag->protection.E;
+   if ( rtag_alloc( &(rtag) ) ) {
+      LOG(LOG_ERR, "Failed to allocate data object status arrays\n");
+      return -1;
+   }
+   int closeres = 0;
+   if (stream->datahandle != NULL) {
+      closeres = ne_close(stream->datahandle, NULL, &(rtag.stripestate));
+      stream->datahandle = NULL; // never reattempt this process
+   }
+   return closeout_obj(stream, curftag, mdalctxt, rtag, closeres);
+}
+
 /**
  * Generate a new DATASTREAM of the given type and the given initial target file
  * @param STREAM_TYPE type : Type of the DATASTREAM to be created
@@ -1356,6 +1732,11 @@ DATASTREAM genstream(STREAM_TYPE type, const char* path, char rpathflag, marfs_p
    stream->offset = 0; // redefined below
    stream->excessoffset = 0;
    stream->datahandle = NULL;
+   stream->prefetch = NULL;
+   stream->prefetchcnt = 0;
+   stream->lazyverify = 0;
+   stream->randomread = 0;
+   stream->writebehind = NULL;
    stream->files = NULL; // redefined below
    stream->curfile = 0;
    stream->filealloc = 0; // redefined below
@@ -1920,6 +2301,288 @@ int completefile(DATASTREAM stream, STREAMFILE* file) {
    return 0;
 }
 
+/**
+ * Background thread function, closing a single write-behind data object
+ * @param void* arg : Reference to the DATASTREAM_WRITEBEHIND state of the object
+ * @return void* : Always NULL
+ */
+void* writebehind_thread(void* arg) {
+   DATASTREAM_WRITEBEHIND* wb = (DATASTREAM_WRITEBEHIND*)arg;
+   LOG(LOG_INFO, "Closing object %zu in the background\n", wb->ftag.objno);
+   wb->closeres = ne_close(wb->handle, NULL, &(wb->rtag.stripestate));
+   wb->handle = NULL;
+   return NULL;
+}
+
+/**
+ * Wait for any outstanding write-behind object close of the given DATASTREAM, then complete
+ * all files which were awaiting that close
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param MDAL_CTXT mdalctxt : Optional reference to an MDAL_CTXT for the current NS
+ *                             ( to avoid generating a new one for rebuild marker creation )
+ * @return int : Zero on success, or -1 on failure
+ *    NOTE -- On failure, the stream should be considered unusable.  All files which were
+ *            awaiting the close will have been left in an incomplete state.
+ */
+int writebehind_reap(DATASTREAM stream, MDAL_CTXT mdalctxt) {
+   DATASTREAM_WRITEBEHIND* wb = stream->writebehind;
+   if (wb == NULL) {
+      return 0; // nothing outstanding
+   }
+   stream->writebehind = NULL;
+   if (wb->active) {
+      pthread_join(wb->thread, NULL);
+   }
+   int retval = 0;
+   if (closeout_obj(stream, &(wb->ftag), mdalctxt, wb->rtag, wb->closeres)) {
+      LOG(LOG_ERR, "Write-behind close failure for object %zu\n", wb->ftag.objno);
+      retval = -1;
+   }
+   // complete all files stored within the closed object
+   const marfs_ms* ms = &(stream->ns->prepo->metascheme);
+   size_t fileindex = 0;
+   for (; fileindex < wb->filecnt; fileindex++) {
+      STREAMFILE* compfile = wb->files + fileindex;
+      if (retval == 0) {
+         LOG(LOG_INFO, "Completing file %zu\n", compfile->ftag.fileno);
+         if (completefile(stream, compfile)) {
+            LOG(LOG_ERR, "Failed to complete file %zu\n", compfile->ftag.fileno);
+            retval = -1;
+         }
+      }
+      else if (compfile->metahandle && ms->mdal->close(compfile->metahandle)) {
+         LOG(LOG_WARNING, "Failed to close meta handle for file %zu\n", compfile->ftag.fileno);
+      }
+      compfile->metahandle = NULL;
+   }
+   if (wb->files) {
+      free(wb->files);
+   }
+   free(wb);
+   return retval;
+}
+
+/**
+ * Close the current data object of a writing DATASTREAM, and complete all files preceding
+ * the current one ( shifting the current file to the front of the file list )
+ * NOTE -- If write-behind is enabled for the stream's repo, the object close and file
+ *         completions will instead proceed asynchronously.  Any resulting error will be
+ *         reported by the next transition, seek, release, or close of the stream.
+ * @param DATASTREAM stream : Current DATASTREAM
+ * @param FTAG* curftag : Reference to the FTAG value associated with the current object
+ * @param MDAL_CTXT mdalctxt : Optional reference to an MDAL_CTXT for the current NS
+ * @return int : Zero on success, or -1 on failure
+ *    NOTE -- On failure, the stream should be considered unusable.
+ */
+int transition_obj(DATASTREAM stream, FTAG* curftag, MDAL_CTXT mdalctxt) {
+   const marfs_ds* ds = &(stream->ns->prepo->datascheme);
+   // only a single write-behind close may be outstanding
+   if (writebehind_reap(stream, mdalctxt)) {
+      return -1;
+   }
+   // attempt to setup a write-behind close of the current object
+   DATASTREAM_WRITEBEHIND* wb = NULL;
+   if (ds->writebehind && stream->datahandle != NULL) {
+      wb = calloc(1, sizeof(DATASTREAM_WRITEBEHIND));
+      if (wb != NULL) {
+         wb->rtag.majorversion = RTAG_CURRENT_MAJORVERSION;
+         wb->rtag.minorversion = RTAG_CURRENT_MINORVERSION;
+         wb->rtag.stripewidth = curftag->protection.N + curftag->protection.E;
+         if (stream->curfile) {
+            wb->files = malloc(sizeof(STREAMFILE) * stream->curfile);
+         }
+         if (rtag_alloc(&(wb->rtag)) || (stream->curfile && wb->files == NULL)) {
+            rtag_free(&(wb->rtag));
+            if (wb->files) {
+               free(wb->files);
+            }
+            free(wb);
+            wb = NULL;
+         }
+      }
+      if (wb == NULL) {
+         LOG(LOG_WARNING, "Failed to allocate write-behind state, closing object %zu synchronously\n",
+            curftag->objno);
+      }
+   }
+   if (wb == NULL) {
+      // close the current object
+      if (close_current_obj(stream, curftag, mdalctxt)) {
+         return -1;
+      }
+      // mark all previous files as complete
+      char abortflag = 0;
+      size_t curfilepos = stream->curfile;
+      while (stream->curfile) {
+         stream->curfile--;
+         if (completefile(stream, stream->files + stream->curfile)) {
+            LOG(LOG_ERR, "Failed to complete file %zu\n",
+               (stream->files + stream->curfile)->ftag.fileno);
+            abortflag = 1;
+         }
+      }
+      // shift the current file reference to the front of the list
+      stream->files[0] = stream->files[curfilepos];
+      return (abortflag) ? -1 : 0;
+   }
+   // hand off the current object, along with all previous files, to the write-behind state
+   wb->ftag = *curftag;
+   wb->handle = stream->datahandle;
+   stream->datahandle = NULL;
+   if (stream->curfile) {
+      memcpy(wb->files, stream->files, sizeof(STREAMFILE) * stream->curfile);
+      wb->filecnt = stream->curfile;
+      stream->files[0] = stream->files[stream->curfile];
+      stream->curfile = 0;
+   }
+   if (pthread_create(&(wb->thread), NULL, writebehind_thread, wb)) {
+      LOG(LOG_WARNING, "Failed to launch write-behind thread, closing object %zu synchronously\n",
+         curftag->objno);
+      writebehind_thread(wb);
+      stream->writebehind = wb;
+      return writebehind_reap(stream, mdalctxt);
+   }
+   wb->active = 1;
+   stream->writebehind = wb;
+   return 0;
+}
+
+
+/**
+ * Batch thread behavior, establishing reference files of upcoming entries and linking those
+ * of entries which have been placed into the stream ( see datastream_createbatch() )
+ * @param void* arg : Reference to the DATASTREAM_BATCH
+ * @return void* : Always NULL
+ */
+void* batch_thread(void* arg) {
+   DATASTREAM_BATCH* batch = (DATASTREAM_BATCH*)arg;
+   if (pthread_mutex_lock(&(batch->lock))) {
+      LOG(LOG_ERR, "Failed to acquire batch lock\n");
+      return NULL;
+   }
+   while (!(batch->abort)) {
+      if (batch->nextlink < batch->linkable) {
+         // link the oldest placed entry into the user namespace
+         size_t index = batch->nextlink++;
+         DATASTREAM_BATCHSLOT* slot = batch->slots + (index % BATCH_WINDOW);
+         batch->linking++;
+         pthread_mutex_unlock(&(batch->lock));
+         int error = 0;
+         if (linkfile(&(batch->shadow), slot->rpath, batch->entries[index].path, batch->ctxt)) {
+            LOG(LOG_ERR, "Failed to link reference file to target user path: \"%s\"\n",
+               batch->entries[index].path);
+            error = (errno) ? errno : EIO;
+            batch->shadow.ns->prepo->metascheme.mdal->unlinkref(batch->ctxt, slot->rpath);
+         }
+         free(slot->rpath);
+         pthread_mutex_lock(&(batch->lock));
+         slot->rpath = NULL;
+         slot->state = BATCHSLOT_FREE;
+         batch->linking--;
+         if (error && batch->linkerror == 0) {
+            batch->linkerror = error;
+         }
+         pthread_cond_broadcast(&(batch->update));
+      }
+      else if (batch->nextprep < batch->count  &&
+               batch->slots[batch->nextprep % BATCH_WINDOW].state == BATCHSLOT_FREE) {
+         // establish the reference file of the next entry
+         size_t index = batch->nextprep++;
+         DATASTREAM_BATCHSLOT* slot = batch->slots + (index % BATCH_WINDOW);
+         const DATASTREAM_BATCHENT* entry = batch->entries + index;
+         slot->state = BATCHSLOT_PREP;
+         pthread_mutex_unlock(&(batch->lock));
+         errno = 0;
+         slot->rpath = prepfile(&(batch->shadow), entry->path, batch->ctxt, entry->mode,
+                                batch->basefileno + index, 0, &(slot->file), &(slot->finfo));
+         if (slot->rpath == NULL  &&  errno == ENOENT) {
+            // reference dirs should already exist, but we can create them as a fallback
+            pthread_mutex_lock(&(batch->refdirlock));
+            slot->rpath = prepfile(&(batch->shadow), entry->path, batch->ctxt, entry->mode,
+                                   batch->basefileno + index, 1, &(slot->file), &(slot->finfo));
+            pthread_mutex_unlock(&(batch->refdirlock));
+         }
+         int error = 0;
+         if (slot->rpath == NULL) {
+            LOG(LOG_ERR, "Failed to establish reference file for: \"%s\"\n", entry->path);
+            error = (errno) ? errno : EIO;
+         }
+         pthread_mutex_lock(&(batch->lock));
+         slot->error = error;
+         slot->state = (error) ? BATCHSLOT_FAILED : BATCHSLOT_READY;
+         pthread_cond_broadcast(&(batch->update));
+      }
+      else {
+         pthread_cond_wait(&(batch->update), &(batch->lock));
+      }
+   }
+   pthread_mutex_unlock(&(batch->lock));
+   return NULL;
+}
+
+/**
+ * Permit the batch threads to link all entries up to and including the given index
+ * @param DATASTREAM_BATCH* batch : Reference to the DATASTREAM_BATCH
+ * @param size_t index : Index of the most recent entry to be linked
+ */
+void batch_dispatch(DATASTREAM_BATCH* batch, size_t index) {
+   pthread_mutex_lock(&(batch->lock));
+   batch->linkable = index + 1;
+   pthread_cond_broadcast(&(batch->update));
+   pthread_mutex_unlock(&(batch->lock));
+}
+
+/**
+ * Terminate the given DATASTREAM_BATCH, once all dispatched links have completed
+ * NOTE -- Entries which were never linked will have their reference files removed.
+ *         The DATASTREAM_BATCH struct itself is freed by this function.
+ * @param DATASTREAM_BATCH* batch : Reference to the DATASTREAM_BATCH
+ * @param pthread_t* threads : List of batch threads
+ * @param int threadcnt : Count of batch threads
+ * @return int : Zero if all dispatched links succeeded, or -1 if a failure occurred
+ */
+int batch_finish(DATASTREAM_BATCH* batch, pthread_t* threads, int threadcnt) {
+   pthread_mutex_lock(&(batch->lock));
+   while (batch->linking  ||  batch->nextlink < batch->linkable) {
+      pthread_cond_wait(&(batch->update), &(batch->lock));
+   }
+   batch->abort = 1;
+   pthread_cond_broadcast(&(batch->update));
+   pthread_mutex_unlock(&(batch->lock));
+   int thread;
+   for (thread = 0; thread < threadcnt; thread++) {
+      pthread_join(threads[thread], NULL);
+   }
+   // clean up any entries left behind
+   const marfs_ms* ms = &(batch->shadow.ns->prepo->metascheme);
+   int slotindex;
+   for (slotindex = 0; slotindex < BATCH_WINDOW; slotindex++) {
+      DATASTREAM_BATCHSLOT* slot = batch->slots + slotindex;
+      if (slot->state == BATCHSLOT_READY) {
+         // never installed into the stream
+         abandonfile(&(batch->shadow), batch->ctxt, slot->rpath, &(slot->file), &(slot->finfo));
+      }
+      else if (slot->state == BATCHSLOT_PLACED  &&  slot->rpath) {
+         // installed, but never linked ( meta handle belongs to the stream )
+         ms->mdal->unlinkref(batch->ctxt, slot->rpath);
+         free(slot->rpath);
+      }
+   }
+   int retval = 0;
+   if (batch->linkerror) {
+      LOG(LOG_ERR, "Failed to link at least one batch entry\n");
+      errno = batch->linkerror;
+      retval = -1;
+   }
+   pthread_mutex_destroy(&(batch->refdirlock));
+   pthread_cond_destroy(&(batch->update));
+   pthread_mutex_destroy(&(batch->lock));
+   free(batch->shadow.ctag);
+   free(batch->shadow.streamid);
+   free(batch);
+   return retval;
+}
+
 
 //   -------------   EXTERNAL FUNCTIONS    -------------
 
@@ -2312,39 +2975,18 @@ int datastream_create(DATASTREAM* stream, const char* path, marfs_position* pos,
          // check for an object transition
          STREAMFILE* newfile = newstream->files + newstream->curfile;
          if (newfile->ftag.objno != curobj) {
-            size_t newfilepos = newstream->curfile;
             LOG(LOG_INFO, "Stream has transitioned from objno %zu to %zu\n",
                curobj, newfile->ftag.objno);
-            // close our data handle
+            // close our data handle, and mark all previous files as complete
             FTAG oldftag = (newfile - 1)->ftag;
             oldftag.objno = curobj;
-            if (close_current_obj(newstream, &(oldftag), pos->ctxt)) {
+            if (transition_obj(newstream, &(oldftag), pos->ctxt)) {
                LOG(LOG_ERR, "Failure to close data object %zu\n", curobj);
                freestream(newstream);
                *stream = NULL; // unsafe to reuse this stream
                errno = EBADFD;
                return -1;
             }
-            // we need to mark all previous files as complete
-            char abortflag = 0;
-            while (newstream->curfile) {
-               newstream->curfile--;
-               if (completefile(newstream, newstream->files + newstream->curfile)) {
-                  LOG(LOG_ERR, "Failed to complete file %zu\n",
-                     (newstream->files + newstream->curfile)->ftag.fileno);
-                  abortflag = 1;
-               }
-            }
-            // shift the new file reference to the front of the list
-            newstream->files[0] = newstream->files[newfilepos];
-            // check for any errors
-            if (abortflag) {
-               LOG(LOG_INFO, "Terminating datastream due to previous errors\n");
-               freestream(newstream);
-               *stream = NULL; // unsafe to reuse this stream
-               errno = EBADFD;
-               return -1;
-            }
          }
       }
    }
@@ -2376,6 +3018,238 @@ int datastream_create(DATASTREAM* stream, const char* path, marfs_position* pos,
    return 0;
 }
 
+/**
+ * Create, and write out the content of, a sequence of new files associated with a CREATE stream
+ * NOTE -- This produces the same result as a datastream_create() / datastream_write() sequence
+ *         for each entry.  However, the creation and linking of the reference file of each
+ *         entry are performed by background threads, concurrently with the data of preceding
+ *         entries being written to the stream.  This is intended for packing many small files.
+ * @param DATASTREAM* stream : Reference to an existing CREATE stream; if that ref is NULL
+ *                             a fresh stream will be generated to replace that ref
+ * @param const DATASTREAM_BATCHENT* entries : List of files to be created
+ *                                             NOTE -- every entry should target a distinct path
+ * @param size_t count : Count of 'entries'
+ * @param marfs_position* pos : Reference to the marfs_position value of all target files
+ * @param const char* ctag : Client tag to be associated with this stream
+ * @return ssize_t : Count of entries created and written, or -1 on failure prior to the creation
+ *                   of any entry; a value below 'count' indicates failure at that entry index
+ *    NOTE -- Following a failure, the stream may continue to reference the failed entry, which
+ *            will have been created but not completely written.  As with datastream_create(),
+ *            certain catastrophic error conditions will result in the DATASTREAM being
+ *            destroyed, the 'stream' reference set to NULL, and errno set to EBADFD.
+ */
+ssize_t datastream_createbatch(DATASTREAM* stream, const DATASTREAM_BATCHENT* entries, size_t count, marfs_position* pos, const char* ctag) {
+   // check for a NULL entry list
+   if (entries == NULL  &&  count) {
+      LOG(LOG_ERR, "Received a NULL entries argument\n");
+      errno = EINVAL;
+      return -1;
+   }
+   // check for a NULL position
+   if (pos == NULL) {
+      LOG(LOG_ERR, "Received a NULL position argument\n");
+      errno = EINVAL;
+      return -1;
+   }
+   // check for NULL stream reference
+   if (stream == NULL) {
+      LOG(LOG_ERR, "Received a NULL stream reference argument\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (count == 0) {
+      return 0;
+   }
+   size_t created = 0;
+   DATASTREAM tgtstream = *stream;
+   if (tgtstream == NULL  ||  tgtstream->type != CREATE_STREAM  ||
+       strcmp(tgtstream->ns->idstr, pos->ns->idstr)) {
+      // a fresh stream is produced via the standard create path ( as are non-CREATE stream errors )
+      if (datastream_create(stream, entries->path, pos, entries->mode, ctag)) {
+         LOG(LOG_ERR, "Failed to create initial batch file: \"%s\"\n", entries->path);
+         return -1;
+      }
+      if (entries->size  &&  datastream_write(stream, entries->data, entries->size) != (ssize_t)(entries->size)) {
+         LOG(LOG_ERR, "Failed to write out content of initial batch file: \"%s\"\n", entries->path);
+         return 0;
+      }
+      created = 1;
+      tgtstream = *stream;
+   }
+   if (created == count) {
+      return created;
+   }
+
+   // set up our batch state
+   DATASTREAM_BATCH* batch = calloc(1, sizeof(struct datastream_batch_struct));
+   if (batch == NULL) {
+      LOG(LOG_ERR, "Failed to allocate batch state\n");
+      return created;
+   }
+   if (pthread_mutex_init(&(batch->lock), NULL)) {
+      LOG(LOG_ERR, "Failed to initialize batch lock\n");
+      free(batch);
+      return created;
+   }
+   if (pthread_cond_init(&(batch->update), NULL)) {
+      LOG(LOG_ERR, "Failed to initialize batch condition\n");
+      pthread_mutex_destroy(&(batch->lock));
+      free(batch);
+      return created;
+   }
+   if (pthread_mutex_init(&(batch->refdirlock), NULL)) {
+      LOG(LOG_ERR, "Failed to initialize batch refdir lock\n");
+      pthread_cond_destroy(&(batch->update));
+      pthread_mutex_destroy(&(batch->lock));
+      free(batch);
+      return created;
+   }
+   // batch threads reference only batch state, so that they are unaffected by stream destruction
+   batch->shadow.type = CREATE_STREAM;
+   batch->shadow.ns = pos->ns;
+   batch->shadow.recoveryheaderlen = tgtstream->recoveryheaderlen;
+   batch->shadow.ctag = strdup(tgtstream->ctag);
+   batch->shadow.streamid = strdup(tgtstream->streamid);
+   batch->ctxt = pos->ctxt;
+   batch->entries = entries + created;
+   batch->count = count - created;
+   batch->basefileno = tgtstream->fileno + 1;
+   pthread_t threads[BATCH_THREADS];
+   int threadcnt = 0;
+   if (batch->shadow.ctag  &&  batch->shadow.streamid) {
+      for (; threadcnt < BATCH_THREADS; threadcnt++) {
+         if (pthread_create(threads + threadcnt, NULL, batch_thread, batch)) {
+            LOG(LOG_WARNING, "Failed to launch batch thread %d\n", threadcnt);
+            break;
+         }
+      }
+   }
+   if (threadcnt == 0) {
+      // fall back to creating each file via the standard path
+      LOG(LOG_WARNING, "No batch threads are available, creating files sequentially\n");
+      batch_finish(batch, threads, threadcnt);
+      for (; created < count; created++) {
+         const DATASTREAM_BATCHENT* entry = entries + created;
+         if (datastream_create(stream, entry->path, pos, entry->mode, ctag)) {
+            LOG(LOG_ERR, "Failed to create batch file: \"%s\"\n", entry->path);
+            break;
+         }
+         if (entry->size  &&  datastream_write(stream, entry->data, entry->size) != (ssize_t)(entry->size)) {
+            LOG(LOG_ERR, "Failed to write out content of batch file: \"%s\"\n", entry->path);
+            break;
+         }
+      }
+      return created;
+   }
+
+   // place each entry into the stream, as its reference file becomes available
+   char destroyed = 0;  // flag indicating that the stream has been rendered unusable
+   size_t installed = 0; // count of entries installed into the stream
+   size_t index;
+   for (index = 0; index < batch->count; index++) {
+      const DATASTREAM_BATCHENT* entry = batch->entries + index;
+      DATASTREAM_BATCHSLOT* slot = batch->slots + (index % BATCH_WINDOW);
+      // wait for the reference file of this entry
+      pthread_mutex_lock(&(batch->lock));
+      while (batch->nextprep <= index  ||  slot->state == BATCHSLOT_PREP) {
+         pthread_cond_wait(&(batch->update), &(batch->lock));
+      }
+      char prepped = (slot->state == BATCHSLOT_READY);
+      int preperror = slot->error;
+      pthread_mutex_unlock(&(batch->lock));
+      if (!(prepped)) {
+         LOG(LOG_ERR, "Failed to establish reference file for batch file: \"%s\"\n", entry->path);
+         errno = (preperror == EBADFD) ? ENOMSG : preperror;
+         break;
+      }
+      size_t curobj = tgtstream->objno;
+      // finalize the current file
+      if (finfile(tgtstream)) {
+         LOG(LOG_ERR, "Failed to finalize previous stream file\n");
+         destroyed = 1;
+         break;
+      }
+      // push out the finalized FTAG
+      if (putftag(tgtstream, tgtstream->files + tgtstream->curfile)) {
+         LOG(LOG_ERR, "Failed to finalize FTAG of previous stream file\n");
+         destroyed = 1;
+         break;
+      }
+      // the previous entry can now be linked into the user namespace
+      if (installed) {
+         batch_dispatch(batch, installed - 1);
+      }
+      // progress to the next file
+      tgtstream->curfile++;
+      tgtstream->fileno++;
+      slot->file.ftag.ctag = tgtstream->ctag;
+      slot->file.ftag.streamid = tgtstream->streamid;
+      if (placefile(tgtstream, &(slot->file))  ||  installfile(tgtstream, &(slot->file), &(slot->finfo))) {
+         LOG(LOG_ERR, "Failed to place batch file into the stream: \"%s\"\n", entry->path);
+         // roll back our stream changes
+         tgtstream->curfile--;
+         tgtstream->fileno--;
+         if (errno == EBADFD) {
+            errno = ENOMSG;
+         } // avoid using our reserved errno value
+         break;
+      }
+      pthread_mutex_lock(&(batch->lock));
+      slot->state = BATCHSLOT_PLACED;
+      pthread_mutex_unlock(&(batch->lock));
+      installed = index + 1;
+      // check for an object transition
+      STREAMFILE* newfile = tgtstream->files + tgtstream->curfile;
+      if (newfile->ftag.objno != curobj) {
+         LOG(LOG_INFO, "Stream has transitioned from objno %zu to %zu\n",
+            curobj, newfile->ftag.objno);
+         // close our data handle, and mark all previous files as complete
+         FTAG oldftag = (newfile - 1)->ftag;
+         oldftag.objno = curobj;
+         if (transition_obj(tgtstream, &(oldftag), pos->ctxt)) {
+            LOG(LOG_ERR, "Failure to close data object %zu\n", curobj);
+            destroyed = 1;
+            break;
+         }
+      }
+      // write out the content of this entry
+      if (entry->size  &&  datastream_write(stream, entry->data, entry->size) != (ssize_t)(entry->size)) {
+         LOG(LOG_ERR, "Failed to write out content of batch file: \"%s\"\n", entry->path);
+         if (*stream == NULL) {
+            tgtstream = NULL; // already destroyed by datastream_write()
+            destroyed = 1;
+         }
+         break;
+      }
+      created++;
+   }
+   int origerrno = errno;
+   if (!(destroyed)  &&  installed  &&  batch->linkable < installed) {
+      // the current file is not yet finalized, so attach its initial FTAG, just as datastream_create() would
+      if (putftag(tgtstream, &(batch->slots[(installed - 1) % BATCH_WINDOW].file))) {
+         LOG(LOG_ERR, "Failed to initialize FTAG value on current batch file\n");
+         destroyed = 1;
+      }
+      else {
+         batch_dispatch(batch, installed - 1);
+      }
+   }
+   if (batch_finish(batch, threads, threadcnt)) {
+      LOG(LOG_ERR, "Failed to link batch files into the user namespace\n");
+      destroyed = 1;
+   }
+   if (destroyed) {
+      if (tgtstream) {
+         freestream(tgtstream);
+      }
+      *stream = NULL; // unsafe to reuse this stream
+      errno = EBADFD;
+      return created;
+   }
+   errno = origerrno;
+   return created;
+}
+
 /**
  * Open an existing file associated with a READ or EDIT stream
  * @param DATASTREAM* stream : Reference to an existing DATASTREAM of the requested type;
@@ -2791,39 +3665,18 @@ int datastream_repack(DATASTREAM* stream, const char* refpath, marfs_position* p
          // check for an object transition
          STREAMFILE* newfile = newstream->files + newstream->curfile;
          if (newfile->ftag.objno != curobj) {
-            size_t newfilepos = newstream->curfile;
             LOG(LOG_INFO, "Stream has transitioned from objno %zu to %zu\n",
                curobj, newfile->ftag.objno);
-            // close our data handle
+            // close our data handle, and mark all previous files as complete
             FTAG oldftag = (newfile - 1)->ftag;
             oldftag.objno = curobj;
-            if (close_current_obj(newstream, &(oldftag), pos->ctxt)) {
+            if (transition_obj(newstream, &(oldftag), pos->ctxt)) {
                LOG(LOG_ERR, "Failure to close data object %zu\n", curobj);
                freestream(newstream);
                *stream = NULL; // unsafe to reuse this stream
                errno = EBADFD;
                return -1;
             }
-            // we need to mark all previous files as complete
-            char abortflag = 0;
-            while (newstream->curfile) {
-               newstream->curfile--;
-               if (completefile(newstream, newstream->files + newstream->curfile)) {
-                  LOG(LOG_ERR, "Failed to complete file %zu\n",
-                     (newstream->files + newstream->curfile)->ftag.fileno);
-                  abortflag = 1;
-               }
-            }
-            // shift the new file reference to the front of the list
-            newstream->files[0] = newstream->files[newfilepos];
-            // check for any errors
-            if (abortflag) {
-               LOG(LOG_INFO, "Terminating datastream due to previous errors\n");
-               freestream(newstream);
-               *stream = NULL; // unsafe to reuse this stream
-               errno = EBADFD;
-               return -1;
-            }
          }
       }
    }
@@ -3196,7 +4049,11 @@ int datastream_release(DATASTREAM* stream) {
    FTAG curftag = curfile->ftag;
    curftag.objno = tgtstream->objno;
    curftag.offset = tgtstream->offset;
-   if (close_current_obj(tgtstream, &(curftag), NULL)) {
+   if (writebehind_reap(tgtstream, NULL)) {
+      LOG(LOG_ERR, "Write-behind failure for a previous object of the stream\n");
+      abortflag = 1;
+   }
+   else if (close_current_obj(tgtstream, &(curftag), NULL)) {
       LOG(LOG_ERR, "Close failure for object %zu\n", tgtstream->objno);
       abortflag = 1;
    }
@@ -3286,6 +4143,13 @@ int datastream_close(DATASTREAM* stream) {
          return -1;
       }
    }
+   // wait out any write-behind close of a previous object
+   if (writebehind_reap(tgtstream, NULL)) {
+      LOG(LOG_ERR, "Write-behind failure for a previous object of the stream\n");
+      freestream(tgtstream);
+      *stream = NULL; // unsafe to reuse this stream
+      return -1;
+   }
    // close our data handle
    FTAG curftag = curfile->ftag;
    curftag.objno = tgtstream->objno;
@@ -3547,43 +4411,18 @@ ssize_t datastream_write(DATASTREAM* stream, const void* buf, size_t count) {
             errno = EBADFD;
             return -1;
          }
-         // close the previous data handle
+         // close the previous data handle, and mark all previous files as complete
          FTAG curftag = curfile->ftag;
          curftag.objno = tgtstream->objno;
          curftag.offset = tgtstream->offset;
-         if (close_current_obj(tgtstream, &(curftag), NULL)) {
+         if (transition_obj(tgtstream, &(curftag), NULL)) {
             LOG(LOG_ERR, "Failed to close previous data object\n");
             freestream(tgtstream);
             *stream = NULL; // unsafe to continue with previous handle
             errno = EBADFD;
             return -1;
          }
-         // we (may) need to mark all previous files as complete
-         if (tgtstream->type == CREATE_STREAM  ||  tgtstream->type == REPACK_STREAM) {
-            size_t curfilepos = tgtstream->curfile;
-            char abortflag = 0;
-            while (tgtstream->curfile) {
-               tgtstream->curfile--;
-               if (completefile(tgtstream, tgtstream->files + tgtstream->curfile)) {
-                  LOG(LOG_ERR, "Failed to complete file %zu\n",
-                     (tgtstream->files + tgtstream->curfile)->ftag.fileno);
-                  abortflag = 1;
-               }
-            }
-            // check for any errors
-            if (abortflag) {
-               LOG(LOG_INFO, "Terminating datastream due to previous errors\n");
-               freestream(tgtstream);
-               *stream = NULL; // unsafe to reuse this stream
-               errno = EBADFD;
-               return -1;
-            }
-            if (curfilepos != tgtstream->curfile) {
-               // shift the new file reference to the front of the list
-               tgtstream->files[0] = tgtstream->files[curfilepos];
-               curfile = tgtstream->files;
-            }
-         }
+         curfile = tgtstream->files + tgtstream->curfile;
 
          // progress to the next data object
          tgtstream->objno++;
@@ -3710,6 +4549,57 @@ int datastream_setrecoverypath(DATASTREAM* stream, const char* recovpath) {
    return 0;
 }
 
+/**
+ * Enable or disable sampled CRC verification for data objects read via the given READ DATASTREAM
+ * ( see NE_LAZYVERIFY ; NOTE -- this only applies to objects opened after this call )
+ * @param DATASTREAM* stream : Reference to the READ DATASTREAM to be modified
+ * @param char lazy : Non-zero to verify only a sample of data, or zero to verify all data
+ * @return int : Zero on success, or -1 on failure
+ */
+int datastream_setverify(DATASTREAM* stream, char lazy) {
+   // check for invalid args
+   if (stream == NULL || *stream == NULL) {
+      LOG(LOG_ERR, "Received a NULL stream reference\n");
+      errno = EINVAL;
+      return -1;
+   }
+   DATASTREAM tgtstream = *stream;
+   if (tgtstream->type != READ_STREAM) {
+      LOG(LOG_ERR, "Received stream type is not supported\n");
+      errno = EINVAL;
+      return -1;
+   }
+   tgtstream->lazyverify = (lazy) ? 1 : 0;
+   return 0;
+}
+
+/**
+ * Enable or disable random-access reads of data objects via the given READ DATASTREAM
+ * ( see NE_RANDOM ; NOTE -- this only applies to objects opened after this call )
+ * @param DATASTREAM* stream : Reference to the READ DATASTREAM to be modified
+ * @param char random : Non-zero to read objects via positional DAL gets, or zero to use
+ *                      sequential read-ahead
+ * @return int : Zero on success, or -1 on failure
+ *    NOTE -- Random-access reads always verify data inline, and will take precedence over
+ *            any datastream_setverify() setting.
+ */
+int datastream_setrandom(DATASTREAM* stream, char random) {
+   // check for invalid args
+   if (stream == NULL || *stream == NULL) {
+      LOG(LOG_ERR, "Received a NULL stream reference\n");
+      errno = EINVAL;
+      return -1;
+   }
+   DATASTREAM tgtstream = *stream;
+   if (tgtstream->type != READ_STREAM) {
+      LOG(LOG_ERR, "Received stream type is not supported\n");
+      errno = EINVAL;
+      return -1;
+   }
+   tgtstream->randomread = (random) ? 1 : 0;
+   return 0;
+}
+
 /**
  * Seek to the provided offset of the file referenced by the given DATASTREAM
  * @param DATASTREAM* stream : Reference to the DATASTREAM
@@ -3807,6 +4697,14 @@ off_t datastream_seek(DATASTREAM* stream, off_t offset, int whence) {
          }
          tgtstream->finfo.eof = 0; // unset the EOF flag, as it no longer applies
       }
+      // the new target may be a write-behind object, so wait out any such close
+      if (writebehind_reap(tgtstream, NULL)) {
+         LOG(LOG_ERR, "Write-behind failure for a previous object of the stream\n");
+         freestream(tgtstream);
+         *stream = NULL;
+         errno = EBADFD;
+         return -1;
+      }
       // close any existing object handle
       FTAG curftag = curfile->ftag;
       curftag.objno = tgtstream->objno;
@@ -40,6 +40,13 @@ typedef struct datastream_struct {
    size_t      offset;
    size_t      excessoffset;
    ne_handle   datahandle;
+   // Read-Ahead Info ( READ streams only )
+   struct datastream_prefetch_struct* prefetch;
+   size_t      prefetchcnt;
+   char        lazyverify; // open objects with NE_LAZYVERIFY
+   char        randomread; // open objects with NE_RDONLY | NE_RANDOM
+   // Write-Behind Info ( non-READ streams only )
+   struct datastream_writebehind_struct* writebehind;
    // Per-File Info
    STREAMFILE* files;
    size_t      curfile;
@@ -52,6 +59,13 @@ typedef struct datastream_struct {
    size_t      finfostrlen;
 }*DATASTREAM;
 
+typedef struct datastream_batchent_struct {
+   const char* path;  // path of the file to be created
+   mode_t      mode;  // mode value of the file to be created
+   const void* data;  // content of the file
+   size_t      size;  // length of 'data'
+} DATASTREAM_BATCHENT;
+
 /**
  * Calculates the final data object number referenced by the given FTAG of a MarFS file
  * @param const FTAG* ftag : FTAG value associated with the target file
@@ -115,6 +129,28 @@ int datastream_objtarget(FTAG* ftag, const marfs_ds* ds, char** objname, ne_eras
  */
 int datastream_create(DATASTREAM* stream, const char* path, marfs_position* pos, mode_t mode, const char* ctag);
 
+/**
+ * Create, and write out the content of, a sequence of new files associated with a CREATE stream
+ * NOTE -- This produces the same result as a datastream_create() / datastream_write() sequence
+ *         for each entry.  However, the creation and linking of the reference file of each
+ *         entry are performed by background threads, concurrently with the data of preceding
+ *         entries being written to the stream.  This is intended for packing many small files.
+ * @param DATASTREAM* stream : Reference to an existing CREATE stream; if that ref is NULL
+ *                             a fresh stream will be generated to replace that ref
+ * @param const DATASTREAM_BATCHENT* entries : List of files to be created
+ *                                             NOTE -- every entry should target a distinct path
+ * @param size_t count : Count of 'entries'
+ * @param marfs_position* pos : Reference to the marfs_position value of all target files
+ * @param const char* ctag : Client tag to be associated with this stream
+ * @return ssize_t : Count of entries created and written, or -1 on failure prior to the creation
+ *                   of any entry; a value below 'count' indicates failure at that entry index
+ *    NOTE -- Following a failure, the stream may continue to reference the failed entry, which
+ *            will have been created but not completely written.  As with datastream_create(),
+ *            certain catastrophic error conditions will result in the DATASTREAM being
+ *            destroyed, the 'stream' reference set to NULL, and errno set to EBADFD.
+ */
+ssize_t datastream_createbatch(DATASTREAM* stream, const DATASTREAM_BATCHENT* entries, size_t count, marfs_position* pos, const char* ctag);
+
 /**
  * Open an existing file associated with a READ or EDIT stream
  * @param DATASTREAM* stream : Reference to an existing DATASTREAM of the requested type;
@@ -192,6 +228,8 @@ int datastream_repack_cleanup(const char* refpath, marfs_position* pos);
  * Release the given DATASTREAM ( close the stream without completing the referenced file )
  * @param DATASTREAM* stream : Reference to the DATASTREAM to be released
  * @return int : Zero on success, or -1 on failure
+ *    NOTE -- For repos with write-behind enabled, a failure may indicate that an earlier
+ *            data object of the stream failed to close.
  */
 int datastream_release(DATASTREAM* stream);
 
@@ -199,6 +237,9 @@ int datastream_release(DATASTREAM* stream);
  * Close the given DATASTREAM ( marking the referenced file as complete, for non-READ )
  * @param DATASTREAM* stream : Reference to the DATASTREAM to be closed
  * @return int : Zero on success, or -1 on failure
+ *    NOTE -- For repos with write-behind enabled, a failure may indicate that an earlier
+ *            data object of the stream failed to close.  In that case, files stored in that
+ *            object will have been left incomplete.
  */
 int datastream_close(DATASTREAM* stream);
 
@@ -239,6 +280,27 @@ ssize_t datastream_write(DATASTREAM* stream, const void* buff, size_t count);
  */
 int datastream_setrecoverypath(DATASTREAM* stream, const char* recovpath);
 
+/**
+ * Enable or disable sampled CRC verification for data objects read via the given READ DATASTREAM
+ * ( see NE_LAZYVERIFY ; NOTE -- this only applies to objects opened after this call )
+ * @param DATASTREAM* stream : Reference to the READ DATASTREAM to be modified
+ * @param char lazy : Non-zero to verify only a sample of data, or zero to verify all data
+ * @return int : Zero on success, or -1 on failure
+ */
+int datastream_setverify(DATASTREAM* stream, char lazy);
+
+/**
+ * Enable or disable random-access reads of data objects via the given READ DATASTREAM
+ * ( see NE_RANDOM ; NOTE -- this only applies to objects opened after this call )
+ * @param DATASTREAM* stream : Reference to the READ DATASTREAM to be modified
+ * @param char random : Non-zero to read objects via positional DAL gets, or zero to use
+ *                      sequential read-ahead
+ * @return int : Zero on success, or -1 on failure
+ *    NOTE -- Random-access reads always verify data inline, and will take precedence over
+ *            any datastream_setverify() setting.
+ */
+int datastream_setrandom(DATASTREAM* stream, char random);
+
 /**
  * Seek to the provided offset of the file referenced by the given DATASTREAM
  * @param DATASTREAM* stream : Reference to the DATASTREAM
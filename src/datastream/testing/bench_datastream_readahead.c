@@ -0,0 +1,210 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Read-ahead benchmark for sequential datastream reads
+ *
+ * Writes a single packed datastream of many small files, then reads every file back through a
+ * single READ stream, in stream order.  The read pass is repeated for each read-ahead depth from
+ * zero ( objects opened on demand ) up to the depth given in the config, reporting file and data
+ * throughput for each.
+ */
+
+#include "marfs_auto_config.h" // ahead of all system headers, for nftw()
+#include "datastream/datastream.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ftw.h>
+#include <sys/time.h>
+
+#define BENCH_TOPDIR "./bench_datastream_topdir"
+
+double elapsed(struct timeval* beg, struct timeval* end) {
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+int rmtreeentry(const char* fpath, const struct stat* sb, int typeflag, struct FTW* ftwbuf) {
+   if (remove(fpath)) {
+      printf("ERROR: failed to remove \"%s\"\n", fpath);
+      return -1;
+   }
+   return 0;
+}
+
+void fillfile(unsigned char* buf, size_t filesize, int fileno) {
+   size_t i;
+   for (i = 0; i < filesize; i++) {
+      buf[i] = (unsigned char)((fileno + i) % 251);
+   }
+}
+
+int writefiles(marfs_position* pos, int filecnt, size_t filesize, unsigned char* buf) {
+   DATASTREAM stream = NULL;
+   char fname[64];
+   int i;
+   for (i = 0; i < filecnt; i++) {
+      snprintf(fname, sizeof(fname), "benchfile.%d", i);
+      if (datastream_create(&(stream), fname, pos, 0600, "BENCH-CLIENT")) {
+         printf("ERROR: failed to create \"%s\" (%s)\n", fname, strerror(errno));
+         return -1;
+      }
+      fillfile(buf, filesize, i);
+      if (datastream_write(&(stream), buf, filesize) != filesize) {
+         printf("ERROR: failed to write to \"%s\" (%s)\n", fname, strerror(errno));
+         return -1;
+      }
+   }
+   if (datastream_close(&(stream))) {
+      printf("ERROR: failed to close create stream (%s)\n", strerror(errno));
+      return -1;
+   }
+   return 0;
+}
+
+int readfiles(marfs_position* pos, int filecnt, size_t filesize, unsigned char* buf, unsigned char* refbuf, double* seconds) {
+   DATASTREAM stream = NULL;
+   char fname[64];
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   int i;
+   for (i = 0; i < filecnt; i++) {
+      snprintf(fname, sizeof(fname), "benchfile.%d", i);
+      if (datastream_open(&(stream), READ_STREAM, fname, pos, NULL)) {
+         printf("ERROR: failed to open \"%s\" (%s)\n", fname, strerror(errno));
+         return -1;
+      }
+      if (datastream_read(&(stream), buf, filesize) != filesize) {
+         printf("ERROR: failed to read from \"%s\" (%s)\n", fname, strerror(errno));
+         return -1;
+      }
+      // spot check file content, to ensure we are reading from the correct objects
+      fillfile(refbuf, filesize, i);
+      if (memcmp(buf, refbuf, filesize)) {
+         printf("ERROR: content of \"%s\" does not match written\n", fname);
+         return -1;
+      }
+   }
+   if (datastream_close(&(stream))) {
+      printf("ERROR: failed to close read stream (%s)\n", strerror(errno));
+      return -1;
+   }
+   gettimeofday(&end, NULL);
+   *seconds = elapsed(&beg, &end);
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   int filecnt = 4096;
+   size_t filesize = 16384;
+   if (argc > 3) {
+      printf("usage: %s [file_count] [file_size]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { filecnt = atoi(argv[1]); }
+   if (argc > 2) { filesize = strtoull(argv[2], NULL, 10); }
+   if (filecnt < 1 || filesize < 1) {
+      printf("ERROR: invalid file count or size\n");
+      return -1;
+   }
+
+   LIBXML_TEST_VERSION
+
+   // create the dirs necessary for DAL/MDAL initialization (ignore EEXIST)
+   errno = 0;
+   if (mkdir(BENCH_TOPDIR, S_IRWXU) && errno != EEXIST) {
+      printf("ERROR: failed to create %s\n", BENCH_TOPDIR);
+      return -1;
+   }
+   errno = 0;
+   if (mkdir(BENCH_TOPDIR "/dal_root", S_IRWXU) && errno != EEXIST) {
+      printf("ERROR: failed to create %s/dal_root\n", BENCH_TOPDIR);
+      return -1;
+   }
+   errno = 0;
+   if (mkdir(BENCH_TOPDIR "/mdal_root", S_IRWXU) && errno != EEXIST) {
+      printf("ERROR: failed to create %s/mdal_root\n", BENCH_TOPDIR);
+      return -1;
+   }
+
+   // establish a new marfs config
+   pthread_mutex_t erasurelock;
+   if (pthread_mutex_init(&erasurelock, NULL)) {
+      printf("ERROR: failed to initialize erasure lock\n");
+      return -1;
+   }
+   marfs_config* config = config_init("./testing/bench_config.xml", &erasurelock);
+   if (config == NULL) {
+      printf("ERROR: failed to initialize marfs config\n");
+      return -1;
+   }
+   int flags = CFG_FIX | CFG_OWNERCHECK | CFG_MDALCHECK | CFG_DALCHECK | CFG_RECURSE;
+   if (config_verify(config, "./.", flags)) {
+      printf("ERROR: failed to validate the marfs config\n");
+      return -1;
+   }
+   MDAL rootmdal = config->rootns->prepo->metascheme.mdal;
+   marfs_position pos = {
+      .ns = config->rootns,
+      .depth = 0,
+      .ctxt = rootmdal->newctxt("/.", rootmdal->ctxt)
+   };
+   if (pos.ctxt == NULL) {
+      printf("ERROR: failed to establish root MDAL_CTXT for position\n");
+      return -1;
+   }
+   marfs_ds* ds = &(pos.ns->prepo->datascheme);
+   size_t maxdepth = ds->readahead;
+
+   unsigned char* buf = malloc(filesize);
+   unsigned char* refbuf = malloc(filesize);
+   if (buf == NULL || refbuf == NULL) {
+      printf("ERROR: failed to allocate file buffers\n");
+      return -1;
+   }
+
+   int retval = 0;
+   if (writefiles(&(pos), filecnt, filesize, buf)) {
+      retval = -1;
+   }
+   else {
+      printf("%d files of %zu bytes, %zu files per object\n", filecnt, filesize, ds->objfiles);
+      printf("%10s %14s %14s\n", "readahead", "files/s", "MB/s");
+      size_t depth;
+      for (depth = 0; depth <= maxdepth; depth++) {
+         ds->readahead = depth;
+         double seconds = 0.0;
+         if (readfiles(&(pos), filecnt, filesize, buf, refbuf, &(seconds))) {
+            printf("ERROR: benchmark failure for read-ahead depth %zu\n", depth);
+            retval = -1;
+            break;
+         }
+         printf("%10zu %14.1f %14.3f\n", depth, filecnt / seconds,
+                ((double)filecnt * filesize) / seconds / 1e6);
+      }
+      ds->readahead = maxdepth;
+   }
+
+   // cleanup all state
+   free(buf);
+   free(refbuf);
+   rootmdal->destroyctxt(pos.ctxt);
+   if (config_term(config)) {
+      printf("ERROR: failed to terminate marfs config\n");
+      retval = -1;
+   }
+   pthread_mutex_destroy(&erasurelock);
+   if (nftw(BENCH_TOPDIR, rmtreeentry, 64, FTW_DEPTH | FTW_PHYS)) {
+      printf("ERROR: failed to remove %s\n", BENCH_TOPDIR);
+      retval = -1;
+   }
+   return retval;
+}
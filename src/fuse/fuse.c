@@ -34,6 +34,9 @@
 #endif
 
 #define CONFIGVER_FNAME "/.configver"
+#define PATHCACHE_ENTRIES 1024 // path prefixes cached by our marfs_ctxt
+#define PATHCACHE_TTL 1 // seconds ( matching the default FUSE attr_timeout )
+#define READ_VERIFY MARFS_LAZYVERIFY // marfs_open() flag of file reads ( 0, to check the CRC of all data read )
 
 #define ENTER_USER(CTXT,UID,GID,GROUPS) if( enter_user(CTXT, UID, GID, GROUPS) != 0 ) { return (errno) ? -errno : -ENOMSG; }
 
@@ -514,7 +517,7 @@ int fuse_open(const char *path, struct fuse_file_info *ffi)
   ENTER_USER(&u_ctxt, fuse_get_context()->uid, fuse_get_context()->gid, 1);
 
   char* newpath = translate_path( fctxt->ctxt, path );
-  ffi->fh = (uint64_t)marfs_open(fctxt->ctxt, NULL, newpath, flags);
+  ffi->fh = (uint64_t)marfs_open(fctxt->ctxt, NULL, newpath, (flags == O_RDONLY) ? (flags | READ_VERIFY) : flags);
   int err = errno;
   free( newpath );
 
@@ -1145,6 +1148,10 @@ void marfs_fuse_init(void)
   if ( marfs_setctag( fctxt->ctxt, "FUSE" ) ) {
     fprintf( stderr, "Warning: Failed to set Client Tag String\n" );
   }
+  // NOTE -- all path ops enter the calling user's groups, as well as their UID / GID
+  if ( marfs_setpathcache( fctxt->ctxt, PATHCACHE_ENTRIES, PATHCACHE_TTL ) ) {
+    fprintf( stderr, "Warning: Failed to enable path cache\n" );
+  }
 }
 
 void marfs_fuse_destroy(void *userdata)
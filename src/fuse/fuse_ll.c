@@ -0,0 +1,1841 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * MarFS FUSE low-level frontend
+ *
+ * Unlike the path-based frontend ( fuse.c ), this one services the inode-based libfuse low-level
+ * API, via a multi-threaded session loop.  Every kernel inode reference is mapped to the MarFS
+ * path of its target, with the marfs_ctxt path cache resolving those paths to cached positions.
+ * Attributes produced by readdir ( via marfs_readdirplus() ) are briefly retained, allowing the
+ * lookups which typically follow a listing to be answered without a separate marfs_stat().
+ * Each file opened for read may hold several MarFS handles ( 'cursors' ), so that concurrent
+ * readers of a single open file do not serialize on one stream.  All but the first of these are
+ * opened in MARFS_RANDOMREAD mode.
+ */
+
+#define FUSE_USE_VERSION 26
+
+#include "marfs_auto_config.h"
+#ifdef DEBUG_FUSE
+#define DEBUG DEBUG_FUSE
+#elif (defined DEBUG_ALL)
+#define DEBUG DEBUG_ALL
+#endif
+#define LOG_PREFIX "fuse_ll"
+#include "logging/logging.h"
+
+#include <fuse_lowlevel.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "change_user.h"
+#include "api/marfs.h"
+
+// ENOATTR is not always defined, so define a convenience val
+#ifndef ENOATTR
+#define ENOATTR ENODATA
+#endif
+
+#define CONFIGVER_FNAME ".configver" // reserved entry of the root dir
+#define CONFIGVER_INO (FUSE_ROOT_ID + 1)
+#define PATHCACHE_ENTRIES 1024 // path prefixes cached by our marfs_ctxt
+#define PATHCACHE_TTL 1 // seconds ( matching ATTR_TTL )
+#define ATTR_TTL 1.0 // seconds for which the kernel ( and our attr cache ) may retain attributes
+#define INODE_BUCKETS 65536 // hash buckets of our inode table
+#define ATTRCACHE_ENTRIES 4096 // readdir attributes retained for subsequent lookups
+#define READ_CURSORS 8 // maximum MarFS handles per file opened for read
+#define READ_VERIFY MARFS_LAZYVERIFY // marfs_open() flag of file reads ( 0, to check the CRC of all data read )
+#define MAX_IO 1048576 // max_write / max_readahead requested of the kernel
+
+#define ENTER_USER(CTXT,REQ,GROUPS) if( enter_user(CTXT, fuse_req_ctx(REQ)->uid, fuse_req_ctx(REQ)->gid, GROUPS) != 0 ) { fuse_reply_err(REQ, (errno) ? errno : ENOMSG); return; }
+
+typedef struct marfs_inode_struct {
+  fuse_ino_t ino;
+  char* path;         // MarFS path of the target ( including mountpoint prefix )
+  char hashed;        // indicates that this inode is present in the path table
+  uint64_t nlookup;   // kernel lookup count
+  uint64_t pathhash;
+  struct marfs_inode_struct* inonext;  // ino table chain
+  struct marfs_inode_struct* pathnext; // path table chain
+  struct marfs_inode_struct* children; // inodes of entries of this dir ( for updating paths on rename )
+  struct marfs_inode_struct* sibnext;  // next inode of the parent's child list ( or of the orphan list )
+  struct marfs_inode_struct** sibref;  // reference to this inode within that list ( NULL, if in none )
+} marfs_inode;
+
+typedef struct marfs_attrent_struct {
+  char* path;
+  uid_t uid;         // attributes are only reused for the user which produced them
+  gid_t gid;
+  unsigned long gen; // invalidation generation at time of production
+  double expiry;
+  struct stat st;
+} marfs_attrent;
+
+typedef struct marfs_fuse_file_struct {
+  pthread_mutex_t lock;
+  pthread_cond_t  idle;                     // signaled whenever a read cursor is released
+  int             flags;                    // O_RDONLY or O_WRONLY
+  ino_t           objino;                   // MarFS inode of the file, for validating additional read cursors
+  marfs_fhandle   cursors[READ_CURSORS];    // MarFS handles ( the only write handle, in slot zero )
+  off_t           nextoff[READ_CURSORS];    // offset following the most recent read of each cursor
+  char            busy[READ_CURSORS];
+  char            noexpand;                 // set for write handles, or if opening an additional cursor has failed
+}* marfs_fuse_file;
+
+typedef struct marfs_fuse_ctxt_struct {
+   marfs_ctxt ctxt;
+   pthread_mutex_t erasurelock;
+   // inode table
+   pthread_mutex_t inodelock;
+   marfs_inode** inotable;
+   marfs_inode** pathtable;
+   marfs_inode* orphans; // inodes without a parent dir inode, always checked by renames
+   fuse_ino_t nextino;
+   // readdir attr cache
+   pthread_mutex_t attrlock;
+   marfs_attrent* attrcache;
+   unsigned long attrgen;
+   // per-thread read buffers
+   pthread_key_t readbufkey;
+}* marfs_fuse_ctxt;
+
+typedef struct marfs_readbuf_struct {
+  size_t size;
+  char data[];
+}* marfs_readbuf;
+
+marfs_fuse_ctxt fctxt;
+
+
+//   -------------   INODE TABLE   -------------
+
+/**
+ * Produce a hash value for the given path ( FNV-1a )
+ * @param const char* path : Path string
+ * @return uint64_t : Hash of the path
+ */
+uint64_t pathhash( const char* path ) {
+  uint64_t hash = 14695981039346656037ULL;
+  for ( ; *path != '\0'; path++ ) {
+    hash ^= (unsigned char)(*path);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+double monotime( void ) {
+  struct timespec now;
+  clock_gettime( CLOCK_MONOTONIC, &now );
+  return now.tv_sec + ( now.tv_nsec * 1e-9 );
+}
+
+// NOTE -- all of the following inode_*() funcs, with the exception of the wrappers which acquire
+//         the inodelock themselves, expect the caller to hold the inodelock
+
+marfs_inode* inode_find( fuse_ino_t ino ) {
+  marfs_inode* node = fctxt->inotable[ ino % INODE_BUCKETS ];
+  while ( node  &&  node->ino != ino ) { node = node->inonext; }
+  return node;
+}
+
+void inode_hashpath( marfs_inode* node ) {
+  node->pathhash = pathhash( node->path );
+  marfs_inode** bucket = &(fctxt->pathtable[ node->pathhash % INODE_BUCKETS ]);
+  node->pathnext = *bucket;
+  *bucket = node;
+  node->hashed = 1;
+}
+
+void inode_unhashpath( marfs_inode* node ) {
+  if ( !(node->hashed) ) { return; }
+  marfs_inode** ref = &(fctxt->pathtable[ node->pathhash % INODE_BUCKETS ]);
+  while ( *ref != node ) { ref = &((*ref)->pathnext); }
+  *ref = node->pathnext;
+  node->pathnext = NULL;
+  node->hashed = 0;
+}
+
+marfs_inode* inode_findpath( const char* path ) {
+  uint64_t hash = pathhash( path );
+  marfs_inode* node = fctxt->pathtable[ hash % INODE_BUCKETS ];
+  while ( node  &&  ( node->pathhash != hash  ||  strcmp( node->path, path ) ) ) { node = node->pathnext; }
+  return node;
+}
+
+void inode_listadd( marfs_inode* node, marfs_inode** list ) {
+  node->sibnext = *list;
+  if ( *list ) { (*list)->sibref = &(node->sibnext); }
+  node->sibref = list;
+  *list = node;
+}
+
+void inode_listremove( marfs_inode* node ) {
+  if ( node->sibref == NULL ) { return; }
+  *(node->sibref) = node->sibnext;
+  if ( node->sibnext ) { node->sibnext->sibref = node->sibref; }
+  node->sibnext = NULL;
+  node->sibref = NULL;
+}
+
+/**
+ * Add the given inode to the child list of the inode of its parent dir ( or to the orphan list, if none )
+ * @param marfs_inode* node : Inode to be attached
+ */
+void inode_attach( marfs_inode* node ) {
+  marfs_inode* parent = NULL;
+  char* sep = strrchr( node->path, '/' );
+  if ( sep  &&  sep != node->path ) {
+    *sep = '\0';
+    parent = inode_findpath( node->path );
+    *sep = '/';
+  }
+  inode_listadd( node, ( parent ) ? &(parent->children) : &(fctxt->orphans) );
+}
+
+/**
+ * Move all children of the given inode to the orphan list
+ * @param marfs_inode* node : Inode to be stripped of children
+ */
+void inode_orphan( marfs_inode* node ) {
+  while ( node->children ) {
+    marfs_inode* child = node->children;
+    inode_listremove( child );
+    inode_listadd( child, &(fctxt->orphans) );
+  }
+}
+
+/**
+ * Replace the leading 'oldlen' characters of the path of the given inode with a new prefix
+ * @param marfs_inode* node : Inode to be updated
+ * @param size_t oldlen : Length of the prefix to be replaced
+ * @param const char* newpath : New prefix
+ * @return int : Zero on success, or -1 if a failure occurred
+ */
+int inode_repath( marfs_inode* node, size_t oldlen, const char* newpath ) {
+  char* renamed = malloc( strlen( newpath ) + strlen( node->path + oldlen ) + 1 );
+  if ( renamed == NULL ) {
+    LOG( LOG_ERR, "Failed to allocate renamed path for inode %lu\n", (unsigned long)node->ino );
+    inode_unhashpath( node ); // better to abandon this inode than leave it referencing a stale path
+    return -1;
+  }
+  sprintf( renamed, "%s%s", newpath, node->path + oldlen );
+  inode_unhashpath( node );
+  free( node->path );
+  node->path = renamed;
+  inode_hashpath( node );
+  return 0;
+}
+
+/**
+ * Update the paths of all inodes below the given one
+ * @param marfs_inode* node : Inode whose children are to be updated
+ * @param size_t oldlen : Length of the path prefix to be replaced
+ * @param const char* newpath : New path prefix
+ * @return int : Zero on success, or -1 if any failure occurred
+ */
+int inode_repathchildren( marfs_inode* node, size_t oldlen, const char* newpath ) {
+  int retval = 0;
+  marfs_inode* child;
+  for ( child = node->children; child; child = child->sibnext ) {
+    if ( child->hashed  &&  inode_repath( child, oldlen, newpath ) ) { retval = -1; }
+    if ( inode_repathchildren( child, oldlen, newpath ) ) { retval = -1; }
+  }
+  return retval;
+}
+
+/**
+ * Produce a duplicate of the path of the given inode
+ * @param fuse_ino_t ino : Inode to retrieve the path of
+ * @return char* : Path of the inode ( to be freed by the caller ), or NULL if a failure occurred
+ */
+char* inode_path( fuse_ino_t ino ) {
+  pthread_mutex_lock( &(fctxt->inodelock) );
+  marfs_inode* node = inode_find( ino );
+  if ( node == NULL ) {
+    pthread_mutex_unlock( &(fctxt->inodelock) );
+    LOG( LOG_ERR, "Failed to locate inode %lu\n", (unsigned long)ino );
+    errno = ESTALE;
+    return NULL;
+  }
+  char* path = strdup( node->path );
+  pthread_mutex_unlock( &(fctxt->inodelock) );
+  if ( path == NULL ) {
+    LOG( LOG_ERR, "Failed to duplicate path of inode %lu\n", (unsigned long)ino );
+  }
+  return path;
+}
+
+/**
+ * Produce the path of the named entry of the given directory inode
+ * @param fuse_ino_t parent : Parent directory inode
+ * @param const char* name : Name of the entry
+ * @return char* : Path of the entry ( to be freed by the caller ), or NULL if a failure occurred
+ */
+char* inode_childpath( fuse_ino_t parent, const char* name ) {
+  if ( strchr( name, '/' ) ) {
+    LOG( LOG_ERR, "Entry name contains a '/' character: \"%s\"\n", name );
+    errno = EINVAL;
+    return NULL;
+  }
+  pthread_mutex_lock( &(fctxt->inodelock) );
+  marfs_inode* node = inode_find( parent );
+  if ( node == NULL ) {
+    pthread_mutex_unlock( &(fctxt->inodelock) );
+    LOG( LOG_ERR, "Failed to locate parent inode %lu\n", (unsigned long)parent );
+    errno = ESTALE;
+    return NULL;
+  }
+  size_t parentlen = strlen( node->path );
+  size_t pathlen = parentlen + 1 + strlen( name );
+  char* path = malloc( pathlen + 1 );
+  if ( path == NULL ) {
+    pthread_mutex_unlock( &(fctxt->inodelock) );
+    LOG( LOG_ERR, "Failed to allocate a path of length %zu\n", pathlen );
+    return NULL;
+  }
+  snprintf( path, pathlen + 1, "%s/%s", node->path, name );
+  pthread_mutex_unlock( &(fctxt->inodelock) );
+  return path;
+}
+
+/**
+ * Acquire a kernel reference to the inode of the given path, creating a new inode if necessary
+ * @param const char* path : Path of the target
+ * @return fuse_ino_t : Inode number of the target, or zero if a failure occurred
+ */
+fuse_ino_t inode_ref( const char* path ) {
+  pthread_mutex_lock( &(fctxt->inodelock) );
+  marfs_inode* node = inode_findpath( path );
+  if ( node == NULL ) {
+    node = calloc( 1, sizeof( marfs_inode ) );
+    if ( node == NULL  ||  (node->path = strdup( path )) == NULL ) {
+      pthread_mutex_unlock( &(fctxt->inodelock) );
+      LOG( LOG_ERR, "Failed to allocate a new inode for path: \"%s\"\n", path );
+      if ( node ) { free( node ); }
+      return 0;
+    }
+    node->ino = fctxt->nextino++;
+    marfs_inode** bucket = &(fctxt->inotable[ node->ino % INODE_BUCKETS ]);
+    node->inonext = *bucket;
+    *bucket = node;
+    inode_hashpath( node );
+    inode_attach( node );
+    LOG( LOG_INFO, "New inode %lu for path: \"%s\"\n", (unsigned long)node->ino, path );
+  }
+  node->nlookup++;
+  fuse_ino_t ino = node->ino;
+  pthread_mutex_unlock( &(fctxt->inodelock) );
+  return ino;
+}
+
+/**
+ * Drop kernel references to the given inode, freeing it once no references remain
+ * @param fuse_ino_t ino : Inode to be released
+ * @param uint64_t nlookup : Count of references to drop
+ */
+void inode_forget( fuse_ino_t ino, uint64_t nlookup ) {
+  if ( ino == FUSE_ROOT_ID  ||  ino == CONFIGVER_INO ) { return; }
+  pthread_mutex_lock( &(fctxt->inodelock) );
+  marfs_inode** ref = &(fctxt->inotable[ ino % INODE_BUCKETS ]);
+  while ( *ref  &&  (*ref)->ino != ino ) { ref = &((*ref)->inonext); }
+  marfs_inode* node = *ref;
+  if ( node == NULL ) {
+    pthread_mutex_unlock( &(fctxt->inodelock) );
+    LOG( LOG_WARNING, "Received forget for unknown inode %lu\n", (unsigned long)ino );
+    return;
+  }
+  node->nlookup = ( nlookup > node->nlookup ) ? 0 : node->nlookup - nlookup;
+  if ( node->nlookup == 0 ) {
+    *ref = node->inonext;
+    inode_unhashpath( node );
+    inode_listremove( node );
+    inode_orphan( node );
+    LOG( LOG_INFO, "Freeing inode %lu of path: \"%s\"\n", (unsigned long)ino, node->path );
+    free( node->path );
+    free( node );
+  }
+  pthread_mutex_unlock( &(fctxt->inodelock) );
+}
+
+/**
+ * Detach any inode of the given path from that path, ensuring that a new inode is produced for
+ * any subsequently created file of the same name
+ * @param const char* path : Path of the removed target
+ */
+void inode_unlinked( const char* path ) {
+  pthread_mutex_lock( &(fctxt->inodelock) );
+  marfs_inode* node = inode_findpath( path );
+  if ( node ) { inode_unhashpath( node ); }
+  pthread_mutex_unlock( &(fctxt->inodelock) );
+}
+
+/**
+ * Update the paths of the renamed inode, and of all inodes below it
+ * @param const char* oldpath : Original path of the target
+ * @param const char* newpath : New path of the target
+ * @return int : Zero on success, or -1 if a failure occurred
+ */
+int inode_renamed( const char* oldpath, const char* newpath ) {
+  size_t oldlen = strlen( oldpath );
+  int retval = 0;
+  pthread_mutex_lock( &(fctxt->inodelock) );
+  // any overwritten target is no longer reachable by path
+  marfs_inode* node = inode_findpath( newpath );
+  if ( node ) { inode_unhashpath( node ); }
+  // update the target itself, and any inodes below it, moving it to the child list of its new parent
+  node = inode_findpath( oldpath );
+  if ( node ) {
+    if ( inode_repath( node, oldlen, newpath ) ) { retval = -1; }
+    if ( inode_repathchildren( node, oldlen, newpath ) ) { retval = -1; }
+    inode_listremove( node );
+    inode_attach( node );
+  }
+  // orphaned inodes may also lie below the target
+  for ( node = fctxt->orphans; node; node = node->sibnext ) {
+    if ( !(node->hashed)  ||  strncmp( node->path, oldpath, oldlen ) ) { continue; }
+    if ( node->path[oldlen] != '/' ) { continue; }
+    if ( inode_repath( node, oldlen, newpath ) ) { retval = -1; }
+    if ( inode_repathchildren( node, oldlen, newpath ) ) { retval = -1; }
+  }
+  pthread_mutex_unlock( &(fctxt->inodelock) );
+  return retval;
+}
+
+
+//   -------------   ATTR CACHE   -------------
+
+/**
+ * Retain attributes of the given path, produced on behalf of the given user
+ * @param const char* path : Path of the target
+ * @param const struct fuse_ctx* uctx : Requesting user
+ * @param const struct stat* st : Attributes of the target
+ */
+void attrcache_put( const char* path, const struct fuse_ctx* uctx, const struct stat* st ) {
+  marfs_attrent* ent = fctxt->attrcache + ( pathhash( path ) % ATTRCACHE_ENTRIES );
+  char* duppath = strdup( path );
+  if ( duppath == NULL ) { return; } // just skip caching
+  pthread_mutex_lock( &(fctxt->attrlock) );
+  if ( ent->path ) { free( ent->path ); }
+  ent->path = duppath;
+  ent->uid = uctx->uid;
+  ent->gid = uctx->gid;
+  ent->gen = fctxt->attrgen;
+  ent->expiry = monotime() + ATTR_TTL;
+  ent->st = *st;
+  pthread_mutex_unlock( &(fctxt->attrlock) );
+}
+
+/**
+ * Retrieve retained attributes of the given path, if produced on behalf of the given user
+ * @param const char* path : Path of the target
+ * @param const struct fuse_ctx* uctx : Requesting user
+ * @param struct stat* st : Stat structure to be populated
+ * @return int : Zero if attributes were retrieved, or -1 if none were available
+ */
+int attrcache_get( const char* path, const struct fuse_ctx* uctx, struct stat* st ) {
+  marfs_attrent* ent = fctxt->attrcache + ( pathhash( path ) % ATTRCACHE_ENTRIES );
+  int retval = -1;
+  pthread_mutex_lock( &(fctxt->attrlock) );
+  if ( ent->path  &&  ent->gen == fctxt->attrgen  &&  ent->uid == uctx->uid  &&  ent->gid == uctx->gid  &&
+       strcmp( ent->path, path ) == 0  &&  ent->expiry > monotime() ) {
+    *st = ent->st;
+    retval = 0;
+  }
+  pthread_mutex_unlock( &(fctxt->attrlock) );
+  return retval;
+}
+
+/**
+ * Invalidate all retained attributes ( following any modification through this mount )
+ */
+void attrcache_invalidate( void ) {
+  pthread_mutex_lock( &(fctxt->attrlock) );
+  fctxt->attrgen++;
+  pthread_mutex_unlock( &(fctxt->attrlock) );
+}
+
+
+//   -------------   HELPERS   -------------
+
+void configver_stat( struct stat* st ) {
+  memset( st, 0, sizeof( struct stat ) );
+  st->st_ino = CONFIGVER_INO;
+  st->st_uid = getuid();
+  st->st_gid = getgid();
+  st->st_atime = time( NULL );
+  st->st_mtime = time( NULL );
+  st->st_mode = S_IFREG | 0444;
+  st->st_nlink = 1;
+  st->st_size = marfs_configver( fctxt->ctxt, NULL, 0 ) + 1;
+}
+
+/**
+ * Stat the given path, then reply to the request with a new entry reference for it
+ * NOTE -- This is expected to be called from within the requesting user's context
+ * @param fuse_req_t req : Request to reply to
+ * @param const char* path : Path of the new entry
+ * @param struct fuse_file_info* fi : File info of a create request ( NULL for all others )
+ * @return int : Zero on success, or an errno value if a failure occurred
+ */
+int reply_entry( fuse_req_t req, const char* path, struct fuse_file_info* fi ) {
+  struct fuse_entry_param e;
+  memset( &e, 0, sizeof( struct fuse_entry_param ) );
+  if ( attrcache_get( path, fuse_req_ctx(req), &(e.attr) )  &&
+       marfs_stat( fctxt->ctxt, path, &(e.attr), AT_SYMLINK_NOFOLLOW ) ) {
+    LOG( LOG_INFO, "%s: %s\n", path, strerror(errno) );
+    return (errno) ? errno : ENOMSG;
+  }
+  e.ino = inode_ref( path );
+  if ( e.ino == 0 ) { return ENOMEM; }
+  e.attr_timeout = ATTR_TTL;
+  e.entry_timeout = ATTR_TTL;
+  if ( fi ) { fuse_reply_create( req, &e, fi ); }
+  else { fuse_reply_entry( req, &e ); }
+  return 0;
+}
+
+/**
+ * Retrieve the calling thread's read buffer, expanding it to at least the given size
+ * @param size_t size : Minimum buffer size
+ * @return char* : Reference to the read buffer, or NULL if a failure occurred
+ */
+char* readbuf_get( size_t size ) {
+  marfs_readbuf rbuf = pthread_getspecific( fctxt->readbufkey );
+  if ( rbuf == NULL  ||  rbuf->size < size ) {
+    size_t allocsize = ( size < MAX_IO ) ? MAX_IO : size;
+    marfs_readbuf newbuf = realloc( rbuf, sizeof( struct marfs_readbuf_struct ) + allocsize );
+    if ( newbuf == NULL ) {
+      LOG( LOG_ERR, "Failed to allocate a read buffer of %zu bytes\n", allocsize );
+      return NULL;
+    }
+    newbuf->size = allocsize;
+    pthread_setspecific( fctxt->readbufkey, newbuf );
+    rbuf = newbuf;
+  }
+  return rbuf->data;
+}
+
+/**
+ * Open a MarFS file or directory handle for an xattr op on the given path
+ * NOTE -- This is expected to be called from within the requesting user's context
+ * @param const char* path : Path of the target
+ * @param marfs_fhandle* fh : Reference to be populated with a file handle ( if a file )
+ * @param marfs_dhandle* dh : Reference to be populated with a dir handle ( if a directory )
+ * @return int : Zero on success, or -1 if a failure occurred
+ */
+int xattr_open( const char* path, marfs_fhandle* fh, marfs_dhandle* dh ) {
+  int cachederrno = errno;
+  *dh = NULL;
+  *fh = marfs_open( fctxt->ctxt, NULL, path, O_RDONLY | O_NOFOLLOW | O_ASYNC );
+  if ( *fh ) { return 0; }
+  if ( errno == EISDIR ) {
+    // this is a dir, and requires a directory handle
+    LOG( LOG_INFO, "Attempting to open a dhandle for target path: \"%s\"\n", path );
+    errno = cachederrno;
+    *dh = marfs_opendir( fctxt->ctxt, path );
+    if ( *dh ) { return 0; }
+  }
+  LOG( LOG_ERR, "Failed to open a handle for target path: \"%s\" (%s)\n", path, strerror(errno) );
+  return -1;
+}
+
+void xattr_close( marfs_fhandle fh, marfs_dhandle dh ) {
+  if ( fh ) {
+    if ( marfs_release(fh) ) {
+      LOG( LOG_WARNING, "Failed to close marfs_fhandle following xattr op\n" );
+    }
+  }
+  else if ( dh  &&  marfs_closedir(dh) ) {
+    LOG( LOG_WARNING, "Failed to close marfs_dhandle following xattr op\n" );
+  }
+}
+
+
+//   -------------   LOW-LEVEL OPS   -------------
+
+void fusell_lookup(fuse_req_t req, fuse_ino_t parent, const char *name)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)parent, name);
+
+  if ( parent == FUSE_ROOT_ID  &&  !strcmp(name, CONFIGVER_FNAME) ) {
+    struct fuse_entry_param e;
+    memset( &e, 0, sizeof( struct fuse_entry_param ) );
+    e.ino = CONFIGVER_INO;
+    configver_stat( &(e.attr) );
+    fuse_reply_entry( req, &e ); // zero timeouts, as the config may change
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  char* path = inode_childpath( parent, name );
+  int err = ( path ) ? reply_entry( req, path, NULL ) : errno;
+  if ( path ) { free( path ); }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+}
+
+void fusell_forget(fuse_req_t req, fuse_ino_t ino, unsigned long nlookup)
+{
+  LOG(LOG_INFO, "%lu -- %lu\n", (unsigned long)ino, nlookup);
+  inode_forget( ino, nlookup );
+  fuse_reply_none( req );
+}
+
+void fusell_getattr(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  struct stat st;
+  if ( ino == CONFIGVER_INO ) {
+    configver_stat( &st );
+    fuse_reply_attr( req, &st, 0.0 );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else if ( attrcache_get( path, fuse_req_ctx(req), &st )  &&
+            marfs_stat( fctxt->ctxt, path, &st, AT_SYMLINK_NOFOLLOW ) ) {
+    LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+    err = (errno) ? errno : ENOMSG;
+  }
+  if ( path ) { free( path ); }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+  else { fuse_reply_attr( req, &st, ATTR_TTL ); }
+}
+
+void fusell_setattr(fuse_req_t req, fuse_ino_t ino, struct stat *attr, int to_set, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu -- 0x%x\n", (unsigned long)ino, to_set);
+
+  if ( ino == CONFIGVER_INO ) {
+    fuse_reply_err( req, EPERM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  char* path = inode_path( ino );
+  if ( path == NULL ) {
+    int err = errno;
+    exit_user(&u_ctxt);
+    fuse_reply_err( req, err );
+    return;
+  }
+  attrcache_invalidate();
+
+  int ret = 0;
+  if ( to_set & FUSE_SET_ATTR_MODE ) {
+    ret = marfs_chmod( fctxt->ctxt, path, attr->st_mode, 0 );
+  }
+  if ( ret == 0  &&  ( to_set & (FUSE_SET_ATTR_UID | FUSE_SET_ATTR_GID) ) ) {
+    ret = marfs_chown( fctxt->ctxt, path, ( to_set & FUSE_SET_ATTR_UID ) ? attr->st_uid : (uid_t)-1,
+                       ( to_set & FUSE_SET_ATTR_GID ) ? attr->st_gid : (gid_t)-1, AT_SYMLINK_NOFOLLOW );
+  }
+  if ( ret == 0  &&  ( to_set & FUSE_SET_ATTR_SIZE ) ) {
+    marfs_fuse_file file = ( fi ) ? (marfs_fuse_file)fi->fh : NULL;
+    if ( file  &&  file->flags == O_WRONLY ) {
+      // truncate via our existing write handle
+      pthread_mutex_lock( &(file->lock) );
+      ret = marfs_ftruncate( file->cursors[0], attr->st_size );
+      pthread_mutex_unlock( &(file->lock) );
+    }
+    else {
+      marfs_fhandle fh = marfs_open( fctxt->ctxt, NULL, path, O_WRONLY );
+      if ( fh == NULL ) { ret = -1; }
+      else {
+        ret = marfs_ftruncate( fh, attr->st_size );
+        if ( marfs_close( fh ) ) { ret = -1; }
+      }
+    }
+  }
+  if ( ret == 0  &&  ( to_set & (FUSE_SET_ATTR_ATIME | FUSE_SET_ATTR_MTIME) ) ) {
+    struct timespec times[2];
+    times[0].tv_nsec = UTIME_OMIT;
+    times[1].tv_nsec = UTIME_OMIT;
+    if ( to_set & FUSE_SET_ATTR_ATIME_NOW ) { times[0].tv_nsec = UTIME_NOW; }
+    else if ( to_set & FUSE_SET_ATTR_ATIME ) { times[0] = attr->st_atim; }
+    if ( to_set & FUSE_SET_ATTR_MTIME_NOW ) { times[1].tv_nsec = UTIME_NOW; }
+    else if ( to_set & FUSE_SET_ATTR_MTIME ) { times[1] = attr->st_mtim; }
+    ret = marfs_utimens( fctxt->ctxt, path, times, 0 );
+  }
+  struct stat st;
+  if ( ret == 0 ) {
+    ret = marfs_stat( fctxt->ctxt, path, &st, AT_SYMLINK_NOFOLLOW );
+  }
+  int err = (errno) ? errno : ENOMSG;
+  if ( ret ) { LOG(LOG_ERR, "%s: %s\n", path, strerror(errno)); }
+  free( path );
+
+  exit_user(&u_ctxt);
+
+  if ( ret ) { fuse_reply_err( req, err ); }
+  else { fuse_reply_attr( req, &st, ATTR_TTL ); }
+}
+
+void fusell_readlink(fuse_req_t req, fuse_ino_t ino)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  char buf[PATH_MAX + 1];
+  ssize_t ret = -1;
+  char* path = inode_path( ino );
+  if ( path ) {
+    ret = marfs_readlink( fctxt->ctxt, path, buf, PATH_MAX );
+    if ( ret < 0 ) { LOG( LOG_ERR, "%s: %s\n", path, strerror(errno) ); }
+    free( path );
+  }
+  int err = (errno) ? errno : ENOMSG;
+
+  exit_user(&u_ctxt);
+
+  if ( ret < 0 ) { fuse_reply_err( req, err ); return; }
+  buf[ret] = '\0';
+  fuse_reply_readlink( req, buf );
+}
+
+void fusell_mkdir(fuse_req_t req, fuse_ino_t parent, const char *name, mode_t mode)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)parent, name);
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* path = inode_childpath( parent, name );
+  if ( path == NULL ) { err = errno; }
+  else {
+    attrcache_invalidate();
+    if ( marfs_mkdir( fctxt->ctxt, path, mode ) ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else { err = reply_entry( req, path, NULL ); }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+}
+
+void fusell_unlink(fuse_req_t req, fuse_ino_t parent, const char *name)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)parent, name);
+
+  if ( parent == FUSE_ROOT_ID  &&  !strcmp(name, CONFIGVER_FNAME) ) {
+    fuse_reply_err( req, EPERM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* path = inode_childpath( parent, name );
+  if ( path == NULL ) { err = errno; }
+  else {
+    attrcache_invalidate();
+    if ( marfs_unlink( fctxt->ctxt, path ) ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else { inode_unlinked( path ); }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_rmdir(fuse_req_t req, fuse_ino_t parent, const char *name)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)parent, name);
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* path = inode_childpath( parent, name );
+  if ( path == NULL ) { err = errno; }
+  else {
+    attrcache_invalidate();
+    if ( marfs_rmdir( fctxt->ctxt, path ) ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else { inode_unlinked( path ); }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_symlink(fuse_req_t req, const char *link, fuse_ino_t parent, const char *name)
+{
+  LOG(LOG_INFO, "%s -- %lu -- %s\n", link, (unsigned long)parent, name);
+
+  if ( parent == FUSE_ROOT_ID  &&  !strcmp(name, CONFIGVER_FNAME) ) {
+    fuse_reply_err( req, EPERM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* path = inode_childpath( parent, name );
+  if ( path == NULL ) { err = errno; }
+  else {
+    // leave target path unmodified
+    attrcache_invalidate();
+    if ( marfs_symlink( fctxt->ctxt, link, path ) ) {
+      LOG(LOG_ERR, "%s %s: %s\n", link, path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else { err = reply_entry( req, path, NULL ); }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+}
+
+void fusell_rename(fuse_req_t req, fuse_ino_t parent, const char *name, fuse_ino_t newparent, const char *newname)
+{
+  LOG(LOG_INFO, "%lu -- %s -> %lu -- %s\n", (unsigned long)parent, name, (unsigned long)newparent, newname);
+
+  if ( ( parent == FUSE_ROOT_ID  &&  !strcmp(name, CONFIGVER_FNAME) )  ||
+       ( newparent == FUSE_ROOT_ID  &&  !strcmp(newname, CONFIGVER_FNAME) ) ) {
+    LOG( LOG_ERR, "Cannot target reserved config version path with a rename op\n" );
+    fuse_reply_err( req, EPERM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* oldpath = inode_childpath( parent, name );
+  char* newpath = ( oldpath ) ? inode_childpath( newparent, newname ) : NULL;
+  if ( newpath == NULL ) { err = errno; }
+  else {
+    attrcache_invalidate();
+    if ( marfs_rename( fctxt->ctxt, oldpath, newpath ) ) {
+      LOG(LOG_ERR, "%s %s: %s\n", oldpath, newpath, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else if ( inode_renamed( oldpath, newpath ) ) {
+      LOG( LOG_WARNING, "Failed to update all inode paths below renamed target: \"%s\"\n", newpath );
+    }
+  }
+  if ( oldpath ) { free( oldpath ); }
+  if ( newpath ) { free( newpath ); }
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_link(fuse_req_t req, fuse_ino_t ino, fuse_ino_t newparent, const char *newname)
+{
+  LOG(LOG_INFO, "%lu -> %lu -- %s\n", (unsigned long)ino, (unsigned long)newparent, newname);
+
+  if ( ino == CONFIGVER_INO  ||  ( newparent == FUSE_ROOT_ID  &&  !strcmp(newname, CONFIGVER_FNAME) ) ) {
+    LOG(LOG_ERR, "cannot link to or over reserved config version file\n");
+    fuse_reply_err( req, EPERM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* oldpath = inode_path( ino );
+  char* newpath = ( oldpath ) ? inode_childpath( newparent, newname ) : NULL;
+  if ( newpath == NULL ) { err = errno; }
+  else {
+    attrcache_invalidate();
+    if ( marfs_link( fctxt->ctxt, oldpath, newpath, AT_SYMLINK_NOFOLLOW ) ) {
+      LOG(LOG_ERR, "%s %s: %s\n", oldpath, newpath, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else { err = reply_entry( req, newpath, NULL ); }
+  }
+  if ( oldpath ) { free( oldpath ); }
+  if ( newpath ) { free( newpath ); }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+}
+
+/**
+ * Allocate a new marfs_fuse_file, wrapping the given MarFS handle
+ * @param marfs_fhandle fh : MarFS handle of the file
+ * @param int flags : O_RDONLY or O_WRONLY
+ * @return marfs_fuse_file : New marfs_fuse_file, or NULL if a failure occurred
+ */
+marfs_fuse_file fusefile_init( marfs_fhandle fh, int flags ) {
+  marfs_fuse_file file = calloc( 1, sizeof( struct marfs_fuse_file_struct ) );
+  if ( file == NULL ) {
+    LOG( LOG_ERR, "Failed to allocate a new marfs_fuse_file\n" );
+    return NULL;
+  }
+  if ( pthread_mutex_init( &(file->lock), NULL ) ) {
+    LOG( LOG_ERR, "Failed to initialize marfs_fuse_file lock\n" );
+    free( file );
+    return NULL;
+  }
+  if ( pthread_cond_init( &(file->idle), NULL ) ) {
+    LOG( LOG_ERR, "Failed to initialize marfs_fuse_file cond\n" );
+    pthread_mutex_destroy( &(file->lock) );
+    free( file );
+    return NULL;
+  }
+  file->flags = flags;
+  file->cursors[0] = fh;
+  file->noexpand = ( flags != O_RDONLY );
+  if ( !(file->noexpand) ) {
+    struct stat st;
+    if ( marfs_fstat( fh, &st ) ) {
+      LOG( LOG_WARNING, "Failed to stat opened file, so no additional read cursors will be opened\n" );
+      file->noexpand = 1;
+    }
+    else { file->objino = st.st_ino; }
+  }
+  return file;
+}
+
+void fusell_open(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  int flags = O_RDONLY;
+  if (fi->flags & O_RDWR)
+  {
+    LOG(LOG_ERR, "%lu: invalid flags %x %x\n", (unsigned long)ino, fi->flags, fi->flags & O_RDWR);
+    fuse_reply_err( req, EINVAL );
+    return;
+  }
+  else if (fi->flags & O_WRONLY)
+  {
+    flags = O_WRONLY;
+  }
+
+  if ( ino == CONFIGVER_INO ) {
+    if (flags == O_WRONLY) {
+      LOG( LOG_ERR, "Cannot open config version file \"%s\" for write\n", CONFIGVER_FNAME );
+      fuse_reply_err( req, EPERM );
+      return;
+    }
+    fi->fh = (uint64_t)0;
+    fi->direct_io = 1; // size may not match content
+    fuse_reply_open( req, fi );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  marfs_fuse_file file = NULL;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else {
+    if ( flags == O_WRONLY ) { attrcache_invalidate(); }
+    marfs_fhandle fh = marfs_open( fctxt->ctxt, NULL, path, (flags == O_RDONLY) ? (flags | READ_VERIFY) : flags );
+    if ( fh == NULL ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else if ( (file = fusefile_init( fh, flags )) == NULL ) {
+      err = ENOMEM;
+      marfs_release( fh );
+    }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); return; }
+  LOG( LOG_INFO, "New MarFS %s Handle: %p\n", (flags == O_RDONLY) ? "Read" : "Write", (void*)file );
+  fi->fh = (uint64_t)file;
+  if ( fuse_reply_open( req, fi ) ) {
+    // the opening process has been interrupted, and will never release this handle
+    marfs_close( file->cursors[0] );
+    pthread_cond_destroy( &(file->idle) );
+    pthread_mutex_destroy( &(file->lock) );
+    free( file );
+  }
+}
+
+void fusell_create(fuse_req_t req, fuse_ino_t parent, const char *name, mode_t mode, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)parent, name);
+
+  if ( parent == FUSE_ROOT_ID  &&  !strcmp(name, CONFIGVER_FNAME) ) {
+    LOG( LOG_ERR, "Cannot create reserved config version file \"%s\"\n", CONFIGVER_FNAME );
+    fuse_reply_err( req, EPERM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  marfs_fuse_file file = NULL;
+  char* path = inode_childpath( parent, name );
+  if ( path == NULL ) { err = errno; }
+  else {
+    attrcache_invalidate();
+    marfs_fhandle fh = marfs_creat( fctxt->ctxt, NULL, path, mode );
+    if ( fh == NULL ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    else if ( (file = fusefile_init( fh, O_WRONLY )) == NULL ) {
+      err = ENOMEM;
+      marfs_close( fh );
+    }
+    else {
+      fi->fh = (uint64_t)file;
+      LOG( LOG_INFO, "New MarFS Create Handle: %p\n", (void*)file );
+      if ( (err = reply_entry( req, path, fi )) ) {
+        marfs_close( fh );
+        pthread_cond_destroy( &(file->idle) );
+        pthread_mutex_destroy( &(file->lock) );
+        free( file );
+      }
+    }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+}
+
+/**
+ * Select a read cursor of the given file, preferring an idle one which left off at the given offset
+ * NOTE -- This is expected to be called with the file lock held, and may wait for a cursor to
+ *         become idle.  The selected cursor is marked busy.  If the selected cursor lacks a MarFS
+ *         handle, the caller is responsible for opening one ( or, on failure, for clearing the
+ *         busy flag and setting noexpand ).
+ * @param marfs_fuse_file file : File to select a cursor of
+ * @param off_t off : Offset of the pending read
+ * @return int : Index of the selected cursor
+ */
+int fusefile_cursor( marfs_fuse_file file, off_t off ) {
+  while ( 1 ) {
+    int idlecursor = -1;
+    int freeslot = -1;
+    int index;
+    for ( index = 0; index < READ_CURSORS; index++ ) {
+      if ( file->cursors[index] == NULL ) {
+        if ( freeslot < 0  &&  !(file->busy[index]) ) { freeslot = index; }
+      }
+      else if ( !(file->busy[index]) ) {
+        if ( file->nextoff[index] == off ) { idlecursor = index; break; }
+        if ( idlecursor < 0 ) { idlecursor = index; }
+      }
+    }
+    if ( idlecursor >= 0  &&  ( file->nextoff[idlecursor] == off  ||  freeslot < 0  ||  file->noexpand ) ) {
+      file->busy[idlecursor] = 1;
+      return idlecursor;
+    }
+    if ( freeslot >= 0  &&  !(file->noexpand) ) {
+      // reserve an additional cursor, rather than seeking an existing one away from its position
+      file->busy[freeslot] = 1;
+      return freeslot;
+    }
+    pthread_cond_wait( &(file->idle), &(file->lock) );
+  }
+}
+
+void fusell_read(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu -- %zu bytes at offset %zd\n", (unsigned long)ino, size, off);
+
+  marfs_fuse_file file = (marfs_fuse_file)fi->fh;
+  if ( file == NULL ) {
+    if ( ino == CONFIGVER_INO ) {
+      // Read the MarFS config version
+      size_t verlen = marfs_configver( fctxt->ctxt, NULL, 0 );
+      char* buf = ( verlen ) ? readbuf_get( verlen + 1 ) : NULL;
+      if ( buf == NULL  ||  marfs_configver( fctxt->ctxt, buf, verlen + 1 ) != verlen ) {
+        fuse_reply_err( req, (errno) ? errno : ENOMSG );
+        return;
+      }
+      buf[verlen] = '\n';
+      verlen++;
+      size_t retsize = ( off < (off_t)verlen ) ? verlen - off : 0;
+      if ( retsize > size ) { retsize = size; }
+      fuse_reply_buf( req, buf + ( ( retsize ) ? off : 0 ), retsize );
+      return;
+    }
+    LOG(LOG_ERR, "%lu: missing file descriptor\n", (unsigned long)ino);
+    fuse_reply_err( req, EBADF );
+    return;
+  }
+  char* buf = readbuf_get( size );
+  if ( buf == NULL ) {
+    fuse_reply_err( req, ENOMEM );
+    return;
+  }
+
+  // select a read cursor, reserving a new one if none is positioned at our target offset
+  pthread_mutex_lock( &(file->lock) );
+  int cursor = fusefile_cursor( file, off );
+  char opencursor = ( file->cursors[cursor] == NULL );
+  pthread_mutex_unlock( &(file->lock) );
+
+  // a new cursor is opened by path, so requires the caller's groups ( see marfs_setpathcache() )
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  if ( enter_user(&u_ctxt, fuse_req_ctx(req)->uid, fuse_req_ctx(req)->gid, opencursor) ) {
+    int err = (errno) ? errno : ENOMSG;
+    pthread_mutex_lock( &(file->lock) );
+    file->busy[cursor] = 0;
+    pthread_cond_signal( &(file->idle) );
+    pthread_mutex_unlock( &(file->lock) );
+    fuse_reply_err( req, err );
+    return;
+  }
+  if ( opencursor ) {
+    // additional cursors only exist to serve reads away from the sequential position of the
+    // others, so retrieve data via positional gets, rather than via block read-ahead
+    // NOTE -- the file may have been renamed since it was opened, so we open the current path of
+    //         its inode, and confirm that the same file was reached
+    marfs_fhandle fh = NULL;
+    char* path = inode_path( ino );
+    if ( path ) {
+      fh = marfs_open( fctxt->ctxt, NULL, path, O_RDONLY | MARFS_RANDOMREAD );
+      free( path );
+    }
+    struct stat st;
+    if ( fh  &&  ( marfs_fstat( fh, &st )  ||  st.st_ino != file->objino ) ) {
+      LOG( LOG_WARNING, "Current path of inode %lu does not reference the opened file\n", (unsigned long)ino );
+      marfs_release( fh );
+      fh = NULL;
+      errno = ESTALE;
+    }
+    pthread_mutex_lock( &(file->lock) );
+    if ( fh ) {
+      LOG( LOG_INFO, "Opened read cursor %d of handle %p\n", cursor, (void*)file );
+      file->cursors[cursor] = fh;
+    }
+    else {
+      LOG( LOG_WARNING, "Failed to open an additional read cursor ( %s )\n", strerror(errno) );
+      file->busy[cursor] = 0;
+      file->noexpand = 1;
+      cursor = fusefile_cursor( file, off ); // now guaranteed to select an open cursor
+    }
+    pthread_mutex_unlock( &(file->lock) );
+  }
+
+  LOG( LOG_INFO, "Performing read of %zubytes at offset %zd via cursor %d\n", size, off, cursor );
+  ssize_t rres = marfs_read_at_offset( file->cursors[cursor], off, (void *)buf, size );
+  int err = (errno) ? errno : ENOMSG;
+
+  pthread_mutex_lock( &(file->lock) );
+  file->nextoff[cursor] = ( rres > 0 ) ? off + rres : -1;
+  file->busy[cursor] = 0;
+  pthread_cond_signal( &(file->idle) );
+  pthread_mutex_unlock( &(file->lock) );
+
+  exit_user(&u_ctxt);
+
+  if ( rres < 0 ) {
+    LOG( LOG_ERR, "%lu: Read of %zd bytes failed (%s)\n", (unsigned long)ino, size, strerror(err) );
+    fuse_reply_err( req, err );
+    return;
+  }
+  LOG( LOG_INFO, "Successfully read %zd bytes\n", rres );
+  fuse_reply_buf( req, buf, rres );
+}
+
+void fusell_write(fuse_req_t req, fuse_ino_t ino, const char *buf, size_t size, off_t off, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu -- %zu bytes at offset %zd\n", (unsigned long)ino, size, off);
+
+  marfs_fuse_file file = (marfs_fuse_file)fi->fh;
+  if ( file == NULL  ||  file->flags != O_WRONLY ) {
+    LOG( LOG_ERR, "%lu: Cannot write to a NULL or read-only file handle\n", (unsigned long)ino );
+    fuse_reply_err( req, EBADF );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 0);
+
+  attrcache_invalidate();
+  int err = 0;
+  pthread_mutex_lock( &(file->lock) );
+  off_t sret = marfs_seek( file->cursors[0], off, SEEK_SET );
+  if ( sret != off ) {
+    LOG( LOG_ERR, "%lu: unexpected seek res: %zd (%s)\n", (unsigned long)ino, sret, strerror(errno) );
+    err = (errno) ? errno : ENOMSG;
+  }
+  else {
+    ssize_t ret = marfs_write( file->cursors[0], buf, size );
+    if ( ret != size ) {
+      LOG( LOG_ERR, "%lu: unexpected write res: %zd (%s)\n", (unsigned long)ino, ret, strerror(errno) );
+      err = (errno) ? errno : ENOMSG;
+    }
+  }
+  pthread_mutex_unlock( &(file->lock) );
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+  else { fuse_reply_write( req, size ); }
+}
+
+void fusell_flush(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
+{
+  LOG( LOG_INFO, "NO-OP for fusell_flush()\n" );
+  fuse_reply_err( req, 0 );
+}
+
+void fusell_fsync(fuse_req_t req, fuse_ino_t ino, int datasync, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+  fuse_reply_err( req, 0 );
+}
+
+void fusell_release(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  marfs_fuse_file file = (marfs_fuse_file)fi->fh;
+  if ( file == NULL ) {
+    if ( ino == CONFIGVER_INO ) {
+      LOG(LOG_INFO, "No-Op for config version file \"%s\"\n", CONFIGVER_FNAME);
+      fuse_reply_err( req, 0 );
+      return;
+    }
+    LOG(LOG_ERR, "%lu: missing file descriptor\n", (unsigned long)ino);
+    fuse_reply_err( req, EBADF );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 0);
+
+  if ( file->flags == O_WRONLY ) { attrcache_invalidate(); }
+  int err = 0;
+  int index;
+  for ( index = 0; index < READ_CURSORS; index++ ) {
+    if ( file->cursors[index]  &&  marfs_close( file->cursors[index] ) ) {
+      LOG(LOG_ERR, "%lu: %s\n", (unsigned long)ino, strerror(errno));
+      if ( err == 0 ) { err = (errno) ? errno : ENOMSG; }
+    }
+  }
+  pthread_cond_destroy( &(file->idle) );
+  pthread_mutex_destroy( &(file->lock) );
+  free( file );
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_opendir(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  marfs_dhandle dh = NULL;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else {
+    dh = marfs_opendir( fctxt->ctxt, path );
+    if ( dh == NULL ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); return; }
+  LOG( LOG_INFO, "New MarFS Directory Handle: %p\n", (void*)dh );
+  fi->fh = (uint64_t)dh;
+  if ( fuse_reply_open( req, fi ) ) { marfs_closedir( dh ); }
+}
+
+void fusell_readdir(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu -- %zu bytes at offset %zd\n", (unsigned long)ino, size, off);
+
+  marfs_dhandle dh = (marfs_dhandle)fi->fh;
+  if ( dh == NULL ) {
+    LOG(LOG_ERR, "%lu: missing file descriptor\n", (unsigned long)ino);
+    fuse_reply_err( req, EBADF );
+    return;
+  }
+  char* buf = malloc( size );
+  char* dirpath = inode_path( ino );
+  if ( buf == NULL  ||  dirpath == NULL ) {
+    if ( buf ) { free( buf ); }
+    fuse_reply_err( req, (errno) ? errno : ENOMEM );
+    return;
+  }
+  size_t dirpathlen = strlen( dirpath );
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  if ( enter_user(&u_ctxt, fuse_req_ctx(req)->uid, fuse_req_ctx(req)->gid, 1) ) {
+    free( buf );
+    free( dirpath );
+    fuse_reply_err( req, (errno) ? errno : ENOMSG );
+    return;
+  }
+
+  // potentially seek to the specified offset
+  int err = 0;
+  if ( off != marfs_telldir( dh ) ) {
+    int seekres = ( off ) ? marfs_seekdir( dh, off ) : marfs_rewinddir( dh );
+    if ( seekres ) {
+      LOG(LOG_ERR, "%s\n", strerror(errno) );
+      err = (errno) ? errno : ENOMSG;
+    }
+  }
+
+  // populate stat info alongside each entry, retaining it for the lookups which are likely to follow
+  size_t bufused = 0;
+  struct dirent* de;
+  struct stat st;
+  long prevpos = off;
+  errno = 0;
+  while ( err == 0  &&  (de = marfs_readdirplus( dh, &st, AT_SYMLINK_NOFOLLOW )) != NULL ) {
+    long posval = marfs_telldir( dh );
+    if ( posval == -1 ) {
+      LOG(LOG_ERR, "%s\n", strerror(errno) );
+      err = (errno) ? errno : ENOMSG;
+      break;
+    }
+    size_t entsize = fuse_add_direntry( req, buf + bufused, size - bufused, de->d_name, &st, (off_t)posval );
+    if ( entsize > size - bufused ) {
+      // no room for this entry, so return it via a future call
+      if ( marfs_seekdir( dh, prevpos ) ) {
+        LOG(LOG_ERR, "Failed to seek back to position of an unreturned entry (%s)\n", strerror(errno) );
+        err = (errno) ? errno : ENOMSG;
+      }
+      break;
+    }
+    bufused += entsize;
+    prevpos = posval;
+    if ( strcmp( de->d_name, "." )  &&  strcmp( de->d_name, ".." ) ) {
+      size_t namelen = strlen( de->d_name );
+      char* entpath = malloc( dirpathlen + namelen + 2 );
+      if ( entpath ) {
+        snprintf( entpath, dirpathlen + namelen + 2, "%s/%s", dirpath, de->d_name );
+        attrcache_put( entpath, fuse_req_ctx(req), &st );
+        free( entpath );
+      }
+    }
+  }
+  if ( err == 0  &&  errno != 0 ) {
+    LOG( LOG_ERR, "%s: Detected errno value post-readdir (%s)\n", dirpath, strerror(errno) );
+    err = errno;
+  }
+
+  exit_user(&u_ctxt);
+
+  if ( err  &&  bufused == 0 ) { fuse_reply_err( req, err ); }
+  else { fuse_reply_buf( req, buf, bufused ); }
+  free( buf );
+  free( dirpath );
+}
+
+void fusell_releasedir(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  if ( !(fi->fh) ) {
+    LOG(LOG_ERR, "%lu: missing file descriptor\n", (unsigned long)ino);
+    fuse_reply_err( req, EBADF );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 0);
+
+  int err = 0;
+  if ( marfs_closedir( (marfs_dhandle)fi->fh ) ) {
+    LOG(LOG_ERR, "%lu: %s\n", (unsigned long)ino, strerror(errno));
+    err = (errno) ? errno : ENOMSG;
+  }
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_fsyncdir(fuse_req_t req, fuse_ino_t ino, int datasync, struct fuse_file_info *fi)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+  fuse_reply_err( req, 0 );
+}
+
+void fusell_statfs(fuse_req_t req, fuse_ino_t ino)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  struct statvfs stbuf;
+  char* path = inode_path( ( ino == CONFIGVER_INO ) ? FUSE_ROOT_ID : ino );
+  if ( path == NULL ) { err = errno; }
+  else {
+    if ( marfs_statvfs( fctxt->ctxt, path, &stbuf ) ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+  else { fuse_reply_statfs( req, &stbuf ); }
+}
+
+void fusell_setxattr(fuse_req_t req, fuse_ino_t ino, const char *name, const char *value, size_t size, int flags)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)ino, name);
+
+  // Temporary (?) change to block non-user xattr interactions for perf benefits
+  if ( strncmp(name,"user.",5)  ||  ino == CONFIGVER_INO ) {
+    LOG( LOG_INFO, "Blocking set of \"%s\" xattr\n", name );
+    fuse_reply_err( req, ENOTSUP );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  marfs_fhandle fh = NULL;
+  marfs_dhandle dh = NULL;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else if ( xattr_open( path, &fh, &dh ) ) {
+    err = ( errno == ELOOP ) ? ENOSYS : ( (errno) ? errno : ENOMSG ); // assume ELOOP -> symlink ( MarFS doesn't support symlink xattrs )
+  }
+  else {
+    int ret = ( fh ) ? marfs_fsetxattr( fh, name, value, size, flags ) : marfs_dsetxattr( dh, name, value, size, flags );
+    if ( ret ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    xattr_close( fh, dh );
+  }
+  if ( path ) { free( path ); }
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_getxattr(fuse_req_t req, fuse_ino_t ino, const char *name, size_t size)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)ino, name);
+
+  // Temporary (?) change to block non-user xattr interactions for perf benefits
+  if ( strncmp(name,"user.",5)  ||  ino == CONFIGVER_INO ) {
+    LOG( LOG_INFO, "Faking absent \"%s\" xattr\n", name );
+    fuse_reply_err( req, ENOATTR );
+    return;
+  }
+  char* value = NULL;
+  if ( size  &&  (value = malloc( size )) == NULL ) {
+    fuse_reply_err( req, ENOMEM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  if ( enter_user(&u_ctxt, fuse_req_ctx(req)->uid, fuse_req_ctx(req)->gid, 1) ) {
+    if ( value ) { free( value ); }
+    fuse_reply_err( req, (errno) ? errno : ENOMSG );
+    return;
+  }
+
+  int err = 0;
+  ssize_t xres = -1;
+  marfs_fhandle fh = NULL;
+  marfs_dhandle dh = NULL;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else if ( xattr_open( path, &fh, &dh ) ) {
+    err = ( errno == ELOOP ) ? ENODATA : ( (errno) ? errno : ENOMSG ); // assume ELOOP -> symlink ( MarFS doesn't support symlink xattrs )
+  }
+  else {
+    xres = ( fh ) ? marfs_fgetxattr( fh, name, value, size ) : marfs_dgetxattr( dh, name, value, size );
+    if ( xres < 0 ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    xattr_close( fh, dh );
+  }
+  if ( path ) { free( path ); }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+  else if ( size == 0 ) { fuse_reply_xattr( req, xres ); }
+  else { fuse_reply_buf( req, value, xres ); }
+  if ( value ) { free( value ); }
+}
+
+void fusell_listxattr(fuse_req_t req, fuse_ino_t ino, size_t size)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  if ( ino == CONFIGVER_INO ) {
+    LOG( LOG_INFO, "Faking lack of all xattrs for reserved config ver file\n" );
+    if ( size == 0 ) { fuse_reply_xattr( req, 0 ); }
+    else { fuse_reply_buf( req, NULL, 0 ); }
+    return;
+  }
+  char* list = NULL;
+  if ( size  &&  (list = malloc( size )) == NULL ) {
+    fuse_reply_err( req, ENOMEM );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  if ( enter_user(&u_ctxt, fuse_req_ctx(req)->uid, fuse_req_ctx(req)->gid, 1) ) {
+    if ( list ) { free( list ); }
+    fuse_reply_err( req, (errno) ? errno : ENOMSG );
+    return;
+  }
+
+  int err = 0;
+  ssize_t xres = 0;
+  marfs_fhandle fh = NULL;
+  marfs_dhandle dh = NULL;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else if ( xattr_open( path, &fh, &dh ) ) {
+    if ( errno != ELOOP ) { err = (errno) ? errno : ENOMSG; } // assume ELOOP -> symlink ( MarFS doesn't support symlink xattrs )
+  }
+  else {
+    xres = ( fh ) ? marfs_flistxattr( fh, list, size ) : marfs_dlistxattr( dh, list, size );
+    if ( xres < 0 ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    xattr_close( fh, dh );
+  }
+  if ( path ) { free( path ); }
+
+  exit_user(&u_ctxt);
+
+  if ( err ) { fuse_reply_err( req, err ); }
+  else if ( size == 0 ) { fuse_reply_xattr( req, xres ); }
+  else { fuse_reply_buf( req, list, xres ); }
+  if ( list ) { free( list ); }
+}
+
+void fusell_removexattr(fuse_req_t req, fuse_ino_t ino, const char *name)
+{
+  LOG(LOG_INFO, "%lu -- %s\n", (unsigned long)ino, name);
+
+  if ( ino == CONFIGVER_INO ) {
+    fuse_reply_err( req, ENOATTR );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  marfs_fhandle fh = NULL;
+  marfs_dhandle dh = NULL;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else if ( xattr_open( path, &fh, &dh ) ) {
+    err = ( errno == ELOOP ) ? ENODATA : ( (errno) ? errno : ENOMSG ); // assume ELOOP -> symlink ( MarFS doesn't support symlink xattrs )
+  }
+  else {
+    int ret = ( fh ) ? marfs_fremovexattr( fh, name ) : marfs_dremovexattr( dh, name );
+    if ( ret ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    xattr_close( fh, dh );
+  }
+  if ( path ) { free( path ); }
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_access(fuse_req_t req, fuse_ino_t ino, int mask)
+{
+  LOG(LOG_INFO, "%lu\n", (unsigned long)ino);
+
+  if ( ino == CONFIGVER_INO ) {
+    fuse_reply_err( req, ( mask & (W_OK | X_OK) ) ? EACCES : 0 );
+    return;
+  }
+
+  struct user_ctxt_struct u_ctxt;
+  memset(&u_ctxt, 0, sizeof(struct user_ctxt_struct));
+  ENTER_USER(&u_ctxt, req, 1);
+
+  int err = 0;
+  char* path = inode_path( ino );
+  if ( path == NULL ) { err = errno; }
+  else {
+    if ( marfs_access( fctxt->ctxt, path, mask, AT_SYMLINK_NOFOLLOW | AT_EACCESS ) ) {
+      LOG(LOG_ERR, "%s: %s\n", path, strerror(errno));
+      err = (errno) ? errno : ENOMSG;
+    }
+    free( path );
+  }
+
+  exit_user(&u_ctxt);
+
+  fuse_reply_err( req, err );
+}
+
+void fusell_init(void *userdata, struct fuse_conn_info *conn)
+{
+  LOG(LOG_INFO, "init ( capable = 0x%x )\n", conn->capable);
+  // permit large write requests, rather than single pages
+  if ( conn->capable & FUSE_CAP_BIG_WRITES ) { conn->want |= FUSE_CAP_BIG_WRITES; }
+  // NOTE -- libfuse will further limit max_write to the size of its request buffers
+  conn->max_write = MAX_IO;
+  if ( conn->max_readahead > MAX_IO ) { conn->max_readahead = MAX_IO; }
+}
+
+void readbuf_free( void* rbuf )
+{
+  free( rbuf );
+}
+
+void marfs_fuse_init(void)
+{
+  LOG(LOG_INFO, "init\n");
+  fctxt = calloc( 1, sizeof( struct marfs_fuse_ctxt_struct ) );
+  if ( fctxt == NULL ) {
+    fprintf( stderr, "Failed to allocate a marfs_fuse_ctxt struct\n" );
+    exit(-1);
+  }
+  if ( pthread_mutex_init( &(fctxt->erasurelock), NULL )  ||
+       pthread_mutex_init( &(fctxt->inodelock), NULL )  ||
+       pthread_mutex_init( &(fctxt->attrlock), NULL )  ||
+       pthread_key_create( &(fctxt->readbufkey), readbuf_free ) ) {
+    fprintf( stderr, "Failed to initialize local locks\n" );
+    exit(-1);
+  }
+  fctxt->inotable = calloc( INODE_BUCKETS, sizeof( marfs_inode* ) );
+  fctxt->pathtable = calloc( INODE_BUCKETS, sizeof( marfs_inode* ) );
+  fctxt->attrcache = calloc( ATTRCACHE_ENTRIES, sizeof( marfs_attrent ) );
+  if ( fctxt->inotable == NULL  ||  fctxt->pathtable == NULL  ||  fctxt->attrcache == NULL ) {
+    fprintf( stderr, "Failed to allocate inode tables\n" );
+    exit(-1);
+  }
+  // initialize the MarFS config
+  fctxt->ctxt = marfs_init( getenv("MARFS_CONFIG_PATH"), MARFS_INTERACTIVE, &(fctxt->erasurelock) );
+  if ( fctxt->ctxt == NULL ) {
+    fprintf( stderr, "Failed to initialize MarFS context!\n" );
+    exit(-1);
+  }
+  if ( marfs_setctag( fctxt->ctxt, "FUSE" ) ) {
+    fprintf( stderr, "Warning: Failed to set Client Tag String\n" );
+  }
+  // NOTE -- all path ops enter the calling user's groups, as well as their UID / GID
+  if ( marfs_setpathcache( fctxt->ctxt, PATHCACHE_ENTRIES, PATHCACHE_TTL ) ) {
+    fprintf( stderr, "Warning: Failed to enable path cache\n" );
+  }
+  // establish our root inode, targeting the mountpoint
+  size_t mountlen = marfs_mountpath( fctxt->ctxt, NULL, 0 );
+  marfs_inode* root = calloc( 1, sizeof( marfs_inode ) );
+  if ( mountlen == 0  ||  root == NULL  ||  (root->path = malloc( mountlen + 1 )) == NULL  ||
+       marfs_mountpath( fctxt->ctxt, root->path, mountlen + 1 ) != mountlen ) {
+    fprintf( stderr, "Failed to establish root inode\n" );
+    exit(-1);
+  }
+  root->ino = FUSE_ROOT_ID;
+  root->nlookup = 1;
+  fctxt->inotable[ FUSE_ROOT_ID % INODE_BUCKETS ] = root;
+  inode_hashpath( root );
+  fctxt->nextino = CONFIGVER_INO + 1;
+}
+
+void marfs_fuse_destroy(void *userdata)
+{
+  LOG(LOG_INFO, "destroy\n");
+  if ( marfs_term(fctxt->ctxt) ) {
+    LOG( LOG_WARNING, "Failed to properly terminate marfs_ctxt\n" );
+  }
+  size_t index;
+  for ( index = 0; index < INODE_BUCKETS; index++ ) {
+    marfs_inode* node = fctxt->inotable[index];
+    while ( node ) {
+      marfs_inode* next = node->inonext;
+      free( node->path );
+      free( node );
+      node = next;
+    }
+  }
+  for ( index = 0; index < ATTRCACHE_ENTRIES; index++ ) {
+    if ( fctxt->attrcache[index].path ) { free( fctxt->attrcache[index].path ); }
+  }
+  free( fctxt->inotable );
+  free( fctxt->pathtable );
+  free( fctxt->attrcache );
+  pthread_key_delete( fctxt->readbufkey );
+  pthread_mutex_destroy( &(fctxt->attrlock) );
+  pthread_mutex_destroy( &(fctxt->inodelock) );
+  if ( pthread_mutex_destroy( &(fctxt->erasurelock) ) ) {
+    LOG( LOG_WARNING, "Failed to properly destroy local erasurelock\n" );
+  }
+  free( fctxt );
+}
+
+int main(int argc, char *argv[])
+{
+
+  struct fuse_lowlevel_ops marfs_oper;
+  bzero( &(marfs_oper), sizeof( struct fuse_lowlevel_ops ) );
+  // initialize startup / teardown funcs
+  marfs_oper.init = fusell_init;
+  marfs_oper.destroy = marfs_fuse_destroy;
+  // initialize inode ops
+  marfs_oper.lookup = fusell_lookup;
+  marfs_oper.forget = fusell_forget;
+  // initialize basic metadata ops
+  marfs_oper.access = fusell_access;
+  marfs_oper.getattr = fusell_getattr;
+  marfs_oper.setattr = fusell_setattr;
+  marfs_oper.getxattr = fusell_getxattr;
+  marfs_oper.setxattr = fusell_setxattr;
+  marfs_oper.listxattr = fusell_listxattr;
+  marfs_oper.removexattr = fusell_removexattr;
+  marfs_oper.readlink = fusell_readlink;
+  marfs_oper.rename = fusell_rename;
+  marfs_oper.symlink = fusell_symlink;
+  marfs_oper.link = fusell_link;
+  marfs_oper.unlink = fusell_unlink;
+  marfs_oper.statfs = fusell_statfs;
+  // initialize directory ops
+  marfs_oper.mkdir = fusell_mkdir;
+  marfs_oper.rmdir = fusell_rmdir;
+  marfs_oper.opendir = fusell_opendir;
+  marfs_oper.readdir = fusell_readdir;
+  marfs_oper.fsyncdir = fusell_fsyncdir;
+  marfs_oper.releasedir = fusell_releasedir;
+  // initialize file ops
+  marfs_oper.create = fusell_create;
+  marfs_oper.open = fusell_open;
+  marfs_oper.read = fusell_read;
+  marfs_oper.write = fusell_write;
+  marfs_oper.flush = fusell_flush;
+  marfs_oper.fsync = fusell_fsync;
+  marfs_oper.release = fusell_release;
+
+  if ( getenv("MARFS_CONFIG_PATH") == NULL )
+  {
+    fprintf( stderr, "MARFS_CONFIG_PATH is not specified, will not start fuse.\n" );
+    return EXIT_FAILURE;
+  }
+
+  struct fuse_args args = FUSE_ARGS_INIT(argc, argv);
+  char* mountpoint = NULL;
+  int multithreaded = 0;
+  int foreground = 0;
+  if ( fuse_parse_cmdline( &args, &mountpoint, &multithreaded, &foreground ) ) {
+    fprintf( stderr, "Failed to parse command line arguments\n" );
+    return EXIT_FAILURE;
+  }
+
+  marfs_fuse_init();
+
+  int retval = EXIT_FAILURE;
+  struct fuse_chan* ch = fuse_mount( mountpoint, &args );
+  if ( ch ) {
+    struct fuse_session* se = fuse_lowlevel_new( &args, &marfs_oper, sizeof( marfs_oper ), NULL );
+    if ( se ) {
+      if ( fuse_set_signal_handlers( se ) == 0 ) {
+        fuse_session_add_chan( se, ch );
+        fuse_daemonize( foreground );
+        if ( ( multithreaded ) ? fuse_session_loop_mt( se ) : fuse_session_loop( se ) ) {
+          LOG( LOG_ERR, "FUSE session loop terminated with an error\n" );
+        }
+        else { retval = EXIT_SUCCESS; }
+        fuse_remove_signal_handlers( se );
+        fuse_session_remove_chan( ch );
+      }
+      fuse_session_destroy( se ); // calls our destroy func
+    }
+    fuse_unmount( mountpoint, ch );
+  }
+  if ( mountpoint ) { free( mountpoint ); }
+  fuse_opt_free_args( &args );
+  return retval;
+}
@@ -0,0 +1,507 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Drives the low-level FUSE ops of fuse_ll.c directly, without a kernel mount.  The libfuse reply
+ * functions are replaced by the ones below, which simply record each reply in our request struct.
+ */
+
+#define main fusell_main
+#include "fuse_ll.c" // include C file directly, to allow traversal of all structures
+#undef main
+#include "config/config.h" // for config validation, alone
+
+#include <ftw.h>
+
+
+#define DATASIZE (8 * 1048576)
+#define READSIZE 131072
+#define READERS 4
+
+
+// replacement libfuse request / reply funcs
+struct fuse_req {
+   int err;
+   int replied;
+   struct fuse_entry_param e;
+   struct stat st;
+   struct fuse_file_info fi;
+   char* buf;
+   size_t bufsize;
+   size_t count;
+};
+static struct fuse_ctx uctx;
+const struct fuse_ctx* fuse_req_ctx( fuse_req_t req ) { return &uctx; }
+int fuse_reply_err( fuse_req_t req, int err ) { req->err = err; req->replied++; return 0; }
+void fuse_reply_none( fuse_req_t req ) { req->replied++; }
+int fuse_reply_entry( fuse_req_t req, const struct fuse_entry_param* e ) { req->e = *e; req->replied++; return 0; }
+int fuse_reply_create( fuse_req_t req, const struct fuse_entry_param* e, const struct fuse_file_info* fi ) {
+   req->e = *e; req->fi = *fi; req->replied++; return 0;
+}
+int fuse_reply_attr( fuse_req_t req, const struct stat* attr, double timeout ) { req->st = *attr; req->replied++; return 0; }
+int fuse_reply_readlink( fuse_req_t req, const char* link ) { req->buf = strdup( link ); req->replied++; return 0; }
+int fuse_reply_open( fuse_req_t req, const struct fuse_file_info* fi ) { req->fi = *fi; req->replied++; return 0; }
+int fuse_reply_write( fuse_req_t req, size_t count ) { req->count = count; req->replied++; return 0; }
+int fuse_reply_buf( fuse_req_t req, const char* buf, size_t size ) {
+   req->buf = malloc( size + 1 );
+   if ( req->buf ) { memcpy( req->buf, buf, size ); }
+   req->bufsize = size;
+   req->replied++;
+   return 0;
+}
+int fuse_reply_statfs( fuse_req_t req, const struct statvfs* stbuf ) { req->replied++; return 0; }
+int fuse_reply_xattr( fuse_req_t req, size_t count ) { req->count = count; req->replied++; return 0; }
+size_t fuse_add_direntry( fuse_req_t req, char* buf, size_t bufsize, const char* name, const struct stat* stbuf, off_t off ) {
+   size_t need = 24 + ( ( strlen( name ) + 8 ) & ~7UL );
+   if ( need <= bufsize ) { snprintf( buf, need, "%s", name ); }
+   return need;
+}
+
+
+// WARNING: error-prone and ugly method of deleting dir trees, written for simplicity only
+//          don't replicate this junk into ANY production code paths!
+size_t tgtlistpos = 0;
+char** tgtlist = NULL;
+int ftwnotetgt( const char* fpath, const struct stat* sb, int typeflag ) {
+   tgtlist[tgtlistpos] = strdup( fpath );
+   if ( tgtlist[tgtlistpos] == NULL ) {
+      printf( "Failed to duplicate tgt name: \"%s\"\n", fpath );
+      return -1;
+   }
+   tgtlistpos++;
+   if ( tgtlistpos >= 1048576 ) { printf( "Dirlist has insufficient length! (curtgt = %s)\n", fpath ); return -1; }
+   return 0;
+}
+int deletefstree( const char* basepath ) {
+   tgtlist = malloc( sizeof(char*) * 1048576 );
+   if ( tgtlist == NULL ) {
+      printf( "Failed to allocate tgtlist\n" );
+      return -1;
+   }
+   if ( ftw( basepath, ftwnotetgt, 100 ) ) {
+      printf( "Failed to identify reference tgts of \"%s\"\n", basepath );
+      return -1;
+   }
+   int retval = 0;
+   while ( tgtlistpos ) {
+      tgtlistpos--;
+      if ( strcmp( tgtlist[tgtlistpos], basepath ) ) {
+         errno = 0;
+         if ( rmdir( tgtlist[tgtlistpos] ) ) {
+            if ( errno != ENOTDIR  ||  unlink( tgtlist[tgtlistpos] ) ) {
+               printf( "ERROR -- failed to delete \"%s\"\n", tgtlist[tgtlistpos] );
+               retval = -1;
+            }
+         }
+      }
+      free( tgtlist[tgtlistpos] );
+   }
+   free( tgtlist );
+   return retval;
+}
+
+
+// shared state of our concurrent readers
+char* data = NULL;
+fuse_ino_t fileino = 0;
+struct fuse_file_info readfi;
+
+void* reader( void* arg ) {
+   long tnum = (long)arg;
+   off_t offset;
+   // each reader covers every READERS'th MiB of the file, sequentially within each MiB
+   for ( offset = tnum * 1048576; offset < DATASIZE; offset += READERS * 1048576 ) {
+      off_t suboff;
+      for ( suboff = 0; suboff < 1048576; suboff += READSIZE ) {
+         struct fuse_req req = {0};
+         fusell_read( &req, fileino, READSIZE, offset + suboff, &readfi );
+         if ( req.replied != 1  ||  req.err  ||  req.bufsize != READSIZE ) {
+            printf( "ERROR: reader %ld failed to read offset %zd ( err = %d )\n", tnum, offset + suboff, req.err );
+            return (void*)-1;
+         }
+         if ( memcmp( req.buf, data + offset + suboff, READSIZE ) ) {
+            printf( "ERROR: reader %ld retrieved unexpected content at offset %zd\n", tnum, offset + suboff );
+            return (void*)-1;
+         }
+         free( req.buf );
+      }
+   }
+   return NULL;
+}
+
+/**
+ * Check that the given inode references the expected path, relative to the mountpoint
+ * @param fuse_ino_t ino : Inode to check
+ * @param const char* relpath : Expected path, following the mountpoint
+ * @return int : Zero if the path matches, or -1 if not
+ */
+int checkinopath( fuse_ino_t ino, const char* relpath ) {
+   char* path = inode_path( ino );
+   if ( path == NULL ) {
+      printf( "ERROR: failed to retrieve the path of inode %lu\n", (unsigned long)ino );
+      return -1;
+   }
+   char* rootpath = inode_path( FUSE_ROOT_ID );
+   size_t rootlen = strlen( rootpath );
+   int retval = 0;
+   if ( strncmp( path, rootpath, rootlen )  ||  strcmp( path + rootlen, relpath ) ) {
+      printf( "ERROR: inode %lu has path \"%s\", rather than \"%s%s\"\n", (unsigned long)ino, path, rootpath, relpath );
+      retval = -1;
+   }
+   free( rootpath );
+   free( path );
+   return retval;
+}
+
+
+int main( int argc, char** argv ) {
+
+   // NOTE -- I'm ignoring memory leaks for error conditions
+   //         which result in immediate termination
+
+   // create the dirs necessary for DAL/MDAL initialization (ignore EEXIST)
+   errno = 0;
+   if ( mkdir( "./test_fuse_topdir", S_IRWXU )  &&  errno != EEXIST ) {
+      printf( "failed to create test_fuse_topdir\n" );
+      return -1;
+   }
+   errno = 0;
+   if ( mkdir( "./test_fuse_topdir/dal_root", S_IRWXU )  &&  errno != EEXIST ) {
+      printf( "failed to create test_fuse_topdir/dal_root\n" );
+      return -1;
+   }
+   errno = 0;
+   if ( mkdir( "./test_fuse_topdir/mdal_root", S_IRWXU )  &&  errno != EEXIST ) {
+      printf( "failed to create \"./test_fuse_topdir/mdal_root\"\n" );
+      return -1;
+   }
+
+   // verify the marfs config
+   pthread_mutex_t erasurelock;
+   if ( pthread_mutex_init( &erasurelock, NULL ) ) {
+      fprintf( stderr, "ERROR: failed to initialize erasure lock\n" );
+      return -1;
+   }
+   marfs_config* verconf = config_init( "testing/config.xml", &erasurelock );
+   int flags = CFG_FIX | CFG_OWNERCHECK | CFG_MDALCHECK | CFG_DALCHECK | CFG_RECURSE;
+   if ( verconf == NULL  ||  config_verify( verconf, ".", flags ) ) {
+      printf( "failed to verify config\n" );
+      return -1;
+   }
+   config_term( verconf );
+   pthread_mutex_destroy( &erasurelock );
+
+   // initialize our FUSE ctxt, just as the daemon would
+   if ( setenv( "MARFS_CONFIG_PATH", "testing/config.xml", 1 ) ) {
+      printf( "failed to set MARFS_CONFIG_PATH\n" );
+      return -1;
+   }
+   uctx.uid = getuid();
+   uctx.gid = getgid();
+   marfs_fuse_init();
+
+   // lookup our target NS
+   struct fuse_req req = {0};
+   fusell_lookup( &req, FUSE_ROOT_ID, "gransom-allocation" );
+   if ( req.replied != 1  ||  req.err  ||  req.e.ino <= CONFIGVER_INO ) {
+      printf( "ERROR: failed to lookup \"gransom-allocation\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   fuse_ino_t gaino = req.e.ino;
+   memset( &req, 0, sizeof(req) );
+   fusell_lookup( &req, gaino, "heavily-protected-data" );
+   if ( req.err ) {
+      printf( "ERROR: failed to lookup \"heavily-protected-data\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   fuse_ino_t nsino = req.e.ino;
+   memset( &req, 0, sizeof(req) );
+   fusell_lookup( &req, FUSE_ROOT_ID, "gransom-allocation" );
+   if ( req.e.ino != gaino ) {
+      printf( "ERROR: repeated lookup produced a new inode ( %lu != %lu )\n", (unsigned long)req.e.ino, (unsigned long)gaino );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_lookup( &req, nsino, "nonexistent" );
+   if ( req.err != ENOENT ) {
+      printf( "ERROR: unexpected result of lookup of a nonexistent entry ( err = %d )\n", req.err );
+      return -1;
+   }
+
+   // read the config version file
+   memset( &req, 0, sizeof(req) );
+   fusell_lookup( &req, FUSE_ROOT_ID, CONFIGVER_FNAME );
+   if ( req.e.ino != CONFIGVER_INO ) {
+      printf( "ERROR: unexpected inode of config version file: %lu\n", (unsigned long)req.e.ino );
+      return -1;
+   }
+   struct fuse_file_info cfi = {0};
+   memset( &req, 0, sizeof(req) );
+   fusell_open( &req, CONFIGVER_INO, &cfi );
+   memset( &req, 0, sizeof(req) );
+   fusell_read( &req, CONFIGVER_INO, 4096, 0, &cfi );
+   if ( req.err  ||  req.bufsize < 2  ||  req.buf[req.bufsize - 1] != '\n' ) {
+      printf( "ERROR: failed to read config version file ( err = %d )\n", req.err );
+      return -1;
+   }
+   if ( strncmp( req.buf, "0.0001-fusetest-notarealversion", req.bufsize - 1 ) ) {
+      printf( "ERROR: unexpected config version: \"%.*s\"\n", (int)req.bufsize, req.buf );
+      return -1;
+   }
+   free( req.buf );
+
+   // create a dir tree, containing a single file
+   memset( &req, 0, sizeof(req) );
+   fusell_mkdir( &req, nsino, "fusedir", 0755 );
+   if ( req.err ) {
+      printf( "ERROR: failed to create \"fusedir\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   fuse_ino_t dirino = req.e.ino;
+   memset( &req, 0, sizeof(req) );
+   fusell_mkdir( &req, dirino, "subdir", 0755 );
+   if ( req.err ) {
+      printf( "ERROR: failed to create \"subdir\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   fuse_ino_t subino = req.e.ino;
+   struct fuse_file_info writefi = {0};
+   writefi.flags = O_WRONLY | O_CREAT;
+   memset( &req, 0, sizeof(req) );
+   fusell_create( &req, subino, "file", 0644, &writefi );
+   if ( req.err  ||  req.replied != 1 ) {
+      printf( "ERROR: failed to create \"file\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   fileino = req.e.ino;
+   writefi = req.fi;
+   data = malloc( DATASIZE );
+   if ( data == NULL ) {
+      printf( "ERROR: failed to allocate a data buffer\n" );
+      return -1;
+   }
+   size_t index;
+   for ( index = 0; index < DATASIZE; index++ ) { data[index] = (char)( index * 7 % 251 ); }
+   for ( index = 0; index < DATASIZE; index += 1048576 ) {
+      memset( &req, 0, sizeof(req) );
+      fusell_write( &req, fileino, data + index, 1048576, index, &writefi );
+      if ( req.err  ||  req.count != 1048576 ) {
+         printf( "ERROR: failed to write offset %zu of \"file\" ( err = %d )\n", index, req.err );
+         return -1;
+      }
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_release( &req, fileino, &writefi );
+   if ( req.err ) {
+      printf( "ERROR: failed to release write handle of \"file\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_getattr( &req, fileino, NULL );
+   if ( req.err  ||  req.st.st_size != DATASIZE ) {
+      printf( "ERROR: unexpected attrs of \"file\" ( err = %d, size = %zd )\n", req.err, req.st.st_size );
+      return -1;
+   }
+
+   // open the file for read, and retrieve its first IO via the initial cursor
+   readfi.flags = O_RDONLY;
+   memset( &req, 0, sizeof(req) );
+   fusell_open( &req, fileino, &readfi );
+   if ( req.err ) {
+      printf( "ERROR: failed to open \"file\" for read ( err = %d )\n", req.err );
+      return -1;
+   }
+   readfi = req.fi;
+   memset( &req, 0, sizeof(req) );
+   fusell_read( &req, fileino, READSIZE, 0, &readfi );
+   if ( req.err  ||  req.bufsize != READSIZE  ||  memcmp( req.buf, data, READSIZE ) ) {
+      printf( "ERROR: failed to read start of \"file\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   free( req.buf );
+
+   // rename the parent of the open file, and verify that inode paths follow
+   memset( &req, 0, sizeof(req) );
+   fusell_rename( &req, nsino, "fusedir", nsino, "fusedir2" );
+   if ( req.err ) {
+      printf( "ERROR: failed to rename \"fusedir\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   if ( checkinopath( dirino, "/gransom-allocation/heavily-protected-data/fusedir2" )  ||
+        checkinopath( subino, "/gransom-allocation/heavily-protected-data/fusedir2/subdir" )  ||
+        checkinopath( fileino, "/gransom-allocation/heavily-protected-data/fusedir2/subdir/file" ) ) {
+      return -1;
+   }
+
+   // concurrent reads of the renamed file must open additional cursors, by its new path
+   pthread_t threads[READERS];
+   long tnum;
+   for ( tnum = 0; tnum < READERS; tnum++ ) {
+      if ( pthread_create( threads + tnum, NULL, reader, (void*)tnum ) ) {
+         printf( "ERROR: failed to create reader thread %ld\n", tnum );
+         return -1;
+      }
+   }
+   int readerr = 0;
+   for ( tnum = 0; tnum < READERS; tnum++ ) {
+      void* tres = NULL;
+      pthread_join( threads[tnum], &tres );
+      if ( tres ) { readerr = 1; }
+   }
+   if ( readerr ) { return -1; }
+   marfs_fuse_file file = (marfs_fuse_file)readfi.fh;
+   if ( file->noexpand  ||  file->cursors[1] == NULL ) {
+      printf( "ERROR: failed to open any additional read cursors of the renamed file\n" );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_release( &req, fileino, &readfi );
+   if ( req.err ) {
+      printf( "ERROR: failed to release read handle of \"file\" ( err = %d )\n", req.err );
+      return -1;
+   }
+
+   // renames must also reach inodes whose parent dir inode has been forgotten
+   fusell_forget( &req, subino, 1 );
+   memset( &req, 0, sizeof(req) );
+   fusell_rename( &req, nsino, "fusedir2", nsino, "fusedir3" );
+   if ( req.err ) {
+      printf( "ERROR: failed to rename \"fusedir2\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   if ( checkinopath( dirino, "/gransom-allocation/heavily-protected-data/fusedir3" )  ||
+        checkinopath( fileino, "/gransom-allocation/heavily-protected-data/fusedir3/subdir/file" ) ) {
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_lookup( &req, dirino, "subdir" );
+   if ( req.err ) {
+      printf( "ERROR: failed to lookup \"subdir\" of renamed dir ( err = %d )\n", req.err );
+      return -1;
+   }
+   subino = req.e.ino;
+   memset( &req, 0, sizeof(req) );
+   fusell_getattr( &req, fileino, NULL );
+   if ( req.err  ||  req.st.st_size != DATASIZE ) {
+      printf( "ERROR: unexpected attrs of renamed \"file\" ( err = %d )\n", req.err );
+      return -1;
+   }
+
+   // completed files may be chmod'd, but not truncated
+   struct stat setst = {0};
+   setst.st_mode = 0600;
+   setst.st_size = 4096;
+   memset( &req, 0, sizeof(req) );
+   fusell_setattr( &req, fileino, &setst, FUSE_SET_ATTR_MODE, NULL );
+   if ( req.err  ||  ( req.st.st_mode & 0777 ) != 0600 ) {
+      printf( "ERROR: failed to chmod \"file\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_setattr( &req, fileino, &setst, FUSE_SET_ATTR_SIZE, NULL );
+   if ( req.err != EINVAL ) {
+      printf( "ERROR: unexpected result of truncating a completed file ( err = %d )\n", req.err );
+      return -1;
+   }
+
+   // list the subdir, both fully and in pieces
+   struct fuse_file_info dirfi = {0};
+   memset( &req, 0, sizeof(req) );
+   fusell_opendir( &req, subino, &dirfi );
+   if ( req.err ) {
+      printf( "ERROR: failed to open \"subdir\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   dirfi = req.fi;
+   memset( &req, 0, sizeof(req) );
+   fusell_readdir( &req, subino, 4096, 0, &dirfi );
+   if ( req.err  ||  req.bufsize == 0 ) {
+      printf( "ERROR: failed to read \"subdir\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   free( req.buf );
+   memset( &req, 0, sizeof(req) );
+   fusell_readdir( &req, subino, 64, 0, &dirfi );
+   if ( req.err  ||  req.bufsize > 64 ) {
+      printf( "ERROR: readdir overran the requested size ( err = %d, size = %zu )\n", req.err, req.bufsize );
+      return -1;
+   }
+   free( req.buf );
+   memset( &req, 0, sizeof(req) );
+   fusell_releasedir( &req, subino, &dirfi );
+   if ( req.err ) {
+      printf( "ERROR: failed to release \"subdir\" ( err = %d )\n", req.err );
+      return -1;
+   }
+
+   // create and read a symlink
+   memset( &req, 0, sizeof(req) );
+   fusell_symlink( &req, "file", subino, "link" );
+   if ( req.err ) {
+      printf( "ERROR: failed to create \"link\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   fuse_ino_t linkino = req.e.ino;
+   memset( &req, 0, sizeof(req) );
+   fusell_readlink( &req, linkino );
+   if ( req.err  ||  strcmp( req.buf, "file" ) ) {
+      printf( "ERROR: failed to read \"link\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   free( req.buf );
+
+   // cleanup our dir tree
+   memset( &req, 0, sizeof(req) );
+   fusell_unlink( &req, subino, "link" );
+   if ( req.err ) {
+      printf( "ERROR: failed to unlink \"link\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_unlink( &req, subino, "file" );
+   if ( req.err ) {
+      printf( "ERROR: failed to unlink \"file\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_getattr( &req, fileino, NULL );
+   if ( req.err != ESTALE  &&  req.err != ENOENT ) {
+      printf( "ERROR: unexpected result of getattr of an unlinked file ( err = %d )\n", req.err );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_rmdir( &req, dirino, "subdir" );
+   if ( req.err ) {
+      printf( "ERROR: failed to remove \"subdir\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   memset( &req, 0, sizeof(req) );
+   fusell_rmdir( &req, nsino, "fusedir3" );
+   if ( req.err ) {
+      printf( "ERROR: failed to remove \"fusedir3\" ( err = %d )\n", req.err );
+      return -1;
+   }
+   fusell_forget( &req, linkino, 1 );
+   fusell_forget( &req, fileino, 1 );
+   fusell_forget( &req, subino, 1 );
+   fusell_forget( &req, dirino, 1 );
+   fusell_forget( &req, nsino, 1 );
+   fusell_forget( &req, gaino, 2 );
+   marfs_fuse_destroy( NULL );
+   free( data );
+
+   // delete dal/mdal dir structure
+   if ( deletefstree( "./test_fuse_topdir" ) ) {
+      printf( "Failed to delete subdirs of test_fuse_topdir\n" );
+      return -1;
+   }
+   rmdir( "./test_fuse_topdir" );
+
+   return 0;
+}
@@ -21,9 +21,131 @@ extern "C"
 #include <pthread.h>
 #include <stdint.h>
 
-#define SUPER_BLOCK_CNT 4
+#define SUPER_BLOCK_CNT 4      // default ( and minimum ) count of ioblocks per ioqueue
+#define MAX_SUPER_BLOCK_CNT 64 // maximum count of ioblocks per ioqueue
+#define IOBLOCK_POOL_ALIGN 4096 // ioblock buffer alignment, and granularity of buffer pool size classes
 #define CRC_BYTES 4 // DO NOT decrease without adjusting CRC gen and block creation code!
 
+/* ------------------------------   NUMA PLACEMENT   ------------------------------ */
+
+// CPU and memory placement info for a single NUMA node
+typedef struct io_numa_struct
+{
+   int node;               // NUMA node number
+   unsigned long *cpumask; // bitmask of the CPUs local to this node
+   size_t masklen;         // length of the cpumask list
+} io_numa;
+
+/**
+ * Determine the number of NUMA nodes of this system
+ * @return int : One greater than the highest NUMA node number, or zero if NUMA info is unavailable
+ */
+int io_numa_count(void);
+
+/**
+ * Populate an io_numa struct for the given NUMA node
+ * @param io_numa* numa : Reference to the io_numa struct to be populated
+ * @param int node : NUMA node number
+ * @return int : Zero on success, or -1 if the node does not exist or its CPUs could not be determined
+ */
+int io_numa_init(io_numa *numa, int node);
+
+/**
+ * Free the contents of an io_numa struct
+ * @param io_numa* numa : Reference to the io_numa struct to be freed
+ */
+void io_numa_free(io_numa *numa);
+
+/**
+ * Bind the calling thread to the CPUs of the given NUMA node
+ * @param const io_numa* numa : Reference to the target NUMA node
+ * @return int : Zero on success, or -1 on failure
+ */
+int io_numa_bind_thread(const io_numa *numa);
+
+/**
+ * Set a preference for the pages of the given ( not yet populated ) buffer to reside on the given NUMA node
+ * @param const io_numa* numa : Reference to the target NUMA node
+ * @param void* buff : Page aligned buffer
+ * @param size_t size : Size of the buffer
+ * @return int : Zero on success, or -1 on failure
+ */
+int io_numa_bind_memory(const io_numa *numa, void *buff, size_t size);
+
+/* ------------------------------   IOBLOCK BUFFER POOL   ------------------------------ */
+
+// Idle buffers of a single size
+typedef struct ioblock_pool_class_struct
+{
+   size_t bufsz;   // size of each buffer in this class ( a multiple of IOBLOCK_POOL_ALIGN )
+   void **idle;    // list of idle buffers
+   size_t idlecnt; // number of idle buffers
+   size_t idlemax; // allocated length of the idle list
+} ioblock_pool_class;
+
+// Buffer pool statistics
+typedef struct ioblock_pool_stats_struct
+{
+   size_t hits;      // buffer requests satisfied by an idle buffer
+   size_t misses;    // buffer requests requiring a new allocation
+   size_t allocsz;   // current total size of allocated buffers ( both in use and idle )
+   size_t idlesz;    // current total size of idle buffers
+   size_t peaksz;    // peak value of 'allocsz'
+} ioblock_pool_stats;
+
+// Pool of ioblock buffers, shared by all ioqueues of a ne_ctxt
+typedef struct ioblock_pool_struct
+{
+   pthread_mutex_t lock;         // lock for pool manipulation
+   ioblock_pool_class *classes;  // list of buffer size classes
+   int classcnt;                 // number of buffer size classes
+   size_t maxidle;               // maximum total size of idle buffers to be retained
+   const io_numa *numa;          // NUMA node on which new buffers are to be allocated ( NULL if none )
+   ioblock_pool_stats stats;     // pool statistics
+} ioblock_pool;
+
+/**
+ * Creates a new ioblock_pool
+ * @param size_t maxidle : Maximum total size of idle buffers to be retained by the pool
+ *                         ( buffers released beyond this limit are simply freed )
+ * @param const io_numa* numa : NUMA node on which to allocate buffers ( NULL if no preference )
+ *                              NOTE -- this reference must remain valid for the life of the pool
+ * @return ioblock_pool* : Reference to the new ioblock_pool, or NULL on failure
+ */
+ioblock_pool *create_ioblock_pool(size_t maxidle, const io_numa *numa);
+
+/**
+ * Destroys an ioblock_pool, freeing all idle buffers
+ * @param ioblock_pool* pool : Reference to the ioblock_pool to be destroyed
+ * @return int : Zero on success, or -1 if buffers from the pool remain in use
+ *               ( the pool is destroyed regardless; such buffers are simply leaked )
+ */
+int destroy_ioblock_pool(ioblock_pool *pool);
+
+/**
+ * Retrieve a buffer of at least the given size from an ioblock_pool
+ * @param ioblock_pool* pool : Reference to the ioblock_pool
+ * @param size_t size : Minimum size of the requested buffer
+ * @return void* : Reference to a IOBLOCK_POOL_ALIGN aligned buffer, or NULL on failure
+ */
+void *ioblock_pool_get(ioblock_pool *pool, size_t size);
+
+/**
+ * Return a buffer to an ioblock_pool
+ * @param ioblock_pool* pool : Reference to the ioblock_pool
+ * @param void* buff : Buffer to be released ( previously produced by ioblock_pool_get() )
+ * @param size_t size : Size value passed to ioblock_pool_get() for this buffer
+ */
+void ioblock_pool_put(ioblock_pool *pool, void *buff, size_t size);
+
+/**
+ * Retrieve statistics of an ioblock_pool
+ * @param ioblock_pool* pool : Reference to the ioblock_pool
+ * @param ioblock_pool_stats* stats : Reference to the stats struct to be populated
+ * @return int : Zero on success, or -1 on failure
+ */
+int ioblock_pool_getstats(ioblock_pool *pool, ioblock_pool_stats *stats);
+
 /* ------------------------------   IO QUEUE   ------------------------------ */
 
 typedef struct ioblock_struct
@@ -41,7 +163,9 @@ typedef struct ioqueue_struct
    pthread_cond_t avail_block;          // condition for awaiting an available block
    int head;                            // integer indicating location of the next available block
    int depth;                           // current depth of the queue
-   ioblock block_list[SUPER_BLOCK_CNT]; // list of ioblocks
+   int blockcnt;                        // total number of ioblocks in the queue
+   ioblock *block_list;                 // list of ioblocks
+   ioblock_pool *pool;                  // pool from which ioblock buffers were retrieved ( NULL if none )
 
    //size_t          fill_threshold;
    size_t split_threshold;
@@ -56,9 +180,13 @@ typedef struct ioqueue_struct
  * Creates a new IOQueue
  * @param size_t iosz : Byte size of each IO to be performed
  * @param size_t partsz : Byte size of each erasure part
+ * @param DAL_MODE mode : Mode of the IO to be performed
+ * @param int blockcnt : Number of ioblocks in the queue ( SUPER_BLOCK_CNT to MAX_SUPER_BLOCK_CNT )
+ * @param ioblock_pool* pool : Pool from which to retrieve ioblock buffers
+ *                             ( if NULL, buffers are allocated directly )
  * @return ioqueue* : Reference to the newly created IOQueue
  */
-ioqueue *create_ioqueue(size_t iosz, size_t partsz, DAL_MODE mode);
+ioqueue *create_ioqueue(size_t iosz, size_t partsz, DAL_MODE mode, int blockcnt, ioblock_pool *pool);
 
 /**
  * Destroys an existing IOQueue
@@ -100,6 +228,14 @@ int align_ioblock(ioblock *cur_block, size_t trim, ioqueue *ioq);
  */
 int reserve_ioblock(ioblock **cur_block, ioblock **push_block, ioqueue *ioq);
 
+/**
+ * Calculate how much additional data can be stored to the given ioblock before it must be pushed
+ * @param ioblock* block : Reference to the ioblock to check
+ * @param ioqueue* ioq : Reference to the ioqueue struct from which the ioblock was gathered
+ * @return size_t : Data size remaining before the ioblock reaches its split threshold ( zero if full )
+ */
+size_t ioblock_remaining(ioblock *block, ioqueue *ioq);
+
 /**
  * Retrieve a buffer target reference for writing into the given ioblock
  * @param ioblock* block : Reference to the ioblock to retrieve a target for
@@ -132,6 +268,17 @@ void ioblock_update_fill(ioblock *block, size_t bytes, char bad_data);
  */
 size_t ioblock_get_fill(ioblock *block);
 
+/**
+ * Calculate a checksum of the given buffer, continuing from a previous checksum value
+ * NOTE -- this function is stateless, and may be called concurrently by any number of threads
+ * @param DAL_CRC crctype : Checksum algorithm to be used
+ * @param uint32_t crc : Previous checksum value to continue from ( or CRC_SEED, for a new checksum )
+ * @param const void* buf : Buffer to be checksummed
+ * @param size_t len : Length of the buffer
+ * @return uint32_t : Checksum of all data covered by the previous value, followed by the given buffer
+ */
+uint32_t io_checksum(DAL_CRC crctype, uint32_t crc, const void *buf, size_t len);
+
 /**
  * Simply makes an ioblock available for use again by increasing ioqueue depth (works due to single producer & consumer assumption)
  * @param ioqueue* ioq : Reference to the ioqueue struct to have depth increased
@@ -141,6 +288,8 @@ int release_ioblock(ioqueue *ioq);
 
 /* ------------------------------   THREAD BEHAVIOR   ------------------------------ */
 
+#define VERIFY_SAMPLE 8 // with lazy verification, read threads check the CRC of only one of every VERIFY_SAMPLE IOs
+
 // This struct contains all info read threads should need
 // to access their respective data blocks
 typedef struct global_state_struct
@@ -154,7 +303,12 @@ typedef struct global_state_struct
    char meta_error;
    char data_error;
    ioqueue *ioq;
-   pthread_mutex_t* erasurelock;
+   int qdepth;                   // ioblock count of 'ioq' ( SUPER_BLOCK_CNT, if unset )
+   ioblock_pool *iopool;         // buffer pool of 'ioq' ( NULL, if unset )
+   pthread_mutex_t* erasurelock; // unused by iothreads ( CRC generation requires no serialization )
+   char lazyverify;              // if non-zero, read threads verify only a sample of IO CRCs ( see VERIFY_SAMPLE )
+   const io_numa *numa;          // if non-NULL, block threads bind themselves to the CPUs of this NUMA node
+   BLOCK_CTXT *handoff;          // if non-NULL, read threads pass their open DAL handle here at term, rather than closing it
 } gthread_state;
 
 // Write thread internal state struct
@@ -166,6 +320,9 @@ typedef struct thread_state_struct
    ioblock *iob;
    uint64_t crcsumchk;
    char continuous;
+   struct iovec *wiov; // buffers of held ioblocks, awaiting a coalesced write ( 'wmax' entries )
+   int wcnt;           // number of ioblocks currently held
+   int wmax;           // number of ioblocks to be coalesced into each write
 } thread_state;
 
 /**
@@ -203,7 +360,10 @@ int write_consume(void **state, void **work_todo);
 int read_produce(void **state, void **work_tofill);
 
 /**
- * No-op function, just to fill out the TQ struct
+ * Write out any ioblocks held for a coalesced put, prior to pausing
+ * @param void** state : Thread state reference
+ * @param void** prev_work : Reference to any previously consumed buffer
+ * @return int : Integer return code ( -1 on error, 0 on success )
  */
 int write_pause(void **state, void **prev_work);
 
@@ -234,7 +394,7 @@ int read_resume(void **state, void **prev_work);
 void write_term(void **state, void **prev_work, TQ_Control_Flags flg);
 
 /**
- * Close our target reference
+ * Close ( or hand off ) our target reference
  * @param void** state : Thread state reference
  * @param void** prev_work : Reference to any unused previous buffer
  * @param TQ_Control_Flags flg : Control flags values at thread term
@@ -65,6 +65,9 @@ underlying skt_etc() functions.
 #include "logging/logging.h"
 
 #include "io/io.h"
+#include "general_include/crc.c"
+
+#include <isa-l.h>
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -75,9 +78,363 @@ underlying skt_etc() functions.
 #include <unistd.h>
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+
+
+
+
+/* ------------------------------   NUMA PLACEMENT   ------------------------------ */
 
+#define NUMA_SYSFS_ROOT "/sys/devices/system/node"
+#define NUMA_MPOL_PREFERRED 1 // equivalent of MPOL_PREFERRED ( see mbind() manpage )
+#define BITS_PER_MASK ( sizeof( unsigned long ) * 8 )
 
 
+/**
+ * Determine the number of NUMA nodes of this system
+ * @return int : One greater than the highest NUMA node number, or zero if NUMA info is unavailable
+ */
+int io_numa_count( void ) {
+   DIR* nodedir = opendir( NUMA_SYSFS_ROOT );
+   if ( nodedir == NULL ) {
+      LOG( LOG_INFO, "NUMA info is unavailable ( failed to open \"%s\" )\n", NUMA_SYSFS_ROOT );
+      return 0;
+   }
+   int count = 0;
+   struct dirent* entry;
+   while ( (entry = readdir( nodedir )) != NULL ) {
+      int node;
+      char tail;
+      if ( sscanf( entry->d_name, "node%d%c", &node, &tail ) == 1  &&  node >= count ) {
+         count = node + 1;
+      }
+   }
+   closedir( nodedir );
+   return count;
+}
+
+
+/**
+ * Populate an io_numa struct for the given NUMA node
+ * @param io_numa* numa : Reference to the io_numa struct to be populated
+ * @param int node : NUMA node number
+ * @return int : Zero on success, or -1 if the node does not exist or its CPUs could not be determined
+ */
+int io_numa_init( io_numa* numa, int node ) {
+   char path[128];
+   snprintf( path, sizeof( path ), "%s/node%d/cpulist", NUMA_SYSFS_ROOT, node );
+   FILE* cpulist = fopen( path, "r" );
+   if ( cpulist == NULL ) {
+      LOG( LOG_ERR, "Failed to open CPU list of NUMA node %d ( \"%s\" )\n", node, path );
+      return -1;
+   }
+   // parse the list, of the form "0-3,8,10-11"
+   numa->node = node;
+   numa->cpumask = NULL;
+   numa->masklen = 0;
+   size_t cpucnt = 0;
+   unsigned long first, last;
+   int parsed;
+   while ( (parsed = fscanf( cpulist, "%lu", &first )) == 1 ) {
+      last = first;
+      int sep = fgetc( cpulist );
+      if ( sep == '-' ) {
+         if ( fscanf( cpulist, "%lu", &last ) != 1  ||  last < first ) { break; }
+         sep = fgetc( cpulist );
+      }
+      // expand our mask to cover the new range
+      size_t reqlen = ( last / BITS_PER_MASK ) + 1;
+      if ( reqlen > numa->masklen ) {
+         unsigned long* newmask = realloc( numa->cpumask, sizeof( unsigned long ) * reqlen );
+         if ( newmask == NULL ) {
+            LOG( LOG_ERR, "Failed to allocate a CPU mask for NUMA node %d\n", node );
+            break;
+         }
+         memset( newmask + numa->masklen, 0, sizeof( unsigned long ) * (reqlen - numa->masklen) );
+         numa->cpumask = newmask;
+         numa->masklen = reqlen;
+      }
+      for ( ; first <= last; first++ ) {
+         numa->cpumask[ first / BITS_PER_MASK ] |= ( 1UL << (first % BITS_PER_MASK) );
+         cpucnt++;
+      }
+      if ( sep != ',' ) { parsed = EOF; break; }
+   }
+   fclose( cpulist );
+   if ( parsed != EOF  ||  cpucnt == 0 ) {
+      LOG( LOG_ERR, "Failed to parse any CPUs for NUMA node %d\n", node );
+      io_numa_free( numa );
+      return -1;
+   }
+   LOG( LOG_INFO, "NUMA node %d has %zu local CPUs\n", node, cpucnt );
+   return 0;
+}
+
+
+/**
+ * Free the contents of an io_numa struct
+ * @param io_numa* numa : Reference to the io_numa struct to be freed
+ */
+void io_numa_free( io_numa* numa ) {
+   free( numa->cpumask );
+   numa->cpumask = NULL;
+   numa->masklen = 0;
+}
+
+
+/**
+ * Bind the calling thread to the CPUs of the given NUMA node
+ * @param const io_numa* numa : Reference to the target NUMA node
+ * @return int : Zero on success, or -1 on failure
+ */
+int io_numa_bind_thread( const io_numa* numa ) {
+   cpu_set_t cpuset;
+   CPU_ZERO( &cpuset );
+   size_t cpu;
+   for ( cpu = 0; cpu < ( numa->masklen * BITS_PER_MASK )  &&  cpu < CPU_SETSIZE; cpu++ ) {
+      if ( numa->cpumask[ cpu / BITS_PER_MASK ] & ( 1UL << (cpu % BITS_PER_MASK) ) ) {
+         CPU_SET( cpu, &cpuset );
+      }
+   }
+   int res = pthread_setaffinity_np( pthread_self(), sizeof( cpu_set_t ), &cpuset );
+   if ( res ) {
+      LOG( LOG_ERR, "Failed to bind thread to the CPUs of NUMA node %d\n", numa->node );
+      errno = res;
+      return -1;
+   }
+   return 0;
+}
+
+
+/**
+ * Set a preference for the pages of the given ( not yet populated ) buffer to reside on the given NUMA node
+ * @param const io_numa* numa : Reference to the target NUMA node
+ * @param void* buff : Page aligned buffer
+ * @param size_t size : Size of the buffer
+ * @return int : Zero on success, or -1 on failure
+ */
+int io_numa_bind_memory( const io_numa* numa, void* buff, size_t size ) {
+#ifdef SYS_mbind
+   unsigned long nodemask[ ( numa->node / BITS_PER_MASK ) + 1 ];
+   memset( nodemask, 0, sizeof( nodemask ) );
+   nodemask[ numa->node / BITS_PER_MASK ] = ( 1UL << (numa->node % BITS_PER_MASK) );
+   // NOTE -- use the raw syscall, to avoid any libnuma dependency
+   if ( syscall( SYS_mbind, buff, size, NUMA_MPOL_PREFERRED, nodemask, (sizeof( nodemask ) * 8) + 1, 0 ) ) {
+      LOG( LOG_ERR, "Failed to set NUMA node %d preference for a %zu byte buffer\n", numa->node, size );
+      return -1;
+   }
+   return 0;
+#else
+   LOG( LOG_ERR, "NUMA memory placement is unsupported on this platform\n" );
+   errno = ENOSYS;
+   return -1;
+#endif
+}
+
+
+/* ------------------------------   IOBLOCK BUFFER POOL   ------------------------------ */
+
+
+/**
+ * Creates a new ioblock_pool
+ * @param size_t maxidle : Maximum total size of idle buffers to be retained by the pool
+ *                         ( buffers released beyond this limit are simply freed )
+ * @param const io_numa* numa : NUMA node on which to allocate buffers ( NULL if no preference )
+ *                              NOTE -- this reference must remain valid for the life of the pool
+ * @return ioblock_pool* : Reference to the new ioblock_pool, or NULL on failure
+ */
+ioblock_pool* create_ioblock_pool( size_t maxidle, const io_numa* numa ) {
+   ioblock_pool* pool = calloc( 1, sizeof( struct ioblock_pool_struct ) );
+   if ( pool == NULL ) {
+      LOG( LOG_ERR, "failed to allocate memory for an ioblock_pool_struct!\n" );
+      return NULL;
+   }
+   if ( pthread_mutex_init( &(pool->lock), NULL ) ) {
+      LOG( LOG_ERR, "failed to initialize the ioblock_pool lock!\n" );
+      free( pool );
+      return NULL;
+   }
+   pool->maxidle = maxidle;
+   pool->numa = numa;
+   return pool;
+}
+
+
+/**
+ * Destroys an ioblock_pool, freeing all idle buffers
+ * @param ioblock_pool* pool : Reference to the ioblock_pool to be destroyed
+ * @return int : Zero on success, or -1 if buffers from the pool remain in use
+ *               ( the pool is destroyed regardless; such buffers are simply leaked )
+ */
+int destroy_ioblock_pool( ioblock_pool* pool ) {
+   if ( pool == NULL ) {
+      LOG( LOG_ERR, "Received NULL ioblock_pool reference!\n" );
+      return -1;
+   }
+   int retval = 0;
+   if ( pool->stats.allocsz != pool->stats.idlesz ) {
+      LOG( LOG_WARNING, "Destroying ioblock_pool with %zu bytes of buffers still in use\n", pool->stats.allocsz - pool->stats.idlesz );
+      retval = -1;
+   }
+   int c;
+   for ( c = 0; c < pool->classcnt; c++ ) {
+      ioblock_pool_class* class = pool->classes + c;
+      while ( class->idlecnt ) {
+         class->idlecnt--;
+         free( class->idle[class->idlecnt] );
+      }
+      free( class->idle );
+   }
+   free( pool->classes );
+   pthread_mutex_destroy( &(pool->lock) );
+   free( pool );
+   return retval;
+}
+
+
+/**
+ * Identify ( or create ) the size class of an ioblock_pool for buffers of the given size
+ * NOTE -- the caller must hold the pool lock
+ * @param ioblock_pool* pool : Reference to the ioblock_pool
+ * @param size_t bufsz : Size class value ( a multiple of IOBLOCK_POOL_ALIGN )
+ * @return ioblock_pool_class* : Reference to the size class, or NULL on failure
+ */
+static ioblock_pool_class* ioblock_pool_class_lookup( ioblock_pool* pool, size_t bufsz ) {
+   int c;
+   for ( c = 0; c < pool->classcnt; c++ ) {
+      if ( pool->classes[c].bufsz == bufsz ) { return pool->classes + c; }
+   }
+   // NOTE -- most contexts only ever see a handful of iosz / partsz combinations
+   ioblock_pool_class* newclasses = realloc( pool->classes, sizeof( ioblock_pool_class ) * (pool->classcnt + 1) );
+   if ( newclasses == NULL ) {
+      LOG( LOG_ERR, "failed to expand ioblock_pool class list!\n" );
+      return NULL;
+   }
+   pool->classes = newclasses;
+   ioblock_pool_class* class = pool->classes + pool->classcnt;
+   pool->classcnt++;
+   class->bufsz = bufsz;
+   class->idle = NULL;
+   class->idlecnt = 0;
+   class->idlemax = 0;
+   LOG( LOG_INFO, "Created ioblock_pool class for %zu byte buffers\n", bufsz );
+   return class;
+}
+
+
+/**
+ * Retrieve a buffer of at least the given size from an ioblock_pool
+ * @param ioblock_pool* pool : Reference to the ioblock_pool
+ * @param size_t size : Minimum size of the requested buffer
+ * @return void* : Reference to a IOBLOCK_POOL_ALIGN aligned buffer, or NULL on failure
+ */
+void* ioblock_pool_get( ioblock_pool* pool, size_t size ) {
+   size_t bufsz = ( (size + IOBLOCK_POOL_ALIGN - 1) / IOBLOCK_POOL_ALIGN ) * IOBLOCK_POOL_ALIGN;
+   if ( pthread_mutex_lock( &(pool->lock) ) ) {
+      LOG( LOG_ERR, "Failed to aquire ioblock_pool lock!\n" );
+      return NULL;
+   }
+   ioblock_pool_class* class = ioblock_pool_class_lookup( pool, bufsz );
+   if ( class == NULL ) {
+      pthread_mutex_unlock( &(pool->lock) );
+      return NULL;
+   }
+   if ( class->idlecnt ) {
+      class->idlecnt--;
+      void* buff = class->idle[class->idlecnt];
+      pool->stats.hits++;
+      pool->stats.idlesz -= bufsz;
+      pthread_mutex_unlock( &(pool->lock) );
+      return buff;
+   }
+   pool->stats.misses++;
+   pthread_mutex_unlock( &(pool->lock) );
+   // allocate a new buffer, outside of the pool lock
+   void* buff = NULL;
+   int allocres = posix_memalign( &(buff), IOBLOCK_POOL_ALIGN, bufsz );
+   if ( allocres  ||  buff == NULL ) {
+      LOG( LOG_ERR, "failed to allocate a %zu byte ioblock buffer!\n", bufsz );
+      errno = allocres; // posix_memalign() does not set errno for us
+      return NULL;
+   }
+   // no pages of the new buffer have been touched, so they can still be placed
+   if ( pool->numa  &&  io_numa_bind_memory( pool->numa, buff, bufsz ) ) {
+      LOG( LOG_WARNING, "Failed to place new ioblock buffer on NUMA node %d\n", pool->numa->node );
+   }
+   pthread_mutex_lock( &(pool->lock) );
+   pool->stats.allocsz += bufsz;
+   if ( pool->stats.allocsz > pool->stats.peaksz ) { pool->stats.peaksz = pool->stats.allocsz; }
+   pthread_mutex_unlock( &(pool->lock) );
+   return buff;
+}
+
+
+/**
+ * Return a buffer to an ioblock_pool
+ * @param ioblock_pool* pool : Reference to the ioblock_pool
+ * @param void* buff : Buffer to be released ( previously produced by ioblock_pool_get() )
+ * @param size_t size : Size value passed to ioblock_pool_get() for this buffer
+ */
+void ioblock_pool_put( ioblock_pool* pool, void* buff, size_t size ) {
+   size_t bufsz = ( (size + IOBLOCK_POOL_ALIGN - 1) / IOBLOCK_POOL_ALIGN ) * IOBLOCK_POOL_ALIGN;
+   if ( pthread_mutex_lock( &(pool->lock) ) ) {
+      LOG( LOG_ERR, "Failed to aquire ioblock_pool lock, freeing buffer!\n" );
+      free( buff ); // NOTE -- pool stats will no longer be accurate
+      return;
+   }
+   ioblock_pool_class* class = NULL;
+   if ( pool->stats.idlesz + bufsz <= pool->maxidle ) {
+      class = ioblock_pool_class_lookup( pool, bufsz );
+   }
+   if ( class  &&  class->idlecnt == class->idlemax ) {
+      size_t newmax = ( class->idlemax ) ? class->idlemax * 2 : SUPER_BLOCK_CNT;
+      void** newidle = realloc( class->idle, sizeof( void* ) * newmax );
+      if ( newidle == NULL ) {
+         LOG( LOG_WARNING, "failed to expand ioblock_pool idle list, freeing buffer\n" );
+         class = NULL;
+      }
+      else {
+         class->idle = newidle;
+         class->idlemax = newmax;
+      }
+   }
+   if ( class == NULL ) {
+      // this buffer is not to be retained
+      pool->stats.allocsz -= bufsz;
+      pthread_mutex_unlock( &(pool->lock) );
+      free( buff );
+      return;
+   }
+   class->idle[class->idlecnt] = buff;
+   class->idlecnt++;
+   pool->stats.idlesz += bufsz;
+   pthread_mutex_unlock( &(pool->lock) );
+}
+
+
+/**
+ * Retrieve statistics of an ioblock_pool
+ * @param ioblock_pool* pool : Reference to the ioblock_pool
+ * @param ioblock_pool_stats* stats : Reference to the stats struct to be populated
+ * @return int : Zero on success, or -1 on failure
+ */
+int ioblock_pool_getstats( ioblock_pool* pool, ioblock_pool_stats* stats ) {
+   if ( pool == NULL  ||  stats == NULL ) {
+      LOG( LOG_ERR, "Received NULL ioblock_pool or stats reference!\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   if ( pthread_mutex_lock( &(pool->lock) ) ) {
+      LOG( LOG_ERR, "Failed to aquire ioblock_pool lock!\n" );
+      return -1;
+   }
+   *stats = pool->stats;
+   pthread_mutex_unlock( &(pool->lock) );
+   return 0;
+}
+
 
 /* ------------------------------   IO QUEUE/BLOCK INTERACTION   ------------------------------ */
 
@@ -86,9 +443,13 @@ underlying skt_etc() functions.
  * Creates a new IOQueue
  * @param size_t iosz : Byte size of each IO to be performed
  * @param size_t partsz : Byte size of each erasure part
+ * @param DAL_MODE mode : Mode of the IO to be performed
+ * @param int blockcnt : Number of ioblocks in the queue ( SUPER_BLOCK_CNT to MAX_SUPER_BLOCK_CNT )
+ * @param ioblock_pool* pool : Pool from which to retrieve ioblock buffers
+ *                             ( if NULL, buffers are allocated directly )
  * @return ioqueue* : Reference to the newly created IOQueue
  */
-ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
+ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode, int blockcnt, ioblock_pool* pool ) {
    LOG( LOG_INFO, "Creating IOQueue with IOSZ=%zu, PARTSZ=%zu, MODE=%s\n", iosz, partsz, ( mode == DAL_READ ) ? "read" : "write" );
    // sanity check that our IO Size is sufficient to at least do something
    if ( iosz <= CRC_BYTES ) {
@@ -100,6 +461,12 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
       LOG( LOG_ERR, "PartSz %zu is invalid!\n", partsz );
       return NULL;
    }
+   // sanity check blockcnt
+   if ( blockcnt < SUPER_BLOCK_CNT  ||  blockcnt > MAX_SUPER_BLOCK_CNT ) {
+      LOG( LOG_ERR, "Block count of %d is outside of the allowable range ( %d - %d )!\n", blockcnt, SUPER_BLOCK_CNT, MAX_SUPER_BLOCK_CNT );
+      errno = EINVAL;
+      return NULL;
+   }
    size_t subsz = (mode == DAL_READ) ? (iosz - CRC_BYTES) : partsz;
    int    partcnt = (int) ( (iosz - CRC_BYTES) / partsz); // number of complete parts per IO
    if ( partsz > (iosz - CRC_BYTES) ) {
@@ -125,6 +492,15 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
       free( ioq );
       return NULL;
    }
+   // allocate our ioblock list
+   ioq->block_list = calloc( blockcnt, sizeof( ioblock ) );
+   if ( ioq->block_list == NULL ) {
+      LOG( LOG_ERR, "failed to allocate a list of %d ioblocks!\n", blockcnt );
+      pthread_cond_destroy( &(ioq->avail_block) );
+      pthread_mutex_destroy( &(ioq->qlock) );
+      free( ioq );
+      return NULL;
+   }
    // determine fill and split thresholds for these blocks
    //ioq->fill_threshold = ( (iosz - CRC_BYTES) > partsz ) ? (iosz - CRC_BYTES) : partsz;
    // NOTE -- if we're writing, we need to get both a complete part and a complete IO
@@ -135,7 +511,9 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
    ioq->iosz = iosz;
    ioq->partcnt = partcnt;
    ioq->head = 0;
-   ioq->depth = SUPER_BLOCK_CNT;
+   ioq->depth = blockcnt;
+   ioq->blockcnt = blockcnt;
+   ioq->pool = pool;
    // calculate the blocksz we must allocate to allways fit written data
    // NOTE -- assuming perfect IOSZ and PARTSZ alignment, we will need space for a full buffer plus
    //         room for trailing CRC bytes.
@@ -156,15 +534,24 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
    //}
    LOG( LOG_INFO, "Using ioblock size of %zu\n", ioq->blocksz );
    int i;
-   for ( i = 0; i < SUPER_BLOCK_CNT; i++ ) {
+   for ( i = 0; i < blockcnt; i++ ) {
       // initialize state and struct for each ioblock
-      int allocres = posix_memalign( &(ioq->block_list[i].buff), 4096, sizeof( char ) * ioq->blocksz );
+      int allocres = 0;
+      if ( pool ) {
+         ioq->block_list[i].buff = ioblock_pool_get( pool, sizeof( char ) * ioq->blocksz );
+         if ( ioq->block_list[i].buff == NULL ) { allocres = errno; }
+      }
+      else {
+         allocres = posix_memalign( &(ioq->block_list[i].buff), IOBLOCK_POOL_ALIGN, sizeof( char ) * ioq->blocksz );
+      }
       if ( allocres  ||  ioq->block_list[i].buff == NULL ) {
          // we've messed up, time to try to clean everything up
          LOG( LOG_ERR, "failed to allocate space for ioblock %d!\n", i );
          for ( i -= 1; i >= 0; i-- ) {
-            free( ioq->block_list[i].buff );
+            if ( pool ) { ioblock_pool_put( pool, ioq->block_list[i].buff, ioq->blocksz ); }
+            else { free( ioq->block_list[i].buff ); }
          }
+         free( ioq->block_list );
          pthread_cond_destroy( &(ioq->avail_block) );
          pthread_mutex_destroy( &(ioq->qlock) );
          free( ioq );
@@ -192,15 +579,17 @@ int destroy_ioqueue( ioqueue* ioq ) {
       LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
       return -1;
    }
-   if ( ioq->depth != SUPER_BLOCK_CNT ) {
+   if ( ioq->depth != ioq->blockcnt ) {
       LOG( LOG_ERR, "Cannot destroy ioqueue struct while ioblocks are in use!\n" );
       pthread_mutex_unlock(&ioq->qlock);
       return -1;
    }
    int i;
-   for ( i = 0; i < SUPER_BLOCK_CNT; i++ ) {
-      free( ioq->block_list[i].buff );
+   for ( i = 0; i < ioq->blockcnt; i++ ) {
+      if ( ioq->pool ) { ioblock_pool_put( ioq->pool, ioq->block_list[i].buff, ioq->blocksz ); }
+      else { free( ioq->block_list[i].buff ); }
    }
+   free( ioq->block_list );
    pthread_cond_destroy( &(ioq->avail_block) );
    pthread_mutex_unlock(&ioq->qlock);
    pthread_mutex_destroy( &(ioq->qlock) );
@@ -220,7 +609,7 @@ ssize_t ioqueue_maxdata( ioqueue* ioq ) {
       LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
       return -1;
    }
-   return ( SUPER_BLOCK_CNT * ioq->split_threshold );
+   return ( ioq->blockcnt * ioq->split_threshold );
 }
 
 
@@ -321,7 +710,7 @@ int reserve_ioblock( ioblock** cur_block, ioblock** push_block, ioqueue* ioq ) {
    // update queue values to reflect the block being in use
    ioq->depth--;
    ioq->head += 1;
-   if ( ioq->head == SUPER_BLOCK_CNT ) { ioq->head = 0; }
+   if ( ioq->head == ioq->blockcnt ) { ioq->head = 0; }
    pthread_mutex_unlock(&ioq->qlock);
 
    // clear any old values in this newly reserved block
@@ -347,6 +736,20 @@ int reserve_ioblock( ioblock** cur_block, ioblock** push_block, ioqueue* ioq ) {
 }
 
 
+/**
+ * Calculate how much additional data can be stored to the given ioblock before it must be pushed
+ * @param ioblock* block : Reference to the ioblock to check
+ * @param ioqueue* ioq : Reference to the ioqueue struct from which the ioblock was gathered
+ * @return size_t : Data size remaining before the ioblock reaches its split threshold ( zero if full )
+ */
+size_t ioblock_remaining( ioblock* block, ioqueue* ioq ) {
+   if ( block->data_size >= ioq->split_threshold ) {
+      return 0;
+   }
+   return ( ioq->split_threshold - block->data_size );
+}
+
+
 /**
  * Retrieve a buffer target reference for writing into the given ioblock
  * @param ioblock* block : Reference to the ioblock to retrieve a target for
@@ -403,6 +806,23 @@ void ioblock_overwrite_fill( ioblock* block, size_t bytes, off_t error_end ) {
 }
 
 
+/**
+ * Calculate a checksum of the given buffer, continuing from a previous checksum value
+ * NOTE -- this function is stateless, and may be called concurrently by any number of threads
+ * @param DAL_CRC crctype : Checksum algorithm to be used
+ * @param uint32_t crc : Previous checksum value to continue from ( or CRC_SEED, for a new checksum )
+ * @param const void* buf : Buffer to be checksummed
+ * @param size_t len : Length of the buffer
+ * @return uint32_t : Checksum of all data covered by the previous value, followed by the given buffer
+ */
+uint32_t io_checksum( DAL_CRC crctype, uint32_t crc, const void* buf, size_t len ) {
+   if ( crctype == CRC_ISCSI ) {
+      return crc32_iscsi( (unsigned char*)buf, (int)len, crc );
+   }
+   return crc32_ieee( crc, (const unsigned char*)buf, len );
+}
+
+
 /**
  * Get the current data size written to the ioblock
  * @param ioblock* block : Reference to the ioblock to update
@@ -423,13 +843,13 @@ int release_ioblock( ioqueue* ioq ) {
       LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
       return -1;
    }
-   if ( ioq->depth == SUPER_BLOCK_CNT ) {
+   if ( ioq->depth == ioq->blockcnt ) {
       LOG( LOG_ERR, "No outstanding ioblocks to be released!\n" );
       pthread_mutex_unlock(&ioq->qlock);
       return -1;
    }
    ioq->depth++;
-   LOG( LOG_INFO, "%d out of %d ioblocks available\n", ioq->depth, SUPER_BLOCK_CNT );
+   LOG( LOG_INFO, "%d out of %d ioblocks available\n", ioq->depth, ioq->blockcnt );
    pthread_cond_signal(&ioq->avail_block);
    pthread_mutex_unlock(&ioq->qlock);
    return 0;
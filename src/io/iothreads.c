@@ -94,6 +94,10 @@ int write_init(unsigned int tID, void* global_state, void** state) {
       LOG(LOG_ERR, "Block %d has too many threads in a single queue!\n", gstate->location.block);
       return -1;
    }
+   // bind to the CPUs of our NUMA node, if requested
+   if (gstate->numa && io_numa_bind_thread(gstate->numa)) {
+      LOG(LOG_WARNING, "Block %d failed to bind to NUMA node %d\n", gstate->location.block, gstate->numa->node);
+   }
    // allocate space for a thread state struct
    (*state) = malloc(sizeof(struct thread_state_struct));
    thread_state* tstate = (*state);
@@ -116,6 +120,22 @@ int write_init(unsigned int tID, void* global_state, void** state) {
    tstate->iob = NULL;
    tstate->crcsumchk = 0;
    tstate->continuous = 1;
+   tstate->wcnt = 0;
+   tstate->wiov = NULL;
+   // coalesce ioblocks only if the DAL supports it, and only to a depth which cannot starve our producer
+   // NOTE -- ne_init() rejects any DAL batch depth exceeding that limit
+   tstate->wmax = 1;
+   int qdepth = (gstate->qdepth) ? gstate->qdepth : SUPER_BLOCK_CNT;
+   if (dal->putv != NULL && dal->io_batch > 1) {
+      tstate->wmax = (dal->io_batch > qdepth - 2) ? qdepth - 2 : dal->io_batch;
+      tstate->wiov = malloc(sizeof(struct iovec) * tstate->wmax);
+      if (tstate->wiov == NULL) {
+         LOG(LOG_ERR, "Block %d failed to allocate space for %d coalesced buffer references!\n", gstate->location.block, tstate->wmax);
+         free(tstate);
+         *state = NULL;
+         return -1;
+      }
+   }
 
    // open a handle for this block
    tstate->handle = dal->open(dal->ctxt, gstate->dmode, gstate->location, gstate->objID);
@@ -141,6 +161,10 @@ int read_init(unsigned int tID, void* global_state, void** state) {
       LOG(LOG_ERR, "Block %d has too many threads in a single queue!\n", gstate->location.block);
       return -1;
    }
+   // bind to the CPUs of our NUMA node, if requested
+   if (gstate->numa && io_numa_bind_thread(gstate->numa)) {
+      LOG(LOG_WARNING, "Block %d failed to bind to NUMA node %d\n", gstate->location.block, gstate->numa->node);
+   }
    // allocate space for a thread state struct
    (*state) = malloc(sizeof(struct thread_state_struct));
    thread_state* tstate = (*state);
@@ -161,6 +185,9 @@ int read_init(unsigned int tID, void* global_state, void** state) {
    tstate->iob = NULL;
    tstate->crcsumchk = 0;
    tstate->continuous = 1;
+   tstate->wcnt = 0;
+   tstate->wiov = NULL;
+   tstate->wmax = 1;
    if (tstate->offset) {
       tstate->continuous = 0;
    }
@@ -189,6 +216,35 @@ int read_init(unsigned int tID, void* global_state, void** state) {
    return 0;
 }
 
+/**
+ * Write out all ioblocks held by this thread via a single coalesced put, then release them
+ * @param thread_state* tstate : Thread state reference
+ * @param char discard : If non-zero, release the held ioblocks without writing them out
+ * @return int : Zero on success, -1 on failure
+ */
+static int flush_held_ioblocks(thread_state* tstate, char discard) {
+   gthread_state* gstate = (gthread_state*)(tstate->gstate);
+   if (tstate->wcnt == 0) {
+      return 0;
+   }
+   // write data out via the DAL, but only if we have not yet encoutered a write error
+   if (!(discard) && (gstate->data_error == 0) && gstate->dal->putv(tstate->handle, tstate->wiov, tstate->wcnt)) {
+      LOG(LOG_ERR, "Failed to write %d coalesced ioblocks to block %d!\n", tstate->wcnt, gstate->location.block);
+      gstate->data_error = 1;
+      // don't bother to abort yet, we'll do that on close
+   }
+   // regardless of success, we need to free up our ioblocks
+   int retval = 0;
+   for (; tstate->wcnt > 0; tstate->wcnt--) {
+      if (release_ioblock(gstate->ioq)) {
+         LOG(LOG_ERR, "Block %d failed to release ioblock!\n", gstate->location.block);
+         gstate->data_error = 1;
+         retval = -1;
+      }
+   }
+   return retval;
+}
+
 /**
  * Consume data buffers, generate CRCs for them, and write blocks out to their targets
  * @param void** state : Thread state reference
@@ -209,6 +265,7 @@ int write_consume(void** state, void** work_todo) {
    if (datasrc == NULL) {
       LOG(LOG_ERR, "Block %d received a NULL read target from ioblock!\n", gstate->location.block);
       gstate->data_error = 1;
+      flush_held_ioblocks(tstate, 1);
       release_ioblock(gstate->ioq);
       return -1;
    }
@@ -217,32 +274,33 @@ int write_consume(void** state, void** work_todo) {
    if (datasz > (gstate->minfo.versz - CRC_BYTES)) {
       LOG(LOG_ERR, "Block %d received unexpectedly large data size: %zd\n", gstate->location.block, datasz);
       gstate->data_error = 1;
+      flush_held_ioblocks(tstate, 1);
       release_ioblock(gstate->ioq);
       return -1;
    }
 
    if (datasz > 0) {
-      // critical section : we are now going to call some inlined assembly erasure funcs
-      if ( pthread_mutex_lock( gstate->erasurelock ) ) {
-         LOG(LOG_ERR, "Block %d failed to acquire erasurelock\n", gstate->location.block);
-         gstate->data_error = 1;
-         release_ioblock(gstate->ioq);
-         return -1;
-      }
       // calculate a CRC for this data and append it to the buffer
-      *(uint32_t*)(datasrc + datasz) = crc32_ieee(CRC_SEED, datasrc, datasz);
-      // exiting critical section
-      if ( pthread_mutex_unlock( gstate->erasurelock ) ) {
-         LOG(LOG_ERR, "Block %d failed to release erasurelock\n", gstate->location.block);
-         gstate->data_error = 1;
-         release_ioblock(gstate->ioq);
-         return -1;
-      }
+      // NOTE -- io_checksum() is stateless, so each block thread may run it concurrently
+      *(uint32_t*)(datasrc + datasz) = io_checksum(gstate->minfo.crctype, CRC_SEED, datasrc, datasz);
       gstate->minfo.crcsum += *((uint32_t*)(datasrc + datasz));
       datasz += CRC_BYTES;
       // increment our block size
       gstate->minfo.blocksz += datasz;
 
+      if (tstate->wmax > 1) {
+         // hold onto this ioblock until we have enough to write out via a single coalesced put
+         // NOTE -- ioblocks must be released in the order they were received, so no other ioblock
+         //         may be released while any are held
+         tstate->wiov[tstate->wcnt].iov_base = datasrc;
+         tstate->wiov[tstate->wcnt].iov_len = datasz;
+         tstate->wcnt++;
+         if (tstate->wcnt < tstate->wmax) {
+            return 0;
+         }
+         return flush_held_ioblocks(tstate, 0);
+      }
+
       // write data out via the DAL, but only if we have not yet encoutered a write error
       if ((gstate->data_error == 0) && gstate->dal->put(tstate->handle, datasrc, datasz)) {
          LOG(LOG_ERR, "Failed to write %zu bytes to block %d!\n", datasz, gstate->location.block);
@@ -251,6 +309,12 @@ int write_consume(void** state, void** work_todo) {
       }
    }
 
+   // any held ioblocks must be released ahead of this one
+   if (flush_held_ioblocks(tstate, 0)) {
+      release_ioblock(gstate->ioq);
+      return -1;
+   }
+
    // regardless of success, we need to free up our ioblock
    if (release_ioblock(gstate->ioq)) {
       LOG(LOG_ERR, "Block %d failed to release ioblock!\n", gstate->location.block);
@@ -344,25 +408,17 @@ int read_produce(void** state, void** work_tofill) {
          uint32_t crc = 0;
          uint32_t scrc = *((uint32_t*)(store_tgt + to_read));
          tstate->crcsumchk += scrc; // track our global crc, for reference
-         // critical section : we are now going to call some inlined assembly erasure funcs
-         if ( pthread_mutex_lock( gstate->erasurelock ) ) {
-            LOG(LOG_ERR, "Block %d failed to acquire erasurelock\n", gstate->location.block);
-            gstate->data_error = 1;
-            data_err = 1;
+         // with lazy verification, check only a sample of IOs ( staggered by block, so that every stripe has some checked )
+         if (gstate->lazyverify && ((tstate->offset / gstate->minfo.versz) + gstate->location.block) % VERIFY_SAMPLE) {
+            crc = scrc;
          }
          else {
-            crc = crc32_ieee(CRC_SEED, store_tgt, to_read);
-            // exiting critical section
-            if ( pthread_mutex_unlock( gstate->erasurelock ) ) {
-               LOG(LOG_ERR, "Block %d failed to release erasurelock\n", gstate->location.block);
-               gstate->data_error = 1;
-               return -1; // force an abort
-            }
-            if (crc != scrc) {
-               LOG(LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, scrc);
-               gstate->data_error = 1;
-               data_err = 1;
-            }
+            crc = io_checksum(gstate->minfo.crctype, CRC_SEED, store_tgt, to_read);
+         }
+         if (crc != scrc) {
+            LOG(LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, scrc);
+            gstate->data_error = 1;
+            data_err = 1;
          }
       }
       // note how much REAL data (no CRC) we've stored to the ioblock
@@ -377,10 +433,14 @@ int read_produce(void** state, void** work_tofill) {
 }
 
 /**
- * No-op function, just to fill out the TQ struct
+ * Write out any ioblocks held for a coalesced put, prior to pausing
+ * @param void** state : Thread state reference
+ * @param void** prev_work : Reference to any previously consumed buffer
+ * @return int : Integer return code ( -1 on error, 0 on success )
  */
 int write_pause(void** state, void** prev_work) {
-   return 0; // noop, probably permanently
+   // write out any held ioblocks, so that no data is left buffered while we are paused
+   return flush_held_ioblocks((thread_state*)(*state), 0);
 }
 
 /**
@@ -413,7 +473,8 @@ int read_resume(void** state, void** prev_work) {
    // check for a NULL ioq and create one if so (TODO: unnecessary?)
    if (gstate->ioq == NULL) {
       LOG(LOG_INFO, "Creating own ioqueue for block %d\n", gstate->location.block);
-      gstate->ioq = create_ioqueue(gstate->minfo.versz, gstate->minfo.partsz, gstate->dmode);
+      int qdepth = (gstate->qdepth) ? gstate->qdepth : SUPER_BLOCK_CNT;
+      gstate->ioq = create_ioqueue(gstate->minfo.versz, gstate->minfo.partsz, gstate->dmode, qdepth, gstate->iopool);
       if (gstate->ioq == NULL) {
          LOG(LOG_ERR, "Failed to create ioqueue!\n");
          return -1;
@@ -515,6 +576,9 @@ void write_term(void** state, void** prev_work, TQ_Control_Flags flg) {
    // get a reference to the global state for this block
    gthread_state* gstate = (gthread_state*)(tstate->gstate);
 
+   // write out any held ioblocks ( these precede any unused IOBlock reference )
+   flush_held_ioblocks(tstate, (flg & TQ_ABORT) ? 1 : 0);
+
    // if we never used an IOBlock reference, we need to release it
    if (*(prev_work) != NULL && release_ioblock(gstate->ioq)) {
       LOG(LOG_ERR, "Failed to release previous IOBlock!\n");
@@ -557,12 +621,13 @@ void write_term(void** state, void** prev_work, TQ_Control_Flags flg) {
 
 
    // just free and NULL our state, there isn't any useful info in there
+   free(tstate->wiov);
    free(tstate);
    *state = NULL;
 }
 
 /**
- * Close our target reference
+ * Close ( or hand off ) our target reference
  * @param void** state : Thread state reference
  * @param void** prev_work : Reference to any unused previous buffer
  * @param TQ_Control_Flags flg : Control flags values at thread term
@@ -591,8 +656,12 @@ void read_term(void** state, void** prev_work, TQ_Control_Flags flg) {
       }
    }
 
-   // close our DAL handle
-   if (gstate->dal->close(tstate->handle)) {
+   // pass off our DAL handle, if requested
+   if (gstate->handoff) {
+      *(gstate->handoff) = tstate->handle;
+   }
+   // otherwise, close it
+   else if (gstate->dal->close(tstate->handle)) {
       // pessimistically call this a data erorr ( may not be necessary )
       gstate->data_error = 1;
       LOG(LOG_ERR, "Failed to close read handle for block %d!\n", gstate->location.block);
@@ -13,6 +13,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 
 // sentinel values to ensure good data transfer
@@ -180,10 +181,11 @@ size_t verify_data( size_t prev_ver, size_t partsz, size_t buffsz, void* buffer,
 
 
 
-int test_values( size_t iosz, size_t partsz, DAL_MODE mode ) {
-   printf( "\nTesting queue with iosz=%zu / partsz=%zu / mode=%s\n", iosz, partsz, (mode == DAL_READ) ? "read" : "write" );
+int test_values( size_t iosz, size_t partsz, DAL_MODE mode, int blockcnt, ioblock_pool* pool ) {
+   printf( "\nTesting queue with iosz=%zu / partsz=%zu / mode=%s / blockcnt=%d%s\n", iosz, partsz,
+           (mode == DAL_READ) ? "read" : "write", blockcnt, (pool) ? " / pooled" : "" );
    // create a new ioqueue
-   ioqueue* ioq = create_ioqueue( iosz, partsz, mode );
+   ioqueue* ioq = create_ioqueue( iosz, partsz, mode, blockcnt, pool );
    if ( ioq == NULL ) {
       printf( "ERROR: Failed to create new ioqueue with iosz=%zu and partsz=%zu\n", iosz, partsz );
       return -1;
@@ -199,12 +201,18 @@ int test_values( size_t iosz, size_t partsz, DAL_MODE mode ) {
       destroy_ioqueue( ioq );
       return -1;
    }
+   if ( ioblock_remaining( cur_block, ioq ) != ioq->split_threshold ) {
+      printf( "ERROR: unexpected remaining space for an empty ioblock: %zu\n", ioblock_remaining( cur_block, ioq ) );
+      release_ioblock( ioq );
+      destroy_ioqueue( ioq );
+      return -1;
+   }
 
    // write out data to our new block until it is full
    size_t written_data = 0;
    size_t verified_data = 0;
    int ver_blocks = 0;
-   while ( ver_blocks < ( SUPER_BLOCK_CNT + 1 ) ) {
+   while ( ver_blocks < ( blockcnt + 1 ) ) {
       size_t written = fill_buffer( written_data, iosz, partsz, ioblock_write_target( cur_block ), mode );
       if ( written == 0 ) {
          destroy_ioqueue( ioq );
@@ -303,34 +311,107 @@ int main( int argc, char** argv ) {
    size_t iosz = 8196;
    size_t partsz = 4096;
    DAL_MODE mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
    // Test write IOQueue with a small partsz and larger, aligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
 
    // Test a read IOQueue with small partsz and larger, unaligned iosz
    iosz = 8197;
    mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
    // Test a write IOQueue with small partsz and larger, unaligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
 
    // Test a read IOQueue with large partsz and smaller, aligned iosz
    iosz = 2052;
    mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
    // Test a write IOQueue with large partsz and smaller, aligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
 
    // Test a read IOQueue with a small partsz and very large, unaligned iosz
    iosz = 1048567;
    mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
    // Test a write IOQueue with a small partsz and very large, unaligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, SUPER_BLOCK_CNT, NULL ) ) { return -1; }
+
+   // Test deeper IOQueues, drawing buffers from a shared pool
+   ioblock_pool* pool = create_ioblock_pool( SIZE_MAX, NULL );
+   if ( pool == NULL ) {
+      printf( "ERROR: Failed to create an ioblock_pool\n" );
+      return -1;
+   }
+   int blockcnt = 8;
+   if ( test_values( iosz, partsz, DAL_READ, blockcnt, pool ) ) { return -1; }
+   if ( test_values( iosz, partsz, DAL_READ, blockcnt, pool ) ) { return -1; }
+   ioblock_pool_stats stats;
+   if ( ioblock_pool_getstats( pool, &stats ) ) {
+      printf( "ERROR: Failed to retrieve ioblock_pool stats\n" );
+      return -1;
+   }
+   printf( "Pool stats: hits=%zu, misses=%zu, allocsz=%zu, idlesz=%zu, peaksz=%zu\n",
+           stats.hits, stats.misses, stats.allocsz, stats.idlesz, stats.peaksz );
+   // the second queue should have been satisfied entirely by buffers of the first
+   if ( stats.misses != blockcnt  ||  stats.hits != blockcnt ) {
+      printf( "ERROR: Unexpected ioblock_pool hit/miss counts\n" );
+      return -1;
+   }
+   if ( stats.allocsz != stats.idlesz  ||  stats.peaksz != stats.allocsz  ||  stats.peaksz < (blockcnt * iosz) ) {
+      printf( "ERROR: Unexpected ioblock_pool size values\n" );
+      return -1;
+   }
+   if ( destroy_ioblock_pool( pool ) ) {
+      printf( "ERROR: unexpected return from destroy_ioblock_pool!\n" );
+      return -1;
+   }
+   // a pool retaining no idle buffers should free everything immediately
+   pool = create_ioblock_pool( 0, NULL );
+   if ( pool == NULL ) {
+      printf( "ERROR: Failed to create an ioblock_pool\n" );
+      return -1;
+   }
+   if ( test_values( iosz, partsz, DAL_WRITE, MAX_SUPER_BLOCK_CNT, pool ) ) { return -1; }
+   if ( ioblock_pool_getstats( pool, &stats ) ) {
+      printf( "ERROR: Failed to retrieve ioblock_pool stats\n" );
+      return -1;
+   }
+   if ( stats.hits  ||  stats.allocsz  ||  stats.idlesz ) {
+      printf( "ERROR: Unexpected ioblock_pool stats for a non-retaining pool\n" );
+      return -1;
+   }
+   if ( destroy_ioblock_pool( pool ) ) {
+      printf( "ERROR: unexpected return from destroy_ioblock_pool!\n" );
+      return -1;
+   }
+
+   // Test NUMA placement of pool buffers, if this system provides NUMA info
+   if ( io_numa_count() > 0 ) {
+      io_numa numa;
+      if ( io_numa_init( &numa, 0 ) ) {
+         printf( "ERROR: Failed to identify CPUs of NUMA node 0\n" );
+         return -1;
+      }
+      if ( io_numa_bind_thread( &numa ) ) {
+         printf( "ERROR: Failed to bind to the CPUs of NUMA node 0\n" );
+         return -1;
+      }
+      pool = create_ioblock_pool( SIZE_MAX, &numa );
+      if ( pool == NULL ) {
+         printf( "ERROR: Failed to create a NUMA ioblock_pool\n" );
+         return -1;
+      }
+      if ( test_values( iosz, partsz, DAL_WRITE, SUPER_BLOCK_CNT, pool ) ) { return -1; }
+      if ( destroy_ioblock_pool( pool ) ) {
+         printf( "ERROR: unexpected return from destroy_ioblock_pool!\n" );
+         return -1;
+      }
+      io_numa_free( &numa );
+   }
 
    return 0;
 }
@@ -84,13 +84,17 @@ int main( int argc, char** argv ) {
    gstate.minfo.totsz = 0;
    gstate.meta_error = 0;
    gstate.data_error = 0;
+   gstate.lazyverify = 0;
+   gstate.numa = NULL;
+   gstate.handoff = NULL;
 
    // create an ioqueue for our data blocks
-   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode );
+   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode, SUPER_BLOCK_CNT, NULL );
    if ( gstate.ioq == NULL ) {
       printf( "Failed to create IOQueue for write thread!\n" );
       return -1;
    }
+   gstate.qdepth = SUPER_BLOCK_CNT;
 
    // create a thread state reference
    void* tstate;
@@ -196,7 +200,7 @@ int main( int argc, char** argv ) {
    printf( "done\n" );
 
    // create our ioqueue (based on minfo values gathered by the read thread)
-   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode );
+   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode, SUPER_BLOCK_CNT, NULL );
    if ( gstate.ioq == NULL ) {
       printf( "Failed to create ioqueue for read!\n" );
       return -1;
@@ -430,6 +430,20 @@ typedef struct MDAL_struct {
     */
    struct dirent* (*readdir) ( MDAL_DHANDLE dh );
 
+   /**
+    * Iterate to the next entry of an open directory handle, populating stat info for that
+    * entry
+    * NOTE -- Entries which vanish between being read and being stat'd will be skipped.
+    * @param MDAL_DHANDLE dh : MDAL_DHANDLE to read from
+    * @param struct stat* st : Stat buffer to be populated for the returned entry
+    * @param int flags : A bitwise OR of the following...
+    *                    AT_SYMLINK_NOFOLLOW - do not dereference symlinks
+    * @return struct dirent* : Reference to the next dirent struct, or NULL w/ errno unset
+    *                          if all entries have been read, or NULL w/ errno set if a
+    *                          failure occurred
+    */
+   struct dirent* (*readdirplus) ( MDAL_DHANDLE dh, struct stat* st, int flags );
+
    /**
     * Identify the ( abstract ) location of an open directory handle
     * NOTE -- This 'location' can be used via seekdir() to allow for the repeating
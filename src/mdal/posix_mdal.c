@@ -2261,6 +2261,59 @@ struct dirent* posixmdal_readdir( MDAL_DHANDLE dh ) {
 }
 
 
+/**
+ * Iterate to the next entry of an open directory handle, populating stat info for that entry
+ * NOTE -- Entries which vanish between being read and being stat'd will be skipped.
+ * @param MDAL_DHANDLE dh : MDAL_DHANDLE to read from
+ * @param struct stat* st : Stat buffer to be populated for the returned entry
+ * @param int flags : A bitwise OR of the following...
+ *                    AT_SYMLINK_NOFOLLOW - do not dereference symlinks
+ * @return struct dirent* : Reference to the next dirent struct, or NULL w/ errno unset if all 
+ *                          entries have been read, or NULL w/ errno set if a failure occurred
+ */
+struct dirent* posixmdal_readdirplus( MDAL_DHANDLE dh, struct stat* st, int flags ) {
+   // check for a NULL dir handle
+   if ( !(dh) ) {
+      LOG( LOG_ERR, "Received a NULL MDAL_DHANDLE reference\n" );
+      errno = EINVAL;
+      return NULL;
+   }
+   // check for a NULL stat buffer
+   if ( st == NULL ) {
+      LOG( LOG_ERR, "Received a NULL stat buffer reference\n" );
+      errno = EINVAL;
+      return NULL;
+   }
+   // reject any unsupported flag values
+   if ( flags & ~(AT_SYMLINK_NOFOLLOW) ) {
+      LOG( LOG_ERR, "Detected unsupported flag value\n" );
+      errno = EINVAL;
+      return NULL;
+   }
+   POSIX_DHANDLE pdh = (POSIX_DHANDLE) dh;
+   int dfd = dirfd( pdh->dirp );
+   struct dirent* dent;
+   int origerrno = errno;
+   errno = 0;
+   while ( (dent = readdir( pdh->dirp )) != NULL ) {
+      // stat the entry relative to the dir itself, avoiding any path traversal
+      if ( fstatat( dfd, dent->d_name, st, flags ) == 0 ) {
+         errno = origerrno;
+         return dent;
+      }
+      if ( errno != ENOENT ) {
+         LOG( LOG_ERR, "Failed to stat dir entry: \"%s\" ( %s )\n", dent->d_name, strerror(errno) );
+         return NULL;
+      }
+      // entry was removed out from under us, so just move on to the next
+      LOG( LOG_INFO, "Skipping vanished dir entry: \"%s\"\n", dent->d_name );
+      errno = 0;
+   }
+   if ( errno == 0 ) { errno = origerrno; } // end of stream, so restore the original errno value
+   return NULL;
+}
+
+
 /**
  * Identify the ( abstract ) location of an open directory handle
  * NOTE -- This 'location' can be used via seekdir() to allow for the repeating
@@ -3253,6 +3306,7 @@ MDAL posix_mdal_init( xmlNode* root ) {
          pmdal->dremovexattr = posixmdal_dremovexattr;
          pmdal->dlistxattr = posixmdal_dlistxattr;
          pmdal->readdir = posixmdal_readdir;
+         pmdal->readdirplus = posixmdal_readdirplus;
          pmdal->telldir = posixmdal_telldir;
          pmdal->seekdir = posixmdal_seekdir;
          pmdal->rewinddir = posixmdal_rewinddir;
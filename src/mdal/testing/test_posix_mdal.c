@@ -329,6 +329,31 @@ int main(int argc, char **argv)
       printf( "userfile stat does not match reference stat\n" );
       return -1;
    }
+   // list the NS root with attributes, and verify the userfile entry matches as well
+   MDAL_DHANDLE rootdh = mdal->opendir( rootctxt, "." );
+   if ( !(rootdh) ) {
+      printf( "failed to open NS root dir via rootctxt\n" );
+      return -1;
+   }
+   char userfilefound = 0;
+   errno = 0;
+   while ( (entry = mdal->readdirplus( rootdh, &(verstat), AT_SYMLINK_NOFOLLOW )) != NULL ) {
+      if ( strncmp( "userfile", entry->d_name, 9 ) == 0 ) {
+         if ( memcmp( &(verstat), &(stbuf), sizeof(struct stat) ) ) {
+            printf( "userfile readdirplus stat does not match reference stat\n" );
+            return -1;
+         }
+         userfilefound = 1;
+      }
+   }
+   if ( errno  ||  !(userfilefound) ) {
+      printf( "expected readdirplus of NS root to locate userfile\n" );
+      return -1;
+   }
+   if ( mdal->closedir( rootdh ) ) {
+      printf( "failed to close NS root dir handle\n" );
+      return -1;
+   }
    // seek to EOF minus 8, and verify the CONTENT string
    if ( mdal->lseek( sfh, 10234, SEEK_SET ) != 10234 ) {
       printf( "failed to seek to 10234 of scanner reffile\n" );
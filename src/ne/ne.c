@@ -62,6 +62,7 @@ underlying skt_etc() functions.
 #include "io/io.h"
 #include "dal/dal.h"
 #include "thread_queue/thread_queue.h"
+#include "general_include/crc.c"
 
 #include <isa-l.h>
 
@@ -78,7 +79,27 @@ underlying skt_etc() functions.
 #include <pthread.h>
 
 // Some configurable values
-#define QDEPTH SUPER_BLOCK_CNT + 1
+#define TABLE_CACHE_IDLE 64 // maximum number of unreferenced erasure tables retained by each ne_ctxt
+#define NE_REBUILD_ATTEMPTS 2 // maximum ne_rebuild() calls for each object of a ne_rebuild_batch()
+#define IOBLOCK_POOL_HANDLES 2 // default idle buffer limit of each ne_ctxt buffer pool, in handles of its widest stripe
+
+// Cached erasure tables ( never modified after generation, shared by all handles of a ne_ctxt )
+typedef struct ne_tables_struct {
+   /* Cache Key */
+   int N;
+   int E;
+   char decode;                // zero for encoding tables, non-zero for decoding tables
+   int nerrs;                  // number of erased blocks ( decoding tables only )
+   unsigned char* err_list;    // ordered list of erased blocks ( decoding tables only )
+
+   /* Table Values */
+   unsigned char* decode_index; // blocks to decode from ( decoding tables only )
+   unsigned char* g_tbls;       // expanded isa-l tables
+
+   /* Cache Tracking */
+   unsigned int refcnt;
+   struct ne_tables_struct* next;
+} *ne_tables;
 
 // NE context
 typedef struct ne_ctxt_struct {
@@ -89,8 +110,33 @@ typedef struct ne_ctxt_struct {
    // Synchronization
    pthread_mutex_t locallock;
    pthread_mutex_t* erasurelock;
+   // Erasure table cache ( most recently used first )
+   pthread_mutex_t tablelock;
+   ne_tables tables;
+   ne_table_stats tablestats;
+   // Checksum type for newly written objects
+   DAL_CRC crctype;
+   // IOBlock buffers, shared by all handles
+   int qdepth;
+   ioblock_pool* iopool;
+   // NUMA placement of handles ( round-robin ), each node with its own buffer pool
+   int numacnt;
+   io_numa* numa;
+   ioblock_pool** numapools;
+   unsigned int numanext;
+   // Persistent block threads, shared by all handles ( NULL, if each handle creates its own )
+   TQThreadPool tpool;
 } *ne_ctxt;
 
+// Per-block state of a NE_RANDOM handle
+typedef struct ne_rblock_struct {
+   BLOCK_CTXT bctxt;           // DAL reference for this block ( NULL, until first accessed )
+   void* buff;                 // most recently retrieved IO of this block, including its CRC
+   off_t ioidx;                // index of the IO held in buff ( -1, if none )
+   size_t datasz;              // data size ( excluding CRC ) of the IO held in buff
+   char bad;                   // set once any error is encountered for this block
+} ne_rblock;
+
 typedef struct ne_handle_struct {
    /* Reference back to our global context */
    ne_ctxt ctxt;
@@ -104,6 +150,8 @@ typedef struct ne_handle_struct {
    size_t versz;
    size_t blocksz;
    size_t totsz;
+   DAL_CRC crctype;
+   int numaidx;                // index of the ctxt NUMA node used by this handle ( -1 if none )
 
    /* Read/Write Info and Structures */
    ne_mode mode;
@@ -111,6 +159,7 @@ typedef struct ne_handle_struct {
    off_t iob_datasz;
    off_t iob_offset;
    ssize_t sub_offset;
+   ne_rblock* rblocks;         // per-block IO references, bypassing block threads ( NE_RANDOM only )
 
    /* Threading fields */
    ThreadQueue* thread_queues;
@@ -120,12 +169,13 @@ typedef struct ne_handle_struct {
    /* Erasure Manipulation Structures */
    unsigned char e_ready;
    unsigned char* prev_in_err;
-   unsigned int prev_err_cnt;
-   unsigned char* encode_matrix;
-   unsigned char* decode_matrix;
-   unsigned char* invert_matrix;
-   unsigned char* g_tbls;
-   unsigned char* decode_index;
+   unsigned int prev_err_cnt;  // erasure threads required by the previous range of stripes ( NE_RDONLY only )
+   unsigned char* err_list;    // ordered list of erased blocks in the current stripe
+   int iob_blkcnt;             // count of populated ioblock references
+   int iob_errcnt;             // count of populated ioblocks containing errors
+   ne_tables tables;
+   unsigned int enc_pending;   // count of complete stripes awaiting erasure generation
+   unsigned char** enc_refs;   // per-block buffer references for erasure generation
 
 } *ne_handle;
 
@@ -136,6 +186,223 @@ static int gf_gen_decode_matrix_simple(unsigned char* encode_matrix,
    unsigned char* decode_index, unsigned char* frag_err_list, int nerrs, int k,
    int m);
 
+// ---------------------- ERASURE TABLE CACHE ----------------------
+
+/**
+ * Free a set of cached erasure tables
+ * @param ne_tables tables : Reference to the tables to be freed
+ */
+static void free_tables(ne_tables tables) {
+   free(tables->g_tbls);
+   free(tables->decode_index);
+   free(tables->err_list);
+   free(tables);
+}
+
+/**
+ * Generate a new set of erasure tables
+ * NOTE -- this function acquires the erasurelock of the given ne_ctxt
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to generate tables for
+ * @param int N : Data width of the stripe
+ * @param int E : Erasure width of the stripe
+ * @param unsigned char* err_list : Ordered list of erased blocks, or NULL to produce encoding tables
+ * @param int nerrs : Number of erased blocks in the err_list
+ * @return ne_tables : Reference to the new tables ( with a zero refcnt ), or NULL on failure
+ */
+static ne_tables generate_tables(ne_ctxt ctxt, int N, int E, unsigned char* err_list, int nerrs) {
+   ne_tables tables = calloc(1, sizeof(struct ne_tables_struct));
+   if (tables == NULL) {
+      LOG(LOG_ERR, "Failed to allocate space for a new erasure table struct\n");
+      return NULL;
+   }
+   tables->N = N;
+   tables->E = E;
+   int outcnt = E;
+   if (err_list) {
+      tables->decode = 1;
+      tables->nerrs = nerrs;
+      outcnt = nerrs;
+      tables->err_list = malloc(sizeof(unsigned char) * nerrs);
+      tables->decode_index = calloc(N + E, sizeof(unsigned char));
+      if (tables->err_list == NULL || tables->decode_index == NULL) {
+         LOG(LOG_ERR, "Failed to allocate space for decode table info\n");
+         free_tables(tables);
+         return NULL;
+      }
+      memcpy(tables->err_list, err_list, sizeof(unsigned char) * nerrs);
+   }
+   tables->g_tbls = calloc(N * outcnt * 32, sizeof(unsigned char));
+   // allocate temporary matricies
+   unsigned char* encode_matrix = calloc((N + E) * N, sizeof(unsigned char));
+   unsigned char* decode_matrix = calloc((N + E) * N, sizeof(unsigned char));
+   unsigned char* invert_matrix = calloc((N + E) * N, sizeof(unsigned char));
+   unsigned char* tmpmatrix = calloc((N + E) * N, sizeof(unsigned char));
+   if (tables->g_tbls == NULL || encode_matrix == NULL || decode_matrix == NULL ||
+       invert_matrix == NULL || tmpmatrix == NULL) {
+      LOG(LOG_ERR, "Failed to allocate space for erasure matricies\n");
+      free(tmpmatrix);
+      free(invert_matrix);
+      free(decode_matrix);
+      free(encode_matrix);
+      free_tables(tables);
+      return NULL;
+   }
+
+   // critical section : we are now going to call some inlined assembly erasure funcs
+   if (pthread_mutex_lock(ctxt->erasurelock)) {
+      LOG(LOG_ERR, "Failed to acquire erasurelock prior to table generation\n");
+      free(tmpmatrix);
+      free(invert_matrix);
+      free(decode_matrix);
+      free(encode_matrix);
+      free_tables(tables);
+      return NULL;
+   }
+   int ret_code = 0;
+   // Generate an encoding matrix
+   // NOTE: The matrix generated by gf_gen_rs_matrix is not always invertable for N>=6 and E>=5!
+   gf_gen_cauchy1_matrix(encode_matrix, N + E, N);
+   if (err_list) {
+      ret_code = gf_gen_decode_matrix_simple(encode_matrix, decode_matrix,
+         invert_matrix, tmpmatrix, tables->decode_index, tables->err_list,
+         nerrs, N, N + E);
+      if (ret_code == 0) {
+         ec_init_tables(N, nerrs, decode_matrix, tables->g_tbls);
+      }
+   }
+   else {
+      // Generate g_tbls from encode matrix
+      ec_init_tables(N, E, &(encode_matrix[N * N]), tables->g_tbls);
+   }
+   // exiting critical section
+   if (pthread_mutex_unlock(ctxt->erasurelock)) {
+      LOG(LOG_ERR, "Failed to relinquish erasurelock after table generation\n");
+      ret_code = -1;
+   }
+   free(tmpmatrix);
+   free(invert_matrix);
+   free(decode_matrix);
+   free(encode_matrix);
+   if (ret_code) {
+      LOG(LOG_ERR, "Failed to generate erasure tables for %d errors\n", nerrs);
+      free_tables(tables);
+      errno = ENODATA;
+      return NULL;
+   }
+   return tables;
+}
+
+/**
+ * Retrieve a reference to erasure tables matching the given stripe shape and error pattern,
+ * generating + caching new tables if none exist
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to retrieve tables from
+ * @param int N : Data width of the stripe
+ * @param int E : Erasure width of the stripe
+ * @param unsigned char* err_list : Ordered list of erased blocks, or NULL to retrieve encoding tables
+ * @param int nerrs : Number of erased blocks in the err_list
+ * @return ne_tables : Reference to the tables, to be released via release_tables(), or NULL on failure
+ */
+static ne_tables acquire_tables(ne_ctxt ctxt, int N, int E, unsigned char* err_list, int nerrs) {
+   char decode = (err_list) ? 1 : 0;
+   if (!(decode)) {
+      nerrs = 0;
+   }
+   char missed = 0;
+   ne_tables newtables = NULL;
+   while (1) {
+      if (pthread_mutex_lock(&(ctxt->tablelock))) {
+         LOG(LOG_ERR, "Failed to acquire ne_ctxt tablelock\n");
+         if (newtables) {
+            free_tables(newtables);
+         }
+         return NULL;
+      }
+      // search for a matching entry
+      ne_tables prev = NULL;
+      ne_tables tables = ctxt->tables;
+      while (tables) {
+         if (tables->N == N && tables->E == E && tables->decode == decode && tables->nerrs == nerrs &&
+             (nerrs == 0 || memcmp(tables->err_list, err_list, nerrs) == 0)) {
+            break;
+         }
+         prev = tables;
+         tables = tables->next;
+      }
+      if (tables) {
+         // move the entry to the front of our list
+         if (prev) {
+            prev->next = tables->next;
+            tables->next = ctxt->tables;
+            ctxt->tables = tables;
+         }
+         tables->refcnt++;
+         if (!(missed)) {
+            ctxt->tablestats.hits++;
+         }
+         pthread_mutex_unlock(&(ctxt->tablelock));
+         // another thread may have populated the same tables, while we generated ours
+         if (newtables) {
+            free_tables(newtables);
+         }
+         return tables;
+      }
+      if (newtables) {
+         // insert our new entry at the front of the list
+         newtables->refcnt = 1;
+         newtables->next = ctxt->tables;
+         ctxt->tables = newtables;
+         ctxt->tablestats.entries++;
+         pthread_mutex_unlock(&(ctxt->tablelock));
+         return newtables;
+      }
+      // note the miss, and generate tables without holding the tablelock
+      ctxt->tablestats.misses++;
+      missed = 1;
+      pthread_mutex_unlock(&(ctxt->tablelock));
+      LOG(LOG_INFO, "Generating new erasure tables ( N=%d, E=%d, nerrs=%d )\n", N, E, nerrs);
+      if ((newtables = generate_tables(ctxt, N, E, err_list, nerrs)) == NULL) {
+         return NULL;
+      }
+   }
+}
+
+/**
+ * Release a reference to erasure tables, potentially freeing excess, unreferenced cache entries
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt the tables were retrieved from
+ * @param ne_tables tables : Reference to the tables to be released
+ */
+static void release_tables(ne_ctxt ctxt, ne_tables tables) {
+   if (pthread_mutex_lock(&(ctxt->tablelock))) {
+      LOG(LOG_ERR, "Failed to acquire ne_ctxt tablelock ( erasure tables will be leaked )\n");
+      return;
+   }
+   tables->refcnt--;
+   if (tables->refcnt == 0) {
+      // count idle entries, dropping those beyond our limit ( least recently used are last in the list )
+      size_t idle = 0;
+      ne_tables prev = NULL;
+      ne_tables cur = ctxt->tables;
+      while (cur) {
+         ne_tables next = cur->next;
+         if (cur->refcnt == 0 && (++idle) > TABLE_CACHE_IDLE) {
+            if (prev) {
+               prev->next = next;
+            }
+            else {
+               ctxt->tables = next;
+            }
+            ctxt->tablestats.entries--;
+            free_tables(cur);
+         }
+         else {
+            prev = cur;
+         }
+         cur = next;
+      }
+   }
+   pthread_mutex_unlock(&(ctxt->tablelock));
+}
+
 // ---------------------- INTERNAL HELPER FUNCTIONS ----------------------
 
 /**
@@ -223,6 +490,30 @@ int terminate_thread(ioblock** iobref, ThreadQueue tq, gthread_state* state, ne_
    return ret_val;
 }
 
+/**
+ * Identify the NUMA node assigned to the given handle
+ * @param ne_handle handle : Handle to identify the NUMA node of
+ * @return const io_numa* : Reference to the NUMA node, or NULL if none is assigned
+ */
+static const io_numa* handle_numa(ne_handle handle) {
+   if (handle->numaidx < 0) {
+      return NULL;
+   }
+   return handle->ctxt->numa + handle->numaidx;
+}
+
+/**
+ * Identify the ioblock buffer pool to be used by the given handle
+ * @param ne_handle handle : Handle to identify the buffer pool of
+ * @return ioblock_pool* : Reference to the buffer pool
+ */
+static ioblock_pool* handle_pool(ne_handle handle) {
+   if (handle->numaidx < 0) {
+      return handle->ctxt->iopool;
+   }
+   return handle->ctxt->numapools[handle->numaidx];
+}
+
 /**
  * Allocate a new ne_handle structure
  * @param int max_block : Maximum block value
@@ -248,9 +539,14 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
    handle->versz = consensus->versz;
    handle->blocksz = consensus->blocksz;
    handle->totsz = consensus->totsz;
+   handle->crctype = consensus->crctype;
 
    // set some additional handle info
    handle->ctxt = ctxt;
+   handle->numaidx = -1;
+   if (ctxt->numacnt) {
+      handle->numaidx = (int)(__atomic_fetch_add(&(ctxt->numanext), 1, __ATOMIC_RELAXED) % ctxt->numacnt);
+   }
    handle->objID = strdup(objID);
    handle->loc.pod = loc.pod;
    handle->loc.cap = loc.cap;
@@ -306,22 +602,9 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
       free(handle);
       return NULL;
    }
-   handle->decode_index = calloc(num_blocks, sizeof(char));
-   if (handle->decode_index == NULL) {
-      LOG(LOG_ERR, "Failed to allocate space for a decode_index array!\n");
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
-   }
-   /* allocate matrices */
-   handle->encode_matrix = calloc(num_blocks * consensus->N, sizeof(char));
-   if (handle->encode_matrix == NULL) {
-      LOG(LOG_ERR, "Failed to allocate space for an encode_matrix!\n");
-      free(handle->decode_index);
+   handle->enc_refs = calloc(num_blocks, sizeof(unsigned char*));
+   if (handle->enc_refs == NULL) {
+      LOG(LOG_ERR, "Failed to allocate space for an erasure reference array!\n");
       free(handle->prev_in_err);
       free(handle->thread_states);
       free(handle->thread_queues);
@@ -330,40 +613,10 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
       free(handle);
       return NULL;
    }
-   handle->decode_matrix = calloc(num_blocks * consensus->N, sizeof(char));
-   if (handle->decode_matrix == NULL) {
-      LOG(LOG_ERR, "Failed to allocate space for a decode_matrix!\n");
-      free(handle->encode_matrix);
-      free(handle->decode_index);
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
-   }
-   handle->invert_matrix = calloc(num_blocks * consensus->N, sizeof(char));
-   if (handle->invert_matrix == NULL) {
-      LOG(LOG_ERR, "Failed to allocate space for an invert_matrix!\n");
-      free(handle->decode_matrix);
-      free(handle->encode_matrix);
-      free(handle->decode_index);
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
-   }
-   handle->g_tbls = calloc(consensus->N * consensus->E * 32, sizeof(char));
-   if (handle->g_tbls == NULL) {
-      LOG(LOG_ERR, "Failed to allocate space for g_tbls!\n");
-      free(handle->invert_matrix);
-      free(handle->decode_matrix);
-      free(handle->encode_matrix);
-      free(handle->decode_index);
+   handle->err_list = calloc(num_blocks, sizeof(unsigned char));
+   if (handle->err_list == NULL) {
+      LOG(LOG_ERR, "Failed to allocate space for an err_list array!\n");
+      free(handle->enc_refs);
       free(handle->prev_in_err);
       free(handle->thread_states);
       free(handle->thread_queues);
@@ -372,11 +625,14 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
       free(handle);
       return NULL;
    }
+   // NOTE -- erasure tables are retrieved from the ne_ctxt cache, only once they are needed
+   handle->tables = NULL;
 
    int i;
    for (i = 0; i < num_blocks; i++) {
       // assign values to thread states
       handle->thread_states[i].erasurelock = handle->ctxt->erasurelock;
+      handle->thread_states[i].qdepth = handle->ctxt->qdepth;
       // object attributes
       handle->thread_states[i].objID = handle->objID;
       handle->thread_states[i].location.pod = loc.pod;
@@ -394,6 +650,7 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
       handle->thread_states[i].minfo.blocksz = consensus->blocksz;
       handle->thread_states[i].minfo.crcsum = 0;
       handle->thread_states[i].minfo.totsz = consensus->totsz;
+      handle->thread_states[i].minfo.crctype = consensus->crctype;
       handle->thread_states[i].meta_error = 0;
       handle->thread_states[i].data_error = 0;
       //      size_t iosz = consensus->versz;
@@ -429,11 +686,21 @@ void free_handle(ne_handle handle) {
    //   for ( i = 0; i < handle->epat.N + handle->epat.E; i++ ) {
    //      destroy_ioqueue( handle->thread_states[i].ioq );
    //   }
-   free(handle->g_tbls);
-   free(handle->invert_matrix);
-   free(handle->decode_matrix);
-   free(handle->encode_matrix);
-   free(handle->decode_index);
+   if (handle->tables) {
+      release_tables(handle->ctxt, handle->tables);
+   }
+   if (handle->rblocks) {
+      int i;
+      for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
+         if (handle->rblocks[i].bctxt && handle->ctxt->dal->close(handle->rblocks[i].bctxt)) {
+            LOG(LOG_WARNING, "Failed to close random access reference for block %d\n", i);
+         }
+         free(handle->rblocks[i].buff);
+      }
+      free(handle->rblocks);
+   }
+   free(handle->err_list);
+   free(handle->enc_refs);
    free(handle->prev_in_err);
    free(handle->thread_states);
    free(handle->thread_queues);
@@ -442,6 +709,29 @@ void free_handle(ne_handle handle) {
    free(handle);
 }
 
+/**
+ * Generate erasure parts for all complete stripes of a write handle which have not yet been encoded
+ * NOTE -- pending stripes are always contiguous, ending at the current write target of each ioblock,
+ *         so a single encode call covers all of them.
+ * @param ne_handle handle : Handle to generate erasure for
+ */
+static void encode_pending(ne_handle handle) {
+   if (handle->enc_pending == 0) {
+      return;
+   }
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t enclen = handle->enc_pending * handle->epat.partsz;
+   LOG(LOG_INFO, "Generating erasure parts for %u pending stripes\n", handle->enc_pending);
+   int block;
+   for (block = 0; block < N + E; block++) {
+      handle->enc_refs[block] = (unsigned char*)ioblock_write_target(handle->iob[block]) - enclen;
+   }
+   // NOTE -- g_tbls are read-only once generated, so encoding proceeds without the erasurelock
+   ec_encode_data((int)enclen, N, E, handle->tables->g_tbls, handle->enc_refs, &(handle->enc_refs[N]));
+   handle->enc_pending = 0;
+}
+
 /**
  * This helper function is intended to identify the most common sensible values amongst all meta_buffers
  * for a given number of read threads and return them in a provided read_meta_buffer struct.
@@ -461,13 +751,14 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
    ret_buf->versz = -1;
    ret_buf->blocksz = -1;
    ret_buf->totsz = -1;
+   ret_buf->crctype = CRC_IEEE;
    // bounds checking
    if ( num_blocks < 1 ) {
       LOG( LOG_ERR, "Called with zero blocks, nothing to check\n" );
       return 0;
    }
    // allocate space for ALL match arrays
-   int* N_match = calloc(7, sizeof(int) * num_blocks);
+   int* N_match = calloc(8, sizeof(int) * num_blocks);
    if (N_match == NULL) {
       LOG(LOG_ERR, "Failed to allocate space for match count arrays!\n");
       return 0;
@@ -478,6 +769,7 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
    int* versz_match = (partsz_match + num_blocks);
    int* blocksz_match = (versz_match + num_blocks);
    int* totsz_match = (blocksz_match + num_blocks);
+   int* crctype_match = (totsz_match + num_blocks);
 
    int i;
    for (i = 0; i < num_blocks; i++) {
@@ -503,6 +795,7 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
          COUNT_MATCH_AT_INDEX(versz, versz_match, 0, minfo->versz)       // no maximum
          COUNT_MATCH_AT_INDEX(blocksz, blocksz_match, 0, minfo->blocksz) // no maximum
          COUNT_MATCH_AT_INDEX(totsz, totsz_match, 0, minfo->totsz)       //no maximum
+         COUNT_MATCH_AT_INDEX(crctype, crctype_match, CRC_IEEE, CRC_ISCSI)
    }
 
    // find the value with the most matches
@@ -513,6 +806,7 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
    int versz_index = 0;
    int blocksz_index = 0;
    int totsz_index = 0;
+   int crctype_index = 0;
    for (i = 1; i < num_blocks; i++) {
       // For N/E: if two values are tied for matches, prefer the larger value (helps to avoid taking values from a single bad meta info)
       if (N_match[i] > N_match[N_index] ||
@@ -537,6 +831,8 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
          (totsz_match[i] == totsz_match[totsz_index] &&
             minfo_structs[i]->totsz < minfo_structs[totsz_index]->totsz))
          totsz_index = i;
+      if (crctype_match[i] > crctype_match[crctype_index])
+         crctype_index = i;
    }
 
    // assign appropriate values to our output struct
@@ -578,6 +874,10 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
       anyvalid = 1;
    }
 
+   if (crctype_match[crctype_index]) {
+      ret_buf->crctype = minfo_structs[crctype_index]->crctype;
+   }
+
    int retval = (N_match[N_index] > E_match[E_index]) ? E_match[E_index] : N_match[N_index];
    free(N_match);
    // special case check for no valid meta info values
@@ -588,58 +888,28 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
 }
 
 /**
- *
- *
+ * Populate ioblock references for the current stripe range, until at least the given number of blocks are present
+ * NOTE -- Any halted erasure thread required for this will be restarted at the current ioblock offset.
+ *         Blocks are always populated in order, so iob[0] through iob[iob_blkcnt - 1] are valid after a success.
+ * @param ne_handle handle : Handle to populate ioblocks for
+ * @param int blkcnt : Minimum count of ioblocks to populate
+ * @param char coverrs : If non-zero, also populate one additional erasure ioblock for each block error encountered
+ * @return int : Zero on success, or -1 on failure
  */
-int read_stripes(ne_handle handle) {
+static int read_ioblocks(ne_handle handle, int blkcnt, char coverrs) {
 
    // get some useful reference values
    int N = handle->epat.N;
    int E = handle->epat.E;
-   ssize_t partsz = handle->epat.partsz;
-   size_t stripesz = partsz * N;
 #ifdef DEBUG
-   size_t offset = (handle->iob_offset * N) + handle->sub_offset;
-   unsigned int start_stripe = (unsigned int)(offset / stripesz); // get a stripe num based on offset
+   size_t stripesz = handle->epat.partsz * N;
+   unsigned int start_stripe = (unsigned int)((handle->iob_offset * N) / stripesz);
 #endif
 
-   // make sure our sub_offset is stripe aligned and at the end of our ioblocks ( or zero, if none present )
-   if ( handle->sub_offset % stripesz || handle->sub_offset != (handle->iob_datasz * N) ) {
-      LOG(LOG_ERR, "Called on handle with an inappropriate sub_offset (%zd)!\n", handle->sub_offset);
-      errno = EBADF;
-      return -1;
-   }
-   // update handle offset values ( NOTE : no effect if we don't yet have populated ioblocks )
-   handle->iob_offset += handle->iob_datasz;
-   // always start with a fresh sub_offset for new stripes
-   handle->sub_offset = 0;
-   handle->iob_datasz = 0;
-
-   // if we have previous block references, we'll need to release them
-   int i;
-   for (i = 0; i < handle->epat.N + handle->epat.E && handle->iob[i] != NULL; i++) {
-      if (release_ioblock(handle->thread_states[i].ioq)) {
-         LOG(LOG_ERR, "Failed to release ioblock reference for block %d!\n", i);
-         return -1;
-      }
-      handle->iob[i] = NULL; // NULL out this outdated reference
-   }
-
-   // ---------------------- VERIFY INTEGRITY OF ALL BLOCKS IN STRIPE ----------------------
-
-   // First, loop through all data buffers in the stripe, looking for errors.
-   // Then, starup erasure threads as necessary to deal with errors.
-   // Technically, it would theoretically be more efficient to limit this to
-   // only the blocks we expect to need.  However, if we hit any error in those
-   // blocks, we'll suddenly need the whole stripe.  I am hoping the reduced
-   // complexity of just checking them all will be worth what will probably
-   // only be the slightest of performance hits.  Besides, in the expected
-   // use case of reading a file start to finish, we'll eventually need this
-   // entire stripe regardless.
    int cur_block;
-   int stripecnt = 0;
-   int nstripe_errors = 0;
-   for (cur_block = 0; (cur_block < (N + nstripe_errors) || cur_block < (N + handle->ethreads_running)) && cur_block < (N + E); cur_block++) {
+   for (cur_block = handle->iob_blkcnt;
+        (cur_block < blkcnt || cur_block < (N + handle->ethreads_running) || (coverrs && cur_block < (N + handle->iob_errcnt))) && cur_block < (N + E);
+        cur_block++) {
       // if this thread isn't running, we need to start it
       if (cur_block >= N + handle->ethreads_running) {
          LOG(LOG_INFO, "Starting up thread %d to cope with errors beyond stripe %d\n", cur_block, start_stripe);
@@ -648,10 +918,12 @@ int read_stripes(ne_handle handle) {
             LOG(LOG_INFO, "Releasing ioblock from queue %d, prior to reseek\n", cur_block);
             if (release_ioblock(handle->thread_states[cur_block].ioq)) {
                LOG(LOG_ERR, "Failed to release ioblock from queue %d\n", cur_block);
+               handle->iob[cur_block] = NULL;
                errno = EBADF;
                return -1;
             }
          }
+         handle->iob[cur_block] = NULL;
          if ( tq_wait_for_pause( handle->thread_queues[cur_block] ) ) {
             LOG( LOG_ERR, "Failed to verify that thread %d paused, prior to restarting\n", cur_block );
             errno = EBADF;
@@ -668,19 +940,21 @@ int read_stripes(ne_handle handle) {
       // retrieve a new ioblock from this thread
       if (tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void**)&(handle->iob[cur_block])) < 0) {
          LOG(LOG_ERR, "Failed to retrieve new buffer for block %d!\n", cur_block);
+         handle->iob[cur_block] = NULL;
          errno = EBADF;
          return -1;
       }
       LOG(LOG_INFO, "Dequeued ioblock at position %d\n", cur_block);
+      handle->iob_blkcnt = cur_block + 1;
       // check if this new ioblock will require a rebuild
       ioblock* cur_iob = handle->iob[cur_block];
       if (cur_iob->error_end > 0) {
          LOG(LOG_ERR, "Detected an error at offset %zu of ioblock %d\n", cur_iob->error_end, cur_block);
-         nstripe_errors++;
+         handle->iob_errcnt++;
       }
       // check if we can even handle however many errors we've hit so far
-      if (nstripe_errors > E) {
-         LOG(LOG_ERR, "Data beyond stripe %d has too many errors (%d) to be recovered\n", start_stripe, nstripe_errors);
+      if (handle->iob_errcnt > E) {
+         LOG(LOG_ERR, "Data beyond stripe %d has too many errors (%d) to be recovered\n", start_stripe, handle->iob_errcnt);
          errno = ENODATA;
          return -1;
       }
@@ -694,206 +968,707 @@ int read_stripes(ne_handle handle) {
          }
       }
       else {
-         stripecnt = (cur_iob->data_size / partsz);
          handle->iob_datasz = cur_iob->data_size;
       } // or set it, if we haven't yet
    }
 
-   int block_cnt = cur_block;
+   if (handle->iob_blkcnt < blkcnt) {
+      LOG(LOG_ERR, "Insufficient blocks to populate %d ioblocks\n", blkcnt);
+      errno = ENODATA;
+      return -1;
+   }
+   return 0;
+}
+
+/**
+ * Identify the erased blocks of a single stripe of the current ioblocks, noting any change in error pattern
+ * NOTE -- Blocks without a populated ioblock are not considered to be in error.
+ * @param ne_handle handle : Handle to check the stripe of
+ * @param int stripe : Index of the stripe within the current ioblocks
+ * @return int : Count of erased blocks in the stripe ( listed, in order, in handle->err_list )
+ */
+static int stripe_errors(ne_handle handle, int stripe) {
+   off_t stripe_start = stripe * handle->epat.partsz;
+   int nerrs = 0;
+   int cur_block;
+   for (cur_block = 0; cur_block < (handle->epat.N + handle->epat.E); cur_block++) {
+      unsigned char in_err = 0;
+      // check for bad stripe data in this block
+      if (cur_block < handle->iob_blkcnt && stripe_start < handle->iob[cur_block]->error_end) {
+         handle->err_list[nerrs] = cur_block;
+         nerrs++;
+         in_err = 1;
+      }
+      // check for any change in our error pattern, as that will require reinitializing erasure structs
+      if (handle->prev_in_err[cur_block] != in_err) {
+         handle->e_ready = 0;
+         handle->prev_in_err[cur_block] = in_err;
+      }
+   }
+   return nerrs;
+}
+
+/**
+ * Retrieve decode tables matching the error pattern most recently identified by stripe_errors()
+ * @param ne_handle handle : Handle to retrieve tables for
+ * @param int nerrs : Count of erased blocks in handle->err_list
+ * @return int : Zero on success, or -1 on failure
+ */
+static int stripe_tables(ne_handle handle, int nerrs) {
+   if (handle->e_ready) {
+      return 0;
+   }
+   LOG(LOG_INFO, "Retrieving decode tables ( nstripe_errors = %d )\n", nerrs);
+   // drop any tables for our previous error pattern
+   if (handle->tables) {
+      release_tables(handle->ctxt, handle->tables);
+      handle->tables = NULL;
+   }
+   handle->tables = acquire_tables(handle->ctxt, handle->epat.N, handle->epat.E, handle->err_list, nerrs);
+   if (handle->tables == NULL) {
+      LOG(LOG_ERR, "Failure to generate decode tables, errors may exceed erasure limits (%d)!\n", nerrs);
+      return -1;
+   }
+   handle->e_ready = 1; //indicate that rebuild structures are initialized
+   return 0;
+}
+
+/**
+ * Regenerate a range of a single erased data part of the current ioblocks into the given buffer
+ * NOTE -- Only the requested range of the one requested part is decoded.  Erasure ioblocks are only read
+ *         ( and their threads only restarted ) if they are needed to decode this stripe.
+ *         The ioblock of the erased part is left unaltered.
+ * @param ne_handle handle : NE_RDONLY handle to regenerate data for
+ * @param int stripe : Index of the stripe within the current ioblocks
+ * @param int block : Erased data block to regenerate
+ * @param off_t block_off : Offset of the range within the data part
+ * @param size_t len : Length of the range
+ * @param unsigned char* tgt : Buffer to be populated with regenerated data
+ * @return int : Zero on success, or -1 on failure
+ */
+static int regenerate_range(ne_handle handle, int stripe, int block, off_t block_off, size_t len, unsigned char* tgt) {
+   int N = handle->epat.N;
+   off_t stripe_start = stripe * handle->epat.partsz;
+
+   // make sure we have enough intact blocks in this stripe to decode from
+   int nerrs = stripe_errors(handle, stripe);
+   while ((handle->iob_blkcnt - nerrs) < N) {
+      LOG(LOG_INFO, "Reading erasure to cope with %d errors in stripe %d\n", nerrs, stripe);
+      if (read_ioblocks(handle, N + nerrs, 0)) {
+         LOG(LOG_ERR, "Failed to retrieve sufficient erasure ioblocks to regenerate stripe %d\n", stripe);
+         return -1;
+      }
+      nerrs = stripe_errors(handle, stripe);
+   }
+   // remember how many erasure threads we needed, so that read_stripes() can keep them running
+   if ((unsigned int)(handle->iob_blkcnt - N) > handle->prev_err_cnt) {
+      handle->prev_err_cnt = handle->iob_blkcnt - N;
+   }
+   if (stripe_tables(handle, nerrs)) {
+      return -1;
+   }
+
+   // locate the decode row of our erased block
+   int row;
+   for (row = 0; row < nerrs && handle->err_list[row] != block; row++) {}
+   if (row == nerrs) {
+      LOG(LOG_ERR, "Block %d is not in error for stripe %d\n", block, stripe);
+      errno = EINVAL;
+      return -1;
+   }
+
+   // NOTE -- reads never populate enc_refs, so we can use them as our decode sources
+   unsigned char** recov = handle->enc_refs;
+   int cur_block;
+   for (cur_block = 0; cur_block < N; cur_block++) {
+      recov[cur_block] = handle->iob[handle->tables->decode_index[cur_block]]->buff + stripe_start + block_off;
+   }
+   LOG(LOG_INFO, "Regenerating %zu bytes at offset %zd of block %d of stripe %d\n", len, block_off, block, stripe);
+   // NOTE -- each row of the decode tables is independent, so we can produce only the one we need
+   ec_encode_data((int)len, N, 1, handle->tables->g_tbls + (row * N * 32), recov, &tgt);
+   return 0;
+}
+
+/**
+ * Populate ioblocks for the next range of stripes, releasing all previous ioblocks
+ * NOTE -- For NE_RDONLY handles, only data ioblocks ( plus those of any erasure threads which were required for
+ *         the previous range ) are read.  Erased data is then regenerated only as it is read, via
+ *         regenerate_range().  For all other modes, every erased block of every stripe is regenerated here.
+ * @param ne_handle handle : Handle to populate ioblocks for
+ * @return int : Zero on success, or -1 on failure
+ */
+int read_stripes(ne_handle handle) {
 
-   // if we'er trying to avoid unnecessary reads, halt excess erasure threads
+   // get some useful reference values
+   int N = handle->epat.N;
+   ssize_t partsz = handle->epat.partsz;
+   size_t stripesz = partsz * N;
+#ifdef DEBUG
+   size_t offset = (handle->iob_offset * N) + handle->sub_offset;
+   unsigned int start_stripe = (unsigned int)(offset / stripesz);
+#endif
+
+   // make sure our sub_offset is stripe aligned and at the end of our ioblocks ( or zero, if none present )
+   if ( handle->sub_offset % stripesz || handle->sub_offset != (handle->iob_datasz * N) ) {
+      LOG(LOG_ERR, "Called on handle with an inappropriate sub_offset (%zd)!\n", handle->sub_offset);
+      errno = EBADF;
+      return -1;
+   }
+   // update handle offset values ( NOTE : no effect if we don't yet have populated ioblocks )
+   handle->iob_offset += handle->iob_datasz;
+   // always start with a fresh sub_offset for new stripes
+   handle->sub_offset = 0;
+   handle->iob_datasz = 0;
+
+   // if we have previous block references, we'll need to release them
+   int i;
+   for (i = 0; i < handle->epat.N + handle->epat.E && handle->iob[i] != NULL; i++) {
+      if (release_ioblock(handle->thread_states[i].ioq)) {
+         LOG(LOG_ERR, "Failed to release ioblock reference for block %d!\n", i);
+         return -1;
+      }
+      handle->iob[i] = NULL; // NULL out this outdated reference
+   }
+   handle->iob_blkcnt = 0;
+   handle->iob_errcnt = 0;
+
+   // if we're trying to avoid unnecessary reads, halt any erasure threads not required for the previous stripes
    if (handle->mode == NE_RDONLY) {
-      // keep the greater of how many erasure threads we've needed in the last couple of stripes...
-      if (nstripe_errors > handle->prev_err_cnt)
-         handle->prev_err_cnt = nstripe_errors;
-      // ...and halt all others
-      for (cur_block = (N + nstripe_errors); cur_block < (N + handle->prev_err_cnt); cur_block++) {
-         LOG(LOG_INFO, "Setting HALT state for unneded thread %d\n", cur_block);
-         if (tq_set_flags(handle->thread_queues[cur_block], TQ_HALT)) {
+      while (handle->ethreads_running > handle->prev_err_cnt) {
+         LOG(LOG_INFO, "Setting HALT state for unneded thread %d\n", N + handle->ethreads_running - 1);
+         if (tq_set_flags(handle->thread_queues[N + handle->ethreads_running - 1], TQ_HALT)) {
             // nothing to do besides complain
-            LOG(LOG_ERR, "Failed to pause erasure thread for block %d!\n", cur_block);
-         }
-         else {
-            handle->ethreads_running--;
+            LOG(LOG_ERR, "Failed to pause erasure thread for block %d!\n", N + handle->ethreads_running - 1);
+            break;
          }
+         handle->ethreads_running--;
       }
-      // need to reassign, in case the number of errors is decreasing
-      handle->prev_err_cnt = nstripe_errors;
-   }
+      // the count will be re-established by any regeneration within this range of stripes
+      handle->prev_err_cnt = 0;
 
-   // If any errors were found, we need to try and reconstruct any missing data
-   if (nstripe_errors) {
-      // create some erasure structs
-      unsigned char* stripe_in_err = calloc(N + E, sizeof(unsigned char));
-      if (stripe_in_err == NULL) {
-         LOG(LOG_ERR, "Failed to allocate space for a stripe_in_err array!\n");
+      // ---------------------- READ DATA BLOCKS ONLY ----------------------
+      if (read_ioblocks(handle, N, 0)) {
+         LOG(LOG_ERR, "Failed to populate ioblocks for stripes beyond %d\n", start_stripe);
          return -1;
       }
-      unsigned char* stripe_err_list = calloc(N + E, sizeof(unsigned char));
-      if (stripe_err_list == NULL) {
-         LOG(LOG_ERR, "Failed to allocate space for a stripe_err_list array!\n");
-         free( stripe_in_err );
+      return 0;
+   }
+
+   // ---------------------- VERIFY INTEGRITY OF ALL BLOCKS IN STRIPE ----------------------
+
+   // First, loop through all data buffers in the stripe, looking for errors.
+   // Then, starup erasure threads as necessary to deal with errors.
+   if (read_ioblocks(handle, N, 1)) {
+      LOG(LOG_ERR, "Failed to populate ioblocks for stripes beyond %d\n", start_stripe);
+      return -1;
+   }
+
+   // If any errors were found, we need to try and reconstruct any missing data
+   if (handle->iob_errcnt) {
+      unsigned char** temp_buffs = calloc(handle->iob_errcnt, sizeof(unsigned char*));
+      if (temp_buffs == NULL) {
+         LOG(LOG_ERR, "Failed to allocate space for a temp_buffs array!\n");
          return -1;
       }
+      // NOTE -- reads never populate enc_refs, so we can use them as our decode sources
+      unsigned char** recov = handle->enc_refs;
 
       // loop over each stripe in reverse order, fixing the ends of the buffers first
       // NOTE -- reconstructing in reverse allows us to continue using the error_end values appropriately
       int cur_stripe;
-      for (cur_stripe = stripecnt - 1; cur_stripe >= 0; cur_stripe--) {
+      for (cur_stripe = (handle->iob_datasz / partsz) - 1; cur_stripe >= 0; cur_stripe--) {
 
          // loop over the blocks of the stripe, establishing error counts/positions
          off_t stripe_start = cur_stripe * partsz;
-         nstripe_errors = 0;
-         for (cur_block = 0; cur_block < block_cnt; cur_block++) {
-            // reset our error state
-            stripe_err_list[cur_block] = 0; // as cur_block MUST be <= nstripe_errors at this point
-            stripe_in_err[cur_block] = 0;
-
-            // check for bad stripe data in this block
-            if (stripe_start < handle->iob[cur_block]->error_end) {
-               LOG(LOG_WARNING, "Detected bad data for block %d of stripe %d\n", cur_block, cur_stripe + start_stripe);
-               stripe_err_list[nstripe_errors] = cur_block;
-               nstripe_errors++;
-               stripe_in_err[cur_block] = 1;
-               // we just need to note the error, nothing to be done about it until we have all buffers ready
-            }
+         int nstripe_errors = stripe_errors(handle, cur_stripe);
 
-            // check for any change in our error pattern, as that will require reinitializing erasure structs
-            if (handle->prev_in_err[cur_block] != stripe_in_err[cur_block]) {
-               handle->e_ready = 0;
-               handle->prev_in_err[cur_block] = stripe_in_err[cur_block];
-            }
+         // nothing to regenerate for a stripe without errors
+         if (nstripe_errors == 0) {
+            continue;
          }
+         LOG(LOG_WARNING, "Detected bad data for %d blocks of stripe %d\n", nstripe_errors, cur_stripe + start_stripe);
 
+         if (stripe_tables(handle, nstripe_errors)) {
+            free(temp_buffs);
+            return -1;
+         }
 
-         if (!(handle->e_ready)) {
+         // as this struct will change depending on the head position of our queues, we must generate here
+         int cur_block;
+         for (cur_block = 0; cur_block < N; cur_block++) {
+            recov[cur_block] = handle->iob[handle->tables->decode_index[cur_block]]->buff + stripe_start;
+         }
 
-            LOG(LOG_INFO, "Initializing erasure structs...\n");
+         for (cur_block = 0; cur_block < nstripe_errors; cur_block++) {
+            // assign storage locations for the repaired buffers to be on top of the faulty buffers
+            temp_buffs[cur_block] = handle->iob[handle->err_list[cur_block]]->buff + stripe_start;
+            // as we are regenerating over the bad buffer, mark it as usable from this point on
+            handle->iob[handle->err_list[cur_block]]->error_end = stripe_start;
+         }
 
-            unsigned char* tmpmatrix = calloc((N + E) * (N + E), sizeof(unsigned char));
-            if (tmpmatrix == NULL) {
-               LOG(LOG_ERR, "Failed to allocate space for a tmpmatrix!\n");
-               free(stripe_in_err);
-               free(stripe_err_list);
-               return -1;
-            }
+         LOG(LOG_INFO, "Performing regeneration of stripe %d from erasure\n", cur_stripe + start_stripe);
+         // NOTE -- ec_encode_data() only reads from our (shared) g_tbls, so no erasurelock is required here
+         ec_encode_data(partsz, N, nstripe_errors, handle->tables->g_tbls, recov, &temp_buffs[0]);
+      } // end of per-stripe loop
 
-            // critical section : we are now going to call some inlined assembly erasure funcs
-            if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to acquire erasurelock prior to table generation for stripe %d\n", cur_stripe + start_stripe );
-               free(tmpmatrix);
-               free( stripe_err_list );
-               free( stripe_in_err );
-               return -1;
-            }
+      free(temp_buffs);
 
-            // Generate an encoding matrix
-            gf_gen_cauchy1_matrix(handle->encode_matrix, N + E, N);
-
-            // Generate g_tbls from encode matrix
-            ec_init_tables(N, E, &(handle->encode_matrix[N * N]), handle->g_tbls);
-            int ret_code = gf_gen_decode_matrix_simple(handle->encode_matrix, handle->decode_matrix,
-               handle->invert_matrix, tmpmatrix, handle->decode_index, stripe_err_list,
-               nstripe_errors, N, N + E);
-
-            if (ret_code != 0) {
-               // this is the only error for which we will at least attempt to continue
-               LOG(LOG_ERR, "Failure to generate decode matrix, errors may exceed erasure limits (%d)!\n", nstripe_errors);
-               pthread_mutex_unlock( handle->ctxt->erasurelock );
-               free(tmpmatrix);
-               free(stripe_in_err);
-               free(stripe_err_list);
-               // return the number of stripes we failed to regenerate
-               errno = ENODATA;
-               return -1;
-            }
+   } // end of error regeneration logic
 
-            LOG(LOG_INFO, "Initializing erasure tables ( nstripe_errors = %d )\n", nstripe_errors);
-            ec_init_tables(N, nstripe_errors, handle->decode_matrix, handle->g_tbls);
+   return 0;
+}
 
-            // exiting critical section
-            if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to relinquish erasurelock after table generation for stripe %d\n", cur_stripe + start_stripe );
-               free(tmpmatrix);
-               free( stripe_err_list );
-               free( stripe_in_err );
-               return -1;
-            }
-            free(tmpmatrix);
+// ---------------------- RANDOM ACCESS READS ----------------------
 
-            handle->e_ready = 1; //indicate that rebuild structures are initialized
+/**
+ * Retrieve and verify a single IO of a block of a NE_RANDOM handle ( a no-op, if that IO is already held )
+ * NOTE -- Any failure to open, read, or verify the block marks it as bad for the remaining life of the handle
+ * @param ne_handle handle : NE_RANDOM handle to retrieve data for
+ * @param int block : Block to retrieve data from
+ * @param off_t ioidx : Index of the IO within the block
+ * @return int : Zero on success, 1 if the block is bad, or -1 on failure
+ */
+static int random_fetch(ne_handle handle, int block, off_t ioidx) {
+   ne_rblock* rblock = handle->rblocks + block;
+   gthread_state* gstate = handle->thread_states + block;
+   if (rblock->bad) {
+      return 1;
+   }
+   if (rblock->ioidx == ioidx) {
+      return 0;
+   }
+   DAL dal = handle->ctxt->dal;
+   if (gstate->data_error) {
+      LOG(LOG_WARNING, "Block %d has a previous data error\n", block);
+      rblock->bad = 1;
+      return 1;
+   }
+   // our block reference is inherited from the block thread which retrieved our meta info
+   if (rblock->bctxt == NULL) {
+      LOG(LOG_ERR, "Block %d has no open reference for random access\n", block);
+      gstate->data_error = 1;
+      rblock->bad = 1;
+      return 1;
+   }
+   // allocate a buffer for this block, if we haven't yet
+   if (rblock->buff == NULL) {
+      rblock->buff = malloc(handle->versz);
+      if (rblock->buff == NULL) {
+         LOG(LOG_ERR, "Failed to allocate an IO buffer for block %d\n", block);
+         return -1;
+      }
+   }
+   // determine the size of this IO ( only the final IO of a block may be short )
+   off_t iooff = ioidx * handle->versz;
+   ssize_t iosz = handle->versz;
+   if (iosz > (gstate->minfo.blocksz - iooff)) {
+      iosz = gstate->minfo.blocksz - iooff;
+   }
+   rblock->ioidx = -1; // buffer contents are now invalid, until verified
+   if (iosz <= CRC_BYTES) {
+      LOG(LOG_ERR, "IO %zd of block %d is beyond the end of the block\n", ioidx, block);
+      gstate->data_error = 1;
+      rblock->bad = 1;
+      return 1;
+   }
+   LOG(LOG_INFO, "Reading %zd bytes from offset %zd of block %d\n", iosz, iooff, block);
+   ssize_t getres = dal->get(rblock->bctxt, rblock->buff, iosz, iooff);
+   if (getres < iosz) {
+      LOG(LOG_ERR, "Expected read return value of %zd for block %d, but recieved: %zd\n", iosz, block, getres);
+      gstate->data_error = 1;
+      rblock->bad = 1;
+      return 1;
+   }
+   iosz -= CRC_BYTES;
+   uint32_t scrc = *((uint32_t*)(rblock->buff + iosz));
+   uint32_t crc = io_checksum(gstate->minfo.crctype, CRC_SEED, rblock->buff, iosz);
+   if (crc != scrc) {
+      LOG(LOG_ERR, "Calculated CRC of IO %zd of block %d (%u) does not match stored CRC: %u\n", ioidx, block, crc, scrc);
+      gstate->data_error = 1;
+      rblock->bad = 1;
+      return 1;
+   }
+   rblock->ioidx = ioidx;
+   rblock->datasz = iosz;
+   return 0;
+}
+
+/**
+ * Regenerate a range of a single IO of a bad block of a NE_RANDOM handle into the given buffer
+ * NOTE -- Only the first N intact blocks are read, and only the requested range of the bad block is decoded
+ * @param ne_handle handle : NE_RANDOM handle to regenerate data for
+ * @param int block : Bad block to regenerate
+ * @param off_t ioidx : Index of the IO within the block
+ * @param off_t iooff : Offset of the range within the IO
+ * @param size_t len : Length of the range
+ * @param unsigned char* tgt : Buffer to be populated with regenerated data
+ * @return int : Zero on success, or -1 on failure
+ */
+static int random_regenerate(ne_handle handle, int block, off_t ioidx, off_t iooff, size_t len, unsigned char* tgt) {
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   // retrieve this IO from the first N intact blocks, noting all bad blocks encountered along the way
+   int nerrs = 0;
+   int srccnt = 0;
+   int cur_block;
+   for (cur_block = 0; cur_block < (N + E); cur_block++) {
+      unsigned char in_err = 0;
+      if (srccnt < N) {
+         int fetchres = random_fetch(handle, cur_block, ioidx);
+         if (fetchres < 0) {
+            return -1;
+         }
+         if (fetchres == 0 && handle->rblocks[cur_block].datasz < (iooff + len)) {
+            LOG(LOG_ERR, "IO %zd of block %d is subsized (%zu)\n", ioidx, cur_block, handle->rblocks[cur_block].datasz);
+            handle->thread_states[cur_block].data_error = 1;
+            handle->rblocks[cur_block].bad = 1;
+            fetchres = 1;
+         }
+         if (fetchres) {
+            handle->err_list[nerrs] = cur_block;
+            nerrs++;
+            in_err = 1;
+         }
+         else {
+            srccnt++;
+         }
+      }
+      // check for any change in our error pattern, as that will require reinitializing erasure structs
+      if (handle->prev_in_err[cur_block] != in_err) {
+         handle->e_ready = 0;
+         handle->prev_in_err[cur_block] = in_err;
+      }
+   }
+   if (srccnt < N) {
+      LOG(LOG_ERR, "Insufficient intact blocks ( %d ) to regenerate IO %zd of block %d\n", srccnt, ioidx, block);
+      errno = ENODATA;
+      return -1;
+   }
+   if (stripe_tables(handle, nerrs)) {
+      return -1;
+   }
+   // locate the decode row of our bad block
+   int row;
+   for (row = 0; row < nerrs && handle->err_list[row] != block; row++) {}
+   if (row == nerrs) {
+      LOG(LOG_ERR, "Block %d is not in error for IO %zd\n", block, ioidx);
+      errno = EINVAL;
+      return -1;
+   }
+   // NOTE -- reads never populate enc_refs, so we can use them as our decode sources
+   unsigned char** recov = handle->enc_refs;
+   for (cur_block = 0; cur_block < N; cur_block++) {
+      recov[cur_block] = (unsigned char*)(handle->rblocks[handle->tables->decode_index[cur_block]].buff) + iooff;
+   }
+   LOG(LOG_INFO, "Regenerating %zu bytes at offset %zd of IO %zd of block %d\n", len, iooff, ioidx, block);
+   ec_encode_data((int)len, N, 1, handle->tables->g_tbls + (row * N * 32), recov, &tgt);
+   return 0;
+}
+
+/**
+ * Read from the current offset of a NE_RANDOM handle
+ * NOTE -- The caller is expected to have already limited the request to the size of the object
+ * @param ne_handle handle : NE_RANDOM handle to read from
+ * @param void* buffer : Buffer to be populated with read data ( if NULL, data is simply skipped )
+ * @param size_t bytes : Number of bytes to be read
+ * @return ssize_t : The number of bytes read, or -1 on failure
+ */
+static ssize_t random_read(ne_handle handle, void* buffer, size_t bytes) {
+   int N = handle->epat.N;
+   ssize_t partsz = handle->epat.partsz;
+   size_t stripesz = partsz * N;
+   size_t iodatasz = handle->versz - CRC_BYTES;
+   off_t offset = handle->sub_offset; // NOTE -- iob_offset is always zero for random handles
+   size_t bytes_read = 0;
+   while (bytes_read < bytes) {
+      // translate our object offset to a block, and an offset of one IO within that block
+      int block = (offset % stripesz) / partsz;
+      off_t part_off = offset % partsz;
+      off_t block_off = ((offset / stripesz) * partsz) + part_off;
+      off_t ioidx = block_off / iodatasz;
+      off_t iooff = block_off % iodatasz;
+      // limit this read to a single part and a single IO
+      size_t to_read = bytes - bytes_read;
+      if (to_read > (partsz - part_off)) {
+         to_read = partsz - part_off;
+      }
+      if (to_read > (iodatasz - iooff)) {
+         to_read = iodatasz - iooff;
+      }
+      if (buffer) {
+         int fetchres = random_fetch(handle, block, ioidx);
+         if (fetchres < 0) {
+            LOG(LOG_ERR, "Failed to retrieve IO %zd of block %d\n", ioidx, block);
+            return -1;
+         }
+         if (fetchres == 0 && handle->rblocks[block].datasz < (iooff + to_read)) {
+            LOG(LOG_ERR, "IO %zd of block %d is subsized (%zu)\n", ioidx, block, handle->rblocks[block].datasz);
+            handle->thread_states[block].data_error = 1;
+            handle->rblocks[block].bad = 1;
+            fetchres = 1;
+         }
+         if (fetchres == 0) {
+            LOG(LOG_INFO, "   Reading %zu bytes from block %d\n", to_read, block);
+            memcpy(buffer + bytes_read, handle->rblocks[block].buff + iooff, to_read);
+         }
+         else if (random_regenerate(handle, block, ioidx, iooff, to_read, (unsigned char*)buffer + bytes_read)) {
+            LOG(LOG_ERR, "Failed to regenerate %zu bytes of IO %zd of block %d\n", to_read, ioidx, block);
+            return -1;
          }
+      }
+      bytes_read += to_read;
+      offset += to_read;
+   }
+   handle->sub_offset = offset;
+   return bytes_read;
+}
+
+// ---------------------- CONTEXT CREATION/DESTRUCTION/VALIDATION ----------------------
+
+/**
+ * Exercise each isa-l routine used on our hot paths exactly once, while holding the erasurelock
+ * NOTE -- isa-l 'multibinary' routines resolve their arch-specific implementation on first call.
+ *         Once resolved, ec_encode_data() and our crc routines only read from caller provided tables
+ *         and buffers, allowing them to be called concurrently without any lock.
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to prime
+ * @return int : Zero on success, or -1 on failure
+ */
+static int prime_erasure_funcs(ne_ctxt ctxt) {
+   unsigned char matrix[2 * 1];
+   unsigned char tbls[32 * 1 * 1];
+   unsigned char data[64] = { 0 };
+   unsigned char erasure[64];
+   unsigned char* dref = data;
+   unsigned char* eref = erasure;
+   if ( pthread_mutex_lock( ctxt->erasurelock ) ) {
+      LOG( LOG_ERR, "Failed to acquire erasurelock prior to isa-l priming\n" );
+      return -1;
+   }
+   gf_gen_cauchy1_matrix(matrix, 2, 1);
+   ec_init_tables(1, 1, &(matrix[1]), tbls);
+   ec_encode_data(sizeof(data), 1, 1, tbls, &dref, &eref);
+   crc32_ieee(CRC_SEED, data, sizeof(data));
+   crc32_iscsi(data, sizeof(data), CRC_SEED);
+   if ( pthread_mutex_unlock( ctxt->erasurelock ) ) {
+      LOG( LOG_ERR, "Failed to relinquish erasurelock after isa-l priming\n" );
+      return -1;
+   }
+   return 0;
+}
+
+/**
+ * Parse the optional 'checksum' attribute of a DAL root node
+ * @param xmlNode* dal_root : Root of a libxml2 DAL node
+ * @param DAL_CRC* crctype : Reference to be populated with the specified checksum type
+ *                           ( left unaltered, if no such attribute exists )
+ * @return int : Zero on success, or -1 on failure
+ */
+static int parse_checksum_attr(xmlNode* dal_root, DAL_CRC* crctype) {
+   xmlAttr* attr = dal_root->properties;
+   for ( ; attr; attr = attr->next ) {
+      if ( attr->type != XML_ATTRIBUTE_NODE  ||  strncmp( (char*)attr->name, "checksum", 9 ) ) {
+         continue;
+      }
+      if ( attr->children == NULL  ||  attr->children->type != XML_TEXT_NODE  ||  attr->children->content == NULL ) {
+         LOG( LOG_ERR, "DAL 'checksum' attribute has no associated value\n" );
+         return -1;
+      }
+      const char* value = (const char*)attr->children->content;
+      if ( strncasecmp( value, "ieee", 5 ) == 0  ||  strncasecmp( value, "crc32", 6 ) == 0 ) {
+         *crctype = CRC_IEEE;
+      }
+      else if ( strncasecmp( value, "crc32c", 7 ) == 0  ||  strncasecmp( value, "iscsi", 6 ) == 0 ) {
+         *crctype = CRC_ISCSI;
+      }
+      else {
+         LOG( LOG_ERR, "Unrecognized DAL 'checksum' value: \"%s\"\n", value );
+         return -1;
+      }
+   }
+   return 0;
+}
+
+/**
+ * Parse the optional 'threadpool' attribute of a DAL root node
+ * @param xmlNode* dal_root : Root of a libxml2 DAL node
+ * @param char* usepool : Reference to be populated with a flag indicating if block threads should persist
+ *                        in a ne_ctxt pool ( left unaltered, if no such attribute exists )
+ * @return int : Zero on success, or -1 on failure
+ */
+static int parse_threadpool_attr(xmlNode* dal_root, char* usepool) {
+   xmlAttr* attr = dal_root->properties;
+   for ( ; attr; attr = attr->next ) {
+      if ( attr->type != XML_ATTRIBUTE_NODE  ||  strncmp( (char*)attr->name, "threadpool", 11 ) ) {
+         continue;
+      }
+      if ( attr->children == NULL  ||  attr->children->type != XML_TEXT_NODE  ||  attr->children->content == NULL ) {
+         LOG( LOG_ERR, "DAL 'threadpool' attribute has no associated value\n" );
+         return -1;
+      }
+      const char* value = (const char*)attr->children->content;
+      if ( strncasecmp( value, "yes", 4 ) == 0  ||  strncasecmp( value, "on", 3 ) == 0 ) {
+         *usepool = 1;
+      }
+      else if ( strncasecmp( value, "no", 3 ) == 0  ||  strncasecmp( value, "off", 4 ) == 0 ) {
+         *usepool = 0;
+      }
+      else {
+         LOG( LOG_ERR, "Unrecognized DAL 'threadpool' value: \"%s\"\n", value );
+         return -1;
+      }
+   }
+   return 0;
+}
+
+/**
+ * Determine the default idle buffer limit of the buffer pools of a ne_ctxt
+ * NOTE -- this retains the ioblocks of IOBLOCK_POOL_HANDLES handles of the widest stripe, each of
+ *         which may require up to twice the DAL io size
+ * @param int max_block : Maximum block count ( N + E ) of the ne_ctxt
+ * @param int qdepth : Ioblock count of each block thread
+ * @param size_t iosz : IO size of the DAL
+ * @return size_t : Idle buffer limit, in bytes
+ */
+static size_t default_pool_limit(int max_block, int qdepth, size_t iosz) {
+   return (size_t)IOBLOCK_POOL_HANDLES * max_block * qdepth * 2 * iosz;
+}
 
-         // as this struct will change depending on the head position of our queues, we must generate here
-         unsigned char** recov = calloc(N + E, sizeof(unsigned char*));
-         if (recov == NULL) {
-            LOG(LOG_ERR, "Failed to allocate space for a recovery array!\n");
-            free(stripe_in_err);
-            free(stripe_err_list);
+/**
+ * Parse the optional 'qdepth' and 'bufpool' attributes of a DAL root node
+ * @param xmlNode* dal_root : Root of a libxml2 DAL node
+ * @param int* qdepth : Reference to be populated with the ioblock count of each block thread
+ *                      ( left unaltered, if no such attribute exists )
+ * @param size_t* maxidle : Reference to be populated with the idle buffer limit of the buffer pool
+ *                          ( left unaltered, if no such attribute exists )
+ * @return int : Zero on success, or -1 on failure
+ */
+static int parse_ioqueue_attrs(xmlNode* dal_root, int* qdepth, size_t* maxidle) {
+   xmlAttr* attr = dal_root->properties;
+   for ( ; attr; attr = attr->next ) {
+      if ( attr->type != XML_ATTRIBUTE_NODE  ||
+           ( strncmp( (char*)attr->name, "qdepth", 7 )  &&  strncmp( (char*)attr->name, "bufpool", 8 ) ) ) {
+         continue;
+      }
+      if ( attr->children == NULL  ||  attr->children->type != XML_TEXT_NODE  ||  attr->children->content == NULL ) {
+         LOG( LOG_ERR, "DAL '%s' attribute has no associated value\n", (char*)attr->name );
+         return -1;
+      }
+      const char* value = (const char*)attr->children->content;
+      char* endptr = NULL;
+      errno = 0;
+      unsigned long long parsed = strtoull( value, &(endptr), 10 );
+      if ( errno  ||  endptr == value  ||  *endptr != '\0' ) {
+         LOG( LOG_ERR, "Invalid DAL '%s' value: \"%s\"\n", (char*)attr->name, value );
+         return -1;
+      }
+      if ( strncmp( (char*)attr->name, "qdepth", 7 ) == 0 ) {
+         if ( parsed < SUPER_BLOCK_CNT  ||  parsed > MAX_SUPER_BLOCK_CNT ) {
+            LOG( LOG_ERR, "DAL 'qdepth' value of %llu is outside of the allowable range ( %d - %d )\n",
+                 parsed, SUPER_BLOCK_CNT, MAX_SUPER_BLOCK_CNT );
             return -1;
          }
-         //unsigned char* recov[ MAXPARTS ];
-         for (cur_block = 0; cur_block < N; cur_block++) {
-            //BufferQueue* bq = &handle->blocks[handle->decode_index[cur_block]];
-            //recov[cur_block] = bq->buffers[ bq->head ];
-            recov[cur_block] = handle->iob[handle->decode_index[cur_block]]->buff + stripe_start;
-         }
+         *qdepth = (int)parsed;
+      }
+      else {
+         *maxidle = (size_t)parsed;
+      }
+   }
+   return 0;
+}
 
-         unsigned char** temp_buffs = calloc(nstripe_errors, sizeof(unsigned char*));
-         if (temp_buffs == NULL) {
-            LOG(LOG_ERR, "Failed to allocate space for a temp_buffs array!\n");
-            free(recov);
-            free(stripe_in_err);
-            free(stripe_err_list);
+/**
+ * Parse the optional 'numa' attribute of a DAL root node and populate the NUMA placement info of a ne_ctxt
+ * NOTE -- the attribute value may be "off" ( the default ), "all", or a comma-separated list of node numbers
+ * @param xmlNode* dal_root : Root of a libxml2 DAL node
+ * @param ne_ctxt ctxt : Context to be populated with NUMA placement info
+ * @param size_t maxidle : Idle buffer limit for each per-node buffer pool
+ * @return int : Zero on success, or -1 on failure
+ */
+static int setup_numa_placement(xmlNode* dal_root, ne_ctxt ctxt, size_t maxidle) {
+   const char* value = NULL;
+   xmlAttr* attr = dal_root->properties;
+   for ( ; attr; attr = attr->next ) {
+      if ( attr->type != XML_ATTRIBUTE_NODE  ||  strncmp( (char*)attr->name, "numa", 5 ) ) {
+         continue;
+      }
+      if ( attr->children == NULL  ||  attr->children->type != XML_TEXT_NODE  ||  attr->children->content == NULL ) {
+         LOG( LOG_ERR, "DAL 'numa' attribute has no associated value\n" );
+         return -1;
+      }
+      value = (const char*)attr->children->content;
+   }
+   if ( value == NULL  ||  strncasecmp( value, "off", 4 ) == 0 ) {
+      return 0; // NUMA placement is disabled
+   }
+   int nodecnt = io_numa_count();
+   if ( nodecnt < 1 ) {
+      LOG( LOG_WARNING, "NUMA info is unavailable, so NUMA placement will be disabled\n" );
+      return 0;
+   }
+   ctxt->numa = calloc( nodecnt, sizeof( io_numa ) );
+   ctxt->numapools = calloc( nodecnt, sizeof( ioblock_pool* ) );
+   if ( ctxt->numa == NULL  ||  ctxt->numapools == NULL ) {
+      LOG( LOG_ERR, "failed to allocate NUMA node lists\n" );
+      return -1;
+   }
+   char allnodes = ( strncasecmp( value, "all", 4 ) == 0 ) ? 1 : 0;
+   const char* parse = value;
+   int node = 0;
+   while ( allnodes ? (node < nodecnt) : (*parse != '\0') ) {
+      if ( !(allnodes) ) {
+         char* endptr = NULL;
+         long parsed = strtol( parse, &(endptr), 10 );
+         if ( endptr == parse  ||  (*endptr != ','  &&  *endptr != '\0')  ||  parsed < 0  ||  parsed >= nodecnt ) {
+            LOG( LOG_ERR, "Invalid DAL 'numa' value: \"%s\"\n", value );
             return -1;
          }
-         //unsigned char* temp_buffs[ nstripe_errors ];
-         for (cur_block = 0; cur_block < nstripe_errors; cur_block++) {
-            //BufferQueue* bq = &handle->blocks[stripe_err_list[ cur_block ]];
-            //temp_buffs[ cur_block ] = bq->buffers[ bq->head ];
-
-            // assign storage locations for the repaired buffers to be on top of the faulty buffers
-            temp_buffs[cur_block] = handle->iob[stripe_err_list[cur_block]]->buff + stripe_start;
-            // as we are regenerating over the bad buffer, mark it as usable from this point on
-            handle->iob[stripe_err_list[cur_block]]->error_end = stripe_start;
-
-            // as we are regenerating over the bad buffer, mark it as usable for future iterations
-            //*(u32*)( temp_buffs[ cur_block ] + bsz ) = 1;
+         node = (int)parsed;
+         parse = ( *endptr == ',' ) ? endptr + 1 : endptr;
+         if ( ctxt->numacnt == nodecnt ) {
+            LOG( LOG_ERR, "DAL 'numa' value lists more nodes than exist: \"%s\"\n", value );
+            return -1;
          }
-
-         LOG(LOG_INFO, "Performing regeneration of stripe %d from erasure\n", cur_stripe + start_stripe);
-         // critical section : we are now going to call some inlined assembly erasure funcs
-         if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-            LOG( LOG_ERR, "Failed to acquire erasurelock prior to regeneration of stripe %d\n", cur_stripe + start_stripe );
-            free(recov);
-            free( stripe_err_list );
-            free( stripe_in_err );
+      }
+      if ( io_numa_init( ctxt->numa + ctxt->numacnt, node ) ) {
+         if ( !(allnodes) ) {
+            LOG( LOG_ERR, "Failed to identify CPUs of NUMA node %d\n", node );
             return -1;
          }
-         ec_encode_data(partsz, N, nstripe_errors, handle->g_tbls, recov, &temp_buffs[0]);
-         // exiting critical section
-         if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-            LOG( LOG_ERR, "Failed to relinquish erasurelock after regeneration of stripe %d\n", cur_stripe + start_stripe );
-            free(recov);
-            free( stripe_err_list );
-            free( stripe_in_err );
+         LOG( LOG_INFO, "Skipping NUMA node %d, which has no identifiable CPUs\n", node );
+      }
+      else {
+         ctxt->numapools[ctxt->numacnt] = create_ioblock_pool( maxidle, ctxt->numa + ctxt->numacnt );
+         if ( ctxt->numapools[ctxt->numacnt] == NULL ) {
+            LOG( LOG_ERR, "failed to create ioblock buffer pool for NUMA node %d\n", node );
+            io_numa_free( ctxt->numa + ctxt->numacnt );
             return -1;
          }
-
-         free(recov);
-         free(temp_buffs);
-      } // end of per-stripe loop
-
-      // free unneeded lists
-      free(stripe_in_err);
-      free(stripe_err_list);
-
-   } // end of error regeneration logic
-
+         ctxt->numacnt++;
+      }
+      if ( allnodes ) { node++; }
+   }
+   LOG( LOG_INFO, "Placing handles across %d NUMA nodes\n", ctxt->numacnt );
    return 0;
 }
 
-// ---------------------- CONTEXT CREATION/DESTRUCTION/VALIDATION ----------------------
+/**
+ * Free all NUMA placement info of a ne_ctxt
+ * @param ne_ctxt ctxt : Context to free NUMA placement info of
+ */
+static void free_numa_placement(ne_ctxt ctxt) {
+   int i;
+   for ( i = 0; i < ctxt->numacnt; i++ ) {
+      if ( destroy_ioblock_pool( ctxt->numapools[i] ) ) {
+         LOG( LOG_WARNING, "ioblock buffers of NUMA node %d remained in use at ne_ctxt termination\n", ctxt->numa[i].node );
+      }
+      io_numa_free( ctxt->numa + i );
+   }
+   free( ctxt->numapools );
+   free( ctxt->numa );
+   ctxt->numapools = NULL;
+   ctxt->numa = NULL;
+   ctxt->numacnt = 0;
+}
 
 /**
  * Initializes an ne_ctxt with a default posix DAL configuration.
@@ -901,7 +1676,9 @@ int read_stripes(ne_handle handle) {
  * @param const char* path : The complete path template for the erasure stripe
  * @param ne_location max_loc : The maximum pod/cap/scatter values for this context
  * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
+ *                                       to isa-l erasure table generation functions in multi-threaded programs.
+ *                                       Erasure encoding / decoding and CRC generation only consume
+ *                                       previously generated tables, and never acquire this lock.
  *                                       If NULL, libne will create such a lock internally.  In such a case,
  *                                       the internal lock will continue to protect multi-threaded programs
  *                                       ONLY if they exclusively use a single ne_ctxt at a time.
@@ -978,6 +1755,54 @@ ne_ctxt ne_path_init(const char* path, ne_location max_loc, int max_block, pthre
       ctxt->erasurelock = &(ctxt->locallock);
    }
 
+   // initialize our erasure table cache
+   if ( pthread_mutex_init( &(ctxt->tablelock), NULL ) ) {
+      LOG( LOG_ERR, "failed to initialize erasure table lock\n" );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
+
+   // resolve isa-l function dispatch, so that later encode/crc calls need not serialize
+   if ( prime_erasure_funcs( ctxt ) ) {
+      LOG( LOG_ERR, "failed to prime isa-l erasure functions\n" );
+      pthread_mutex_destroy( &(ctxt->tablelock) );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
+
+   // size ioqueues to accommodate the preferred write batch depth of the DAL
+   ctxt->qdepth = SUPER_BLOCK_CNT;
+   if ( dal->io_batch > ctxt->qdepth - 2 ) {
+      ctxt->qdepth = ( dal->io_batch > MAX_SUPER_BLOCK_CNT - 2 ) ? MAX_SUPER_BLOCK_CNT : dal->io_batch + 2;
+   }
+
+   // initialize our ioblock buffer pool
+   ctxt->iopool = create_ioblock_pool( default_pool_limit( max_block, ctxt->qdepth, dal->io_size ), NULL );
+   if ( ctxt->iopool == NULL ) {
+      LOG( LOG_ERR, "failed to create ioblock buffer pool\n" );
+      pthread_mutex_destroy( &(ctxt->tablelock) );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
+
+   // initialize our block thread pool
+   ctxt->tpool = tq_pool_init( "libNE" );
+   if ( ctxt->tpool == NULL ) {
+      LOG( LOG_ERR, "failed to create block thread pool\n" );
+      destroy_ioblock_pool( ctxt->iopool );
+      pthread_mutex_destroy( &(ctxt->tablelock) );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
+
    // return the new ne_ctxt
    return ctxt;
 }
@@ -989,7 +1814,9 @@ ne_ctxt ne_path_init(const char* path, ne_location max_loc, int max_block, pthre
  *                              values for this context
  * @param int max_block : Integer maximum block value ( N + E ) for this context
  * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
+ *                                       to isa-l erasure table generation functions in multi-threaded programs.
+ *                                       Erasure encoding / decoding and CRC generation only consume
+ *                                       previously generated tables, and never acquire this lock.
  *                                       If NULL, libne will create such a lock internally.  In such a case,
  *                                       the internal lock will continue to protect multi-threaded programs
  *                                       ONLY if they exclusively use a single ne_ctxt at a time.
@@ -999,6 +1826,29 @@ ne_ctxt ne_path_init(const char* path, ne_location max_loc, int max_block, pthre
  * @return ne_ctxt : New ne_ctxt or NULL if an error was encountered
  */
 ne_ctxt ne_init(xmlNode* dal_root, ne_location max_loc, int max_block, pthread_mutex_t* erasurelock) {
+   // Determine the checksum type for new objects
+   DAL_CRC crctype = CRC_IEEE;
+   if (parse_checksum_attr(dal_root, &crctype)) {
+      LOG(LOG_ERR, "Failed to parse DAL checksum type\n");
+      errno = EINVAL;
+      return NULL;
+   }
+   // Determine ioqueue depth and buffer pool limits
+   int qdepth = SUPER_BLOCK_CNT;
+   size_t maxidle = SIZE_MAX; // replaced by default_pool_limit(), once the DAL is known, if not configured
+   if (parse_ioqueue_attrs(dal_root, &qdepth, &maxidle)) {
+      LOG(LOG_ERR, "Failed to parse DAL ioqueue values\n");
+      errno = EINVAL;
+      return NULL;
+   }
+   // Determine if block threads should persist between handles
+   char usepool = 1;
+   if (parse_threadpool_attr(dal_root, &usepool)) {
+      LOG(LOG_ERR, "Failed to parse DAL threadpool value\n");
+      errno = EINVAL;
+      return NULL;
+   }
+
    // Initialize a DAL instance
    DAL_location maxdal = { .pod = max_loc.pod, .block = max_block - 1, .cap = max_loc.cap, .scatter = max_loc.scatter };
    DAL dal = init_dal(dal_root, maxdal);
@@ -1008,6 +1858,18 @@ ne_ctxt ne_init(xmlNode* dal_root, ne_location max_loc, int max_block, pthread_m
       return NULL;
    }
 
+   // block threads coalesce writes only while leaving ioblocks for the writer to fill
+   if ( dal->io_batch > qdepth - 2 ) {
+      LOG(LOG_ERR, "DAL write batch depth of %d requires a 'qdepth' of at least %d ( currently %d )\n",
+                   dal->io_batch, dal->io_batch + 2, qdepth);
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      errno = EINVAL;
+      return NULL;
+   }
+   if ( maxidle == SIZE_MAX ) {
+      maxidle = default_pool_limit( max_block, qdepth, dal->io_size );
+   }
+
    // allocate a new context struct
    ne_ctxt ctxt = calloc( 1, sizeof(struct ne_ctxt_struct) );
    if (ctxt == NULL) {
@@ -1030,9 +1892,69 @@ ne_ctxt ne_init(xmlNode* dal_root, ne_location max_loc, int max_block, pthread_m
       ctxt->erasurelock = &(ctxt->locallock);
    }
 
+   // initialize our erasure table cache
+   if ( pthread_mutex_init( &(ctxt->tablelock), NULL ) ) {
+      LOG( LOG_ERR, "failed to initialize erasure table lock\n" );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
+
+   // resolve isa-l function dispatch, so that later encode/crc calls need not serialize
+   if ( prime_erasure_funcs( ctxt ) ) {
+      LOG( LOG_ERR, "failed to prime isa-l erasure functions\n" );
+      pthread_mutex_destroy( &(ctxt->tablelock) );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
+
+   // initialize our ioblock buffer pool
+   ctxt->iopool = create_ioblock_pool( maxidle, NULL );
+   if ( ctxt->iopool == NULL ) {
+      LOG( LOG_ERR, "failed to create ioblock buffer pool\n" );
+      pthread_mutex_destroy( &(ctxt->tablelock) );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
+
+   // identify any NUMA nodes for handle placement
+   if ( setup_numa_placement( dal_root, ctxt, maxidle ) ) {
+      LOG( LOG_ERR, "failed to setup NUMA placement\n" );
+      free_numa_placement( ctxt );
+      destroy_ioblock_pool( ctxt->iopool );
+      pthread_mutex_destroy( &(ctxt->tablelock) );
+      if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+      free( ctxt );
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      errno = EINVAL;
+      return NULL;
+   }
+
+   // initialize our block thread pool
+   if ( usepool ) {
+      ctxt->tpool = tq_pool_init( "libNE" );
+      if ( ctxt->tpool == NULL ) {
+         LOG( LOG_ERR, "failed to create block thread pool\n" );
+         free_numa_placement( ctxt );
+         destroy_ioblock_pool( ctxt->iopool );
+         pthread_mutex_destroy( &(ctxt->tablelock) );
+         if ( ctxt->erasurelock == &(ctxt->locallock) ) { pthread_mutex_destroy( ctxt->erasurelock ); }
+         free( ctxt );
+         dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+         return NULL;
+      }
+   }
+
    // fill in context values and return
    ctxt->max_block = max_block;
    ctxt->dal = dal;
+   ctxt->crctype = crctype;
+   ctxt->qdepth = qdepth;
 
    return ctxt;
 }
@@ -1050,15 +1972,39 @@ int ne_verify(ne_ctxt ctxt, char fix) {
 
 /**
  * Destroys an existing ne_ctxt
+ * NOTE -- all handles of the context must be closed first ( this will fail with errno == EBUSY, otherwise )
  * @param ne_ctxt ctxt : Reference to the ne_ctxt to be destroyed
  * @return int : Zero on a success, and -1 on a failure
  */
 int ne_term(ne_ctxt ctxt) {
+   // Terminate our block threads ( fails if any handles remain open )
+   if ( ctxt->tpool ) {
+      if ( tq_pool_term( ctxt->tpool ) ) {
+         LOG( LOG_ERR, "failed to terminate block thread pool\n" );
+         return -1;
+      }
+      ctxt->tpool = NULL;
+   }
    // Cleanup the DAL context
    if (ctxt->dal->cleanup(ctxt->dal) != 0) {
       LOG(LOG_ERR, "failed to cleanup DAL context!\n");
       return -1;
    }
+   // cleanup our erasure table cache
+   while ( ctxt->tables ) {
+      ne_tables tables = ctxt->tables;
+      if ( tables->refcnt ) {
+         LOG( LOG_WARNING, "freeing erasure tables with %u remaining references\n", tables->refcnt );
+      }
+      ctxt->tables = tables->next;
+      free_tables( tables );
+   }
+   pthread_mutex_destroy( &(ctxt->tablelock) );
+   // cleanup our buffer pool
+   if ( destroy_ioblock_pool( ctxt->iopool ) ) {
+      LOG( LOG_WARNING, "ioblock buffers remained in use at ne_ctxt termination\n" );
+   }
+   free_numa_placement( ctxt );
    // potentially cleanup our local lock
    if ( ctxt->erasurelock == &(ctxt->locallock) ) {
       pthread_mutex_destroy( ctxt->erasurelock );
@@ -1067,6 +2013,57 @@ int ne_term(ne_ctxt ctxt) {
    return 0;
 }
 
+/**
+ * Retrieve erasure table cache statistics for the given ne_ctxt
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to retrieve stats from
+ * @param ne_table_stats* stats : Reference to the ne_table_stats struct to be populated
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_get_table_stats(ne_ctxt ctxt, ne_table_stats* stats) {
+   if ( ctxt == NULL  ||  stats == NULL ) {
+      LOG( LOG_ERR, "received a NULL ne_ctxt or ne_table_stats reference\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   if ( pthread_mutex_lock( &(ctxt->tablelock) ) ) {
+      LOG( LOG_ERR, "failed to acquire ne_ctxt tablelock\n" );
+      return -1;
+   }
+   *stats = ctxt->tablestats;
+   pthread_mutex_unlock( &(ctxt->tablelock) );
+   return 0;
+}
+
+/**
+ * Retrieve ioblock buffer pool statistics for the given ne_ctxt
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to retrieve stats from
+ * @param ne_pool_stats* stats : Reference to the ne_pool_stats struct to be populated
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_get_pool_stats(ne_ctxt ctxt, ne_pool_stats* stats) {
+   if ( ctxt == NULL  ||  stats == NULL ) {
+      LOG( LOG_ERR, "received a NULL ne_ctxt or ne_pool_stats reference\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   memset( stats, 0, sizeof( ne_pool_stats ) );
+   // NOTE -- with NUMA placement, stats are totaled across the pools of every node
+   int i;
+   for ( i = -1; i < ctxt->numacnt; i++ ) {
+      ioblock_pool_stats pstats;
+      if ( ioblock_pool_getstats( ( i < 0 ) ? ctxt->iopool : ctxt->numapools[i], &pstats ) ) {
+         LOG( LOG_ERR, "failed to retrieve ioblock pool stats\n" );
+         return -1;
+      }
+      stats->hits += pstats.hits;
+      stats->misses += pstats.misses;
+      stats->allocsz += pstats.allocsz;
+      stats->idlesz += pstats.idlesz;
+      stats->peaksz += pstats.peaksz;
+   }
+   return 0;
+}
+
 // ---------------------- PER-OBJECT FUNCTIONS ----------------------
 
 /**
@@ -1282,6 +2279,34 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       return NULL;
    }
 
+   // strip off any NE_LAZYVERIFY modifier, which only applies to read handles
+   char lazyverify = (mode & NE_LAZYVERIFY) ? 1 : 0;
+   mode &= ~(NE_LAZYVERIFY);
+   if (lazyverify && mode != NE_RDONLY && mode != NE_RDALL) {
+      LOG(LOG_ERR, "NE_LAZYVERIFY is only applicable to NE_RDONLY or NE_RDALL handles!\n");
+      errno = EINVAL;
+      return NULL;
+   }
+   // likewise, strip off any NE_RANDOM modifier ( every IO of a random handle is verified inline )
+   char randomread = (mode & NE_RANDOM) ? 1 : 0;
+   mode &= ~(NE_RANDOM);
+   if (randomread && (mode != NE_RDONLY || lazyverify)) {
+      LOG(LOG_ERR, "NE_RANDOM is only applicable to NE_RDONLY handles, without NE_LAZYVERIFY!\n");
+      errno = EINVAL;
+      return NULL;
+   }
+   if (randomread) {
+      handle->rblocks = calloc(handle->epat.N + handle->epat.E, sizeof(ne_rblock));
+      if (handle->rblocks == NULL) {
+         LOG(LOG_ERR, "Failed to allocate space for random access block references!\n");
+         return NULL;
+      }
+      int i;
+      for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
+         handle->rblocks[i].ioidx = -1;
+      }
+   }
+
    // we need to startup some threads
    TQ_Init_Opts tqopts = {0};
    char* lprefstr = malloc(sizeof(char) * (6 + (handle->ctxt->max_block / 10)));
@@ -1299,7 +2324,9 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       preffmt = "WQ%d";
    }
    tqopts.init_flags = TQ_HALT; // initialize the threads in a HALTED state (essential for reads, doesn't hurt writes)
-   tqopts.max_qdepth = QDEPTH;
+   tqopts.max_qdepth = handle->ctxt->qdepth + 1;
+   tqopts.lockfree = 1; // the master proc passes every ioblock through these queues, so avoid contention on the queue lock
+   tqopts.pool = handle->ctxt->tpool; // borrow persistent threads, rather than creating our own
    tqopts.num_threads = 1;
    tqopts.num_prod_threads = (mode == NE_WRONLY || mode == NE_WRALL) ? 0 : 1;
    DAL_MODE dmode = DAL_READ;
@@ -1324,6 +2351,11 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
    int i;
    for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
       handle->thread_states[i].dmode = dmode;
+      handle->thread_states[i].numa = handle_numa(handle);
+      handle->thread_states[i].iopool = handle_pool(handle);
+      handle->thread_states[i].lazyverify = lazyverify;
+      // the block threads of a random handle pass off their DAL handles, for reuse by random_fetch()
+      handle->thread_states[i].handoff = (handle->rblocks) ? &(handle->rblocks[i].bctxt) : NULL;
       tqopts.global_state = &(handle->thread_states[i]);
       // set a log_prefix value for this queue
       snprintf(lprefstr, 6 + (handle->ctxt->max_block/10), preffmt, i);
@@ -1430,6 +2462,7 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       handle->versz = consensus.versz;
       handle->blocksz = consensus.blocksz;
       handle->totsz = consensus.totsz;
+      handle->crctype = consensus.crctype;
 
       // confirm and correct meta info values
       for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
@@ -1446,6 +2479,20 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       }
    }
 
+   // the threads of a random handle only retrieve meta info, so shut them down now
+   // NOTE -- each passes its DAL handle to our random access block references at term
+   if (handle->rblocks) {
+      for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
+         tq_set_flags(handle->thread_queues[i], TQ_ABORT);
+         tq_next_thread_status(handle->thread_queues[i], NULL);
+         tq_close(handle->thread_queues[i]);
+         handle->thread_queues[i] = NULL;
+      }
+      handle->ethreads_running = 0;
+      handle->mode = mode;
+      return handle;
+   }
+
    // start with zero erasure threads running only for NE_RDONLY
    handle->ethreads_running = 0;
    if (mode != NE_RDONLY) {
@@ -1461,7 +2508,7 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       } // if we already have a versz, use that instead
 
       // initialize ioqueues
-      handle->thread_states[i].ioq = create_ioqueue(iosz, handle->epat.partsz, dmode);
+      handle->thread_states[i].ioq = create_ioqueue(iosz, handle->epat.partsz, dmode, handle->ctxt->qdepth, handle_pool(handle));
       if (handle->thread_states[i].ioq == NULL) {
          LOG(LOG_ERR, "Failed to create ioqueue for thread %d!\n", i);
          break;
@@ -1502,6 +2549,8 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
  * @param ne_location loc : Location of the object to be rebuilt
  * @param ne_erasure epat : Erasure pattern of the object to be rebuilt
  * @param ne_mode mode : Handle mode (NE_RDONLY || NE_RDALL || NE_WRONLY || NE_WRALL || NE_REBUILD)
+ *                       NOTE -- NE_RDONLY and NE_RDALL may be combined with NE_LAZYVERIFY
+ *                               NE_RDONLY may alternatively be combined with NE_RANDOM
  * @return ne_handle : Newly created ne_handle, or NULL if an error occured
  */
 ne_handle ne_open(ne_ctxt ctxt, const char* objID, ne_location loc, ne_erasure epat, ne_mode mode) {
@@ -1513,7 +2562,8 @@ ne_handle ne_open(ne_ctxt ctxt, const char* objID, ne_location loc, ne_erasure e
    }
 
    // verify that our mode argument makes sense
-   if (mode != NE_RDONLY && mode != NE_RDALL && mode != NE_WRONLY && mode != NE_WRALL && mode != NE_REBUILD) {
+   ne_mode basemode = (mode & ~(NE_LAZYVERIFY | NE_RANDOM));
+   if (basemode != NE_RDONLY && basemode != NE_RDALL && basemode != NE_WRONLY && basemode != NE_WRALL && basemode != NE_REBUILD) {
       LOG(LOG_ERR, "Recieved an inappropriate mode argument!\n");
       errno = EINVAL;
       return NULL;
@@ -1525,10 +2575,11 @@ ne_handle ne_open(ne_ctxt ctxt, const char* objID, ne_location loc, ne_erasure e
    minfo.E = epat.E;
    minfo.O = epat.O;
    minfo.partsz = epat.partsz;
-   minfo.versz = (mode == NE_WRONLY || mode == NE_WRALL) ? ctxt->dal->io_size : 0;
+   minfo.versz = (basemode == NE_WRONLY || basemode == NE_WRALL) ? ctxt->dal->io_size : 0;
    minfo.blocksz = 0;
    minfo.crcsum = 0;
    minfo.totsz = 0;
+   minfo.crctype = ctxt->crctype;
 
    // allocate our handle structure
    ne_handle handle = allocate_handle(ctxt, objID, loc, &minfo);
@@ -1591,6 +2642,8 @@ int ne_close(ne_handle handle, ne_erasure* epat, ne_state* sref) {
          handle->totsz -= (stripesz - partstripe);
          free(zerobuff);
       }
+      // generate erasure for any remaining stripes, prior to pushing our final ioblocks
+      encode_pending(handle);
    }
 
    int ret_val = 0;
@@ -1636,7 +2689,8 @@ int ne_close(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    //         }
    //      }
 
-   if (handle->mode != NE_STAT) {
+   // NOTE -- random handles shut down their threads as soon as meta info is retrieved
+   if (handle->mode != NE_STAT && handle->rblocks == NULL) {
       // set a FINISHED state for all threads
       for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
          LOG(LOG_INFO, "Terminating thread %d\n", i);
@@ -1727,7 +2781,7 @@ int ne_abort(ne_handle handle) {
       return -1;
    }
 
-   if (handle->mode != NE_STAT) {
+   if (handle->mode != NE_STAT && handle->rblocks == NULL) {
       int i;
       for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
          tq_set_flags(handle->thread_queues[i], TQ_ABORT);
@@ -1937,6 +2991,7 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    int i;
    for (i = 0; i < N + E; i++) {
       outstates[i].erasurelock = handle->ctxt->erasurelock;
+      outstates[i].qdepth = handle->ctxt->qdepth;
       // object attributes
       outstates[i].objID = handle->objID;
       outstates[i].location.pod = handle->loc.pod;
@@ -1954,6 +3009,7 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
       outstates[i].minfo.blocksz = handle->blocksz;
       outstates[i].minfo.crcsum = 0;
       outstates[i].minfo.totsz = 0;
+      outstates[i].minfo.crctype = handle->crctype;
       outstates[i].meta_error = 0;
       outstates[i].data_error = 0;
    }
@@ -1967,7 +3023,9 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    tqopts.log_prefix = lprefstr;
    // create a format string for each thread queue
    tqopts.init_flags = TQ_HALT; // initialize the threads in a HALTED state (essential for reads, doesn't hurt writes)
-   tqopts.max_qdepth = QDEPTH;
+   tqopts.max_qdepth = handle->ctxt->qdepth + 1;
+   tqopts.lockfree = 1; // the master proc passes every ioblock through these queues, so avoid contention on the queue lock
+   tqopts.pool = handle->ctxt->tpool; // borrow persistent threads, rather than creating our own
    tqopts.num_threads = 1;
    tqopts.num_prod_threads = 0;
    tqopts.thread_init_func = write_init;
@@ -1979,6 +3037,8 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    // finally, startup the output threads for each in-error block
    for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
       outstates[i].dmode = DAL_REBUILD;
+      outstates[i].numa = handle_numa(handle);
+      outstates[i].iopool = handle_pool(handle);
       tqopts.global_state = &(outstates[i]);
       // only initialize threads for blocks with errors
       if (handle->thread_states[i].data_error || handle->thread_states[i].meta_error) {
@@ -2032,7 +3092,7 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
       if (OutTQs[i] != NULL) {
          LOG(LOG_INFO, "Prepping block %d for output\n", i);
          // initialize ioqueues
-         outstates[i].ioq = create_ioqueue(handle->versz, handle->epat.partsz, DAL_REBUILD);
+         outstates[i].ioq = create_ioqueue(handle->versz, handle->epat.partsz, DAL_REBUILD, handle->ctxt->qdepth, handle_pool(handle));
          if (outstates[i].ioq == NULL) {
             LOG(LOG_ERR, "Failed to create ioqueue for thread %d!\n", i);
             break;
@@ -2292,6 +3352,214 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    return newerrs;
 }
 
+// shared state of a batch rebuild
+typedef struct rebuild_batch_struct {
+   ne_ctxt ctxt;
+   pthread_mutex_t lock;     // protects all following values
+   pthread_cond_t  memavail; // signaled as running rebuilds release their memory
+   size_t memlimit;          // limit on the estimated memory of all running rebuilds ( zero == no limit )
+   size_t memused;           // estimated memory of all running rebuilds
+} rebuild_batch;
+
+/**
+ * Estimate the buffer memory required to rebuild an object
+ * NOTE -- this assumes every block reads through a full ioqueue, and that up to E blocks are rewritten
+ * @param ne_ctxt ctxt : Context of the rebuild
+ * @param ne_erasure* epat : Erasure pattern of the object
+ * @return size_t : Estimated byte count
+ */
+static size_t rebuild_footprint(ne_ctxt ctxt, ne_erasure* epat) {
+   size_t blocksz = ctxt->dal->io_size + epat->partsz;
+   return (size_t)(epat->N + (2 * epat->E)) * ctxt->qdepth * blocksz;
+}
+
+/**
+ * Rebuild a single target of a batch, via a standard NE_REBUILD handle
+ * @param ne_ctxt ctxt : Context of the rebuild
+ * @param ne_rebuild_target* target : Target to be rebuilt ( populated with the result )
+ */
+static void rebuild_target(ne_ctxt ctxt, ne_rebuild_target* target) {
+   target->result = -1;
+   target->errval = 0;
+   ne_handle handle = ne_open(ctxt, target->objID, target->loc, target->epat, NE_REBUILD);
+   if (handle == NULL) {
+      target->errval = (errno) ? errno : ENOTRECOVERABLE;
+      LOG(LOG_ERR, "Failed to open rebuild handle for object \"%s\"\n", target->objID);
+      return;
+   }
+   if (target->seed  &&  ne_seed_status(handle, target->seed)) {
+      LOG(LOG_WARNING, "Failed to seed status into rebuild handle for object \"%s\"\n", target->objID);
+   }
+   // rebuild the object, performing up to NE_REBUILD_ATTEMPTS attempts
+   int rebuildres = -1;
+   int attempt;
+   for (attempt = 0; attempt < NE_REBUILD_ATTEMPTS; attempt++) {
+      rebuildres = ne_rebuild(handle, NULL, NULL);
+      if (rebuildres <= 0) { break; }
+      LOG(LOG_WARNING, "Object \"%s\" still contains %d errors after attempt %d\n", target->objID, rebuildres, attempt + 1);
+   }
+   if (rebuildres) {
+      target->result = rebuildres;
+      target->errval = (errno) ? errno : ENOTRECOVERABLE;
+      LOG(LOG_ERR, "Failed to rebuild object \"%s\"\n", target->objID);
+      if (ne_abort(handle)) {
+         LOG(LOG_ERR, "Failed to abort rebuild handle for object \"%s\"\n", target->objID);
+      }
+      return;
+   }
+   int closeres = ne_close(handle, NULL, NULL);
+   if (closeres) {
+      target->result = (closeres > 0) ? closeres : -1;
+      target->errval = (errno) ? errno : ENOTRECOVERABLE;
+      LOG(LOG_ERR, "Failed to close rebuild handle for object \"%s\"\n", target->objID);
+      return;
+   }
+   target->result = 0;
+}
+
+// rebuild batch thread initialization, simply providing each thread with the shared batch state
+static int rebuild_batch_init(unsigned int tID, void* global_state, void** state) {
+   *state = global_state;
+   return 0;
+}
+
+// rebuild batch thread behavior, admitting each target only once it fits within the memory limit
+static int rebuild_batch_consume(void** state, void** work_todo) {
+   rebuild_batch* batch = (rebuild_batch*)(*state);
+   ne_rebuild_target* target = (ne_rebuild_target*)(*work_todo);
+   size_t footprint = rebuild_footprint(batch->ctxt, &(target->epat));
+   pthread_mutex_lock(&(batch->lock));
+   // NOTE -- an oversized target is still admitted, once nothing else is running
+   while (batch->memlimit  &&  batch->memused  &&  (batch->memused + footprint) > batch->memlimit) {
+      pthread_cond_wait(&(batch->memavail), &(batch->lock));
+   }
+   batch->memused += footprint;
+   pthread_mutex_unlock(&(batch->lock));
+
+   LOG(LOG_INFO, "Rebuilding object \"%s\" ( est. %zu bytes )\n", target->objID, footprint);
+   rebuild_target(batch->ctxt, target);
+
+   pthread_mutex_lock(&(batch->lock));
+   batch->memused -= footprint;
+   pthread_cond_broadcast(&(batch->memavail));
+   pthread_mutex_unlock(&(batch->lock));
+   *work_todo = NULL;
+   return 0;
+}
+
+// rebuild batch thread termination ( nothing to cleanup, as the batch state is shared )
+static void rebuild_batch_term(void** state, void** prev_work, TQ_Control_Flags flg) {
+   return;
+}
+
+/**
+ * Verify and reconstruct a batch of erasure striped objects, rebuilding several in parallel
+ * NOTE -- Each target is rebuilt exactly as via ne_open( NE_REBUILD ) / ne_rebuild() / ne_close().
+ *         Targets are dispatched in list order, but each only begins once its estimated buffer memory, combined with
+ *         that of all running rebuilds, fits within 'memlimit'.
+ * @param ne_ctxt ctxt : The ne_ctxt used to access all targets
+ * @param ne_rebuild_target* targets : List of objects to be rebuilt ( each populated with a result )
+ * @param size_t count : Length of the target list
+ * @param int threads : Maximum number of objects to rebuild at once
+ * @param size_t memlimit : Limit on the estimated buffer memory of all objects being rebuilt at once
+ *                          ( zero == no limit, beyond the thread count )
+ * @return int : Count of targets which were not completely rebuilt ( see the 'result' of each ),
+ *               or -1 if the batch could not be processed
+ */
+int ne_rebuild_batch(ne_ctxt ctxt, ne_rebuild_target* targets, size_t count, int threads, size_t memlimit) {
+   if (ctxt == NULL  ||  (targets == NULL  &&  count)) {
+      LOG(LOG_ERR, "Received a NULL ne_ctxt or target list\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (threads < 1) {
+      LOG(LOG_ERR, "Received an invalid thread count: %d\n", threads);
+      errno = EINVAL;
+      return -1;
+   }
+   if (count == 0) { return 0; }
+   if (threads > count) { threads = (int)count; }
+
+   rebuild_batch batch = { .ctxt = ctxt, .memlimit = memlimit, .memused = 0 };
+   if (pthread_mutex_init(&(batch.lock), NULL)) {
+      LOG(LOG_ERR, "Failed to initialize rebuild batch lock\n");
+      return -1;
+   }
+   if (pthread_cond_init(&(batch.memavail), NULL)) {
+      LOG(LOG_ERR, "Failed to initialize rebuild batch condition\n");
+      pthread_mutex_destroy(&(batch.lock));
+      return -1;
+   }
+
+   TQ_Init_Opts tqopts = {0};
+   tqopts.log_prefix = "RebuildBatch";
+   tqopts.init_flags = TQ_NONE;
+   tqopts.max_qdepth = (unsigned int)threads * 2;
+   tqopts.pool = ctxt->tpool;
+   tqopts.global_state = &(batch);
+   tqopts.num_threads = (unsigned int)threads;
+   tqopts.num_prod_threads = 0;
+   tqopts.thread_init_func = rebuild_batch_init;
+   tqopts.thread_consumer_func = rebuild_batch_consume;
+   tqopts.thread_term_func = rebuild_batch_term;
+   ThreadQueue tq = tq_init(&tqopts);
+   if (tq == NULL) {
+      LOG(LOG_ERR, "Failed to initialize rebuild batch thread queue\n");
+      pthread_cond_destroy(&(batch.memavail));
+      pthread_mutex_destroy(&(batch.lock));
+      return -1;
+   }
+   if (tq_check_init(tq)) {
+      LOG(LOG_ERR, "Detected init failure of rebuild batch threads\n");
+      tq_set_flags(tq, TQ_ABORT);
+      while (tq_next_thread_status(tq, NULL) > 0) {}
+      tq_close(tq);
+      pthread_cond_destroy(&(batch.memavail));
+      pthread_mutex_destroy(&(batch.lock));
+      return -1;
+   }
+
+   // feed all targets to our threads
+   int retval = 0;
+   size_t t;
+   for (t = 0; t < count; t++) {
+      targets[t].result = -1;
+      targets[t].errval = ECANCELED;
+   }
+   for (t = 0; t < count; t++) {
+      if (tq_enqueue(tq, TQ_NONE, (void*)(targets + t))) {
+         LOG(LOG_ERR, "Failed to enqueue rebuild target %zu\n", t);
+         retval = -1;
+         break;
+      }
+   }
+   if (retval == 0  &&  tq_set_flags(tq, TQ_FINISHED)) {
+      LOG(LOG_ERR, "Failed to set a FINISHED state on the rebuild batch thread queue\n");
+      retval = -1;
+   }
+   if (retval == 0  &&  tq_wait_for_completion(tq)) {
+      LOG(LOG_ERR, "Failed to wait for rebuild batch completion\n");
+      retval = -1;
+   }
+   if (retval) {
+      tq_set_flags(tq, TQ_ABORT);
+   }
+   while (tq_next_thread_status(tq, NULL) > 0) {}
+   while (tq_dequeue(tq, TQ_ABORT, NULL) > 0) {} // discard any unprocessed targets
+   tq_close(tq);
+   pthread_cond_destroy(&(batch.memavail));
+   pthread_mutex_destroy(&(batch.lock));
+   if (retval) { return -1; }
+
+   // count up any incomplete targets
+   int incomplete = 0;
+   for (t = 0; t < count; t++) {
+      if (targets[t].result) { incomplete++; }
+   }
+   LOG(LOG_INFO, "Rebuild batch completed with %d of %zu targets incomplete\n", incomplete, count);
+   return incomplete;
+}
+
 /**
  * Seek to a new offset on a read ne_handle
  * @param ne_handle handle : Handle on which to seek (must be open for read)
@@ -2317,6 +3585,12 @@ off_t ne_seek(ne_handle handle, off_t offset) {
       LOG(LOG_WARNING, "Seek offset extends beyond EOF, resizing read request to %zu\n", offset);
    }
 
+   // random handles have no ioblocks to realign
+   if (handle->rblocks) {
+      handle->sub_offset = offset;
+      return offset;
+   }
+
    int N = handle->epat.N;
    ssize_t partsz = handle->epat.partsz;
    size_t stripesz = partsz * N;
@@ -2516,6 +3790,11 @@ ssize_t ne_read(ne_handle handle, void* buffer, size_t bytes) {
 
    LOG(LOG_INFO, "Stripe: ( N = %d, E = %d, partsz = %zu )\n", N, handle->epat.E, partsz);
 
+   // random handles bypass our block threads entirely
+   if (handle->rblocks) {
+      return random_read(handle, buffer, bytes);
+   }
+
    // ---------------------- BEGIN MAIN READ LOOP ----------------------
 
    // time to start actually filling this read request
@@ -2551,21 +3830,32 @@ ssize_t ne_read(ne_handle handle, void* buffer, size_t bytes) {
             errno = EBADF;
             return -1;
          }
-         // make sure the ioblock has no errors in this stripe
-         if (cur_iob->error_end > (cur_stripe * partsz)) {
-            LOG(LOG_ERR, "Ioblock at position %d of stripe %d has an error beyond requested stripe (error_end = %zu)!\n",
-               cur_block, cur_stripe + iob_stripe, cur_iob->error_end);
-            errno = ENODATA;
-            return -1;
-         }
-         // otherwise, copy this data off to our caller's buffer
          off_t block_off = (off_in_stripe % partsz);
          size_t block_read = (to_read_in_stripe > (partsz - block_off)) ? (partsz - block_off) : to_read_in_stripe;
          if (block_read == 0) {
             break;
          } // if we've completed our reads, stop here
-         // check for NULL target buffer
-         if (buffer) {
+         // make sure the ioblock has no errors in this stripe
+         if (cur_iob->error_end > (cur_stripe * partsz)) {
+            // NE_RDONLY handles regenerate only the erased data we actually return
+            if (handle->mode != NE_RDONLY) {
+               LOG(LOG_ERR, "Ioblock at position %d of stripe %d has an error beyond requested stripe (error_end = %zu)!\n",
+                  cur_block, cur_stripe + iob_stripe, cur_iob->error_end);
+               errno = ENODATA;
+               return -1;
+            }
+            if (buffer) {
+               if (regenerate_range(handle, cur_stripe, cur_block, block_off, block_read, (unsigned char*)buffer + bytes_read)) {
+                  LOG(LOG_ERR, "Failed to regenerate %zu bytes of block %d of stripe %d!\n", block_read, cur_block, cur_stripe + iob_stripe);
+                  return -1;
+               }
+            }
+            else {
+               LOG(LOG_INFO, "   Dropping %zu bytes from erased block %d\n", block_read, cur_block);
+            }
+         }
+         // otherwise, copy this data off to our caller's buffer
+         else if (buffer) {
             LOG(LOG_INFO, "   Reading %zu bytes from block %d\n", block_read, cur_block);
             memcpy(buffer + bytes_read, cur_iob->buff + (cur_stripe * partsz) + block_off, block_read);
          }
@@ -2624,32 +3914,17 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
 
    // initialize erasure structs (these never change for writes, so we can just check here)
    if (handle->e_ready == 0) {
-      LOG(LOG_INFO, "Initializing erasure matricies...\n");
-      // critical section : we are now going to call some inlined assembly erasure funcs
-      if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-         LOG( LOG_ERR, "Failed to acquire erasurelock prior to encoding prep of stripe %d\n", stripenum );
-         return -1;
+      LOG(LOG_INFO, "Retrieving encode tables...\n");
+      if (handle->tables) {
+         release_tables(handle->ctxt, handle->tables);
       }
-      // Generate an encoding matrix
-      // NOTE: The matrix generated by gf_gen_rs_matrix is not always invertable for N>=6 and E>=5!
-      gf_gen_cauchy1_matrix(handle->encode_matrix, N + E, N);
-      // Generate g_tbls from encode matrix
-      ec_init_tables(N, E, &(handle->encode_matrix[N * N]), handle->g_tbls);
-      // exiting critical section
-      if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-         LOG( LOG_ERR, "Failed to relinquish erasurelock after encoding prep of stripe %d\n", stripenum );
+      if ((handle->tables = acquire_tables(handle->ctxt, N, E, NULL, 0)) == NULL) {
+         LOG( LOG_ERR, "Failed to retrieve encode tables prior to encoding of stripe %d\n", stripenum );
          return -1;
       }
       handle->e_ready = 1;
    }
 
-   // allocate space for our buffer references
-   void** tgt_refs = calloc(N + E, sizeof(char*));
-   if (tgt_refs == NULL) {
-      LOG(LOG_ERR, "Failed to allocate space for a target buffer array!\n");
-      return -1;
-   }
-
    int outblock = (offset % stripesz) / partsz;  //determine what block we're filling
    size_t to_write = partsz - (offset % partsz); //determine if we need to finish writing a data part
 
@@ -2697,25 +3972,13 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
 
          // check if we have completed a stripe
          if (outblock == (N + E)) {
-            LOG(LOG_INFO, "Generating erasure parts for stripe %u\n", stripenum);
-            // build an array of data/erasure references while reseting outblock to zero
-            for (outblock -= 1; outblock >= 0; outblock--) {
-               // previously written data will be one partsz behind
-               tgt_refs[outblock] = ioblock_write_target(handle->iob[outblock]) - partsz;
-            }
-            // critical section : we are now going to call some inlined assembly erasure funcs
-            if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to acquire erasurelock prior to encoding of stripe %d\n", stripenum );
-               free( tgt_refs );
-               return -1;
-            }
-            // generate erasure parts
-            ec_encode_data(partsz, N, E, handle->g_tbls, (unsigned char**)tgt_refs, (unsigned char**)&(tgt_refs[N]));
-            // exiting critical section
-            if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to relinquish erasurelock after encoding of stripe %d\n", stripenum );
-               free( tgt_refs );
-               return -1;
+            // defer erasure generation until our ioblocks are full, then encode all stripes at once
+            // NOTE -- all ioblocks share the same fill level at a stripe boundary, so checking the first
+            //         is sufficient to ensure no block will be pushed or split with unencoded stripes
+            handle->enc_pending++;
+            LOG(LOG_INFO, "Completed stripe %u ( %u stripes pending erasure )\n", stripenum, handle->enc_pending);
+            if (ioblock_remaining(handle->iob[0], handle->thread_states[0].ioq) == 0) {
+               encode_pending(handle);
             }
             // reset outblock
             outblock = 0;
@@ -2727,7 +3990,6 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
          if (tq_enqueue(handle->thread_queues[outblock], TQ_NONE, (void*)push_block)) {
             LOG(LOG_ERR, "Failed to push ioblock to thread_queue %d\n", outblock);
             errno = EBADF;
-            free(tgt_refs);
             return -1;
          }
          //NOOOOOOOOO!!!!! outblock++;
@@ -2735,7 +3997,6 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
       else {
          LOG(LOG_ERR, "Failed to reserve ioblock for position %d!\n", outblock);
          errno = EBADF;
-         free(tgt_refs);
          return -1;
       }
 
@@ -2746,7 +4007,6 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
    }
 
    // we have output all data
-   free(tgt_refs);
    return written;
 }
 
@@ -63,11 +63,17 @@ typedef enum
 {
  NE_ERR = 0,           // RESERVED FOR INTERNAL USE
  NE_STAT,              // RESERVED FOR INTERNAL USE
- NE_RDONLY,            //2  -- read data, only read erasure when necessary for reconstruction
+ NE_RDONLY,            //2  -- read data, only read erasure when necessary for reconstruction of requested data
  NE_RDALL,             //3  -- read data and all erasure, regardless of data state
  NE_WRONLY,            //4  -- write data and erasure to new stripe
  NE_WRALL = NE_WRONLY, //   -- same as above, defined just to avoid confusion
- NE_REBUILD            //5  -- rebuild an existing object
+ NE_REBUILD,           //5  -- rebuild an existing object
+ NE_LAZYVERIFY = 0x10, //   -- modifier for NE_RDONLY / NE_RDALL ( i.e. NE_RDONLY | NE_LAZYVERIFY ), verifying
+                       //      the CRC of only one of every VERIFY_SAMPLE IOs of each block ( trading detection
+                       //      of corruption in the remainder for reduced CPU load )
+ NE_RANDOM = 0x20      //   -- modifier for NE_RDONLY ( i.e. NE_RDONLY | NE_RANDOM ), reading each touched IO of
+                       //      each block directly via the DAL, rather than through sequential read-ahead
+                       //      ( ne_seek() becomes free, and small random reads cost ~one DAL get per part )
 } ne_mode;
 
 typedef struct ne_erasure_struct
@@ -101,6 +107,36 @@ typedef struct ne_location_struct
  int scatter;
 } ne_location;
 
+// batch rebuild target
+typedef struct ne_rebuild_target_struct
+{
+ const char *objID; // ID of the object to be rebuilt
+ ne_location loc;   // location of the object to be rebuilt
+ ne_erasure epat;   // erasure pattern of the object to be rebuilt
+ ne_state *seed;    // error pattern to seed into the rebuild handle ( see ne_seed_status(), ignored if NULL )
+ int result;        // populated with zero if all errors were repaired, a positive count of remaining errors,
+                    //  or -1 if the rebuild failed outright
+ int errval;        // populated with an errno value describing any failure
+} ne_rebuild_target;
+
+// erasure table cache statistics
+typedef struct ne_table_stats_struct
+{
+ size_t hits;    // table retrievals satisfied by an existing cache entry
+ size_t misses;  // table retrievals requiring generation of new tables
+ size_t entries; // current count of cached tables ( both referenced and idle )
+} ne_table_stats;
+
+// IO buffer pool statistics
+typedef struct ne_pool_stats_struct
+{
+ size_t hits;    // buffer retrievals satisfied by an idle pool buffer
+ size_t misses;  // buffer retrievals requiring a new allocation
+ size_t allocsz; // current total size of allocated buffers ( both in use and idle )
+ size_t idlesz;  // current total size of idle buffers
+ size_t peaksz;  // peak value of 'allocsz' ( summed across nodes, with NUMA placement )
+} ne_pool_stats;
+
 /*
  ---  Initialization/Termination functions, to produce and destroy a ne_ctxt  ---
 */
@@ -111,11 +147,27 @@ typedef struct ne_ctxt_struct *ne_ctxt; // forward decl.
 /**
  * Initializes a new ne_ctxt
  * @param xmlNode* dal_root : Root of a libxml2 DAL node describing data access
+ *                            An optional 'checksum' attribute of this node ( "ieee" or "crc32c" )
+ *                            selects the CRC type for newly written objects ( default = "ieee" )
+ *                            An optional 'qdepth' attribute sets the number of IO buffers used by
+ *                            each block thread ( 4 - 64, default = 4 )
+ *                            An optional 'bufpool' attribute limits the total bytes of idle IO buffers
+ *                            retained for reuse by later handles ( default = the IO buffers of two handles of
+ *                            max_block width; "0" disables reuse )
+ *                            An optional 'numa' attribute ( "off", "all", or a list of nodes, such as "0,1" )
+ *                            places each handle on a single NUMA node, round-robin across the listed nodes,
+ *                            binding its block threads to local CPUs and allocating its IO buffers from local
+ *                            memory ( default = "off" )
+ *                            An optional 'threadpool' attribute ( "yes" or "no" ) selects whether block
+ *                            threads persist in a pool shared by all handles of the context, rather than
+ *                            being created and joined by each handle ( default = "yes" )
  * @param ne_location max_loc : ne_location struct containing maximum allowable pod/cap/scatter
  *                              values for this context
  * @param int max_block : Integer maximum block value ( N + E ) for this context
  * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
+ *                                       to isa-l erasure table generation functions in multi-threaded programs.
+ *                                       Erasure encoding / decoding and CRC generation only consume
+ *                                       previously generated tables, and never acquire this lock.
  *                                       If NULL, libne will create such a lock internally.  In such a case,
  *                                       the internal lock will continue to protect multi-threaded programs
  *                                       ONLY if they exclusively use a single ne_ctxt at a time.
@@ -132,7 +184,9 @@ ne_ctxt ne_init(xmlNode *dal_root, ne_location max_loc, int max_block, pthread_m
  * @param const char* path : The complete path template for the erasure stripe
  * @param ne_location max_loc : The maximum pod/cap/scatter values for this context
  * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
+ *                                       to isa-l erasure table generation functions in multi-threaded programs.
+ *                                       Erasure encoding / decoding and CRC generation only consume
+ *                                       previously generated tables, and never acquire this lock.
  *                                       If NULL, libne will create such a lock internally.  In such a case,
  *                                       the internal lock will continue to protect multi-threaded programs
  *                                       ONLY if they exclusively use a single ne_ctxt at a time.
@@ -153,11 +207,30 @@ int ne_verify(ne_ctxt ctxt, char fix);
 
 /**
  * Destroys an existing ne_ctxt
+ * NOTE -- all handles of the context must be closed first ( this will fail with errno == EBUSY, otherwise )
  * @param ne_ctxt ctxt : Reference to the ne_ctxt to be destroyed
  * @return int : Zero on a success, and -1 on a failure
  */
 int ne_term(ne_ctxt ctxt);
 
+/**
+ * Retrieve erasure table cache statistics for the given ne_ctxt
+ * NOTE -- all handles of a ne_ctxt share encode/decode tables for matching N/E values and error patterns
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to retrieve stats from
+ * @param ne_table_stats* stats : Reference to the ne_table_stats struct to be populated
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_get_table_stats(ne_ctxt ctxt, ne_table_stats* stats);
+
+/**
+ * Retrieve IO buffer pool statistics for the given ne_ctxt
+ * NOTE -- all handles of a ne_ctxt draw IO buffers from a shared pool, returning them on close
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to retrieve stats from
+ * @param ne_pool_stats* stats : Reference to the ne_pool_stats struct to be populated
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_get_pool_stats(ne_ctxt ctxt, ne_pool_stats* stats);
+
 /*
  ---  Per-Object functions, no handle required  ---
 */
@@ -202,6 +275,8 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode);
  * @param ne_location loc : Location of the object to be rebuilt
  * @param ne_erasure epat : Erasure pattern of the object to be rebuilt
  * @param ne_mode mode : Handle mode (NE_RDONLY || NE_RDALL || NE_WRONLY || NE_WRALL || NE_REBUILD)
+ *                       NOTE -- NE_RDONLY and NE_RDALL may be combined with NE_LAZYVERIFY
+ *                               NE_RDONLY may alternatively be combined with NE_RANDOM
  * @return ne_handle : Newly created ne_handle, or NULL if an error occured
  */
 ne_handle ne_open(ne_ctxt ctxt, const char *objID, ne_location loc, ne_erasure epat, ne_mode mode);
@@ -260,6 +335,22 @@ int ne_seed_status(ne_handle handle, ne_state *sref);
  */
 int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref);
 
+/**
+ * Verify and reconstruct a batch of erasure striped objects, rebuilding several in parallel
+ * NOTE -- Each target is rebuilt exactly as via ne_open( NE_REBUILD ) / ne_rebuild() / ne_close().
+ *         Targets are dispatched in list order, but each only begins once its estimated buffer memory, combined with
+ *         that of all running rebuilds, fits within 'memlimit'.
+ * @param ne_ctxt ctxt : The ne_ctxt used to access all targets
+ * @param ne_rebuild_target* targets : List of objects to be rebuilt ( each populated with a result )
+ * @param size_t count : Length of the target list
+ * @param int threads : Maximum number of objects to rebuild at once
+ * @param size_t memlimit : Limit on the estimated buffer memory of all objects being rebuilt at once
+ *                          ( zero == no limit, beyond the thread count )
+ * @return int : Count of targets which were not completely rebuilt ( see the 'result' of each ),
+ *               or -1 if the batch could not be processed
+ */
+int ne_rebuild_batch(ne_ctxt ctxt, ne_rebuild_target *targets, size_t count, int threads, size_t memlimit);
+
 /**
  * Seek to a new offset on a read ne_handle
  * @param ne_handle handle : Handle on which to seek (must be open for read)
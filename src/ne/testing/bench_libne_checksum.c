@@ -0,0 +1,165 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Checksum benchmark for erasure encoded writes
+ *
+ * For each supported DAL 'checksum' type, reports :
+ *    'checksum'   - raw throughput of the checksum routine over IO sized buffers
+ *    'ne_write'   - complete ne_open() / ne_write() / ne_close() sequences against the no-op DAL,
+ *                   for several part sizes
+ */
+
+#include "ne/ne.h"
+#include <isa-l.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define BENCH_N 10
+#define BENCH_E 2
+#define BENCH_IOSZ 1048576
+
+typedef struct bench_checksum_struct {
+   const char* name; // value of the DAL 'checksum' attribute
+   uint32_t (*crcfunc)(uint32_t crc, unsigned char* buf, size_t len);
+} bench_checksum;
+
+static uint32_t crc_ieee(uint32_t crc, unsigned char* buf, size_t len) {
+   return crc32_ieee(crc, buf, len);
+}
+
+static uint32_t crc_iscsi(uint32_t crc, unsigned char* buf, size_t len) {
+   return crc32_iscsi(buf, (int)len, crc);
+}
+
+static bench_checksum checksums[] = {
+   { "ieee", crc_ieee },
+   { "crc32c", crc_iscsi }
+};
+
+double elapsed(struct timeval* beg, struct timeval* end) {
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+int bench_crc(bench_checksum* cksum, size_t datasz, double* gbps) {
+   unsigned char* buf = malloc(BENCH_IOSZ);
+   if (buf == NULL) {
+      printf("ERROR: failed to allocate a checksum buffer\n");
+      return -1;
+   }
+   memset(buf, 'x', BENCH_IOSZ);
+   volatile uint32_t crc = 0;
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   size_t done;
+   for (done = 0; done < datasz; done += BENCH_IOSZ) {
+      crc = cksum->crcfunc(crc, buf, BENCH_IOSZ);
+   }
+   gettimeofday(&end, NULL);
+   *gbps = (double)done / elapsed(&beg, &end) / 1e9;
+   free(buf);
+   return 0;
+}
+
+int bench_write(ne_ctxt ctxt, size_t partsz, size_t datasz, double* gbps) {
+   ne_erasure epat = { .N = BENCH_N, .E = BENCH_E, .O = 0, .partsz = partsz };
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   void* iobuff = calloc(1, BENCH_IOSZ);
+   if (iobuff == NULL) {
+      printf("ERROR: failed to allocate an iobuffer\n");
+      return -1;
+   }
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   ne_handle handle = ne_open(ctxt, "bench_libne_checksum", loc, epat, NE_WRALL);
+   if (handle == NULL) {
+      printf("ERROR: failed to open a write handle\n");
+      free(iobuff);
+      return -1;
+   }
+   size_t written = 0;
+   while (written < datasz) {
+      if (ne_write(handle, iobuff, BENCH_IOSZ) != BENCH_IOSZ) {
+         printf("ERROR: unexpected ne_write return value\n");
+         ne_abort(handle);
+         free(iobuff);
+         return -1;
+      }
+      written += BENCH_IOSZ;
+   }
+   if (ne_close(handle, NULL, NULL) < 0) {
+      printf("ERROR: failed to close write handle\n");
+      free(iobuff);
+      return -1;
+   }
+   gettimeofday(&end, NULL);
+   *gbps = (double)written / elapsed(&beg, &end) / 1e9;
+   free(iobuff);
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   size_t datamb = 1024;
+   if (argc > 2) {
+      printf("usage: %s [MiB_per_test]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { datamb = strtoull(argv[1], NULL, 10); }
+   if (datamb < 1) {
+      printf("ERROR: invalid data size\n");
+      return -1;
+   }
+   size_t datasz = datamb * 1048576;
+
+   LIBXML_TEST_VERSION
+   printf("N=%d E=%d, %zu MiB per test\n", BENCH_N, BENCH_E, datamb);
+   printf("%10s %16s %10s %16s\n", "checksum", "checksum GB/s", "partsz", "ne_write GB/s");
+   int retval = 0;
+   int c;
+   for (c = 0; c < sizeof(checksums) / sizeof(bench_checksum) && retval == 0; c++) {
+      xmlDoc* doc = xmlReadFile("./testing/noop_config.xml", NULL, XML_PARSE_NOBLANKS);
+      if (doc == NULL) {
+         printf("ERROR: could not parse file %s\n", "./testing/noop_config.xml");
+         return -1;
+      }
+      xmlNode* root = xmlDocGetRootElement(doc);
+      xmlSetProp(root, (const xmlChar*)"checksum", (const xmlChar*)checksums[c].name);
+      ne_location maxloc = { .pod = 1, .cap = 1, .scatter = 1 };
+      ne_ctxt ctxt = ne_init(root, maxloc, BENCH_N + BENCH_E, NULL);
+      xmlFreeDoc(doc);
+      if (ctxt == NULL) {
+         printf("ERROR: failed to initialize ne_ctxt with checksum \"%s\"\n", checksums[c].name);
+         return -1;
+      }
+
+      double crcrate = 0.0;
+      if (bench_crc(&(checksums[c]), datasz, &crcrate)) {
+         retval = -1;
+      }
+      size_t partsz;
+      for (partsz = 4096; partsz <= 1048576 && retval == 0; partsz *= 16) {
+         double newrite = 0.0;
+         if (bench_write(ctxt, partsz, datasz, &newrite)) {
+            printf("ERROR: benchmark failure for checksum \"%s\" and partsz %zu\n", checksums[c].name, partsz);
+            retval = -1;
+            break;
+         }
+         printf("%10s %16.3f %10zu %16.3f\n", checksums[c].name, crcrate, partsz, newrite);
+      }
+
+      if (ne_term(ctxt)) {
+         printf("ERROR: failed to terminate ne_ctxt\n");
+         retval = -1;
+      }
+   }
+   xmlCleanupParser();
+   return retval;
+}
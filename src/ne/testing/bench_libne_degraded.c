@@ -0,0 +1,172 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Degraded read benchmark
+ *
+ * Writes a single object through the posix DAL ( within the current directory ), then reports the rate of
+ * random 4KiB ne_seek() / ne_read() sequences on NE_RDONLY and NE_RDONLY | NE_RANDOM handles, both for the
+ * intact object and after removal of the block holding one data part of every stripe.  Only reads which
+ * intersect the missing part should require erasure to be read and decoded.
+ */
+
+#include "ne/ne.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#define BENCH_N 10
+#define BENCH_E 2
+#define BENCH_PARTSZ 65536
+#define BENCH_IOSZ 1048576
+#define BENCH_READSZ 4096
+#define BENCH_ERASED 3 // data part to be removed from every stripe
+
+double elapsed(struct timeval* beg, struct timeval* end) {
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+int bench_reads(ne_ctxt ctxt, ne_location loc, ne_erasure epat, ne_mode mode, size_t objsz, int reads, double* usec) {
+   char readbuf[BENCH_READSZ];
+   ne_handle handle = ne_open(ctxt, "bench_libne_degraded", loc, epat, mode);
+   if (handle == NULL) {
+      printf("ERROR: failed to open a read handle\n");
+      return -1;
+   }
+   srand(1); // identical offsets for every pass
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   int r;
+   for (r = 0; r < reads; r++) {
+      off_t offset = ((off_t)rand() % (objsz / BENCH_READSZ)) * BENCH_READSZ;
+      if (ne_seek(handle, offset) != offset) {
+         printf("ERROR: failed to seek to offset %zd\n", offset);
+         ne_abort(handle);
+         return -1;
+      }
+      if (ne_read(handle, readbuf, BENCH_READSZ) != BENCH_READSZ) {
+         printf("ERROR: unexpected ne_read return value at offset %zd\n", offset);
+         ne_abort(handle);
+         return -1;
+      }
+   }
+   gettimeofday(&end, NULL);
+   if (ne_close(handle, NULL, NULL) < 0) {
+      printf("ERROR: failed to close read handle\n");
+      return -1;
+   }
+   *usec = elapsed(&beg, &end) * 1e6 / reads;
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   size_t datamb = 64;
+   int reads = 2000;
+   if (argc > 3) {
+      printf("usage: %s [object_MiB [reads_per_test]]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { datamb = strtoull(argv[1], NULL, 10); }
+   if (argc > 2) { reads = atoi(argv[2]); }
+   if (datamb < 1 || reads < 1) {
+      printf("ERROR: invalid object size or read count\n");
+      return -1;
+   }
+   size_t objsz = datamb * 1048576;
+
+   LIBXML_TEST_VERSION
+   const char* xmlconfig = "<DAL type=\"posix\">"
+                           "<dir_template>./bench_libne_degraded.block{b}.pod{p}.cap{c}.scatter{s}</dir_template>"
+                           "<sec_root></sec_root></DAL>";
+   xmlDoc* doc = xmlReadMemory(xmlconfig, strlen(xmlconfig), "noname.xml", NULL, XML_PARSE_NOBLANKS);
+   if (doc == NULL) {
+      printf("ERROR: could not parse DAL config\n");
+      return -1;
+   }
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_init(xmlDocGetRootElement(doc), loc, BENCH_N + BENCH_E, NULL);
+   xmlFreeDoc(doc);
+   if (ctxt == NULL) {
+      printf("ERROR: failed to initialize ne_ctxt\n");
+      return -1;
+   }
+
+   // write out our object
+   ne_erasure epat = { .N = BENCH_N, .E = BENCH_E, .O = 0, .partsz = BENCH_PARTSZ };
+   void* iobuff = malloc(BENCH_IOSZ);
+   if (iobuff == NULL) {
+      printf("ERROR: failed to allocate an iobuffer\n");
+      return -1;
+   }
+   memset(iobuff, 'x', BENCH_IOSZ);
+   ne_handle handle = ne_open(ctxt, "bench_libne_degraded", loc, epat, NE_WRALL);
+   if (handle == NULL) {
+      printf("ERROR: failed to open a write handle\n");
+      return -1;
+   }
+   size_t written;
+   for (written = 0; written < objsz; written += BENCH_IOSZ) {
+      if (ne_write(handle, iobuff, BENCH_IOSZ) != BENCH_IOSZ) {
+         printf("ERROR: unexpected ne_write return value\n");
+         ne_abort(handle);
+         return -1;
+      }
+   }
+   if (ne_close(handle, NULL, NULL) < 0) {
+      printf("ERROR: failed to close write handle\n");
+      return -1;
+   }
+   free(iobuff);
+
+   printf("N=%d E=%d partsz=%d, %zu MiB object, %d random %d byte reads per test\n",
+          BENCH_N, BENCH_E, BENCH_PARTSZ, datamb, reads, BENCH_READSZ);
+   printf("%10s %8s %12s %12s\n", "object", "mode", "usec/read", "reads/s");
+   ne_mode modes[2] = { NE_RDONLY, NE_RDONLY | NE_RANDOM };
+   const char* modestrs[2] = { "RDONLY", "RANDOM" };
+   int retval = 0;
+   double usec = 0.0;
+   int m;
+   for (m = 0; m < 2  &&  retval == 0; m++) {
+      if (bench_reads(ctxt, loc, epat, modes[m], objsz, reads, &usec)) {
+         retval = -1;
+      }
+      else {
+         printf("%10s %8s %12.1f %12.0f\n", "intact", modestrs[m], usec, 1e6 / usec);
+      }
+   }
+
+   // remove a single data block, then repeat the same reads
+   char blockpath[128];
+   snprintf(blockpath, 128, "./bench_libne_degraded.block%d.pod0.cap0.scatter0bench_libne_degraded", BENCH_ERASED);
+   if (retval == 0 && unlink(blockpath)) {
+      printf("ERROR: failed to remove block file \"%s\"\n", blockpath);
+      retval = -1;
+   }
+   for (m = 0; m < 2  &&  retval == 0; m++) {
+      if (bench_reads(ctxt, loc, epat, modes[m], objsz, reads, &usec)) {
+         retval = -1;
+      }
+      else {
+         printf("%10s %8s %12.1f %12.0f\n", "degraded", modestrs[m], usec, 1e6 / usec);
+      }
+   }
+
+   if (ne_delete(ctxt, "bench_libne_degraded", loc)) {
+      printf("ERROR: failed to delete benchmark object\n");
+      retval = -1;
+   }
+   if (ne_term(ctxt)) {
+      printf("ERROR: failed to terminate ne_ctxt\n");
+      retval = -1;
+   }
+   xmlCleanupParser();
+   return retval;
+}
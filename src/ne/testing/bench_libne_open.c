@@ -0,0 +1,120 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Small object latency benchmark
+ *
+ * Reports the mean latency of complete ne_open() / ne_write() / ne_close() sequences against the no-op DAL,
+ * for object sizes from 4KiB to 1MiB, with the DAL 'threadpool' attribute both disabled ( every handle
+ * creates and joins its own block threads ) and enabled ( block threads persist in a ne_ctxt pool ).
+ */
+
+#include "ne/ne.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define BENCH_N 10
+#define BENCH_E 2
+#define BENCH_PARTSZ 4096
+
+double elapsed(struct timeval* beg, struct timeval* end) {
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+int bench_objects(ne_ctxt ctxt, size_t objsz, int iters, double* usec) {
+   ne_erasure epat = { .N = BENCH_N, .E = BENCH_E, .O = 0, .partsz = BENCH_PARTSZ };
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   void* iobuff = calloc(1, objsz);
+   if (iobuff == NULL) {
+      printf("ERROR: failed to allocate an iobuffer\n");
+      return -1;
+   }
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   int iter;
+   for (iter = 0; iter < iters; iter++) {
+      ne_handle handle = ne_open(ctxt, "bench_libne_open", loc, epat, NE_WRALL);
+      if (handle == NULL) {
+         printf("ERROR: failed to open write handle %d\n", iter);
+         free(iobuff);
+         return -1;
+      }
+      if (ne_write(handle, iobuff, objsz) != objsz) {
+         printf("ERROR: unexpected ne_write return value for handle %d\n", iter);
+         ne_abort(handle);
+         free(iobuff);
+         return -1;
+      }
+      if (ne_close(handle, NULL, NULL) < 0) {
+         printf("ERROR: failed to close write handle %d\n", iter);
+         free(iobuff);
+         return -1;
+      }
+   }
+   gettimeofday(&end, NULL);
+   *usec = elapsed(&beg, &end) * 1e6 / iters;
+   free(iobuff);
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   int iters = 1000;
+   if (argc > 2) {
+      printf("usage: %s [objects_per_test]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { iters = atoi(argv[1]); }
+   if (iters < 1) {
+      printf("ERROR: invalid object count\n");
+      return -1;
+   }
+
+   LIBXML_TEST_VERSION
+   printf("N=%d E=%d partsz=%d, %d objects per test\n", BENCH_N, BENCH_E, BENCH_PARTSZ, iters);
+   printf("%10s %10s %16s %12s\n", "threadpool", "objsz", "usec/object", "objects/s");
+   const char* poolvals[] = { "no", "yes" };
+   int retval = 0;
+   int p;
+   for (p = 0; p < 2 && retval == 0; p++) {
+      xmlDoc* doc = xmlReadFile("./testing/noop_config.xml", NULL, XML_PARSE_NOBLANKS);
+      if (doc == NULL) {
+         printf("ERROR: could not parse file %s\n", "./testing/noop_config.xml");
+         return -1;
+      }
+      xmlNode* root = xmlDocGetRootElement(doc);
+      xmlSetProp(root, (const xmlChar*)"threadpool", (const xmlChar*)poolvals[p]);
+      ne_location maxloc = { .pod = 1, .cap = 1, .scatter = 1 };
+      ne_ctxt ctxt = ne_init(root, maxloc, BENCH_N + BENCH_E, NULL);
+      xmlFreeDoc(doc);
+      if (ctxt == NULL) {
+         printf("ERROR: failed to initialize ne_ctxt with threadpool \"%s\"\n", poolvals[p]);
+         return -1;
+      }
+
+      size_t objsz;
+      for (objsz = 4096; objsz <= 1048576 && retval == 0; objsz *= 4) {
+         double usec = 0.0;
+         if (bench_objects(ctxt, objsz, iters, &usec)) {
+            printf("ERROR: benchmark failure for threadpool \"%s\" and objsz %zu\n", poolvals[p], objsz);
+            retval = -1;
+            break;
+         }
+         printf("%10s %10zu %16.1f %12.0f\n", poolvals[p], objsz, usec, 1e6 / usec);
+      }
+
+      if (ne_term(ctxt)) {
+         printf("ERROR: failed to terminate ne_ctxt\n");
+         retval = -1;
+      }
+   }
+   xmlCleanupParser();
+   return retval;
+}
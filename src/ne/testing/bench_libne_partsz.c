@@ -0,0 +1,175 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Part size benchmark for erasure encoding
+ *
+ * For each part size from 4KiB to 1MiB, reports encode throughput in three forms :
+ *    'per-stripe' - one ec_encode_data() call per stripe ( the behavior of ne_write() prior to batching )
+ *    'batched'    - one ec_encode_data() call per IO sized region of contiguous stripes
+ *    'ne_write'   - complete ne_open() / ne_write() / ne_close() sequences against the no-op DAL
+ */
+
+#include "ne/ne.h"
+#include <isa-l.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define BENCH_N 10
+#define BENCH_E 2
+#define BENCH_IOSZ 1048576
+
+double elapsed(struct timeval* beg, struct timeval* end) {
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+int bench_encode(size_t partsz, size_t datasz, double* stripe_gbps, double* batch_gbps) {
+   int N = BENCH_N;
+   int E = BENCH_E;
+   unsigned char matrix[(BENCH_N + BENCH_E) * BENCH_N];
+   unsigned char tbls[32 * BENCH_N * BENCH_E];
+   unsigned char* parts[BENCH_N + BENCH_E];
+   unsigned char* refs[BENCH_N + BENCH_E];
+   // each buffer holds as many complete parts as fit in a single IO
+   size_t batchsz = (BENCH_IOSZ / partsz) * partsz;
+   if (batchsz == 0) {
+      batchsz = partsz;
+   }
+   int i;
+   for (i = 0; i < N + E; i++) {
+      if ((parts[i] = malloc(batchsz)) == NULL) {
+         printf("ERROR: failed to allocate part buffers\n");
+         while (i > 0) { i--; free(parts[i]); }
+         return -1;
+      }
+      memset(parts[i], i, batchsz);
+   }
+   gf_gen_cauchy1_matrix(matrix, N + E, N);
+   ec_init_tables(N, E, &(matrix[N * N]), tbls);
+   size_t batches = datasz / (N * batchsz);
+   if (batches == 0) {
+      batches = 1;
+   }
+
+   // one encode call per stripe
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   size_t b;
+   for (b = 0; b < batches; b++) {
+      size_t off;
+      for (off = 0; off < batchsz; off += partsz) {
+         for (i = 0; i < N + E; i++) { refs[i] = parts[i] + off; }
+         ec_encode_data((int)partsz, N, E, tbls, refs, &(refs[N]));
+      }
+   }
+   gettimeofday(&end, NULL);
+   *stripe_gbps = ((double)batches * batchsz * N) / elapsed(&beg, &end) / 1e9;
+
+   // one encode call per batch of stripes
+   gettimeofday(&beg, NULL);
+   for (b = 0; b < batches; b++) {
+      ec_encode_data((int)batchsz, N, E, tbls, parts, &(parts[N]));
+   }
+   gettimeofday(&end, NULL);
+   *batch_gbps = ((double)batches * batchsz * N) / elapsed(&beg, &end) / 1e9;
+
+   for (i = 0; i < N + E; i++) { free(parts[i]); }
+   return 0;
+}
+
+int bench_write(ne_ctxt ctxt, size_t partsz, size_t datasz, double* gbps) {
+   ne_erasure epat = { .N = BENCH_N, .E = BENCH_E, .O = 0, .partsz = partsz };
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   void* iobuff = calloc(1, BENCH_IOSZ);
+   if (iobuff == NULL) {
+      printf("ERROR: failed to allocate an iobuffer\n");
+      return -1;
+   }
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   ne_handle handle = ne_open(ctxt, "bench_libne_partsz", loc, epat, NE_WRALL);
+   if (handle == NULL) {
+      printf("ERROR: failed to open a write handle\n");
+      free(iobuff);
+      return -1;
+   }
+   size_t written = 0;
+   while (written < datasz) {
+      if (ne_write(handle, iobuff, BENCH_IOSZ) != BENCH_IOSZ) {
+         printf("ERROR: unexpected ne_write return value\n");
+         ne_abort(handle);
+         free(iobuff);
+         return -1;
+      }
+      written += BENCH_IOSZ;
+   }
+   if (ne_close(handle, NULL, NULL) < 0) {
+      printf("ERROR: failed to close write handle\n");
+      free(iobuff);
+      return -1;
+   }
+   gettimeofday(&end, NULL);
+   *gbps = (double)written / elapsed(&beg, &end) / 1e9;
+   free(iobuff);
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   size_t datamb = 1024;
+   if (argc > 2) {
+      printf("usage: %s [MiB_per_test]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { datamb = strtoull(argv[1], NULL, 10); }
+   if (datamb < 1) {
+      printf("ERROR: invalid data size\n");
+      return -1;
+   }
+   size_t datasz = datamb * 1048576;
+
+   LIBXML_TEST_VERSION
+   xmlDoc* doc = xmlReadFile("./testing/noop_config.xml", NULL, XML_PARSE_NOBLANKS);
+   if (doc == NULL) {
+      printf("ERROR: could not parse file %s\n", "./testing/noop_config.xml");
+      return -1;
+   }
+   ne_location maxloc = { .pod = 1, .cap = 1, .scatter = 1 };
+   ne_ctxt ctxt = ne_init(xmlDocGetRootElement(doc), maxloc, BENCH_N + BENCH_E, NULL);
+   xmlFreeDoc(doc);
+   xmlCleanupParser();
+   if (ctxt == NULL) {
+      printf("ERROR: failed to initialize ne_ctxt\n");
+      return -1;
+   }
+
+   printf("N=%d E=%d, %zu MiB per test\n", BENCH_N, BENCH_E, datamb);
+   printf("%10s %18s %18s %18s\n", "partsz", "per-stripe GB/s", "batched GB/s", "ne_write GB/s");
+   int retval = 0;
+   size_t partsz;
+   for (partsz = 4096; partsz <= 1048576; partsz *= 2) {
+      double stripe = 0.0;
+      double batch = 0.0;
+      double newrite = 0.0;
+      if (bench_encode(partsz, datasz, &stripe, &batch) ||
+          bench_write(ctxt, partsz, datasz, &newrite)) {
+         printf("ERROR: benchmark failure for partsz %zu\n", partsz);
+         retval = -1;
+         break;
+      }
+      printf("%10zu %18.3f %18.3f %18.3f\n", partsz, stripe, batch, newrite);
+   }
+
+   if (ne_term(ctxt)) {
+      printf("ERROR: failed to terminate ne_ctxt\n");
+      retval = -1;
+   }
+   return retval;
+}
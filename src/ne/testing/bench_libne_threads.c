@@ -0,0 +1,215 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * Thread scaling benchmark for erasure encoding
+ *
+ * Reports aggregate encode throughput across an increasing number of threads, in two forms :
+ *    'serialized' - every ec_encode_data() call is wrapped in a single shared mutex
+ *                   ( the behavior of libne prior to lock-free encoding )
+ *    'lock-free'  - ec_encode_data() is called without any shared lock
+ * Finally, full ne_open() / ne_write() / ne_close() sequences are run against the no-op DAL, with all
+ * threads sharing a single ne_ctxt, to show the scaling of the complete libne write path.
+ */
+
+#include "ne/ne.h"
+#include <isa-l.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define BENCH_N 10
+#define BENCH_E 2
+#define BENCH_PARTSZ 65536
+
+typedef struct bench_thread_struct {
+   pthread_mutex_t* lock;  // shared erasurelock
+   int serialize;          // if set, hold the shared lock for every encode call
+   ne_ctxt ctxt;           // shared ne_ctxt, if running through libne
+   int tnum;               // thread number
+   size_t datasz;          // amount of data to process
+   int err;                // set on any failure
+} bench_thread;
+
+double elapsed(struct timeval* beg, struct timeval* end) {
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_usec - beg->tv_usec) * 1e-6);
+}
+
+void* encode_thread(void* arg) {
+   bench_thread* bt = (bench_thread*)arg;
+   int N = BENCH_N;
+   int E = BENCH_E;
+   unsigned char matrix[(BENCH_N + BENCH_E) * BENCH_N];
+   unsigned char tbls[32 * BENCH_N * BENCH_E];
+   unsigned char* parts[BENCH_N + BENCH_E];
+   int i;
+   for (i = 0; i < N + E; i++) {
+      if ((parts[i] = malloc(BENCH_PARTSZ)) == NULL) {
+         printf("ERROR: thread %d failed to allocate part buffers\n", bt->tnum);
+         bt->err = 1;
+         while (i > 0) { i--; free(parts[i]); }
+         return NULL;
+      }
+      memset(parts[i], (bt->tnum + i) & 0xFF, BENCH_PARTSZ);
+   }
+   // table generation is always serialized
+   pthread_mutex_lock(bt->lock);
+   gf_gen_cauchy1_matrix(matrix, N + E, N);
+   ec_init_tables(N, E, &(matrix[N * N]), tbls);
+   pthread_mutex_unlock(bt->lock);
+   size_t stripes = bt->datasz / (N * BENCH_PARTSZ);
+   size_t s;
+   for (s = 0; s < stripes; s++) {
+      if (bt->serialize) { pthread_mutex_lock(bt->lock); }
+      ec_encode_data(BENCH_PARTSZ, N, E, tbls, parts, &(parts[N]));
+      if (bt->serialize) { pthread_mutex_unlock(bt->lock); }
+   }
+   for (i = 0; i < N + E; i++) { free(parts[i]); }
+   return NULL;
+}
+
+void* write_thread(void* arg) {
+   bench_thread* bt = (bench_thread*)arg;
+   ne_erasure epat = { .N = BENCH_N, .E = BENCH_E, .O = 0, .partsz = BENCH_PARTSZ };
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   size_t iosz = 1048576;
+   void* iobuff = calloc(1, iosz);
+   if (iobuff == NULL) {
+      printf("ERROR: thread %d failed to allocate an iobuffer\n", bt->tnum);
+      bt->err = 1;
+      return NULL;
+   }
+   char objID[64];
+   snprintf(objID, sizeof(objID), "bench_libne_threads.%d", bt->tnum);
+   ne_handle handle = ne_open(bt->ctxt, objID, loc, epat, NE_WRALL);
+   if (handle == NULL) {
+      printf("ERROR: thread %d failed to open a write handle\n", bt->tnum);
+      bt->err = 1;
+      free(iobuff);
+      return NULL;
+   }
+   size_t written = 0;
+   while (written < bt->datasz) {
+      if (ne_write(handle, iobuff, iosz) != iosz) {
+         printf("ERROR: thread %d received an unexpected ne_write return value\n", bt->tnum);
+         bt->err = 1;
+         break;
+      }
+      written += iosz;
+   }
+   if (ne_close(handle, NULL, NULL) < 0) {
+      printf("ERROR: thread %d failed to close its write handle\n", bt->tnum);
+      bt->err = 1;
+   }
+   free(iobuff);
+   return NULL;
+}
+
+int run_threads(int tcnt, void* (*func)(void*), pthread_mutex_t* lock, int serialize, ne_ctxt ctxt, size_t datasz, double* gbps) {
+   pthread_t* threads = calloc(tcnt, sizeof(pthread_t));
+   bench_thread* bts = calloc(tcnt, sizeof(bench_thread));
+   if (threads == NULL || bts == NULL) {
+      printf("ERROR: failed to allocate thread structs\n");
+      free(threads);
+      free(bts);
+      return -1;
+   }
+   struct timeval beg, end;
+   gettimeofday(&beg, NULL);
+   int t;
+   int started = 0;
+   for (t = 0; t < tcnt; t++) {
+      bts[t].lock = lock;
+      bts[t].serialize = serialize;
+      bts[t].ctxt = ctxt;
+      bts[t].tnum = t;
+      bts[t].datasz = datasz;
+      if (pthread_create(&(threads[t]), NULL, func, &(bts[t]))) {
+         printf("ERROR: failed to create thread %d\n", t);
+         break;
+      }
+      started++;
+   }
+   int err = (started == tcnt) ? 0 : -1;
+   for (t = 0; t < started; t++) {
+      pthread_join(threads[t], NULL);
+      if (bts[t].err) { err = -1; }
+   }
+   gettimeofday(&end, NULL);
+   *gbps = ((double)datasz * tcnt) / elapsed(&beg, &end) / 1e9;
+   free(threads);
+   free(bts);
+   return err;
+}
+
+int main(int argc, char** argv) {
+   int maxthreads = 16;
+   size_t datamb = 64;
+   if (argc > 3) {
+      printf("usage: %s [max_threads] [MiB_per_thread]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1) { maxthreads = atoi(argv[1]); }
+   if (argc > 2) { datamb = strtoull(argv[2], NULL, 10); }
+   if (maxthreads < 1 || datamb < 1) {
+      printf("ERROR: invalid thread count or data size\n");
+      return -1;
+   }
+   size_t datasz = datamb * 1048576;
+
+   pthread_mutex_t erasurelock;
+   if (pthread_mutex_init(&erasurelock, NULL)) {
+      printf("ERROR: failed to initialize erasurelock\n");
+      return -1;
+   }
+
+   LIBXML_TEST_VERSION
+   xmlDoc* doc = xmlReadFile("./testing/noop_config.xml", NULL, XML_PARSE_NOBLANKS);
+   if (doc == NULL) {
+      printf("ERROR: could not parse file %s\n", "./testing/noop_config.xml");
+      pthread_mutex_destroy(&erasurelock);
+      return -1;
+   }
+   ne_location maxloc = { .pod = 1, .cap = 1, .scatter = 1 };
+   ne_ctxt ctxt = ne_init(xmlDocGetRootElement(doc), maxloc, BENCH_N + BENCH_E, &erasurelock);
+   xmlFreeDoc(doc);
+   xmlCleanupParser();
+   if (ctxt == NULL) {
+      printf("ERROR: failed to initialize ne_ctxt\n");
+      pthread_mutex_destroy(&erasurelock);
+      return -1;
+   }
+
+   printf("N=%d E=%d partsz=%d, %zu MiB per thread\n", BENCH_N, BENCH_E, BENCH_PARTSZ, datamb);
+   printf("%8s %16s %16s %16s\n", "threads", "serialized GB/s", "lock-free GB/s", "ne_write GB/s");
+   int retval = 0;
+   int tcnt;
+   for (tcnt = 1; tcnt <= maxthreads; tcnt *= 2) {
+      double serial = 0.0;
+      double lockfree = 0.0;
+      double newrite = 0.0;
+      if (run_threads(tcnt, encode_thread, &erasurelock, 1, NULL, datasz, &serial) ||
+          run_threads(tcnt, encode_thread, &erasurelock, 0, NULL, datasz, &lockfree) ||
+          run_threads(tcnt, write_thread, &erasurelock, 0, ctxt, datasz, &newrite)) {
+         printf("ERROR: benchmark failure at %d threads\n", tcnt);
+         retval = -1;
+         break;
+      }
+      printf("%8d %16.3f %16.3f %16.3f\n", tcnt, serial, lockfree, newrite);
+   }
+
+   if (ne_term(ctxt)) {
+      printf("ERROR: failed to terminate ne_ctxt\n");
+      retval = -1;
+   }
+   pthread_mutex_destroy(&erasurelock);
+   return retval;
+}
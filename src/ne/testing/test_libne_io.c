@@ -10,6 +10,7 @@
 
 #include "ne/ne.h"
 #include <unistd.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -197,6 +198,47 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
    }
    printf( "...write handle closed...\n" );
 
+   // a second write handle should reuse the cached encode tables of the first
+   printf( "...Verifying erasure table reuse...\n" );
+   write_handle = ne_open( ctxt, "tablecache", cur_loc, *epat, NE_WRALL );
+   if ( write_handle == NULL ) {
+      printf( "ERROR: Failed to open a second write handle!\n" );
+      return -1;
+   }
+   if ( iosz != ne_write( write_handle, iobuff, iosz ) ) {
+      printf( "ERROR: Unexpected return value from second ne_write!\n" );
+      return -1;
+   }
+   if ( ne_close( write_handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of second ne_close!\n" );
+      return -1;
+   }
+   ne_table_stats tstats;
+   if ( ne_get_table_stats( ctxt, &tstats ) ) {
+      printf( "ERROR: Failed to retrieve erasure table stats!\n" );
+      return -1;
+   }
+   if ( tstats.misses != 1  ||  tstats.hits != 1  ||  tstats.entries != 1 ) {
+      printf( "ERROR: Unexpected erasure table stats ( hits=%zu, misses=%zu, entries=%zu )\n",
+              tstats.hits, tstats.misses, tstats.entries );
+      return -1;
+   }
+   // the second handle should have reused the IO buffers of the first
+   ne_pool_stats pstats;
+   if ( ne_get_pool_stats( ctxt, &pstats ) ) {
+      printf( "ERROR: Failed to retrieve IO buffer pool stats!\n" );
+      return -1;
+   }
+   if ( pstats.hits < pstats.misses  ||  pstats.allocsz != pstats.idlesz  ||  pstats.peaksz < pstats.allocsz ) {
+      printf( "ERROR: Unexpected IO buffer pool stats ( hits=%zu, misses=%zu, allocsz=%zu, idlesz=%zu, peaksz=%zu )\n",
+              pstats.hits, pstats.misses, pstats.allocsz, pstats.idlesz, pstats.peaksz );
+      return -1;
+   }
+   if ( ne_delete( ctxt, "tablecache", cur_loc ) ) {
+      printf( "ERROR: Failed to delete second written object!\n" );
+      return -1;
+   }
+
 
    // open a read handle to verify our data
    printf( "...Verifying written data (RDONLY)...\n" );
@@ -324,6 +366,523 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
 
 
 
+int test_checksum( ne_erasure* epat, size_t iosz, size_t partsz ) {
+   printf( "\nTesting crc32c protected objects with iosz=%zu / partsz=%zu\n", iosz, partsz );
+
+   void* iobuff = malloc( iosz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   // a write batch depth which would starve the writer of ioblocks must be rejected
+   const char* badconfig = "<DAL type=\"posix\" qdepth=\"8\">"
+                           "<dir_template>./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}</dir_template>"
+                           "<sec_root></sec_root><io batch=\"7\"/></DAL>";
+   xmlDoc* config = xmlReadMemory( badconfig, strlen( badconfig ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse XML config\n" );
+      return -1;
+   }
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( config ), cur_loc, epat->N + epat->E, NULL );
+   xmlFreeDoc( config );
+   if ( ctxt != NULL ) {
+      printf( "ERROR: ne_init() accepted a write batch depth exceeding qdepth - 2!\n" );
+      ne_term( ctxt );
+      return -1;
+   }
+   // create a libne ctxt which writes crc32c protected objects, coalescing as many IOs as it may
+   const char* xmlconfig = "<DAL type=\"posix\" checksum=\"crc32c\" qdepth=\"8\" numa=\"all\" threadpool=\"no\">"
+                           "<dir_template>./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}</dir_template>"
+                           "<sec_root></sec_root><io batch=\"6\"/></DAL>";
+   config = xmlReadMemory( xmlconfig, strlen( xmlconfig ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse XML config\n" );
+      return -1;
+   }
+   ctxt = ne_init( xmlDocGetRootElement( config ), cur_loc, epat->N + epat->E, NULL );
+   xmlFreeDoc( config );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize crc32c ne_ctxt!\n" );
+      return -1;
+   }
+   // ...as well as a default ctxt, which must still read those objects
+   ne_ctxt defctxt = ne_path_init( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E, NULL );
+   if ( defctxt == NULL ) {
+      printf( "ERROR: Failed to initialize default ne_ctxt!\n" );
+      return -1;
+   }
+
+   // write out data
+   printf( "Writing out crc32c data stripe...\n" );
+   ne_handle handle = ne_open( ctxt, "crc32c", cur_loc, *epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   int iocnt = 10;
+   int i;
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != fill_buffer( iosz * i, iosz, partsz, iobuff ) ) {
+         printf( "ERROR: Failed to populate data buffer!\n" );
+         return -1;
+      }
+      if ( iosz != ne_write( handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_write!\n" );
+         return -1;
+      }
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // the checksum type is recorded with the object, so any ctxt must be able to verify it
+   ne_ctxt ctxts[2] = { ctxt, defctxt };
+   int c;
+   for ( c = 0; c < 2; c++ ) {
+      printf( "...Verifying crc32c data via %s ctxt (RDALL)...\n", ( c ) ? "default" : "crc32c" );
+      handle = ne_open( ctxts[c], "crc32c", cur_loc, *epat, NE_RDALL );
+      if ( handle == NULL ) {
+         printf( "ERROR: Failed to open a read handle!\n" );
+         return -1;
+      }
+      for ( i = 0; i < iocnt; i++ ) {
+         if ( iosz != ne_read( handle, iobuff, iosz ) ) {
+            printf( "ERROR: Unexpected return value from ne_read!\n" );
+            return -1;
+         }
+         if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+            printf( "ERROR: Failed to verify data buffer!\n" );
+            return -1;
+         }
+      }
+      // any CRC mismatch would have been reported as a data error
+      if ( ne_close( handle, NULL, NULL ) ) {
+         printf( "ERROR: Failure of ne_close, or unexpected errors on read!\n" );
+         return -1;
+      }
+   }
+
+   // delete our test object
+   if ( ne_delete( ctxt, "crc32c", cur_loc ) ) {
+      printf( "ERROR: Failed to delete written object!\n" );
+      return -1;
+   }
+   if ( ne_term( defctxt )  ||  ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( iobuff );
+
+   return 0;
+}
+
+
+int test_lazyverify( ne_erasure* epat, size_t iosz, size_t partsz ) {
+   printf( "\nTesting lazy verification with iosz=%zu / partsz=%zu\n", iosz, partsz );
+
+   void* iobuff = malloc( iosz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_path_init( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E, NULL );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+
+   // write out enough data for each block to hold several IOs
+   printf( "Writing out data stripe...\n" );
+   ne_handle handle = ne_open( ctxt, "lazyverify", cur_loc, *epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   int iocnt = ( 4 * epat->N * 1048576 ) / iosz;
+   int i;
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != fill_buffer( iosz * i, iosz, partsz, iobuff ) ) {
+         printf( "ERROR: Failed to populate data buffer!\n" );
+         return -1;
+      }
+      if ( iosz != ne_write( handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_write!\n" );
+         return -1;
+      }
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // a clean object should read and close without errors
+   printf( "...Verifying data (RDONLY | LAZYVERIFY)...\n" );
+   handle = ne_open( ctxt, "lazyverify", cur_loc, *epat, NE_RDONLY | NE_LAZYVERIFY );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a lazily verified read handle!\n" );
+      return -1;
+   }
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != ne_read( handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         return -1;
+      }
+      if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+         printf( "ERROR: Failed to verify data buffer!\n" );
+         return -1;
+      }
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close, or unexpected errors on read!\n" );
+      return -1;
+   }
+
+   // corrupt the first IO of block 0, which is always sampled
+   printf( "...Corrupting a sampled IO...\n" );
+   int fd = open( "./test_libne_io.block0.pod0.cap0.scatter0lazyverify", O_WRONLY );
+   if ( fd < 0 ) {
+      printf( "ERROR: Failed to open block file for corruption!\n" );
+      return -1;
+   }
+   if ( pwrite( fd, "corrupt", 7, 100 ) != 7 ) {
+      printf( "ERROR: Failed to corrupt block file!\n" );
+      return -1;
+   }
+   close( fd );
+
+   // the corruption must be caught, and the affected data regenerated from erasure
+   printf( "...Reading corrupted data (RDALL | LAZYVERIFY)...\n" );
+   handle = ne_open( ctxt, "lazyverify", cur_loc, *epat, NE_RDALL | NE_LAZYVERIFY );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a lazily verified read handle!\n" );
+      return -1;
+   }
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != ne_read( handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         return -1;
+      }
+      if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+         printf( "ERROR: Failed to verify regenerated data buffer!\n" );
+         return -1;
+      }
+   }
+   ne_state state = { .meta_status = calloc( epat->N + epat->E, sizeof(char) ),
+                      .data_status = calloc( epat->N + epat->E, sizeof(char) ), .csum = NULL };
+   if ( state.meta_status == NULL  ||  state.data_status == NULL ) {
+      printf( "ERROR: Failed to allocate ne_state lists!\n" );
+      return -1;
+   }
+   int errcnt = ne_close( handle, NULL, &state );
+   if ( errcnt != 1 ) {
+      printf( "ERROR: Expected a single block error from ne_close, but received %d!\n", errcnt );
+      return -1;
+   }
+   if ( state.data_status[ ( epat->N + epat->E - epat->O ) % ( epat->N + epat->E ) ] == 0 ) {
+      printf( "ERROR: Corrupted block is not reflected in data_status!\n" );
+      return -1;
+   }
+   free( state.meta_status );
+   free( state.data_status );
+
+   // delete our test object
+   if ( ne_delete( ctxt, "lazyverify", cur_loc ) ) {
+      printf( "ERROR: Failed to delete written object!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( iobuff );
+
+   return 0;
+}
+
+
+
+int read_degraded( ne_handle handle, ne_erasure* epat, size_t iosz, size_t partsz, int iocnt, int erased, void* iobuff ) {
+   // a sequential read should regenerate the erased part of every stripe
+   int i;
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != ne_read( handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         return -1;
+      }
+      if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+         printf( "ERROR: Failed to verify data buffer!\n" );
+         return -1;
+      }
+   }
+
+   // small reads, in reverse stripe order, within, straddling, and entirely outside of the erased part
+   size_t stripesz = epat->N * epat->partsz;
+   size_t totsz = iosz * iocnt;
+   size_t smallsz = 4096;
+   int stripe;
+   for ( stripe = ( totsz / stripesz ) - 1; stripe >= 0; stripe-- ) {
+      off_t offsets[3] = { ( stripe * stripesz ) + ( erased * epat->partsz ) + ( ( stripe * smallsz ) % ( epat->partsz - smallsz ) ),
+                           ( stripe * stripesz ) + ( erased * epat->partsz ) - ( smallsz / 2 ),
+                           ( stripe * stripesz ) + ( ( erased + 2 ) * epat->partsz ) + 100 };
+      int o;
+      for ( o = 0; o < 3; o++ ) {
+         if ( ne_seek( handle, offsets[o] ) != offsets[o] ) {
+            printf( "ERROR: Failed to seek to offset %zd!\n", offsets[o] );
+            return -1;
+         }
+         if ( smallsz != ne_read( handle, iobuff, smallsz ) ) {
+            printf( "ERROR: Unexpected return value from ne_read at offset %zd!\n", offsets[o] );
+            return -1;
+         }
+         if ( smallsz != verify_data( offsets[o], partsz, smallsz, iobuff ) ) {
+            printf( "ERROR: Failed to verify data buffer at offset %zd!\n", offsets[o] );
+            return -1;
+         }
+      }
+   }
+   return 0;
+}
+
+
+
+int test_degraded_read( ne_erasure* epat, size_t iosz, size_t partsz ) {
+   printf( "\nTesting degraded reads with iosz=%zu / partsz=%zu\n", iosz, partsz );
+
+   void* iobuff = malloc( iosz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_path_init( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E, NULL );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+
+   // write out enough data for several complete stripes
+   printf( "Writing out data stripe...\n" );
+   ne_handle handle = ne_open( ctxt, "degraded", cur_loc, *epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   int iocnt = ( 4 * epat->N * 1048576 ) / iosz;
+   int i;
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != fill_buffer( iosz * i, iosz, partsz, iobuff ) ) {
+         printf( "ERROR: Failed to populate data buffer!\n" );
+         return -1;
+      }
+      if ( iosz != ne_write( handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_write!\n" );
+         return -1;
+      }
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // random access reads of the intact object
+   int erased = 3;
+   printf( "...Verifying intact data (RDONLY | RANDOM)...\n" );
+   handle = ne_open( ctxt, "degraded", cur_loc, *epat, NE_RDONLY | NE_RANDOM );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a random access read handle!\n" );
+      return -1;
+   }
+   if ( read_degraded( handle, epat, iosz, partsz, iocnt, erased, iobuff ) ) { return -1; }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close for intact random access handle!\n" );
+      return -1;
+   }
+
+   // remove the block holding a single data part of every stripe
+   char blockpath[128];
+   snprintf( blockpath, 128, "./test_libne_io.block%d.pod0.cap0.scatter0degraded", ( erased + epat->O ) % ( epat->N + epat->E ) );
+   if ( unlink( blockpath ) ) {
+      printf( "ERROR: Failed to remove block file \"%s\"!\n", blockpath );
+      return -1;
+   }
+
+   // both sequential and random access handles should regenerate the missing part
+   ne_mode modes[2] = { NE_RDONLY, NE_RDONLY | NE_RANDOM };
+   int m;
+   for ( m = 0; m < 2; m++ ) {
+      printf( "...Verifying degraded data (%s)...\n", ( modes[m] & NE_RANDOM ) ? "RDONLY | RANDOM" : "RDONLY" );
+      handle = ne_open( ctxt, "degraded", cur_loc, *epat, modes[m] );
+      if ( handle == NULL ) {
+         printf( "ERROR: Failed to open a read handle!\n" );
+         return -1;
+      }
+      if ( read_degraded( handle, epat, iosz, partsz, iocnt, erased, iobuff ) ) { return -1; }
+      ne_state state = { .meta_status = calloc( epat->N + epat->E, sizeof(char) ),
+                         .data_status = calloc( epat->N + epat->E, sizeof(char) ), .csum = NULL };
+      if ( state.meta_status == NULL  ||  state.data_status == NULL ) {
+         printf( "ERROR: Failed to allocate ne_state lists!\n" );
+         return -1;
+      }
+      int errcnt = ne_close( handle, NULL, &state );
+      if ( errcnt != 1 ) {
+         printf( "ERROR: Expected a single block error from ne_close, but received %d!\n", errcnt );
+         return -1;
+      }
+      if ( state.data_status[ erased ] == 0 ) {
+         printf( "ERROR: Erased block is not reflected in data_status!\n" );
+         return -1;
+      }
+      free( state.meta_status );
+      free( state.data_status );
+   }
+
+   // random access is only supported for NE_RDONLY handles
+   if ( ne_open( ctxt, "degraded", cur_loc, *epat, NE_RDALL | NE_RANDOM ) != NULL ) {
+      printf( "ERROR: Unexpected success of NE_RDALL | NE_RANDOM open!\n" );
+      return -1;
+   }
+
+   if ( ne_delete( ctxt, "degraded", cur_loc ) ) {
+      printf( "ERROR: Failed to delete written object!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( iobuff );
+
+   return 0;
+}
+
+
+
+int test_rebuild_batch( ne_erasure* epat, size_t iosz, size_t partsz ) {
+   printf( "\nTesting batch rebuilds with iosz=%zu / partsz=%zu\n", iosz, partsz );
+
+   void* iobuff = malloc( iosz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_path_init( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E, NULL );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+
+   // one extra target, which does not exist
+   int objcnt = 6;
+   ne_rebuild_target targets[7];
+   char objIDs[7][16];
+   int iocnt = 4;
+   int o;
+   int i;
+   for ( o = 0; o <= objcnt; o++ ) {
+      snprintf( objIDs[o], 16, "batch%d", o );
+      targets[o].objID = objIDs[o];
+      targets[o].loc = cur_loc;
+      targets[o].epat = *epat;
+      targets[o].seed = NULL;
+   }
+
+   // two passes : the first admits only a single rebuild at a time, the second has no memory limit
+   size_t memlimits[2] = { 1, 0 };
+   int pass;
+   for ( pass = 0; pass < 2; pass++ ) {
+      printf( "...Writing and damaging %d objects...\n", objcnt );
+      for ( o = 0; o < objcnt; o++ ) {
+         ne_handle handle = ne_open( ctxt, objIDs[o], cur_loc, *epat, NE_WRALL );
+         if ( handle == NULL ) {
+            printf( "ERROR: Failed to open a write handle for \"%s\"!\n", objIDs[o] );
+            return -1;
+         }
+         for ( i = 0; i < iocnt; i++ ) {
+            if ( iosz != fill_buffer( iosz * i, iosz, partsz, iobuff ) ) {
+               printf( "ERROR: Failed to populate data buffer!\n" );
+               return -1;
+            }
+            if ( iosz != ne_write( handle, iobuff, iosz ) ) {
+               printf( "ERROR: Unexpected return value from ne_write!\n" );
+               return -1;
+            }
+         }
+         if ( ne_close( handle, NULL, NULL ) ) {
+            printf( "ERROR: Failure of ne_close!\n" );
+            return -1;
+         }
+         // remove a different block of each object
+         char blockpath[128];
+         if ( snprintf( blockpath, 128, "./test_libne_io.block%d.pod0.cap0.scatter0%s", ( o + pass ) % ( epat->N + epat->E ), objIDs[o] ) >= 128 ) {
+            printf( "ERROR: Failed to generate block path of \"%s\"!\n", objIDs[o] );
+            return -1;
+         }
+         if ( unlink( blockpath ) ) {
+            printf( "ERROR: Failed to remove block file \"%s\"!\n", blockpath );
+            return -1;
+         }
+      }
+
+      printf( "...Rebuilding ( memlimit = %zu )...\n", memlimits[pass] );
+      int incomplete = ne_rebuild_batch( ctxt, targets, objcnt + 1, 4, memlimits[pass] );
+      if ( incomplete != 1 ) {
+         printf( "ERROR: Expected a single incomplete rebuild target, but received %d!\n", incomplete );
+         return -1;
+      }
+      if ( targets[objcnt].result == 0 ) {
+         printf( "ERROR: Rebuild of a nonexistent object reports success!\n" );
+         return -1;
+      }
+      for ( o = 0; o < objcnt; o++ ) {
+         if ( targets[o].result ) {
+            printf( "ERROR: Rebuild of \"%s\" failed with result %d ( errno = %d )!\n", objIDs[o], targets[o].result, targets[o].errval );
+            return -1;
+         }
+      }
+
+      printf( "...Verifying rebuilt objects...\n" );
+      for ( o = 0; o < objcnt; o++ ) {
+         ne_handle handle = ne_open( ctxt, objIDs[o], cur_loc, *epat, NE_RDALL );
+         if ( handle == NULL ) {
+            printf( "ERROR: Failed to open a read handle for \"%s\"!\n", objIDs[o] );
+            return -1;
+         }
+         for ( i = 0; i < iocnt; i++ ) {
+            if ( iosz != ne_read( handle, iobuff, iosz ) ) {
+               printf( "ERROR: Unexpected return value from ne_read!\n" );
+               return -1;
+            }
+            if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+               printf( "ERROR: Failed to verify data buffer!\n" );
+               return -1;
+            }
+         }
+         if ( ne_close( handle, NULL, NULL ) ) {
+            printf( "ERROR: Rebuilt object \"%s\" still contains errors!\n", objIDs[o] );
+            return -1;
+         }
+         if ( ne_delete( ctxt, objIDs[o], cur_loc ) ) {
+            printf( "ERROR: Failed to delete object \"%s\"!\n", objIDs[o] );
+            return -1;
+         }
+      }
+   }
+
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( iobuff );
+
+   return 0;
+}
+
+
 int main( int argc, char** argv ) {
    // Test with a small partsz and larger, aligned iosz
    size_t iosz = 8196;
@@ -335,6 +894,14 @@ int main( int argc, char** argv ) {
    iosz = 1048576;
    epat.partsz = partsz;
    if ( test_values( &epat, iosz, partsz ) ) { return -1; }
+   // Test the alternate checksum type, with the same values
+   if ( test_checksum( &epat, iosz, partsz ) ) { return -1; }
+   // Test lazy verification, with the same values
+   if ( test_lazyverify( &epat, iosz, partsz ) ) { return -1; }
+   // Test degraded reads, with the same values
+   if ( test_degraded_read( &epat, iosz, partsz ) ) { return -1; }
+   // Test parallel rebuilds, with the same values
+   if ( test_rebuild_batch( &epat, iosz, partsz ) ) { return -1; }
 
    return 0;
 }
@@ -32,6 +32,9 @@
                           // Default to 10 minutes ago
 #define RB_M_THRESH  120  // Age of files before they are rebuilt (based on marker)
                           // Default to 2 minutes ago
+#define RB_BATCH_THREADS 4 // Maximum objects of a single rebuild op chain to rebuild in parallel
+#define RB_BATCH_MEMLIMIT 1073741824 // Limit on estimated buffer memory of those parallel rebuilds
+                                     // Default to 1GiB
 #define RP_THRESH 259200  // Age of files before they are repacked
                           // Default to 3 days ago
 #define CL_THRESH  86400  // Age of intermediate state files before they are cleaned up (failed repacks, old logs, etc.)
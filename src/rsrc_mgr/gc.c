@@ -28,7 +28,7 @@ static void print_usage_info(const int rank) {
 
     printf("\n"
            "gc [-c MarFS-Config-File] [-n MarFS-NS-Target] [-r] [-i Iteration-Name] [-l Log-Root]\n"
-           "[-d] [-h]\n"
+           "[-d] [-W] [-h]\n"
            "\n"
            " Arguments --\n"
            "  -c MarFS-Config-File : Specifies the path of the MarFS config file to use\n"
@@ -41,6 +41,8 @@ static void print_usage_info(const int rank) {
            "  -l Log-Root          : Specifies the dir to be used for resource log storage\n"
            "                         (defaults to \"%s\", if unspecified)\n"
            "  -d                   : Specifies a 'dry-run', logging but skipping execution of all ops\n"
+           "  -W                   : Enables work stealing, allowing all producer threads to share the\n"
+           "                         walk of streams within a single reference dir\n"
            "  -T Threshold-Values  : Specifies time threshold values for resource manager ops.\n"
            "                         Value Format = <TimeThresh>[<Unit>]\n"
            "                                           [-<TimeThresh>[<Unit>]]*\n"
@@ -84,7 +86,7 @@ static int parse_args(int argc, char **argv,
     // parse all position-independent arguments
     int print_usage = 0;
     int c;
-    while ((c = getopt(argc, (char* const*)argv, "c:n:ri:l:dT:L:h")) != -1) {
+    while ((c = getopt(argc, (char* const*)argv, "c:n:ri:l:dWT:L:h")) != -1) {
         switch (c) {
             case 'c':
                 *config_path = optarg;
@@ -109,6 +111,9 @@ static int parse_args(int argc, char **argv,
             case 'd':
                 rman->gstate.dryrun = 1;
                 break;
+            case 'W':
+                rman->gstate.worksteal = 1;
+                break;
             case 'T':
             {
                 char* threshparse = optarg;
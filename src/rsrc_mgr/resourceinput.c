@@ -10,6 +10,35 @@
 #include "rsrc_mgr/common.h"
 #include "rsrc_mgr/resourceinput.h"
 
+// discard all queued streamwalks of the given resourceinput
+// NOTE -- caller must hold the resourceinput lock (or otherwise have exclusive access)
+static void discardstealunits(RESOURCEINPUT rin) {
+   for (size_t client = 0; client < rin->stealclients; client++) {
+      stealqueue* sq = rin->stealqueues + client;
+      while (sq->count) {
+         free(sq->units[sq->head]);
+         sq->head = (sq->head + 1) % rin->stealdepth;
+         sq->count--;
+      }
+   }
+   rin->stealcount = 0;
+}
+
+// free all steal queues of the given resourceinput, including any queued streamwalks
+// NOTE -- caller must hold the resourceinput lock (or otherwise have exclusive access)
+static void freestealqueues(RESOURCEINPUT rin) {
+   if (rin->stealqueues == NULL) {
+      return;
+   }
+
+   discardstealunits(rin);
+   free(rin->stealqueues[0].units); // all units arrays are part of a single allocation
+   free(rin->stealqueues);
+   rin->stealqueues = NULL;
+   rin->stealclients = 0;
+   rin->stealdepth = 0;
+}
+
 /**
  * Initialize a given resourceinput
  * @param RESOURCEINPUT* resourceinput : Resourceinput to be initialized
@@ -40,6 +69,10 @@ int resourceinput_init(RESOURCEINPUT* resourceinput, marfs_position* pos, size_t
    rin->refindex = 0;
    rin->prepterm = 0;
    rin->clientcount = clientcount;
+   rin->stealdepth = 0;
+   rin->stealclients = 0;
+   rin->stealcount = 0;
+   rin->stealqueues = NULL;
    pthread_cond_init(&rin->complete, NULL);
    pthread_cond_init(&rin->updated, NULL);
    pthread_mutex_init(&rin->lock, NULL);
@@ -150,17 +183,148 @@ int resourceinput_setrange(RESOURCEINPUT* resourceinput, size_t start, size_t en
    return -1;
 }
 
+/**
+ * Enable work stealing for the given resourceinput, allowing clients to split the datastreams of a single
+ *  reference dir across all clients
+ * NOTE -- this must be called prior to any client retrieving inputs
+ * @param RESOURCEINPUT* resourceinput : Resourceinput to enable work stealing for
+ * @param size_t stealdepth : Maximum number of streamwalk units to be queued by each client
+ *                            (a value of zero disables work stealing)
+ * @return int : Zero on success, or -1 on failure
+ */
+int resourceinput_setsteal(RESOURCEINPUT* resourceinput, size_t stealdepth) {
+   // check for valid ref
+   if (resourceinput == NULL || *resourceinput == NULL) {
+      LOG(LOG_ERR, "Received an invalid resourceinput arg\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   RESOURCEINPUT rin = *resourceinput;
+
+   // acquire the structure lock
+   pthread_mutex_lock(&rin->lock);
+
+   // don't discard any streamwalks which have already been queued
+   if (rin->stealcount) {
+      LOG(LOG_ERR, "Cannot alter work stealing while %zu streamwalks remain queued\n", rin->stealcount);
+      pthread_mutex_unlock(&rin->lock);
+      errno = EBUSY;
+      return -1;
+   }
+
+   freestealqueues(rin);
+
+   if (stealdepth && rin->clientcount) {
+      // allocate a queue for every client, all sharing a single allocation of units
+      stealqueue* queues = calloc(rin->clientcount, sizeof(*queues));
+      char** units = calloc(rin->clientcount * stealdepth, sizeof(*units));
+      if (queues == NULL || units == NULL) {
+         LOG(LOG_ERR, "Failed to allocate %zu steal queues of depth %zu\n", rin->clientcount, stealdepth);
+         free(queues);
+         free(units);
+         pthread_mutex_unlock(&rin->lock);
+         errno = ENOMEM;
+         return -1;
+      }
+
+      for (size_t client = 0; client < rin->clientcount; client++) {
+         queues[client].units = units + (client * stealdepth);
+      }
+
+      rin->stealqueues = queues;
+      rin->stealclients = rin->clientcount;
+      rin->stealdepth = stealdepth;
+   }
+
+   LOG(LOG_INFO, "Work stealing %s (depth = %zu)\n", (rin->stealdepth) ? "enabled" : "disabled", rin->stealdepth);
+   pthread_mutex_unlock(&rin->lock);
+
+   return 0;
+}
+
+/**
+ * Offer the start of a datastream, identified while scanning a reference dir, to be walked by any client
+ * @param RESOURCEINPUT* resourceinput : Resourceinput to offer the streamwalk to
+ * @param size_t client : Index of the calling client (thread ID of the producer thread)
+ * @param const char* reftgt : Reference path of the first file of the datastream (duplicated, if queued)
+ * @return int : One, if the streamwalk was queued;
+ *               Zero, if the caller should walk the stream itself (work stealing disabled or queue full);
+ *               -1 on failure
+ */
+int resourceinput_pushwalk(RESOURCEINPUT* resourceinput, size_t client, const char* reftgt) {
+   // check for valid ref
+   if (resourceinput == NULL || *resourceinput == NULL) {
+      LOG(LOG_ERR, "Received an invalid resourceinput arg\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   if (reftgt == NULL) {
+      LOG(LOG_ERR, "Received a NULL reftgt arg\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   RESOURCEINPUT rin = *resourceinput;
+
+   // acquire the structure lock
+   pthread_mutex_lock(&rin->lock);
+
+   // a disabled or purged input leaves the walk to the caller
+   if (rin->stealdepth == 0 || rin->prepterm > 2) {
+      pthread_mutex_unlock(&rin->lock);
+      return 0;
+   }
+
+   if (client >= rin->stealclients) {
+      LOG(LOG_ERR, "Client index %zu exceeds steal queue count %zu\n", client, rin->stealclients);
+      pthread_mutex_unlock(&rin->lock);
+      errno = EINVAL;
+      return -1;
+   }
+
+   // a full queue leaves the walk to the caller ( bounds the memory of a scan that outpaces all walkers )
+   stealqueue* sq = rin->stealqueues + client;
+   if (sq->count == rin->stealdepth) {
+      pthread_mutex_unlock(&rin->lock);
+      return 0;
+   }
+
+   char* unit = strdup(reftgt);
+   if (unit == NULL) {
+      LOG(LOG_ERR, "Failed to duplicate streamwalk reference path: \"%s\"\n", reftgt);
+      pthread_mutex_unlock(&rin->lock);
+      return -1;
+   }
+
+   sq->units[(sq->head + sq->count) % rin->stealdepth] = unit;
+   sq->count++;
+   rin->stealcount++;
+
+   pthread_cond_signal(&rin->updated); // a single unit only requires a single waiting thread
+   pthread_mutex_unlock(&rin->lock);
+
+   LOG(LOG_INFO, "Client %zu queued streamwalk from reference file \"%s\"\n", client, reftgt);
+   return 1;
+}
+
 /**
  * Get the next ref index to be processed from the given resourceinput
+ * NOTE -- if work stealing is enabled, this will prefer queued streamwalks of the calling client, then
+ *         new reference dirs, then queued streamwalks stolen from the client with the most queued
  * @param RESOURCEINPUT* resourceinput : Resourceinput to get the next ref index from
+ * @param size_t client : Index of the calling client (thread ID of the producer thread)
  * @param opinfo** nextop : Reference to be populated with a new op from an input logfile
  * @param MDAL_SCANNER* scanner : Reference to be populated with a new reference scanner
  * @param char** rdirpath : Reference to be populated with the path of a newly opened reference dir
+ * @param char** reftgt : Reference to be populated with the reference path of a datastream to be walked
+ *                        (caller is responsible for freeing this string)
  * @return int : Zero, if no inputs are currently available;
  *               One, if an input was produced;
  *               Ten, if the caller should prepare for termination (resourceinput is preparing to be closed)
  */
-int resourceinput_getnext(RESOURCEINPUT* resourceinput, opinfo** nextop, MDAL_SCANNER* scanner, char** rdirpath) {
+int resourceinput_getnext(RESOURCEINPUT* resourceinput, size_t client, opinfo** nextop, MDAL_SCANNER* scanner, char** rdirpath, char** reftgt) {
    // check for valid ref
    if (resourceinput == NULL || *resourceinput == NULL) {
       LOG(LOG_ERR, "Received an invalid resourceinput arg\n");
@@ -200,11 +364,41 @@ int resourceinput_getnext(RESOURCEINPUT* resourceinput, opinfo** nextop, MDAL_SC
       }
    }
 
+   // prefer our own queued streamwalks ( most recently queued first )
+   if (client < rin->stealclients && rin->stealqueues[client].count) {
+      stealqueue* sq = rin->stealqueues + client;
+      sq->count--;
+      rin->stealcount--;
+      *reftgt = sq->units[(sq->head + sq->count) % rin->stealdepth];
+      pthread_mutex_unlock(&rin->lock);
+      LOG(LOG_INFO, "Client %zu retrieved its own queued streamwalk\n", client);
+      return 1;
+   }
+
    MDAL_SCANNER scanres = NULL;
    HASH_NODE* node = NULL;
    while (scanres == NULL) {
       // check if the ref range has already been traversed
       if (rin->refindex == rin->refmax) {
+         // steal the oldest queued streamwalk of whichever client has the most queued
+         if (rin->stealcount) {
+            size_t victim = 0;
+            for (size_t qindex = 1; qindex < rin->stealclients; qindex++) {
+               if (rin->stealqueues[qindex].count > rin->stealqueues[victim].count) {
+                  victim = qindex;
+               }
+            }
+
+            stealqueue* sq = rin->stealqueues + victim;
+            *reftgt = sq->units[sq->head];
+            sq->head = (sq->head + 1) % rin->stealdepth;
+            sq->count--;
+            rin->stealcount--;
+            pthread_mutex_unlock(&rin->lock);
+            LOG(LOG_INFO, "Client %zu stole a queued streamwalk from client %zu\n", client, victim);
+            return 1;
+         }
+
          LOG(LOG_INFO, "Resource inputs have been fully traversed\n");
          int retval = 0;
          if (rin->prepterm) {
@@ -279,6 +473,9 @@ int resourceinput_purge(RESOURCEINPUT* resourceinput) {
    // set ref range values to indicate completion
    rin->refindex = rin->refmax;
 
+   // discard any queued streamwalks
+   discardstealunits(rin);
+
    // set prepterm to cause a bypass of the synchronized termination logic
    rin->prepterm = 3;
 
@@ -309,7 +506,7 @@ int resourceinput_waitforupdate(RESOURCEINPUT* resourceinput) {
    pthread_mutex_lock(&rin->lock);
 
    // wait for the ref range to be traversed
-   while (rin->rlog == NULL && rin->refindex == rin->refmax && rin->prepterm == 0) {
+   while (rin->rlog == NULL && rin->refindex == rin->refmax && rin->stealcount == 0 && rin->prepterm == 0) {
       pthread_cond_wait(&rin->updated, &rin->lock);
    }
 
@@ -322,7 +519,8 @@ int resourceinput_waitforupdate(RESOURCEINPUT* resourceinput) {
 /**
  * Wait for the given resourceinput to be terminated (synchronizing like this ensures ALL work gets enqueued)
  * @param RESOURCEINPUT* resourceinput : Resourceinput to wait on
- * @param int : Zero on success, or -1 on failure
+ * @param int : Zero on success, One if queued streamwalks became available (caller should retrieve
+ *              them via resourceinput_getnext() and wait again afterwards), or -1 on failure
  */
 int resourceinput_waitforterm(RESOURCEINPUT* resourceinput) {
    // check for valid ref
@@ -340,6 +538,20 @@ int resourceinput_waitforterm(RESOURCEINPUT* resourceinput) {
    // wait for the master proc to signal us
    char diddec = 0;
    while (rin->prepterm < 2) {
+      // streamwalks queued by a still active client must be processed prior to termination
+      // NOTE -- a client only ever counts itself as waiting when no streamwalks are queued, so the
+      //         final active client cannot queue more, once all others are waiting
+      if (rin->stealcount) {
+         if (diddec) {
+            LOG(LOG_INFO, "Incrementing active client count from %zu to %zu\n", rin->clientcount, rin->clientcount + 1);
+            rin->clientcount++; // show that we are active again
+         }
+
+         pthread_mutex_unlock(&rin->lock);
+         LOG(LOG_INFO, "Detected queued streamwalks while waiting for termination\n");
+         return 1;
+      }
+
       // check if we should decrement active client count
       if (!diddec && rin->prepterm == 1) {
          if (rin->clientcount) {
@@ -507,6 +719,8 @@ int resourceinput_destroy(RESOURCEINPUT* resourceinput) {
       LOG(LOG_WARNING, "Failed to abort input resourcelog\n");
    }
 
+   freestealqueues(rin);
+
    pthread_cond_destroy(&rin->complete);
    pthread_cond_destroy(&rin->updated);
    if (havelock) { pthread_mutex_unlock(&rin->lock); }
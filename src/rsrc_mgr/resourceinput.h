@@ -17,6 +17,12 @@
 #include "rsrc_mgr/common.h"
 #include "rsrc_mgr/resourcelog.h"
 
+typedef struct {
+   char**           units;    // ring of reference paths, each the start of a datastream to be walked
+   size_t           head;     // index of the oldest unit ( the next to be stolen by another client )
+   size_t           count;    // number of queued units
+} stealqueue;
+
 typedef struct {
    // synchronization and access control
    pthread_mutex_t  lock;     // no simultaneous access
@@ -32,6 +38,11 @@ typedef struct {
    // reference info
    ssize_t          refindex;
    ssize_t          refmax;
+   // work stealing info
+   size_t           stealdepth;   // maximum number of queued streamwalk units per client ( zero, if disabled )
+   size_t           stealclients; // number of client steal queues
+   size_t           stealcount;   // total number of queued streamwalk units, across all clients
+   stealqueue*      stealqueues;  // per-client queues of streamwalk units, available to any client
 }*RESOURCEINPUT;
 
 /**
@@ -62,17 +73,44 @@ int resourceinput_setlogpath( RESOURCEINPUT* resourceinput, const char* logpath
  */
 int resourceinput_setrange( RESOURCEINPUT* resourceinput, size_t start, size_t end );
 
+/**
+ * Enable work stealing for the given resourceinput, allowing clients to split the datastreams of a single
+ *  reference dir across all clients
+ * NOTE -- this must be called prior to any client retrieving inputs
+ * @param RESOURCEINPUT* resourceinput : Resourceinput to enable work stealing for
+ * @param size_t stealdepth : Maximum number of streamwalk units to be queued by each client
+ *                            ( a value of zero disables work stealing )
+ * @return int : Zero on success, or -1 on failure
+ */
+int resourceinput_setsteal( RESOURCEINPUT* resourceinput, size_t stealdepth );
+
+/**
+ * Offer the start of a datastream, identified while scanning a reference dir, to be walked by any client
+ * @param RESOURCEINPUT* resourceinput : Resourceinput to offer the streamwalk to
+ * @param size_t client : Index of the calling client ( thread ID of the producer thread )
+ * @param const char* reftgt : Reference path of the first file of the datastream ( duplicated, if queued )
+ * @return int : One, if the streamwalk was queued;
+ *               Zero, if the caller should walk the stream itself ( work stealing disabled or queue full );
+ *               -1 on failure
+ */
+int resourceinput_pushwalk( RESOURCEINPUT* resourceinput, size_t client, const char* reftgt );
+
 /**
  * Get the next ref index to be processed from the given resourceinput
+ * NOTE -- if work stealing is enabled, this will prefer queued streamwalks of the calling client, then
+ *         new reference dirs, then queued streamwalks stolen from the client with the most queued
  * @param RESOURCEINPUT* resourceinput : Resourceinput to get the next ref index from
+ * @param size_t client : Index of the calling client ( thread ID of the producer thread )
  * @param opinfo** nextop : Reference to be populated with a new op from an input logfile
  * @param MDAL_SCANNER* scanner : Reference to be populated with a new reference scanner
  * @param char** rdirpath : Reference to be populated with the path of a newly opened reference dir
+ * @param char** reftgt : Reference to be populated with the reference path of a datastream to be walked
+ *                        ( caller is responsible for freeing this string )
  * @return int : Zero, if no inputs are currently available;
  *               One, if an input was produced;
  *               Ten, if the caller should prepare for termination ( resourceinput is preparing to be closed )
  */
-int resourceinput_getnext( RESOURCEINPUT* resourceinput, opinfo** nextop, MDAL_SCANNER* scanner, char** rdirpath );
+int resourceinput_getnext( RESOURCEINPUT* resourceinput, size_t client, opinfo** nextop, MDAL_SCANNER* scanner, char** rdirpath, char** reftgt );
 
 /**
  * Destroy all available inputs and signal threads to prepare or for imminent termination
@@ -92,7 +130,8 @@ int resourceinput_waitforupdate( RESOURCEINPUT* resourceinput );
 /**
  * Wait for the given resourceinput to be terminated ( synchronizing like this ensures ALL work gets enqueued )
  * @param RESOURCEINPUT* resourceinput : Resourceinput to wait on
- * @param int : Zero on success, or -1 on failure
+ * @param int : Zero on success, One if queued streamwalks became available ( caller should retrieve
+ *              them via resourceinput_getnext() and wait again afterwards ), or -1 on failure
  */
 int resourceinput_waitforterm( RESOURCEINPUT* resourceinput );
 
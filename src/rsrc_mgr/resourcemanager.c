@@ -30,7 +30,7 @@ static void print_usage_info(const int rank) {
 
    printf("\n"
            "marfs-rman [-c MarFS-Config-File] [-n MarFS-NS-Target] [-r] [-i Iteration-Name] [-l Log-Root]\n"
-           "           [-p Log-Pres-Root] [-d] [-X Execution-Target] [-Q] [-G] [-R] [-P] [-C]\n"
+           "           [-p Log-Pres-Root] [-d] [-W] [-X Execution-Target] [-Q] [-G] [-R] [-P] [-C]\n"
            "           [-T Threshold-Values] [-L [NE-Location]] [-h]\n"
            "\n"
            " Arguments --\n"
@@ -46,6 +46,8 @@ static void print_usage_info(const int rank) {
            "  -p Log-Pres-Root     : Specifies a location to store resource logs to, post-run\n"
            "                         (logfiles will be deleted, if unspecified)\n"
            "  -d                   : Specifies a 'dry-run', logging but skipping execution of all ops\n"
+           "  -W                   : Enables work stealing, allowing all producer threads to share the\n"
+           "                         walk of streams within a single reference dir\n"
            "  -X Execution-Target  : Specifies the logging path of a previous 'dry-run' iteration to\n"
            "                         be processed by this run. The program will NOT scan reference\n"
            "                         paths to identify operations. Instead, it will exclusively\n"
@@ -123,7 +125,7 @@ static int parse_args(int argc, char** argv,
    // parse all position-independent arguments
    int print_usage = 0;
    int c;
-   while ((c = getopt(argc, (char* const*)argv, "c:n:ri:l:p:dX:QGRPCT:L:h")) != -1) {
+   while ((c = getopt(argc, (char* const*)argv, "c:n:ri:l:p:dWX:QGRPCT:L:h")) != -1) {
       switch (c) {
       case 'c':
          args->config_path = optarg;
@@ -151,6 +153,9 @@ static int parse_args(int argc, char** argv,
       case 'd':
          rman->gstate.dryrun = 1;
          break;
+      case 'W':
+         rman->gstate.worksteal = 1;
+         break;
       case 'X':
          rman->execprevroot = optarg;
          break;
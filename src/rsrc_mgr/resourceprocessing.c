@@ -288,94 +288,98 @@ static void process_rebuild(const marfs_position* pos, opinfo* op) {
    // quick refs
    marfs_ds* ds = &pos->ns->prepo->datascheme;
    marfs_ms* ms = &pos->ns->prepo->metascheme;
-   for (; op; op = op->next) {
-      op->start = 0;
-      rebuild_info* rebinf = (rebuild_info*)op->extendedinfo;
+
+   // gather every object of the op chain into a single rebuild batch
+   // NOTE -- ops which already reflect an error contribute no targets
+   size_t tgtcount = 0;
+   opinfo* parseop;
+   for (parseop = op; parseop; parseop = parseop->next) {
+      parseop->start = 0;
+      if (parseop->errval == 0) { tgtcount += parseop->count; }
+   }
+   ne_rebuild_target* targets = NULL;
+   if (tgtcount) {
+      targets = calloc(tgtcount, sizeof(ne_rebuild_target));
+      if (targets == NULL) {
+         LOG(LOG_ERR, "Failed to allocate a list of %zu rebuild targets\n", tgtcount);
+         for (parseop = op; parseop; parseop = parseop->next) {
+            if (parseop->errval == 0) { parseop->errval = ENOMEM; }
+         }
+         return;
+      }
+   }
+   size_t tgtindex = 0;
+   for (parseop = op; parseop; parseop = parseop->next) {
+      if (parseop->errval) { continue; }
+      rebuild_info* rebinf = (rebuild_info*)parseop->extendedinfo;
       size_t countval = 0;
-      while (countval < op->count) {
+      for (; countval < parseop->count; countval++) {
          // identify the object target of the op
-         FTAG tmptag = op->ftag;
+         FTAG tmptag = parseop->ftag;
          tmptag.objno += countval;
 
          char* objname = NULL;
-         ne_erasure erasure;
-         ne_location location;
-         if (datastream_objtarget(&tmptag, ds, &objname, &erasure, &location)) {
-            op->errval = (errno) ? errno : ENOTRECOVERABLE;
+         ne_rebuild_target* target = targets + tgtindex + countval;
+         if (datastream_objtarget(&tmptag, ds, &objname, &(target->epat), &(target->loc))) {
+            parseop->errval = (errno) ? errno : ENOTRECOVERABLE;
             LOG(LOG_ERR, "Failed to identify object target %zu of stream \"%s\"\n", tmptag.objno, tmptag.streamid);
             break;
          }
-
-         // open an object handle
-         ne_handle obj = ne_open(ds->nectxt, objname, location, erasure, NE_REBUILD);
-         if (obj == NULL) {
-            op->errval = (errno) ? errno : ENOTRECOVERABLE;
-            LOG(LOG_ERR, "Failed to open rebuild handle for object \"%s\"\n", objname);
-            free(objname);
-            break;
-         }
-
-         free(objname);
+         target->objID = objname;
 
          // if we have an rtag value, seed it in prior to rebuilding
          if (rebinf && rebinf->rtag && rebinf->rtag->stripestate.meta_status && rebinf->rtag->stripestate.data_status) {
-            if (ne_seed_status(obj, &rebinf->rtag->stripestate)) {
-               LOG(LOG_WARNING, "Failed to seed rtag status into handle for object %zu of stream \"%s\"\n",
-                                 tmptag.objno, tmptag.streamid);
-            }
+            target->seed = &rebinf->rtag->stripestate;
          }
-
-         // rebuild the object, performing up to 2 attempts
-         int iteration = 0;
-         while (iteration < 2) {
-            LOG(LOG_INFO, "Rebuilding object %zu of stream \"%s\" (attempt %d)\n",
-                           tmptag.objno, tmptag.streamid, (int)iteration + 1);
-            int rebuildres = ne_rebuild(obj, NULL, NULL);
-            if (rebuildres < 0) { // unmitigated failure
-               iteration = -1;
-               break;
-            }
-            else if (rebuildres == 0) { // rebuild success
-               LOG(LOG_INFO, "Successfully rebuilt object %zu of stream \"%s\"\n",
-                              tmptag.objno, tmptag.streamid);
-               break;
-            }
-            else {
-               LOG(LOG_WARNING, "Object %zu of stream \"%s\" still contains %d errors after iteration %d\n",
-                                 tmptag.objno, tmptag.streamid, rebuildres, iteration);
-            }
-            // incomplete rebuild (reattempt may succeed)
-            iteration++;
+      }
+      if (parseop->errval) {
+         // drop all targets of this failed op
+         while (countval) {
+            countval--;
+            free((char*)targets[tgtindex + countval].objID);
+            memset(targets + tgtindex + countval, 0, sizeof(ne_rebuild_target));
          }
+         continue;
+      }
+      tgtindex += parseop->count;
+   }
 
-         // check for excessive rebuild reattempts
-         if (iteration >= 2 || iteration < 0) {
-            if (iteration < 0) {
-               LOG(LOG_ERR, "Rebuild failure for object %zu of stream \"%s\"\n", tmptag.objno, tmptag.streamid);
+   // rebuild all objects, several at a time
+   size_t tgtfilled = tgtindex;
+   LOG(LOG_INFO, "Rebuilding %zu objects of stream \"%s\"\n", tgtfilled, op->ftag.streamid);
+   if (tgtfilled  &&  ne_rebuild_batch(ds->nectxt, targets, tgtfilled, RB_BATCH_THREADS, RB_BATCH_MEMLIMIT) < 0) {
+      int batcherr = (errno) ? errno : ENOTRECOVERABLE;
+      LOG(LOG_ERR, "Failed to process rebuild batch of stream \"%s\"\n", op->ftag.streamid);
+      for (parseop = op; parseop; parseop = parseop->next) {
+         if (parseop->errval == 0) { parseop->errval = batcherr; }
+      }
+   }
+
+   // apply the result of each object to its op
+   tgtindex = 0;
+   for (; op; op = op->next) {
+      if (op->errval) { continue; }
+      rebuild_info* rebinf = (rebuild_info*)op->extendedinfo;
+      size_t countval = 0;
+      for (; countval < op->count; countval++) {
+         ne_rebuild_target* target = targets + tgtindex + countval;
+         if (target->result == 0) {
+            LOG(LOG_INFO, "Successfully rebuilt object %zu of stream \"%s\"\n",
+                           op->ftag.objno + countval, op->ftag.streamid);
+         }
+         else if (op->errval == 0) {
+            if (target->result > 0) {
+               LOG(LOG_ERR, "Excessive rebuild reattempts for object %zu of stream \"%s\"\n", op->ftag.objno + countval, op->ftag.streamid);
             }
             else {
-               LOG(LOG_ERR, "Excessive rebuild reattempts for object %zu of stream \"%s\"\n", tmptag.objno, tmptag.streamid);
-            }
-            op->errval = (errno) ? errno : ENOTRECOVERABLE;
-            if (ne_abort(obj)) {
-               LOG(LOG_ERR, "Failed to properly abort rebuild handle for object %zu of stream \"%s\"\n",
-                             tmptag.objno, tmptag.streamid);
+               LOG(LOG_ERR, "Rebuild failure for object %zu of stream \"%s\"\n", op->ftag.objno + countval, op->ftag.streamid);
             }
-            obj = NULL;
-            break;
-         }
-
-         // close the object reference
-         if (obj && ne_close(obj, NULL, NULL)) {
-            op->errval = (errno) ? errno : ENOTRECOVERABLE;
-            LOG(LOG_ERR, "Failed to finalize rebuild of object %zu of stream \"%s\"\n", tmptag.objno, tmptag.streamid);
-            break;
+            op->errval = (target->errval) ? target->errval : ENOTRECOVERABLE;
          }
-
-         countval++;
       }
+      tgtindex += op->count;
 
-      if (countval < op->count) { continue; } // skip over remaining, if we hit an error
+      if (op->errval) { continue; } // skip over remaining, if we hit an error
 
       // potentially cleanup the rtag
       if (rebinf && rebinf->rtag) {
@@ -435,6 +439,10 @@ static void process_rebuild(const marfs_position* pos, opinfo* op) {
    }
 
    // rebuild complete
+   for (tgtindex = 0; tgtindex < tgtfilled; tgtindex++) {
+      free((char*)targets[tgtindex].objID);
+   }
+   free(targets);
    return;
 }
 
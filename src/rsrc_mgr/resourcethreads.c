@@ -338,11 +338,14 @@ static int process_walker(rthread_state* tstate, opinfo **newop) {
 
    int walkres = streamwalker_iterate(&tstate->walker, &tstate->gcops, &tstate->repackops, &tstate->rebuildops);
    if (walkres < 0) { // check for failure
+       // NOTE -- streamwalks retrieved from the resourceinput queues have no associated refdir
        LOG(LOG_ERR, "Thread %u failed to walk a stream beginning in refdir \"%s\" of NS \"%s\"\n",
-          tstate->tID, tstate->rdirpath, tstate->gstate->pos.ns->idstr);
+          tstate->tID, (tstate->rdirpath) ? tstate->rdirpath : "QUEUED-STREAMWALK",
+          tstate->gstate->pos.ns->idstr);
        snprintf(tstate->errorstr, MAX_STR_BUFFER,
                 "Thread %u failed to walk a stream beginning in refdir \"%s\" of NS \"%s\"\n",
-                tstate->tID, tstate->rdirpath, tstate->gstate->pos.ns->idstr);
+                tstate->tID, (tstate->rdirpath) ? tstate->rdirpath : "QUEUED-STREAMWALK",
+                tstate->gstate->pos.ns->idstr);
 
        goto error;
    }
@@ -419,6 +422,30 @@ static int process_walker(rthread_state* tstate, opinfo **newop) {
    return -1;
 }
 
+// begin walking the datastream starting at the given reference path
+static int open_walker(rthread_state* tstate, const char* reftgt) {
+   // only copy relevant threshold values for this walk
+   thresholds tmpthresh = tstate->gstate->thresh;
+   if (!tstate->gstate->lbrebuild) {
+       tmpthresh.rebuildthreshold = 0;
+   }
+
+   LOG(LOG_INFO, "Thread %u beginning streamwalk from reference file \"%s\"\n", tstate->tID, reftgt);
+
+   if (streamwalker_open(&tstate->walker, &tstate->gstate->pos, reftgt, tmpthresh, &tstate->gstate->rebuildloc)) {
+      LOG(LOG_ERR, "Thread %u failed to open streamwalker for \"%s\" of NS \"%s\"\n",
+          tstate->tID, (reftgt) ? reftgt : "NULL-REFERENCE!", tstate->gstate->pos.ns->idstr);
+      snprintf(tstate->errorstr, MAX_STR_BUFFER,
+               "Thread %u failed to open streamwalker for \"%s\" of NS \"%s\"\n",
+               tstate->tID, (reftgt) ? reftgt : "NULL-REFERENCE!", tstate->gstate->pos.ns->idstr);
+
+      return -1;
+   }
+
+   tstate->streamcount++;
+   return 0;
+}
+
 // iterate through the scanner, looking for new operations to dispatch
 static int process_scanner(rthread_state* tstate, opinfo** newop) {
    char* reftgt = NULL;
@@ -442,25 +469,21 @@ static int process_scanner(rthread_state* tstate, opinfo** newop) {
       tstate->rdirpath = NULL;
    }
    else if (scanres == 1) { // start of a new datastream to be walked
-      // only copy relevant threshold values for this walk
-      thresholds tmpthresh = tstate->gstate->thresh;
-      if (!tstate->gstate->lbrebuild) {
-          tmpthresh.rebuildthreshold = 0;
-      }
-
-      LOG(LOG_INFO, "Thread %u beginning streamwalk from reference file \"%s\"\n", tstate->tID, reftgt);
-
-      if (streamwalker_open(&tstate->walker, &tstate->gstate->pos, reftgt, tmpthresh, &tstate->gstate->rebuildloc)) {
-         LOG(LOG_ERR, "Thread %u failed to open streamwalker for \"%s\" of NS \"%s\"\n",
+      // offer the walk to all threads, only walking the stream ourself if it could not be queued
+      int pushres = resourceinput_pushwalk(&tstate->gstate->rinput, tstate->tID, reftgt);
+      if (pushres < 0) {
+         LOG(LOG_ERR, "Thread %u failed to queue streamwalk for \"%s\" of NS \"%s\"\n",
              tstate->tID, (reftgt) ? reftgt : "NULL-REFERENCE!", tstate->gstate->pos.ns->idstr);
          snprintf(tstate->errorstr, MAX_STR_BUFFER,
-                  "Thread %u failed to open streamwalker for \"%s\" of NS \"%s\"\n",
+                  "Thread %u failed to queue streamwalk for \"%s\" of NS \"%s\"\n",
                   tstate->tID, (reftgt) ? reftgt : "NULL-REFERENCE!", tstate->gstate->pos.ns->idstr);
 
          goto error;
       }
 
-      tstate->streamcount++;
+      if (pushres == 0 && open_walker(tstate, reftgt)) {
+         goto error;
+      }
    }
    else if (scanres == 2) { // rebuild marker file
        if (tstate->gstate->lbrebuild) { //skip marker files, if we're rebuilding based on object location
@@ -535,7 +558,8 @@ static int process_scanner(rthread_state* tstate, opinfo** newop) {
 // pull from our resource input reference
 static int process_rinput_ref(rthread_state* tstate, opinfo **newop) {
    int inputres = 0;
-   while ((inputres = resourceinput_getnext(&tstate->gstate->rinput, newop, &tstate->scanner, &tstate->rdirpath)) == 0) {
+   char* reftgt = NULL;
+   while ((inputres = resourceinput_getnext(&tstate->gstate->rinput, tstate->tID, newop, &tstate->scanner, &tstate->rdirpath, &reftgt)) == 0) {
       // wait until inputs are available
       LOG(LOG_INFO, "Thread %u is waiting for inputs\n", tstate->tID);
       if (resourceinput_waitforupdate(&tstate->gstate->rinput)) {
@@ -552,7 +576,8 @@ static int process_rinput_ref(rthread_state* tstate, opinfo **newop) {
    // check for termination condition
    if (inputres == 10) {
       LOG(LOG_INFO, "Thread %u is waiting for termination\n", tstate->tID);
-      if (resourceinput_waitforterm(&tstate->gstate->rinput)) {
+      int termres = resourceinput_waitforterm(&tstate->gstate->rinput);
+      if (termres < 0) {
          LOG(LOG_ERR, "Thread %u failed to wait for input termination\n", tstate->tID);
          snprintf(tstate->errorstr, MAX_STR_BUFFER,
                   "Thread %u failed to wait for input termination\n", tstate->tID);
@@ -560,6 +585,12 @@ static int process_rinput_ref(rthread_state* tstate, opinfo **newop) {
          goto error;
       }
 
+      if (termres > 0) {
+         // another thread has queued streamwalks, which we'll retrieve on our next pass
+         LOG(LOG_INFO, "Thread %u is resuming to process queued streamwalks\n", tstate->tID);
+         return 0;
+      }
+
       LOG(LOG_INFO, "Thread %u is signaling FINISHED state\n", tstate->tID);
       return 1;
    }
@@ -575,6 +606,17 @@ static int process_rinput_ref(rthread_state* tstate, opinfo **newop) {
       goto error;
    }
 
+   // if we got a queued streamwalk, begin walking it
+   if (reftgt) {
+      int openres = open_walker(tstate, reftgt);
+      free(reftgt);
+      if (openres) {
+         goto error;
+      }
+
+      return 0;
+   }
+
    // if we got an op directly, we'll need to process it
    if (*newop) {
       // log the operation
@@ -31,6 +31,7 @@ typedef struct {
    REPACKSTREAMER  rpst;
    unsigned int    numprodthreads;
    unsigned int    numconsthreads;
+   char            worksteal; // if set, streams found by refdir scans are queued for any producer to walk
 } rthread_global_state;
 
 typedef struct {
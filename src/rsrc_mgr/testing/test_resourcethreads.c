@@ -1079,6 +1079,12 @@ int main(void)
       goto free_databuf;
    }
 
+   // share streamwalks between all producers, with a shallow queue depth to also force some local walks
+   if (resourceinput_setsteal(&gstate.rinput, 2)) {
+      printf("failed to enable work stealing for final run\n");
+      goto free_databuf;
+   }
+
    rlogpath = resourcelog_genlogpath(1, "./test_rman_topdir", "yetAgain!", gstate.pos.ns, 17);
    if (rlogpath == NULL) {
       printf("failed to generate rlogpath for logfile 4\n");
@@ -11,6 +11,8 @@
 #include "rsrc_mgr/outputinfo.h"
 #include "rsrc_mgr/resourceinput.h"
 
+#define WORKSTEAL_DEPTH 64 // maximum number of queued streamwalks per producer thread, in work stealing mode
+
 static int error_only_filter(const opinfo* op) {
     return !op->errval;
 }
@@ -64,6 +66,15 @@ static int setranktgt(rmanstate* rman, marfs_ns* ns, workresponse* response) {
       goto error;
    }
 
+   // potentially allow all producers to share the streamwalks of a single reference dir
+   if (rman->gstate.worksteal &&
+       resourceinput_setsteal(&rman->gstate.rinput, WORKSTEAL_DEPTH)) {
+      LOG(LOG_ERR, "Failed to enable work stealing for new NS target: \"%s\"\n", ns->idstr);
+      snprintf(response->errorstr, MAX_ERROR_BUFFER,
+                "Failed to enable work stealing for new NS target: \"%s\"", ns->idstr);
+      goto rman_error;
+   }
+
    // update our output resource log
    char* outlogpath = resourcelog_genlogpath(1, rman->logroot, rman->iteration, ns, rman->ranknum);
    if (outlogpath == NULL) {
@@ -0,0 +1,278 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+/*
+ * ThreadQueue microbenchmark
+ *
+ * For both the lock-protected queue and the lock-free ring, and for 1 to 64 threads, reports :
+ *  - throughput : work packages per second passed from N producer threads to N consumer threads
+ *  - wakeup latency : average time between a master tq_enqueue() and the start of processing by
+ *                     one of N idle consumer threads
+ */
+
+#include "thread_queue/thread_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <time.h>
+
+#define QDEPTH 64
+#define MAX_THREADS 64
+#define LAT_IDLE 200 // usec for which the master sleeps between latency samples, so that consumers go idle
+
+typedef struct global_state_struct
+{
+   size_t totalops;        // number of work packages to be produced
+   size_t nextop;          // next work package to be produced
+   size_t latsum;          // sum of all wakeup latencies, in nsec
+   volatile char consumed; // set once the current latency sample has been received
+} * GlobalState;
+
+typedef struct thread_state_struct
+{
+   GlobalState gstate;
+   size_t wkcnt;
+} * ThreadState;
+
+double elapsed(struct timespec *beg, struct timespec *end)
+{
+   return (end->tv_sec - beg->tv_sec) + ((end->tv_nsec - beg->tv_nsec) * 1e-9);
+}
+
+int bench_thread_init(unsigned int tID, void *global_state, void **state)
+{
+   ThreadState tstate = malloc(sizeof(struct thread_state_struct));
+   if (tstate == NULL)
+   {
+      return -1;
+   }
+   tstate->gstate = (GlobalState)global_state;
+   tstate->wkcnt = 0;
+   *state = tstate;
+   return 0;
+}
+
+int bench_producer(void **state, void **work)
+{
+   ThreadState tstate = ((ThreadState)*state);
+   size_t op = __sync_fetch_and_add(&tstate->gstate->nextop, 1);
+   if (op >= tstate->gstate->totalops)
+   {
+      *work = NULL;
+      return 1; // all work has been produced
+   }
+   tstate->wkcnt++;
+   *work = (void *)(op + 1);
+   return (op + 1 == tstate->gstate->totalops) ? 1 : 0;
+}
+
+int bench_consumer(void **state, void **work)
+{
+   ThreadState tstate = ((ThreadState)*state);
+   tstate->wkcnt++;
+   *work = NULL;
+   return 0;
+}
+
+int latency_consumer(void **state, void **work)
+{
+   ThreadState tstate = ((ThreadState)*state);
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   struct timespec *stamp = (struct timespec *)(*work);
+   size_t nsec = ((now.tv_sec - stamp->tv_sec) * 1000000000L) + (now.tv_nsec - stamp->tv_nsec);
+   __sync_fetch_and_add(&tstate->gstate->latsum, nsec);
+   tstate->wkcnt++;
+   *work = NULL;
+   __sync_synchronize();
+   tstate->gstate->consumed = 1;
+   return 0;
+}
+
+void bench_thread_term(void **state, void **prev_work, TQ_Control_Flags flg)
+{
+   return;
+}
+
+// wait for completion of the given queue, returning the total work count of the given thread range
+ssize_t bench_complete(ThreadQueue tq, unsigned int countfrom)
+{
+   if (tq_wait_for_completion(tq))
+   {
+      printf("ERROR: failed to wait for queue completion\n");
+      return -1;
+   }
+   ssize_t wkcnt = 0;
+   unsigned int tID = 0;
+   int tres = 0;
+   ThreadState tstate = NULL;
+   while ((tres = tq_next_thread_status(tq, (void **)&tstate)) > 0)
+   {
+      if (tstate == NULL)
+      {
+         printf("ERROR: received NULL status for thread %u\n", tID);
+         return -1;
+      }
+      if (tID >= countfrom)
+      {
+         wkcnt += tstate->wkcnt;
+      }
+      free(tstate);
+      tID++;
+   }
+   if (tres != 0 || tq_close(tq))
+   {
+      printf("ERROR: failed to collect thread states and close the queue\n");
+      return -1;
+   }
+   return wkcnt;
+}
+
+// pass 'totalops' work packages from 'threads' producers to 'threads' consumers, returning ops/sec
+double bench_throughput(char lockfree, unsigned int threads, size_t totalops)
+{
+   struct global_state_struct gstate = {.totalops = totalops, .nextop = 0, .latsum = 0, .consumed = 0};
+   TQ_Init_Opts tqopts = {
+      .log_prefix = "BenchTQ",
+      .init_flags = TQ_HALT,
+      .max_qdepth = QDEPTH,
+      .lockfree = lockfree,
+      .global_state = &gstate,
+      .num_threads = threads * 2,
+      .num_prod_threads = threads,
+      .thread_init_func = bench_thread_init,
+      .thread_consumer_func = bench_consumer,
+      .thread_producer_func = bench_producer,
+      .thread_pause_func = NULL,
+      .thread_resume_func = NULL,
+      .thread_term_func = bench_thread_term};
+   ThreadQueue tq = tq_init(&tqopts);
+   if (tq == NULL || tq_check_init(tq))
+   {
+      printf("ERROR: failed to initialize queue with %u producers and consumers\n", threads);
+      return -1.0;
+   }
+
+   struct timespec beg, end;
+   clock_gettime(CLOCK_MONOTONIC, &beg);
+   tq_unset_flags(tq, TQ_HALT);
+   TQ_Control_Flags flags = 0;
+   if (tq_wait_for_flags(tq, 0, &flags) || flags != TQ_FINISHED)
+   {
+      printf("ERROR: queue has unexpected flags value: %d\n", (int)flags);
+      return -1.0;
+   }
+   ssize_t consumed = bench_complete(tq, threads);
+   clock_gettime(CLOCK_MONOTONIC, &end);
+   if (consumed != (ssize_t)totalops)
+   {
+      printf("ERROR: consumed %zd work packages ( expected %zu )\n", consumed, totalops);
+      return -1.0;
+   }
+   return totalops / elapsed(&beg, &end);
+}
+
+// enqueue 'samples' work packages to 'threads' idle consumers, returning the average wakeup latency in usec
+double bench_latency(char lockfree, unsigned int threads, size_t samples)
+{
+   struct global_state_struct gstate = {.totalops = samples, .nextop = 0, .latsum = 0, .consumed = 0};
+   TQ_Init_Opts tqopts = {
+      .log_prefix = "BenchTQ",
+      .init_flags = TQ_NONE,
+      .max_qdepth = QDEPTH,
+      .lockfree = lockfree,
+      .global_state = &gstate,
+      .num_threads = threads,
+      .num_prod_threads = 0,
+      .thread_init_func = bench_thread_init,
+      .thread_consumer_func = latency_consumer,
+      .thread_producer_func = NULL,
+      .thread_pause_func = NULL,
+      .thread_resume_func = NULL,
+      .thread_term_func = bench_thread_term};
+   ThreadQueue tq = tq_init(&tqopts);
+   if (tq == NULL || tq_check_init(tq))
+   {
+      printf("ERROR: failed to initialize queue with %u consumers\n", threads);
+      return -1.0;
+   }
+
+   struct timespec stamp;
+   size_t sample;
+   for (sample = 0; sample < samples; sample++)
+   {
+      usleep(LAT_IDLE);
+      gstate.consumed = 0;
+      __sync_synchronize();
+      clock_gettime(CLOCK_MONOTONIC, &stamp);
+      if (tq_enqueue(tq, TQ_NONE, (void *)&stamp))
+      {
+         printf("ERROR: failed to enqueue latency sample %zu\n", sample);
+         return -1.0;
+      }
+      while (!(gstate.consumed))
+      {
+         sched_yield();
+      }
+   }
+   tq_set_flags(tq, TQ_FINISHED);
+   ssize_t consumed = bench_complete(tq, 0);
+   if (consumed != (ssize_t)samples)
+   {
+      printf("ERROR: consumed %zd latency samples ( expected %zu )\n", consumed, samples);
+      return -1.0;
+   }
+   return (gstate.latsum / (double)samples) / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+   size_t totalops = 1000000;
+   size_t samples = 2000;
+   if (argc > 3)
+   {
+      printf("usage: %s [throughput_ops] [latency_samples]\n", argv[0]);
+      return -1;
+   }
+   if (argc > 1)
+   {
+      totalops = strtoull(argv[1], NULL, 10);
+   }
+   if (argc > 2)
+   {
+      samples = strtoull(argv[2], NULL, 10);
+   }
+   if (totalops < 1 || samples < 1)
+   {
+      printf("ERROR: invalid op or sample count\n");
+      return -1;
+   }
+
+   printf("%zu ops per throughput run, %zu samples per latency run, queue depth %d\n", totalops, samples, QDEPTH);
+   printf("%10s %8s %14s %16s\n", "queue", "threads", "ops/s", "wakeup (usec)");
+   char lockfree;
+   for (lockfree = 0; lockfree < 2; lockfree++)
+   {
+      unsigned int threads;
+      for (threads = 1; threads <= MAX_THREADS; threads *= 2)
+      {
+         double opsps = bench_throughput(lockfree, threads, totalops);
+         double wakeup = bench_latency(lockfree, threads, samples);
+         if (opsps < 0.0 || wakeup < 0.0)
+         {
+            printf("ERROR: benchmark failure for %u threads\n", threads);
+            return -1;
+         }
+         printf("%10s %8u %14.1f %16.2f\n", (lockfree) ? "lockfree" : "locked", threads, opsps, wakeup);
+      }
+   }
+   return 0;
+}
@@ -165,6 +165,16 @@ int check_opts(TQ_Init_Opts *opt_a, TQ_Init_Opts *opt_b)
       printf("Max queue depth is %d (should be %d)\n", opt_a->max_qdepth, opt_b->max_qdepth);
       count++;
    }
+   if (opt_a->lockfree != opt_b->lockfree)
+   {
+      printf("Lock-free value is %d (should be %d)\n", opt_a->lockfree, opt_b->lockfree);
+      count++;
+   }
+   if (opt_a->pool != opt_b->pool)
+   {
+      printf("Thread pool is %p (should be %p)\n", (void *)opt_a->pool, (void *)opt_b->pool);
+      count++;
+   }
    if (opt_a->thread_init_func != opt_b->thread_init_func)
    {
       printf("Init function is incorrect\n");
@@ -215,6 +225,8 @@ int main(int argc, char **argv)
    tqopts.num_threads = NUM_PROD + NUM_CONS;
    tqopts.num_prod_threads = NUM_PROD;
    tqopts.max_qdepth = QDEPTH;
+   tqopts.lockfree = 0;
+   tqopts.pool = NULL;
    tqopts.thread_init_func = my_thread_init;
    tqopts.thread_consumer_func = my_consumer;
    tqopts.thread_producer_func = my_producer;
@@ -0,0 +1,350 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+#include "thread_queue/thread_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+
+#define NUM_CONS 6
+#define NUM_PROD 4
+#define QDEPTH 4 // small, so that producers frequently wait on a full ring
+#define TOT_WRK 5000
+#define HLT_AT 1000
+#define MST_WRK 3 // work packages inserted by the master while the queue is HALTED
+#define SLP_PER_CONS 50 // 50 usec
+
+typedef struct global_state_struct
+{
+   pthread_mutex_t lock;
+   int pkgcnt;
+} * GlobalState;
+
+typedef struct thread_state_struct
+{
+   unsigned int tID;
+   GlobalState gstate;
+   int wkcnt;
+} * ThreadState;
+
+typedef struct work_package_struct
+{
+   int pkgnum;
+} * WorkPkg;
+
+int my_thread_init(unsigned int tID, void *global_state, void **state)
+{
+   *state = malloc(sizeof(struct thread_state_struct));
+   if (*state == NULL)
+   {
+      return -1;
+   }
+   ThreadState tstate = ((ThreadState)*state);
+
+   tstate->tID = tID;
+   tstate->gstate = (GlobalState)global_state;
+   tstate->wkcnt = 0;
+   return 0;
+}
+
+int my_consumer(void **state, void **work)
+{
+   WorkPkg wpkg = ((WorkPkg)*work);
+   ThreadState tstate = ((ThreadState)*state);
+
+   tstate->wkcnt++;
+   int num = wpkg->pkgnum;
+   free(wpkg);
+   if (num % 100 == 0)
+   {
+      usleep(rand() % (SLP_PER_CONS));
+   }
+   // pause the queue, if necessary
+   if (num == HLT_AT)
+   {
+      fprintf(stdout, "Thread %u is pausing the queue!\n", tstate->tID);
+      return 2;
+   }
+   return 0;
+}
+
+int my_producer(void **state, void **work)
+{
+   ThreadState tstate = ((ThreadState)*state);
+
+   WorkPkg wpkg = malloc(sizeof(struct work_package_struct));
+   if (wpkg == NULL)
+   {
+      fprintf(stdout, "Thread %u failed to allocate space for a new work package!\n", tstate->tID);
+      return -1;
+   }
+   if (pthread_mutex_lock(&(tstate->gstate->lock)))
+   {
+      fprintf(stdout, "Thread %u failed to acquire global state lock\n", tstate->tID);
+      free(wpkg);
+      return -1;
+   }
+   wpkg->pkgnum = tstate->gstate->pkgcnt;
+   tstate->gstate->pkgcnt++;
+   pthread_mutex_unlock(&(tstate->gstate->lock));
+   tstate->wkcnt++;
+   *work = (void *)wpkg;
+   if (wpkg->pkgnum == TOT_WRK)
+   {
+      fprintf(stdout, "Thread %u is marking the queue as finished\n", tstate->tID);
+      return 1;
+   }
+   return 0;
+}
+
+void my_thread_term(void **state, void **prev_work, TQ_Control_Flags flg)
+{
+   WorkPkg wpkg = ((WorkPkg)*prev_work);
+   ThreadState tstate = ((ThreadState)*state);
+   if (wpkg != NULL)
+   {
+      fprintf(stdout, "Thread %u is freeing unused work package %d\n", tstate->tID, wpkg->pkgnum);
+      free(wpkg);
+      *prev_work = NULL;
+   }
+   return;
+}
+
+int main(int argc, char **argv)
+{
+   srand(time(NULL));
+   struct global_state_struct gstruct;
+   if (pthread_mutex_init(&(gstruct.lock), NULL))
+   {
+      return -1;
+   }
+   gstruct.pkgcnt = 0;
+
+   TQ_Init_Opts tqopts;
+   tqopts.log_prefix = "MyTQ";
+   tqopts.init_flags = TQ_HALT;
+   tqopts.global_state = (void *)&gstruct;
+   tqopts.num_threads = NUM_PROD + NUM_CONS;
+   tqopts.num_prod_threads = NUM_PROD;
+   tqopts.max_qdepth = QDEPTH;
+   tqopts.lockfree = 1;
+   tqopts.pool = NULL;
+   tqopts.thread_init_func = my_thread_init;
+   tqopts.thread_consumer_func = my_consumer;
+   tqopts.thread_producer_func = my_producer;
+   tqopts.thread_pause_func = NULL;
+   tqopts.thread_resume_func = NULL;
+   tqopts.thread_term_func = my_thread_term;
+
+   printf("Initializing ThreadQueue...\n");
+   ThreadQueue tq = tq_init(&tqopts);
+   if (tq == NULL)
+   {
+      printf("tq_init() failed!  Terminating...\n");
+      return -1;
+   }
+   if (tq_check_init(tq))
+   {
+      printf("tq_check_init() failed!  Terminating...\n");
+      return -1;
+   }
+
+   TQ_Init_Opts got_opts;
+   got_opts.log_prefix = NULL;
+   if (tq_get_opts(tq, &got_opts, 0) || got_opts.lockfree != 1)
+   {
+      printf("tq_get_opts() does not reflect a lock-free queue!\n");
+      return -1;
+   }
+
+   // the queue was initialized in a HALTED state, so nothing should be produced
+   if (tq_wait_for_pause(tq))
+   {
+      printf("unexpected return from tq_wait_for_pause!\n");
+      return -1;
+   }
+   if (gstruct.pkgcnt != 0 || tq_depth(tq) != 0)
+   {
+      printf("work was produced by a HALTED queue!\n");
+      return -1;
+   }
+   printf("...resuming queue...\n");
+   if (tq_unset_flags(tq, TQ_HALT))
+   {
+      printf("unexpected return from tq_unset_flags!\n");
+      return -1;
+   }
+
+   int mastercnt = 0;
+   TQ_Control_Flags flags = 0;
+   while (!(flags & TQ_FINISHED) && !(flags & TQ_ABORT))
+   {
+      if (tq_wait_for_flags(tq, 0, &flags))
+      {
+         printf("unexpected return from tq_wait_for_flags()!\n");
+         return -1;
+      }
+      if ((flags & TQ_HALT) && !(flags & TQ_FINISHED))
+      {
+         printf("queue has halted!  Waiting for all threads to pause...\n");
+         if (tq_wait_for_pause(tq))
+         {
+            printf("unexpected return from tq_wait_for_pause!\n");
+            return -1;
+         }
+         // a HALTED queue should refuse work, unless that state is explicitly ignored
+         WorkPkg wpkg = malloc(sizeof(struct work_package_struct));
+         if (wpkg == NULL)
+         {
+            printf("failed to allocate a master work package!\n");
+            return -1;
+         }
+         wpkg->pkgnum = -1;
+         if (tq_enqueue(tq, TQ_NONE, (void *)wpkg) == 0)
+         {
+            printf("tq_enqueue() succeeded on a HALTED queue!\n");
+            return -1;
+         }
+         // cycle a work package through the halted queue, if there is space
+         if (tq_depth(tq) < QDEPTH)
+         {
+            if (tq_enqueue(tq, TQ_HALT, (void *)wpkg))
+            {
+               printf("tq_enqueue() failed on a HALTED queue with space remaining!\n");
+               return -1;
+            }
+            mastercnt++;
+            WorkPkg gotpkg = NULL;
+            if (tq_dequeue(tq, TQ_HALT, (void **)&gotpkg) < 1 || gotpkg == NULL)
+            {
+               printf("tq_dequeue() failed to retrieve work from a HALTED queue!\n");
+               return -1;
+            }
+            // this may be a producer's package, rather than our own, so just requeue it below
+            wpkg = gotpkg;
+            if (wpkg->pkgnum < 0)
+            {
+               mastercnt--;
+            }
+         }
+         printf("...resuming queue...\n");
+         if (tq_unset_flags(tq, TQ_HALT))
+         {
+            printf("unexpected return from tq_unset_flags!\n");
+            return -1;
+         }
+         // insert our work packages into the running queue
+         int i;
+         for (i = 0; i < MST_WRK; i++)
+         {
+            if (wpkg == NULL)
+            {
+               wpkg = malloc(sizeof(struct work_package_struct));
+               if (wpkg == NULL)
+               {
+                  printf("failed to allocate a master work package!\n");
+                  return -1;
+               }
+               wpkg->pkgnum = -1;
+            }
+            // NOTE -- the package may be consumed as soon as it is enqueued, so check ownership beforehand
+            int ours = (wpkg->pkgnum < 0) ? 1 : 0;
+            if (tq_enqueue(tq, TQ_NONE, (void *)wpkg))
+            {
+               printf("tq_enqueue() failed on a running queue!\n");
+               return -1;
+            }
+            mastercnt += ours;
+            wpkg = NULL;
+         }
+      }
+   }
+   if (flags & TQ_ABORT)
+   {
+      printf("queue has unexpectedly aborted!\n");
+      return -1;
+   }
+   printf("queue is finished!\n");
+   while (tq_wait_for_completion(tq))
+   {
+      if (tq_get_flags(tq, &flags))
+      {
+         printf("failed to retrieve flags of incomplete queue\n");
+         return -1;
+      }
+      if (flags & TQ_HALT)
+      {
+         printf("queue was halted while master waited for completion\n");
+         if (tq_unset_flags(tq, TQ_HALT))
+         {
+            printf("unexpected return from tq_unset_flags!\n");
+            return -1;
+         }
+      }
+      else
+      {
+         printf("failed to wait for queue completion\n");
+         return -1;
+      }
+   }
+
+   // every produced package, and every one of ours, must have been consumed exactly once
+   int tnum = 0;
+   int tres = 0;
+   int prodcnt = 0;
+   int conscnt = 0;
+   ThreadState tstate = NULL;
+   while ((tres = tq_next_thread_status(tq, (void **)&tstate)) > 0)
+   {
+      if (tstate != NULL)
+      {
+         printf("State for thread %d = { tID=%d, wkcnt=%d }\n", tnum, tstate->tID, tstate->wkcnt);
+         if (tstate->tID < NUM_PROD)
+         {
+            prodcnt += tstate->wkcnt;
+         }
+         else
+         {
+            conscnt += tstate->wkcnt;
+         }
+         free(tstate);
+         tnum++;
+      }
+      else
+      {
+         printf("Received NULL status for thread %d\n", tnum);
+         return -1;
+      }
+   }
+   if (tres != 0)
+   {
+      printf("Failure of tq_next_thread_status()!\n");
+      return -1;
+   }
+
+   printf("Global state: %d ( produced=%d, master=%d, consumed=%d )\n", gstruct.pkgcnt, prodcnt, mastercnt, conscnt);
+   if (prodcnt != gstruct.pkgcnt || conscnt != (prodcnt + mastercnt))
+   {
+      printf("Consumed work count does not match produced!\n");
+      return -1;
+   }
+
+   printf("Finally, closing thread queue...\n");
+   int cres = tq_close(tq);
+   if (cres)
+   {
+      printf("Received unexpected return from tq_close() %d\n", cres);
+      return -1;
+   }
+
+   printf("Done\n");
+   return 0;
+}
@@ -182,6 +182,8 @@ int main(int argc, char **argv)
    tqopts.num_threads = NUM_PROD + NUM_CONS;
    tqopts.num_prod_threads = NUM_PROD;
    tqopts.max_qdepth = QDEPTH;
+   tqopts.lockfree = 0;
+   tqopts.pool = NULL;
    tqopts.thread_init_func = my_thread_init;
    tqopts.thread_consumer_func = my_consumer;
    tqopts.thread_producer_func = my_producer;
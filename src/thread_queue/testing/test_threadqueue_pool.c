@@ -0,0 +1,269 @@
+/**
+ * Copyright 2015. Triad National Security, LLC. All rights reserved.
+ *
+ * Full details and licensing terms can be found in the License file in the main development branch
+ * of the repository.
+ *
+ * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
+ */
+
+#include "thread_queue/thread_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <pthread.h>
+
+#define NUM_CONS 3
+#define NUM_PROD 2
+#define QDEPTH 4
+#define TOT_WRK 500
+#define ROUNDS 3 // sequential queues, which should all reuse the same pool threads
+
+typedef struct global_state_struct
+{
+   pthread_mutex_t lock;
+   int pkgcnt;
+} * GlobalState;
+
+typedef struct thread_state_struct
+{
+   unsigned int tID;
+   GlobalState gstate;
+   int wkcnt;
+} * ThreadState;
+
+int my_thread_init(unsigned int tID, void *global_state, void **state)
+{
+   *state = malloc(sizeof(struct thread_state_struct));
+   if (*state == NULL)
+   {
+      return -1;
+   }
+   ThreadState tstate = ((ThreadState)*state);
+
+   tstate->tID = tID;
+   tstate->gstate = (GlobalState)global_state;
+   tstate->wkcnt = 0;
+   return 0;
+}
+
+int my_consumer(void **state, void **work)
+{
+   ThreadState tstate = ((ThreadState)*state);
+   tstate->wkcnt++;
+   free(*work);
+   return 0;
+}
+
+int my_producer(void **state, void **work)
+{
+   ThreadState tstate = ((ThreadState)*state);
+   int *wpkg = malloc(sizeof(int));
+   if (wpkg == NULL)
+   {
+      return -1;
+   }
+   if (pthread_mutex_lock(&(tstate->gstate->lock)))
+   {
+      free(wpkg);
+      return -1;
+   }
+   *wpkg = tstate->gstate->pkgcnt;
+   tstate->gstate->pkgcnt++;
+   pthread_mutex_unlock(&(tstate->gstate->lock));
+   tstate->wkcnt++;
+   *work = (void *)wpkg;
+   if (*wpkg == TOT_WRK)
+   {
+      return 1;
+   }
+   return 0;
+}
+
+void my_thread_term(void **state, void **prev_work, TQ_Control_Flags flg)
+{
+   if (*prev_work != NULL)
+   {
+      free(*prev_work);
+      *prev_work = NULL;
+   }
+   return;
+}
+
+ThreadQueue start_queue(TQThreadPool pool, GlobalState gstate, TQ_Control_Flags flags)
+{
+   gstate->pkgcnt = 0;
+   TQ_Init_Opts tqopts;
+   tqopts.log_prefix = "PoolTQ";
+   tqopts.init_flags = flags;
+   tqopts.global_state = (void *)gstate;
+   tqopts.num_threads = NUM_PROD + NUM_CONS;
+   tqopts.num_prod_threads = NUM_PROD;
+   tqopts.max_qdepth = QDEPTH;
+   tqopts.lockfree = 0;
+   tqopts.pool = pool;
+   tqopts.thread_init_func = my_thread_init;
+   tqopts.thread_consumer_func = my_consumer;
+   tqopts.thread_producer_func = my_producer;
+   tqopts.thread_pause_func = NULL;
+   tqopts.thread_resume_func = NULL;
+   tqopts.thread_term_func = my_thread_term;
+
+   ThreadQueue tq = tq_init(&tqopts);
+   if (tq == NULL)
+   {
+      printf("tq_init() failed!\n");
+      return NULL;
+   }
+   if (tq_check_init(tq))
+   {
+      printf("tq_check_init() failed!\n");
+      return NULL;
+   }
+   return tq;
+}
+
+int finish_queue(ThreadQueue tq, GlobalState gstate)
+{
+   TQ_Control_Flags flags = 0;
+   while (!(flags & (TQ_FINISHED | TQ_ABORT)))
+   {
+      if (tq_wait_for_flags(tq, 0, &flags))
+      {
+         printf("unexpected return from tq_wait_for_flags()!\n");
+         return -1;
+      }
+   }
+   if (flags & TQ_ABORT)
+   {
+      printf("queue has unexpectedly aborted!\n");
+      return -1;
+   }
+   if (tq_wait_for_completion(tq))
+   {
+      printf("failed to wait for queue completion\n");
+      return -1;
+   }
+   int prodcnt = 0;
+   int conscnt = 0;
+   int tres;
+   ThreadState tstate = NULL;
+   while ((tres = tq_next_thread_status(tq, (void **)&tstate)) > 0)
+   {
+      if (tstate == NULL)
+      {
+         printf("Received NULL thread status\n");
+         return -1;
+      }
+      if (tstate->tID < NUM_PROD)
+      {
+         prodcnt += tstate->wkcnt;
+      }
+      else
+      {
+         conscnt += tstate->wkcnt;
+      }
+      free(tstate);
+   }
+   if (tres != 0)
+   {
+      printf("Failure of tq_next_thread_status()!\n");
+      return -1;
+   }
+   if (prodcnt != gstate->pkgcnt || conscnt != prodcnt)
+   {
+      printf("Work counts do not match ( global=%d, produced=%d, consumed=%d )\n", gstate->pkgcnt, prodcnt, conscnt);
+      return -1;
+   }
+   if (tq_close(tq))
+   {
+      printf("failed to close thread queue\n");
+      return -1;
+   }
+   return 0;
+}
+
+int check_pool(TQThreadPool pool, unsigned int expthreads, size_t expruns)
+{
+   unsigned int threads = 0;
+   size_t runs = 0;
+   if (tq_pool_stats(pool, &threads, &runs))
+   {
+      printf("tq_pool_stats() failed!\n");
+      return -1;
+   }
+   printf("Pool has run %zu queue threads across %u pool threads\n", runs, threads);
+   if (threads != expthreads || runs != expruns)
+   {
+      printf("Expected %zu runs across %u threads\n", expruns, expthreads);
+      return -1;
+   }
+   return 0;
+}
+
+int main(int argc, char **argv)
+{
+   struct global_state_struct gstructs[2];
+   if (pthread_mutex_init(&(gstructs[0].lock), NULL) || pthread_mutex_init(&(gstructs[1].lock), NULL))
+   {
+      return -1;
+   }
+
+   TQThreadPool pool = tq_pool_init("TestPool");
+   if (pool == NULL)
+   {
+      printf("tq_pool_init() failed!\n");
+      return -1;
+   }
+
+   // sequential queues should never need more threads than the first
+   int round;
+   for (round = 0; round < ROUNDS; round++)
+   {
+      ThreadQueue tq = start_queue(pool, &gstructs[0], TQ_NONE);
+      if (tq == NULL || finish_queue(tq, &gstructs[0]))
+      {
+         return -1;
+      }
+      if (check_pool(pool, NUM_PROD + NUM_CONS, (round + 1) * (NUM_PROD + NUM_CONS)))
+      {
+         return -1;
+      }
+   }
+
+   // concurrent queues should grow the pool, and the pool should refuse to terminate while they are in use
+   ThreadQueue tqa = start_queue(pool, &gstructs[0], TQ_HALT);
+   ThreadQueue tqb = start_queue(pool, &gstructs[1], TQ_HALT);
+   if (tqa == NULL || tqb == NULL)
+   {
+      return -1;
+   }
+   if (tq_pool_term(pool) == 0 || errno != EBUSY)
+   {
+      printf("tq_pool_term() did not fail with EBUSY for a pool in use\n");
+      return -1;
+   }
+   if (tq_unset_flags(tqa, TQ_HALT) || tq_unset_flags(tqb, TQ_HALT))
+   {
+      printf("unexpected return from tq_unset_flags!\n");
+      return -1;
+   }
+   if (finish_queue(tqa, &gstructs[0]) || finish_queue(tqb, &gstructs[1]))
+   {
+      return -1;
+   }
+   if (check_pool(pool, 2 * (NUM_PROD + NUM_CONS), (ROUNDS + 2) * (NUM_PROD + NUM_CONS)))
+   {
+      return -1;
+   }
+
+   if (tq_pool_term(pool))
+   {
+      printf("tq_pool_term() failed!\n");
+      return -1;
+   }
+   pthread_mutex_destroy(&(gstructs[0].lock));
+   pthread_mutex_destroy(&(gstructs[1].lock));
+   printf("Done\n");
+   return 0;
+}
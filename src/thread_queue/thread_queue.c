@@ -21,7 +21,11 @@
 #include <stdlib.h>
 #include <strings.h>
 #include <errno.h>
+#include <limits.h>
 #include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 #define def_queue_pref "ThreadQueue"
 
@@ -55,6 +59,68 @@ typedef struct thread_queue_worker_pool_struct
    /* function pointer defining the termination behavior of threads */
 } * TQWorkerPool;
 
+typedef struct thread_queue_event_struct
+{
+   unsigned int seq;     /* futex word, incremented for every event */
+   unsigned int waiters; /* number of threads preparing to sleep or sleeping on 'seq' */
+} TQEvent;
+
+typedef struct thread_queue_ring_slot_struct
+{
+   size_t seq; /* ring position at which this slot may next be filled ( pos ) or emptied ( pos + 1 ) */
+   void *work; /* work package stored in this slot */
+} TQRingSlot;
+
+typedef struct thread_queue_ring_struct
+{
+   // Ring Positions ( kept on separate cache lines, as they are updated by different threads )
+   size_t enqpos __attribute__((aligned(64))); /* next position to be filled */
+   size_t deqpos __attribute__((aligned(64))); /* next position to be emptied */
+
+   // Ring Contents
+   TQRingSlot *slots __attribute__((aligned(64)));
+   unsigned int capacity; /* number of ring slots */
+   unsigned int depth;    /* number of claimed slots ( may briefly exceed the number of filled slots ) */
+
+   // Wakeup Mechanisms
+   TQEvent consumers __attribute__((aligned(64))); /* signaled as work becomes available, or the queue flags change */
+   TQEvent producers __attribute__((aligned(64))); /* signaled as space becomes available, or the queue flags change */
+} * TQRing;
+
+typedef struct thread_queue_pool_run_struct
+{
+   void *(*func)(void *);                     /* thread function to be run by a pool thread */
+   void *arg;                                 /* argument to that function */
+   void *result;                              /* return value of that function */
+   char done;                                 /* set once the function has returned */
+   struct thread_queue_pool_run_struct *next; /* next run awaiting a pool thread */
+} TQPoolRun;
+
+typedef struct thread_queue_pool_struct
+{
+   // Logging Prefix
+   char *log_prefix;
+
+   // Synchronization Mechanisms
+   pthread_mutex_t lock;     /* pool lock, protecting all following values */
+   pthread_cond_t run_avail; /* cv signals idle pool threads that a run is available ( or that the pool is terminating ) */
+   pthread_cond_t run_done;  /* cv signals joining procs that a run has completed */
+   char term;                /* set at pool termination */
+
+   // Run Queue
+   TQPoolRun *runhead;   /* next run to be started */
+   TQPoolRun *runtail;   /* last run to be started */
+   unsigned int pending; /* number of runs awaiting a pool thread */
+   unsigned int active;  /* number of runs currently executing */
+   size_t runcnt;        /* total number of runs submitted */
+
+   // Thread Definitions
+   unsigned int idle;     /* number of threads not currently executing a run */
+   unsigned int numthrds; /* number of pool threads */
+   unsigned int maxthrds; /* allocated length of the 'threads' list */
+   pthread_t *threads;    /* thread instances */
+} * TQThreadPool;
+
 typedef struct thread_queue_struct
 {
    // Logging Prefix
@@ -74,12 +140,15 @@ typedef struct thread_queue_struct
    unsigned int max_qdepth; /* maximum number of elements in the queue */
    int head;                /* next full position */
    int tail;                /* next empty position */
+   TQRing ring;             /* lock-free ring, used in place of the above queue fields ( if non-NULL ) */
 
    // Thread Definitions
    unsigned int uncoll_thrds; /* number of threads that have initialized and not yet returned state info */
    pthread_t *threads;        /* thread instances */
    TQWorkerPool prod_pool;    /* reference to producer thread pool */
    TQWorkerPool cons_pool;    /* reference to consumer thread pool */
+   TQThreadPool pool;         /* persistent pool running our threads ( if non-NULL, in place of 'threads' ) */
+   TQPoolRun *runs;           /* pool run instances ( one per thread, only if 'pool' is non-NULL ) */
 } * ThreadQueue;
 
 typedef struct thread_arg_struct
@@ -91,6 +160,173 @@ typedef struct thread_arg_struct
 
 /* -------------------------------------------------------  INTERNAL FUNCTIONS  ------------------------------------------------------- */
 
+// read the control flags of the given queue, without holding the queue lock
+static inline TQ_Control_Flags tq_load_flags(ThreadQueue tq)
+{
+   return __atomic_load_n(&tq->con_flags, __ATOMIC_ACQUIRE);
+}
+
+// set the given control flags of the given queue ( caller must hold the queue lock )
+// NOTE -- updates are atomic, as tq_load_flags() may read the flags concurrently
+static inline void tq_add_flags(ThreadQueue tq, TQ_Control_Flags flags)
+{
+   __atomic_fetch_or(&tq->con_flags, flags, __ATOMIC_RELEASE);
+}
+
+// clear the given control flags of the given queue ( caller must hold the queue lock )
+static inline void tq_del_flags(ThreadQueue tq, TQ_Control_Flags flags)
+{
+   __atomic_fetch_and(&tq->con_flags, ~flags, __ATOMIC_RELEASE);
+}
+
+// register the calling thread as a waiter on the given event and return the current event sequence value
+// NOTE -- the caller must then recheck its wait condition, before calling either tq_event_wait() or tq_event_cancel()
+static inline unsigned int tq_event_prepare(TQEvent *ev)
+{
+   __atomic_add_fetch(&ev->waiters, 1, __ATOMIC_SEQ_CST);
+   return __atomic_load_n(&ev->seq, __ATOMIC_SEQ_CST);
+}
+
+// sleep until the given event occurs ( returns immediately, if it has already occurred since tq_event_prepare() )
+static inline void tq_event_wait(TQEvent *ev, unsigned int seq)
+{
+   syscall(SYS_futex, &ev->seq, FUTEX_WAIT_PRIVATE, seq, NULL, NULL, 0);
+   __atomic_sub_fetch(&ev->waiters, 1, __ATOMIC_SEQ_CST);
+}
+
+// unregister the calling thread as a waiter on the given event, without sleeping
+static inline void tq_event_cancel(TQEvent *ev)
+{
+   __atomic_sub_fetch(&ev->waiters, 1, __ATOMIC_SEQ_CST);
+}
+
+// signal the given event, waking up to 'cnt' sleeping threads ( but avoiding the syscall when no thread waits )
+static inline void tq_event_notify(TQEvent *ev, int cnt)
+{
+   __atomic_add_fetch(&ev->seq, 1, __ATOMIC_SEQ_CST);
+   if (cnt > 0 && __atomic_load_n(&ev->waiters, __ATOMIC_SEQ_CST))
+   {
+      syscall(SYS_futex, &ev->seq, FUTEX_WAKE_PRIVATE, cnt, NULL, NULL, 0);
+   }
+}
+
+// wake all threads waiting on the ring of the given queue ( if any ), so that they recheck the queue flags
+// NOTE -- expectation is that this is called after any modification of the control flags
+static void tq_ring_wake_all(ThreadQueue tq)
+{
+   if (tq->ring)
+   {
+      tq_event_notify(&tq->ring->consumers, INT_MAX);
+      tq_event_notify(&tq->ring->producers, INT_MAX);
+   }
+}
+
+// determine the number of threads to be woken for a new ring event
+// NOTE -- while the queue has no flags set, every sleeping thread is waiting on the ring itself.  Sleepers are
+//         then only woken when the ring leaves an empty ( or full ) state, one at a time, with each woken thread
+//         waking the next if work ( or space ) remains after its own operation.  This avoids a wakeup syscall
+//         for every operation, while some thread is still waiting to be scheduled.
+//         Otherwise, a sleeper may be waiting on the queue state instead, and could absorb a targeted wakeup,
+//         so all threads must be woken.
+static inline int tq_ring_wake_count(ThreadQueue tq, char transition)
+{
+   if (tq_load_flags(tq))
+   {
+      return INT_MAX;
+   }
+   return (transition) ? 1 : 0;
+}
+
+// attempt to insert a work package into the ring, without blocking
+// returns 1 if the work package was inserted, or 0 if the ring is full
+static int tq_ring_push(ThreadQueue tq, void *work)
+{
+   TQRing ring = tq->ring;
+   size_t pos = __atomic_load_n(&ring->enqpos, __ATOMIC_RELAXED);
+   while (1)
+   {
+      TQRingSlot *slot = &ring->slots[pos % ring->capacity];
+      size_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+      ssize_t diff = (ssize_t)seq - (ssize_t)pos;
+      if (diff == 0)
+      {
+         // this slot is empty, so attempt to claim it
+         if (__atomic_compare_exchange_n(&ring->enqpos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+         {
+            // count the element before publishing it, so that the depth never underflows
+            unsigned int depth = __atomic_fetch_add(&ring->depth, 1, __ATOMIC_SEQ_CST);
+            slot->work = work;
+            __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+            tq_event_notify(&ring->consumers, tq_ring_wake_count(tq, (depth == 0)));
+            if (__atomic_load_n(&ring->producers.waiters, __ATOMIC_SEQ_CST))
+            {
+               tq_event_notify(&ring->producers, tq_ring_wake_count(tq, (depth + 1 < ring->capacity)));
+            }
+            return 1;
+         }
+         // on CAS failure, 'pos' has been updated to the current value
+      }
+      else if (diff < 0)
+      {
+         return 0; // the slot has not yet been emptied, so the ring is full
+      }
+      else
+      {
+         pos = __atomic_load_n(&ring->enqpos, __ATOMIC_RELAXED); // another thread claimed this slot
+      }
+   }
+}
+
+// attempt to remove a work package from the ring, without blocking
+// returns the ring depth ( including the removed element ), or 0 if the ring is empty
+static unsigned int tq_ring_pop(ThreadQueue tq, void **work)
+{
+   TQRing ring = tq->ring;
+   size_t pos = __atomic_load_n(&ring->deqpos, __ATOMIC_RELAXED);
+   while (1)
+   {
+      TQRingSlot *slot = &ring->slots[pos % ring->capacity];
+      size_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+      ssize_t diff = (ssize_t)seq - (ssize_t)(pos + 1);
+      if (diff == 0)
+      {
+         // this slot is full, so attempt to claim it
+         if (__atomic_compare_exchange_n(&ring->deqpos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+         {
+            *work = slot->work;
+            slot->work = NULL;
+            __atomic_store_n(&slot->seq, pos + ring->capacity, __ATOMIC_RELEASE);
+            unsigned int depth = __atomic_fetch_sub(&ring->depth, 1, __ATOMIC_SEQ_CST);
+            tq_event_notify(&ring->producers, tq_ring_wake_count(tq, (depth == ring->capacity)));
+            if (__atomic_load_n(&ring->consumers.waiters, __ATOMIC_SEQ_CST))
+            {
+               tq_event_notify(&ring->consumers, tq_ring_wake_count(tq, (depth > 1)));
+            }
+            return depth;
+         }
+      }
+      else if (diff < 0)
+      {
+         return 0; // the slot has not yet been filled, so the ring is empty
+      }
+      else
+      {
+         pos = __atomic_load_n(&ring->deqpos, __ATOMIC_RELAXED); // another thread claimed this slot
+      }
+   }
+}
+
+// determine the current depth of the given queue
+// NOTE -- expectation is that queue lock is held throughout this func, if the queue has no ring
+static inline unsigned int tq_current_depth(ThreadQueue tq)
+{
+   if (tq->ring)
+   {
+      return __atomic_load_n(&tq->ring->depth, __ATOMIC_SEQ_CST);
+   }
+   return tq->qdepth;
+}
+
 // check that all threads in the given pool have terminated
 // NOTE -- expectation is that queue lock is held throughout this func
 char tq_threads_terminated(ThreadQueue tq, TQWorkerPool pool) {
@@ -112,12 +348,13 @@ int tq_signal(ThreadQueue tq, TQ_Control_Flags sig)
 
    pthread_mutex_lock(&tq->qlock);
 
-   tq->con_flags |= sig;
+   tq_add_flags(tq, sig);
 
    // wake ALL threads
    pthread_cond_broadcast(&tq->consumer_resume);
    pthread_cond_broadcast(&tq->producer_resume);
    pthread_cond_broadcast(&tq->state_resume);
+   tq_ring_wake_all(tq);
    pthread_mutex_unlock(&tq->qlock);
    return 0;
 }
@@ -142,9 +379,15 @@ void tq_free_all(ThreadQueue tq)
    }
 
    free(tq->threads);
+   free(tq->runs);
    free(tq->state_flags);
    free(tq->log_prefix);
    free(tq->workpkg);
+   if (tq->ring != NULL)
+   {
+      free(tq->ring->slots);
+      free(tq->ring);
+   }
    free(tq);
 }
 
@@ -164,10 +407,11 @@ int general_thread_init_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned int t
       // failed to initialize thread state
       LOG(LOG_ERR, "%s %s Thread[%u]: Failed to initialize thread state!\n", tq->log_prefix, wp->pname, tID);
       tq->state_flags[tID] |= TQ_ERROR;
-      tq->con_flags |= TQ_ABORT;                    // holding the queue lock, so this should be safe
+      tq_add_flags(tq, TQ_ABORT); // holding the queue lock, so this should be safe
       pthread_cond_broadcast(&tq->producer_resume); // so other threads check for the ABORT signal
       pthread_cond_broadcast(&tq->consumer_resume); // so other threads check for the ABORT signal
       pthread_cond_signal(&tq->state_resume);       // so our state gets rechecked
+      tq_ring_wake_all(tq);
       pthread_mutex_unlock(&tq->qlock);             // drop the lock
       return -1;
    }
@@ -193,11 +437,12 @@ int general_thread_pause_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned int
          {
             // pause func indicates we should abort
             LOG(LOG_ERR, "%s %s Thread[%u]: setting ABORT state due to pause func result\n", tq->log_prefix, wp->pname, tID);
-            tq->con_flags |= TQ_ABORT;
+            tq_add_flags(tq, TQ_ABORT);
             tq->state_flags[tID] |= TQ_ERROR;
             pthread_cond_broadcast(&tq->producer_resume);
             pthread_cond_broadcast(&tq->consumer_resume);
             pthread_cond_broadcast(&tq->state_resume);
+            tq_ring_wake_all(tq);
             return -1; // still holding lock
          }
 
@@ -237,12 +482,13 @@ int general_thread_resume_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned int
          {
             // resume func indicates we should abort
             LOG(LOG_ERR, "%s %s Thread[%u]: setting ABORT state due to resume func result\n", tq->log_prefix, wp->pname, tID);
-            tq->con_flags |= TQ_ABORT;
+            tq_add_flags(tq, TQ_ABORT);
             tq->state_flags[tID] |= TQ_ERROR;
 
             pthread_cond_broadcast(&tq->producer_resume);
             pthread_cond_broadcast(&tq->consumer_resume);
             pthread_cond_broadcast(&tq->state_resume);
+            tq_ring_wake_all(tq);
 
             return -1; // still holding lock
          }
@@ -267,7 +513,7 @@ int general_thread_post_work_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned
    if (work_res < 0)
    {
       LOG(LOG_ERR, "%s %s Thread[%u]: Setting ABORT state\n", tq->log_prefix, wp->pname, tID);
-      tq->con_flags |= TQ_ABORT;
+      tq_add_flags(tq, TQ_ABORT);
       tq->state_flags[tID] |= TQ_ERROR;
       setflags = 1;
    }
@@ -280,7 +526,7 @@ int general_thread_post_work_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned
       else
       {
          LOG(LOG_INFO, "%s %s Thread[%u]: Setting FINISHED state\n", tq->log_prefix, wp->pname, tID);
-         tq->con_flags |= TQ_FINISHED;
+         tq_add_flags(tq, TQ_FINISHED);
          setflags = 1;
       }
    }
@@ -293,7 +539,7 @@ int general_thread_post_work_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned
       else
       {
          LOG(LOG_INFO, "%s %s Thread[%u]: Setting HALT state\n", tq->log_prefix, wp->pname, tID);
-         tq->con_flags |= TQ_HALT;
+         tq_add_flags(tq, TQ_HALT);
          setflags = 1;
       }
    }
@@ -303,6 +549,7 @@ int general_thread_post_work_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned
       pthread_cond_broadcast(&tq->producer_resume);
       pthread_cond_broadcast(&tq->consumer_resume);
       pthread_cond_broadcast(&tq->state_resume);
+      tq_ring_wake_all(tq);
    }
 
    return 0; // still holding lock
@@ -322,6 +569,10 @@ void general_thread_term_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned int
    if ( tq->cons_pool  &&  wp == tq->prod_pool )
    {
       pthread_cond_broadcast(&tq->consumer_resume); // in case consumer threads are waiting for this prod to term
+      if (tq->ring)
+      {
+         tq_event_notify(&tq->ring->consumers, INT_MAX);
+      }
    }
    pthread_mutex_unlock(&tq->qlock);
 
@@ -347,7 +598,7 @@ void *consumer_thread(void *arg)
    void *tstate = NULL;
    if (general_thread_init_behavior(tq, wp, tID, global_state, &tstate))
    { // non-zero return means failure to acquire lock or initialize
-      pthread_exit(tstate);
+      return tstate;
    }
 
    // begin main loop
@@ -419,13 +670,13 @@ void *consumer_thread(void *arg)
       // acquire lock and set queue flags based on work result
       if (general_thread_post_work_behavior(tq, wp, tID, &tstate, &cur_work, work_res))
       { // non-zero return means failure to acquire lock
-         pthread_exit(tstate);
+         return tstate;
       }
    }
    // end of main loop (still holding lock)
 
    general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
-   pthread_exit(tstate);
+   return tstate;
 }
 
 // defines behavior for all producer threads
@@ -443,7 +694,7 @@ void *producer_thread(void *arg)
    void *tstate = NULL;
    if (general_thread_init_behavior(tq, wp, tID, global_state, &tstate))
    { // non-zero return means failure to acquire lock or initialize
-      pthread_exit(tstate);
+      return tstate;
    }
 
    // define pointer for current work package
@@ -463,6 +714,13 @@ void *producer_thread(void *arg)
       } // hit standard abort logic
    }
 
+   // never produce work for a queue which was ABORTed before it could begin
+   if (tq->con_flags & TQ_ABORT)
+   {
+      general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
+      return tstate;
+   }
+
    pthread_mutex_unlock(&tq->qlock); // release the lock
 
    // begin main loop
@@ -475,7 +733,7 @@ void *producer_thread(void *arg)
       // acquire lock and set queue flags based on work result
       if (general_thread_post_work_behavior(tq, wp, tID, &tstate, &cur_work, work_res))
       { // non-zero return means failure to acquire lock
-         pthread_exit(tstate);
+         return tstate;
       }
 
       // Wait while there is no space available OR while the queue is both halted and NOT FINISHED
@@ -547,7 +805,346 @@ void *producer_thread(void *arg)
    // end of main loop (still holding lock)
 
    general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
-   pthread_exit(tstate);
+   return tstate;
+}
+
+// defines behavior for all consumer threads of a queue with a lock-free ring
+void *ring_consumer_thread(void *arg)
+{
+   ThreadArg *targ = (ThreadArg *)arg;
+   ThreadQueue tq = targ->tq;
+   TQWorkerPool wp = tq->cons_pool;
+   unsigned int tID = targ->tID;
+   void *global_state = targ->global_state;
+
+   // 'targ' should never be referenced again by this thread, so we will free it now
+   free( targ );
+
+   // attempt initialization of state for this thread
+   void *tstate = NULL;
+   if (general_thread_init_behavior(tq, wp, tID, global_state, &tstate))
+   { // non-zero return means failure to acquire lock or initialize
+      return tstate;
+   }
+
+   // begin main loop
+   void *cur_work = NULL;
+   while (1)
+   {
+      // This thread should always be holding the queue lock here
+      if (tq->con_flags & TQ_ABORT)
+      {
+         break;
+      }
+
+      // NOTE -- For a FINISHED queue, consumers must wait for producers to terminate, as producers *may* still
+      //         enqueue additional work.  Once they have, the HALT flag no longer applies.
+      char finished = ((tq->con_flags & TQ_FINISHED) && tq_threads_terminated(tq, tq->prod_pool)) ? 1 : 0;
+      if (!(tq->con_flags & TQ_HALT) || finished)
+      {
+         if (tq_ring_pop(tq, &cur_work))
+         {
+            pthread_mutex_unlock(&tq->qlock);
+
+            // Process work pkgs without the lock, for so long as they are available and the queue has no flags set
+            int work_res = 0;
+            do
+            {
+               LOG(LOG_INFO, "%s %s Thread[%u]: Retrieved work package\n", tq->log_prefix, wp->pname, tID);
+               work_res = wp->thread_work_func(&tstate, &cur_work);
+               LOG(LOG_INFO, "%s %s Thread[%u]: Processed work package\n", tq->log_prefix, wp->pname, tID);
+               cur_work = NULL; // clear this value to avoid confusion if we can't reacquire the lock
+            } while (work_res == 0 && !(tq_load_flags(tq)) && tq_ring_pop(tq, &cur_work));
+
+            // acquire lock and set queue flags based on work result
+            if (general_thread_post_work_behavior(tq, wp, tID, &tstate, &cur_work, work_res))
+            { // non-zero return means failure to acquire lock
+               return tstate;
+            }
+            continue;
+         }
+
+         // a non-zero depth indicates that some thread is still filling a ring slot
+         if (finished && tq_current_depth(tq) == 0)
+         {
+            break;
+         }
+      }
+
+      // Wait here while there is no work available or the queue is HALTED
+      if (general_thread_pause_behavior(tq, wp, tID, &tstate, &cur_work) < 0)
+      {
+         break;
+      } // hit standard abort logic
+      unsigned int seq = tq_event_prepare(&tq->ring->consumers);
+      char halted = ((tq->con_flags & TQ_HALT) && !finished) ? 1 : 0;
+      pthread_mutex_unlock(&tq->qlock);
+      if (halted || tq_current_depth(tq) == 0)
+      {
+         tq_event_wait(&tq->ring->consumers, seq);
+      }
+      else
+      {
+         tq_event_cancel(&tq->ring->consumers);
+      }
+      pthread_mutex_lock(&tq->qlock);
+      if (general_thread_resume_behavior(tq, wp, tID, &tstate, &cur_work) < 0)
+      {
+         break;
+      } // hit standard abort logic
+   }
+   // end of main loop (still holding lock)
+
+   general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
+   return tstate;
+}
+
+// defines behavior for all producer threads of a queue with a lock-free ring
+void *ring_producer_thread(void *arg)
+{
+   ThreadArg *targ = (ThreadArg *)arg;
+   ThreadQueue tq = targ->tq;
+   TQWorkerPool wp = tq->prod_pool;
+   unsigned int tID = targ->tID;
+   void *global_state = targ->global_state;
+   // 'targ' should never be referenced again by this thread, so we will free it now
+   free( targ );
+
+   // attempt initialization of state for this thread
+   void *tstate = NULL;
+   if (general_thread_init_behavior(tq, wp, tID, global_state, &tstate))
+   { // non-zero return means failure to acquire lock or initialize
+      return tstate;
+   }
+
+   // define pointer for current work package
+   void *cur_work = NULL;
+
+   // special check for HALT flag before producing first work package
+   while ((tq->con_flags & TQ_HALT) && !((tq->con_flags & TQ_ABORT) || (tq->con_flags & TQ_FINISHED)))
+   {
+      if (general_thread_pause_behavior(tq, wp, tID, &tstate, &cur_work) < 0)
+      {
+         break;
+      } // hit standard abort logic
+      unsigned int seq = tq_event_prepare(&tq->ring->producers);
+      pthread_mutex_unlock(&tq->qlock);
+      tq_event_wait(&tq->ring->producers, seq);
+      pthread_mutex_lock(&tq->qlock);
+      if (general_thread_resume_behavior(tq, wp, tID, &tstate, &cur_work) < 0)
+      {
+         break;
+      } // hit standard abort logic
+   }
+
+   // never produce work for a queue which was ABORTed before it could begin
+   if (tq->con_flags & TQ_ABORT)
+   {
+      general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
+      return tstate;
+   }
+
+   pthread_mutex_unlock(&tq->qlock); // release the lock
+
+   // begin main loop
+   while (1)
+   {
+      // This thread should never be holding the queue lock here
+      // Create our new work pkg
+      int work_res = wp->thread_work_func(&tstate, &cur_work);
+      LOG(LOG_INFO, "%s %s Thread[%u]: Generated work package\n", tq->log_prefix, wp->pname, tID);
+
+      // If the queue has no flags set, attempt to store our work pkg without the lock
+      if (work_res == 0 && !(tq_load_flags(tq)) && (cur_work == NULL || tq_ring_push(tq, cur_work)))
+      {
+         cur_work = NULL; // clear this value to avoid confusion if we exit
+         continue;
+      }
+
+      // acquire lock and set queue flags based on work result
+      if (general_thread_post_work_behavior(tq, wp, tID, &tstate, &cur_work, work_res))
+      { // non-zero return means failure to acquire lock
+         return tstate;
+      }
+
+      // Wait while there is no space available OR while the queue is both halted and NOT FINISHED
+      //  but never wait while the queue is ABORTed
+      while (!(tq->con_flags & TQ_ABORT))
+      {
+         if (!((tq->con_flags & TQ_HALT) && !(tq->con_flags & TQ_FINISHED)))
+         {
+            // check if we have a work package to enqueue
+            if (cur_work == NULL || tq_ring_push(tq, cur_work))
+            {
+               cur_work = NULL; // clear this value to avoid confusion if we exit
+               break;
+            }
+         }
+
+         if (general_thread_pause_behavior(tq, wp, tID, &tstate, &cur_work) < 0)
+         {
+            break;
+         } // hit standard abort logic
+         unsigned int seq = tq_event_prepare(&tq->ring->producers);
+         char halted = ((tq->con_flags & TQ_HALT) && !(tq->con_flags & TQ_FINISHED)) ? 1 : 0;
+         pthread_mutex_unlock(&tq->qlock);
+         if (halted || tq_current_depth(tq) >= tq->ring->capacity)
+         {
+            tq_event_wait(&tq->ring->producers, seq);
+         }
+         else
+         {
+            tq_event_cancel(&tq->ring->producers);
+         }
+         pthread_mutex_lock(&tq->qlock);
+         if (general_thread_resume_behavior(tq, wp, tID, &tstate, &cur_work) < 0)
+         {
+            break;
+         } // hit standard abort logic
+
+      } // end of holding pattern -- this thread has some action to take
+
+      // First, check if we should be aborting
+      if (tq->con_flags & TQ_ABORT)
+      {
+         break;
+      }
+
+      // Now that we've enqueued our (potentially last) work package, check if we should be quitting
+      if (tq->con_flags & TQ_FINISHED)
+      {
+         break;
+      }
+
+      pthread_mutex_unlock(&tq->qlock); // release the lock
+   }
+   // end of main loop (still holding lock)
+
+   general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
+   return tstate;
+}
+
+// defines behavior for all persistent pool threads
+static void *pool_thread(void *arg)
+{
+   TQThreadPool pool = (TQThreadPool)arg;
+   pthread_mutex_lock(&pool->lock);
+   // NOTE -- this thread was counted as 'idle' by its creator
+   while (1)
+   {
+      // wait for a run to be submitted
+      while (pool->runhead == NULL && !(pool->term))
+      {
+         pthread_cond_wait(&pool->run_avail, &pool->lock);
+      }
+      if (pool->runhead == NULL)
+      {
+         break;
+      } // pool is terminating
+      TQPoolRun *run = pool->runhead;
+      pool->runhead = run->next;
+      if (pool->runhead == NULL)
+      {
+         pool->runtail = NULL;
+      }
+      pool->pending--;
+      pool->idle--;
+      pool->active++;
+      pthread_mutex_unlock(&pool->lock);
+
+      // execute the queue thread function, exactly as a dedicated thread would
+      void *result = run->func(run->arg);
+
+      pthread_mutex_lock(&pool->lock);
+      run->result = result;
+      run->done = 1;
+      pool->active--;
+      pool->idle++;
+      pthread_cond_broadcast(&pool->run_done);
+   }
+   pool->idle--;
+   pthread_mutex_unlock(&pool->lock);
+   return NULL;
+}
+
+// start the given thread function for the given queue thread, either in a new thread or a pool thread
+static int tq_start_thread(ThreadQueue tq, unsigned int tID, void *(*func)(void *), void *targ)
+{
+   TQThreadPool pool = tq->pool;
+   if (pool == NULL)
+   {
+      return pthread_create(&tq->threads[tID], NULL, func, targ);
+   }
+   TQPoolRun *run = &tq->runs[tID];
+   run->func = func;
+   run->arg = targ;
+   run->result = NULL;
+   run->done = 0;
+   run->next = NULL;
+   pthread_mutex_lock(&pool->lock);
+   if (pool->idle <= pool->pending)
+   {
+      // every idle thread is spoken for, so we must grow the pool
+      if (pool->numthrds == pool->maxthrds)
+      {
+         unsigned int newmax = (pool->maxthrds) ? (pool->maxthrds * 2) : 16;
+         pthread_t *newthrds = realloc(pool->threads, sizeof(pthread_t) * newmax);
+         if (newthrds == NULL)
+         {
+            LOG(LOG_ERR, "%s failed to expand thread list to %u entries\n", pool->log_prefix, newmax);
+            pthread_mutex_unlock(&pool->lock);
+            return -1;
+         }
+         pool->threads = newthrds;
+         pool->maxthrds = newmax;
+      }
+      if (pthread_create(&pool->threads[pool->numthrds], NULL, pool_thread, (void *)pool))
+      {
+         LOG(LOG_ERR, "%s failed to create pool thread %u\n", pool->log_prefix, pool->numthrds);
+         pthread_mutex_unlock(&pool->lock);
+         return -1;
+      }
+      pool->numthrds++;
+      pool->idle++;
+      LOG(LOG_INFO, "%s created pool thread %u\n", pool->log_prefix, pool->numthrds - 1);
+   }
+   // queue up the new run
+   if (pool->runtail)
+   {
+      pool->runtail->next = run;
+   }
+   else
+   {
+      pool->runhead = run;
+   }
+   pool->runtail = run;
+   pool->pending++;
+   pool->runcnt++;
+   pthread_cond_signal(&pool->run_avail);
+   pthread_mutex_unlock(&pool->lock);
+   return 0;
+}
+
+// wait for the given queue thread to complete, and collect its state
+static int tq_join_thread(ThreadQueue tq, unsigned int tID, void **tstate)
+{
+   TQThreadPool pool = tq->pool;
+   if (pool == NULL)
+   {
+      return pthread_join(tq->threads[tID], tstate);
+   }
+   TQPoolRun *run = &tq->runs[tID];
+   pthread_mutex_lock(&pool->lock);
+   while (!(run->done))
+   {
+      pthread_cond_wait(&pool->run_done, &pool->lock);
+   }
+   pthread_mutex_unlock(&pool->lock);
+   if (tstate != NULL)
+   {
+      *tstate = run->result;
+   }
+   return 0;
 }
 
 /* -------------------------------------------------------  EXPOSED FUNCTIONS  ------------------------------------------------------- */
@@ -642,6 +1239,7 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
    tq->qdepth = 0;
    tq->head = 0;
    tq->tail = 0;
+   tq->ring = NULL;
 
    // initialize control flags
    tq->con_flags = opts->init_flags;
@@ -653,6 +1251,10 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
    // initialize our count of uncollected threads
    tq->uncoll_thrds = 0;
 
+   // note any persistent thread pool
+   tq->pool = opts->pool;
+   tq->runs = NULL;
+
    // initialize pthread control structures
    pthread_mutex_init(&tq->qlock, NULL);
    pthread_cond_init(&tq->state_resume, NULL);
@@ -667,10 +1269,59 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
 
    // initialize fields requiring memory allocation
    tq->state_flags = calloc(opts->num_threads, sizeof(TQ_State_Flags));
-   tq->workpkg = calloc(opts->max_qdepth, sizeof(void *));
+   if (opts->lockfree)
+   {
+      tq->workpkg = NULL;
+      if (posix_memalign((void **)&tq->ring, 64, sizeof(struct thread_queue_ring_struct)))
+      {
+         LOG(LOG_ERR, "%s failed to allocate a lock-free ring\n", tq->log_prefix);
+         tq->ring = NULL;
+      }
+      else
+      {
+         bzero(tq->ring, sizeof(struct thread_queue_ring_struct));
+         tq->ring->capacity = opts->max_qdepth;
+         tq->ring->slots = malloc(sizeof(TQRingSlot) * opts->max_qdepth);
+         if (tq->ring->slots == NULL)
+         {
+            LOG(LOG_ERR, "%s failed to allocate %u ring slots\n", tq->log_prefix, opts->max_qdepth);
+            free(tq->ring);
+            tq->ring = NULL;
+         }
+         else
+         {
+            unsigned int slot;
+            for (slot = 0; slot < opts->max_qdepth; slot++)
+            {
+               tq->ring->slots[slot].seq = slot;
+               tq->ring->slots[slot].work = NULL;
+            }
+         }
+      }
+      if (tq->ring == NULL)
+      {
+         free(tq->state_flags);
+         FREE_PTHREAD_VALUES(tq);
+         FREE_TQP(tq);
+         return NULL;
+      }
+   }
+   else
+   {
+      tq->workpkg = calloc(opts->max_qdepth, sizeof(void *));
+   }
 
    // allocate space for all thread instances
    tq->threads = malloc(sizeof(pthread_t *) * opts->num_threads);
+   if (tq->pool)
+   {
+      tq->runs = calloc(opts->num_threads, sizeof(TQPoolRun));
+      if (tq->runs == NULL)
+      {
+         LOG(LOG_WARNING, "%s failed to allocate pool run list, falling back to dedicated threads\n", tq->log_prefix);
+         tq->pool = NULL;
+      }
+   }
 
    // allocate space for thread arg structs
    ThreadArg** targs = malloc(sizeof(ThreadArg*) * opts->num_threads);
@@ -723,7 +1374,7 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
       targ->tID = tID;
       targ->tq = tq;
       LOG(LOG_INFO, "%s Starting %s Thread %u\n", tq->log_prefix, tq->prod_pool->pname, targ->tID);
-      if (pthread_create(&tq->threads[tID], NULL, producer_thread, (void *)targ))
+      if (tq_start_thread(tq, tID, (tq->ring) ? ring_producer_thread : producer_thread, (void *)targ))
       {
          LOG(LOG_ERR, "%s failed to create thread %d\n", tq->log_prefix, tID);
          break;
@@ -740,7 +1391,7 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
       targ->tID = tID;
       targ->tq = tq;
       LOG(LOG_INFO, "%s Starting %s Thread %u\n", tq->log_prefix, tq->cons_pool->pname, targ->tID);
-      if (pthread_create(&tq->threads[tID], NULL, consumer_thread, (void *)targ))
+      if (tq_start_thread(tq, tID, (tq->ring) ? ring_consumer_thread : consumer_thread, (void *)targ))
       {
          LOG(LOG_ERR, "%s failed to create thread %d\n", tq->log_prefix, tID);
          for( unsigned int i = tID; i < opts->num_threads; i++ ) { free( targs[i] ); }
@@ -761,9 +1412,10 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
    { // an error occured while creating threads
       LOG(LOG_ERR, "%s failed to init all threads: signaling ABORT!\n", tq->log_prefix);
 
-      tq->con_flags |= TQ_ABORT; // signal all threads to abort (potentially redundant)
+      tq_add_flags(tq, TQ_ABORT); // signal all threads to abort (potentially redundant)
       pthread_cond_broadcast(&tq->consumer_resume);
       pthread_cond_broadcast(&tq->producer_resume);
+      tq_ring_wake_all(tq);
 
       if (tID < opts->num_threads)
       {
@@ -772,7 +1424,7 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
 
       for (tID = 0; tID < tq->uncoll_thrds; tID++)
       {
-         pthread_join(tq->threads[tID], NULL); // just ignore thread status, we are already aborting
+         tq_join_thread(tq, tID, NULL); // just ignore thread status, we are already aborting
          LOG(LOG_INFO, "%s joined with thread %u\n", tq->log_prefix, tID);
       }
 
@@ -861,6 +1513,8 @@ int tq_get_opts(ThreadQueue tq, TQ_Init_Opts *opts, int log_strlen)
    // populate all struct fields
    opts->init_flags = TQ_NONE; // just don't bother
    opts->max_qdepth = tq->max_qdepth;
+   opts->lockfree = (tq->ring) ? 1 : 0;
+   opts->pool = tq->pool;
    opts->global_state = NULL; // just don't bother
    opts->num_threads = num_threads;
    opts->num_prod_threads = num_prods;
@@ -901,6 +1555,36 @@ int tq_get_opts(ThreadQueue tq, TQ_Init_Opts *opts, int log_strlen)
  */
 int tq_enqueue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void *workbuff)
 {
+   if (tq->ring)
+   {
+      // insert the new work into the ring, waiting for an opening or for work to be canceled
+      while (1)
+      {
+         // check for any oddball conditions which would prevent this work from completing
+         if (tq_load_flags(tq) & ~(ignore_flags))
+         {
+            LOG(LOG_ERR, "%s queue state prevents enqueueing!\n", tq->log_prefix);
+            errno = EINVAL;
+            return -1;
+         }
+         if (tq_ring_push(tq, workbuff))
+         {
+            LOG(LOG_INFO, "%s master proc has successfully enqueued work\n", tq->log_prefix);
+            return 0;
+         }
+         LOG(LOG_INFO, "%s master proc is waiting for an opening to enqueue into\n", tq->log_prefix);
+         unsigned int seq = tq_event_prepare(&tq->ring->producers);
+         if (!(tq_load_flags(tq) & ~(ignore_flags)) && tq_current_depth(tq) >= tq->ring->capacity)
+         {
+            tq_event_wait(&tq->ring->producers, seq);
+         }
+         else
+         {
+            tq_event_cancel(&tq->ring->producers);
+         }
+      }
+   }
+
    pthread_mutex_lock(&tq->qlock);
 
    // wait for an opening in the queue or for work to be canceled
@@ -964,10 +1648,54 @@ int tq_enqueue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void *workbuff)
  */
 int tq_dequeue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff)
 {
-   pthread_mutex_lock(&tq->qlock);
-
    ignore_flags |= TQ_FINISHED; // a FINISHED queue can still be dequeued from
 
+   if (tq->ring)
+   {
+      void *work = NULL;
+      unsigned int depth = 0;
+      while (1)
+      {
+         TQ_Control_Flags flags = tq_load_flags(tq);
+         // check for any oddball conditions which should prevent this work
+         if (flags & ~(ignore_flags))
+         {
+            LOG(LOG_ERR, "%s queue state prevents dequeueing!\n", tq->log_prefix);
+            errno = EINVAL;
+            return -1;
+         }
+         if ((depth = tq_ring_pop(tq, &work)) > 0)
+         {
+            break;
+         }
+         // check for an empty queue
+         if (flags)
+         {
+            LOG(LOG_INFO, "%s master proc can't dequeue while queue is empty and has flags: %d\n", tq->log_prefix, flags);
+            if (workbuff)
+               *workbuff = NULL;
+            return 0;
+         }
+         // wait for a queue element or for any state flags which could prevent work from being created
+         LOG(LOG_INFO, "%s master proc is waiting for an element to dequeue\n", tq->log_prefix);
+         unsigned int seq = tq_event_prepare(&tq->ring->consumers);
+         if (!(tq_load_flags(tq)) && tq_current_depth(tq) == 0)
+         {
+            tq_event_wait(&tq->ring->consumers, seq);
+         }
+         else
+         {
+            tq_event_cancel(&tq->ring->consumers);
+         }
+      }
+      LOG(LOG_INFO, "%s master proc has successfully dequeued work\n", tq->log_prefix);
+      if (workbuff)
+         *workbuff = work;
+      return (int)depth;
+   }
+
+   pthread_mutex_lock(&tq->qlock);
+
    // wait for a queue element or for any state flags which could prevent work from being created
    while ((tq->qdepth == 0 && !(tq->con_flags)))
    {
@@ -1040,7 +1768,7 @@ int tq_dequeue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff)
 int tq_depth(ThreadQueue tq)
 {
    pthread_mutex_lock(&tq->qlock);
-   const int depth = tq->qdepth;
+   const int depth = tq_current_depth(tq);
    pthread_mutex_unlock(&tq->qlock);
    return depth;
 }
@@ -1057,13 +1785,14 @@ int tq_set_flags(ThreadQueue tq, TQ_Control_Flags flags)
    pthread_mutex_lock(&tq->qlock);
 
    // set the requested flags
-   tq->con_flags |= flags;
+   tq_add_flags(tq, flags);
    LOG(LOG_INFO, "%s master set flag values: %d\n", tq->log_prefix, (int)flags);
 
    // wake all threads
    pthread_cond_broadcast(&tq->producer_resume);
    pthread_cond_broadcast(&tq->consumer_resume);
    pthread_cond_broadcast(&tq->state_resume);
+   tq_ring_wake_all(tq);
 
    // release the lock
    pthread_mutex_unlock(&tq->qlock);
@@ -1083,13 +1812,14 @@ int tq_unset_flags(ThreadQueue tq, TQ_Control_Flags flags)
    pthread_mutex_lock(&tq->qlock);
 
    // unset the requested flags
-   tq->con_flags &= ~(flags);
+   tq_del_flags(tq, flags);
    LOG(LOG_INFO, "%s master removed flag values: %d\n", tq->log_prefix, flags);
 
    // wake all threads
    pthread_cond_broadcast(&tq->producer_resume);
    pthread_cond_broadcast(&tq->consumer_resume);
    pthread_cond_broadcast(&tq->state_resume);
+   tq_ring_wake_all(tq);
 
    // release the lock
    pthread_mutex_unlock(&tq->qlock);
@@ -1256,7 +1986,7 @@ int tq_wait_for_completion(ThreadQueue tq)
                                                       &&  (tq->con_flags & TQ_FINISHED) )
          {
             // special check for possible deadlock
-            if ( tq->cons_pool == NULL  &&  tq->qdepth ) {
+            if ( tq->cons_pool == NULL  &&  tq_current_depth(tq) ) {
                LOG( LOG_WARNING, "Possible deadlock condition: Queue is non-empty and no consumer threads exist\n" );
                pthread_mutex_unlock(&tq->qlock);
                return 1;
@@ -1413,7 +2143,7 @@ int tq_next_thread_status(ThreadQueue tq, void **tstate)
 
       LOG(LOG_INFO, "%s master attempting to join thread %u\n", tq->log_prefix, tID);
 
-      int ret = pthread_join(tq->threads[tID], tstate);
+      int ret = tq_join_thread(tq, tID, tstate);
       if (ret)
       { // indicate a failure if we couldn't join
          LOG(LOG_ERR, "%s master failed to join thread %u!\n", tq->log_prefix, tID);
@@ -1460,11 +2190,11 @@ int tq_close(ThreadQueue tq)
       return -1;
    }
 
-   if (tq->qdepth != 0)
+   if (tq_current_depth(tq) != 0)
    {
       LOG(LOG_ERR, "%s cannont close a queue with elements still remaining!\n", tq->log_prefix);
       errno = EINVAL;
-      int depth = tq->qdepth;
+      int depth = tq_current_depth(tq);
       pthread_mutex_unlock(&tq->qlock);
       return depth;
    }
@@ -1478,3 +2208,113 @@ int tq_close(ThreadQueue tq)
 
    return 0;
 }
+
+/**
+ * Initializes a new, empty pool of persistent threads, which may be shared by any number of ThreadQueues
+ *  NOTE -- Threads are only created as a queue requires more than are currently idle, and idle threads then
+ *          persist until tq_pool_term().  The pool thus grows to the peak number of simultaneously running
+ *          queue threads.
+ * @param const char* log_prefix : String prefix for all log messages produced by this pool ( may be NULL )
+ * @return TQThreadPool : Reference to the new pool, or NULL on failure
+ */
+TQThreadPool tq_pool_init(const char *log_prefix)
+{
+   TQThreadPool pool = calloc(1, sizeof(struct thread_queue_pool_struct));
+   if (pool == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate a new thread pool\n");
+      return NULL;
+   }
+   pool->log_prefix = strdup((log_prefix) ? log_prefix : def_queue_pref);
+   if (pool->log_prefix == NULL)
+   {
+      LOG(LOG_ERR, "failed to duplicate thread pool log prefix\n");
+      free(pool);
+      return NULL;
+   }
+   if (pthread_mutex_init(&pool->lock, NULL))
+   {
+      LOG(LOG_ERR, "%s failed to initialize thread pool lock\n", pool->log_prefix);
+      free(pool->log_prefix);
+      free(pool);
+      return NULL;
+   }
+   pthread_cond_init(&pool->run_avail, NULL);
+   pthread_cond_init(&pool->run_done, NULL);
+   return pool;
+}
+
+/**
+ * Retrieve thread counts of the given pool
+ * @param TQThreadPool pool : Pool to retrieve counts from
+ * @param unsigned int* threads : Reference to be populated with the total number of pool threads ( may be NULL )
+ * @param size_t* runs : Reference to be populated with the total number of queue threads run by the pool,
+ *                       including any still running ( may be NULL )
+ * @return int : Zero on success, or -1 on failure
+ */
+int tq_pool_stats(TQThreadPool pool, unsigned int *threads, size_t *runs)
+{
+   if (pool == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL thread pool reference!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   pthread_mutex_lock(&pool->lock);
+   if (threads)
+   {
+      *threads = pool->numthrds;
+   }
+   if (runs)
+   {
+      *runs = pool->runcnt;
+   }
+   pthread_mutex_unlock(&pool->lock);
+   return 0;
+}
+
+/**
+ * Terminates all threads of the given pool, and frees it
+ * @param TQThreadPool pool : Pool to be terminated
+ * @return int : Zero on success, or -1 on failure ( errno == EBUSY, if the pool is still in use by any queue )
+ */
+int tq_pool_term(TQThreadPool pool)
+{
+   if (pool == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL thread pool reference!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   pthread_mutex_lock(&pool->lock);
+   if (pool->pending || pool->active)
+   {
+      LOG(LOG_ERR, "%s cannot terminate a thread pool with %u pending and %u active runs\n",
+          pool->log_prefix, pool->pending, pool->active);
+      pthread_mutex_unlock(&pool->lock);
+      errno = EBUSY;
+      return -1;
+   }
+   pool->term = 1;
+   pthread_cond_broadcast(&pool->run_avail);
+   pthread_mutex_unlock(&pool->lock);
+
+   unsigned int tnum;
+   for (tnum = 0; tnum < pool->numthrds; tnum++)
+   {
+      if (pthread_join(pool->threads[tnum], NULL))
+      {
+         LOG(LOG_WARNING, "%s failed to join pool thread %u\n", pool->log_prefix, tnum);
+      }
+   }
+   LOG(LOG_INFO, "%s terminated thread pool after %zu runs across %u threads\n",
+       pool->log_prefix, pool->runcnt, pool->numthrds);
+
+   pthread_cond_destroy(&pool->run_done);
+   pthread_cond_destroy(&pool->run_avail);
+   pthread_mutex_destroy(&pool->lock);
+   free(pool->threads);
+   free(pool->log_prefix);
+   free(pool);
+   return 0;
+}
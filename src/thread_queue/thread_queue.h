@@ -10,6 +10,8 @@
  * MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier: LA-CC-15-039.
  */
 
+#include <stddef.h>
+
 typedef enum
 {
    TQ_NONE = 0,             // filler value, used to indicate no flags at all
@@ -23,14 +25,21 @@ typedef enum
                             //  Takes precedence over TQ_HALT and TQ_FINISHED ( those flags will be ignored )
 } TQ_Control_Flags;
 
+typedef struct thread_queue_pool_struct *TQThreadPool; // forward decl.
+
 typedef struct queue_init_struct
 {
    // Queue Info
    char *log_prefix;            /* string prefix for all log messages produced by this queue */
    TQ_Control_Flags init_flags; /* state flags to set at the moment of queue creation, before threads initialize */
    unsigned int max_qdepth;     /* maximum depth of the work queue */
+   char lockfree;               /* if non-zero, work is passed through a bounded lock-free ring, with futex wakeups
+                                   of individual waiting threads, rather than through the lock-protected queue
+                                   ( control flags and thread states are still managed under the queue lock ) */
 
    // Thread Info
+   TQThreadPool pool;             /* if non-NULL, threads are borrowed from this persistent pool, rather than being created
+                                     for this queue and exited at queue completion ( see tq_pool_init() ) */
    void *global_state;            /* reference to some global initial state, passed to the init_thread state func of all threads */
    unsigned int num_threads;      /* number of threads to initialize */
    unsigned int num_prod_threads; /* number of threads to utilize the thread_producer_func() (those with tID < num_prod_threads) */
@@ -125,6 +134,33 @@ typedef struct queue_init_struct
 
 typedef struct thread_queue_struct *ThreadQueue; // forward decl.
 
+/**
+ * Initializes a new, empty pool of persistent threads, which may be shared by any number of ThreadQueues
+ *  NOTE -- Threads are only created as a queue requires more than are currently idle, and idle threads then
+ *          persist until tq_pool_term().  The pool thus grows to the peak number of simultaneously running
+ *          queue threads.
+ * @param const char* log_prefix : String prefix for all log messages produced by this pool ( may be NULL )
+ * @return TQThreadPool : Reference to the new pool, or NULL on failure
+ */
+TQThreadPool tq_pool_init(const char *log_prefix);
+
+/**
+ * Retrieve thread counts of the given pool
+ * @param TQThreadPool pool : Pool to retrieve counts from
+ * @param unsigned int* threads : Reference to be populated with the total number of pool threads ( may be NULL )
+ * @param size_t* runs : Reference to be populated with the total number of queue threads run by the pool,
+ *                       including any still running ( may be NULL )
+ * @return int : Zero on success, or -1 on failure
+ */
+int tq_pool_stats(TQThreadPool pool, unsigned int *threads, size_t *runs);
+
+/**
+ * Terminates all threads of the given pool, and frees it
+ * @param TQThreadPool pool : Pool to be terminated
+ * @return int : Zero on success, or -1 on failure ( errno == EBUSY, if the pool is still in use by any queue )
+ */
+int tq_pool_term(TQThreadPool pool);
+
 /**
  * Initializes a new ThreadQueue according to the parameters of the passed options struct
  * @param TQ_Init_Opts opts : options struct defining parameters for the created ThreadQueue